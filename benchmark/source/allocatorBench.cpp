@@ -0,0 +1,65 @@
+#include <algorithmCollection/allocators/arenaAllocator.h>
+#include <algorithmCollection/allocators/instrumentedAllocator.h>
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+
+#include "benchCommon.h"
+
+// Per-request container lifetimes: build a container, drop it, start over. The arena variants
+// reset their arena at the end of every iteration, the way a request-scoped arena would be.
+// The instrumented variants show what counting every allocation in AllocationStats::global() costs.
+
+template <typename T>
+using ArenaDynamicArray = DynamicArray<T, MonotonicArenaAllocator<T>>;
+
+template <typename T>
+using ArenaList = DoubleLinkedList<T, MonotonicArenaAllocator<T>>;
+
+template <typename T>
+using InstrumentedDynamicArray = DynamicArray<T, InstrumentedAllocator<SimpleAllocator<T>>>;
+
+template <typename T>
+using InstrumentedList = DoubleLinkedList<T, InstrumentedAllocator<SimpleAllocator<T>>>;
+
+template <typename Container>
+void BM_RequestScopedBuild(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            container.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(container);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_RequestScopedBuildArena(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    ArenaResource arena;
+
+    for (auto _ : state) {
+        {
+            Container container(MonotonicArenaAllocator<T>{arena});
+            for (std::size_t i = 0; i < n; ++i) {
+                container.push_back(make_value<T>(i));
+            }
+            benchmark::DoNotOptimize(container);
+        }
+        arena.reset();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+REGISTER_FOR_ELEMENT_TYPES(BM_RequestScopedBuild, DynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_RequestScopedBuildArena, ArenaDynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_RequestScopedBuild, InstrumentedDynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_RequestScopedBuild, DoubleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_RequestScopedBuildArena, ArenaList);
+REGISTER_FOR_ELEMENT_TYPES(BM_RequestScopedBuild, InstrumentedList);
@@ -0,0 +1,69 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// 64-byte trivially copyable payload, one cache line per element
+struct Pod64 {
+    std::uint64_t values[8];
+
+    bool operator==(const Pod64&) const = default;
+};
+
+static_assert(sizeof(Pod64) == 64);
+
+// Value type stored by a container, also for containers that do not expose value_type
+template <typename Container>
+using element_t = std::remove_cvref_t<decltype(*std::declval<Container&>().begin())>;
+
+// Produces a distinct value for element i
+template <typename T>
+T make_value(std::size_t i);
+
+template <>
+inline int make_value<int>(std::size_t i) {
+    return static_cast<int>(i);
+}
+
+template <>
+inline Pod64 make_value<Pod64>(std::size_t i) {
+    Pod64 value{};
+    value.values[0] = i;
+    return value;
+}
+
+template <>
+inline std::string make_value<std::string>(std::size_t i) {
+    // Long enough to defeat the small string optimization, so every element owns a heap buffer
+    return "benchmark-value-" + std::to_string(i) + "-padding-past-sso";
+}
+
+// Reads an element so iteration benchmarks cannot be optimized away
+inline std::uint64_t touch(int value) { return static_cast<std::uint64_t>(value); }
+inline std::uint64_t touch(const Pod64& value) { return value.values[0]; }
+inline std::uint64_t touch(const std::string& value) { return value.size(); }
+
+// Element counts swept by every sized benchmark: 16, then powers of 8 from 64 up to 8^7, and 10M
+inline void container_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(16, 10'000'000);
+}
+
+// Fills a container with n elements through push_back
+template <typename Container>
+Container make_filled(std::size_t n) {
+    using T = element_t<Container>;
+    Container container;
+    for (std::size_t i = 0; i < n; ++i) {
+        container.push_back(make_value<T>(i));
+    }
+    return container;
+}
+
+// Registers a benchmark template for every element type of the sweep
+#define REGISTER_FOR_ELEMENT_TYPES(fn, Container)                          \
+    BENCHMARK_TEMPLATE(fn, Container<int>)->Apply(container_sizes);         \
+    BENCHMARK_TEMPLATE(fn, Container<Pod64>)->Apply(container_sizes);       \
+    BENCHMARK_TEMPLATE(fn, Container<std::string>)->Apply(container_sizes)
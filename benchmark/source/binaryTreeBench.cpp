@@ -0,0 +1,112 @@
+#include <algorithmCollection/data structures/binaryTree.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "benchCommon.h"
+
+// lower_bound over n sorted 32 bit keys: binary search on the sorted array against the Eytzinger
+// and van Emde Boas StaticSearchTree, and the pointer-based BinaryTree against std::set. Probes are
+// random, so once the keys outgrow the cache every level of a binary search is a miss.
+
+namespace {
+    constexpr std::size_t probe_count = 1 << 12;
+
+    struct Lookups {
+        std::vector<std::uint32_t> sorted;
+        std::vector<std::uint32_t> probes;
+    };
+
+    const Lookups& bench_lookups(std::size_t n) {
+        static std::size_t cached_size = 0;
+        static Lookups cached;
+        if (cached_size != n) {
+            std::mt19937_64 rng(42);
+            cached.sorted.resize(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                cached.sorted[i] = static_cast<std::uint32_t>(2 * i);
+            }
+            cached.probes.resize(probe_count);
+            for (std::uint32_t& probe : cached.probes) {
+                probe = static_cast<std::uint32_t>(rng() % (2 * n));
+            }
+            cached_size = n;
+        }
+        return cached;
+    }
+
+    template <TreeLayout Layout>
+    void static_tree_lookups(benchmark::State& state) {
+        const Lookups& lookups = bench_lookups(static_cast<std::size_t>(state.range(0)));
+        const StaticSearchTree<std::uint32_t, Layout> tree(lookups.sorted.begin(), lookups.sorted.end());
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (std::uint32_t probe : lookups.probes) {
+                sum += tree.lower_bound(probe);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(probe_count));
+    }
+
+    template <typename Tree>
+    void node_tree_lookups(benchmark::State& state) {
+        const Lookups& lookups = bench_lookups(static_cast<std::size_t>(state.range(0)));
+        Tree tree;
+        for (std::uint32_t key : lookups.sorted) {
+            tree.insert(key);
+        }
+        for (auto _ : state) {
+            std::uint64_t sum = 0;
+            for (std::uint32_t probe : lookups.probes) {
+                const auto it = tree.lower_bound(probe);
+                sum += it != tree.end() ? *it : 0;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(probe_count));
+    }
+}
+
+static void BM_SortedArrayLowerBound(benchmark::State& state) {
+    const Lookups& lookups = bench_lookups(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::size_t sum = 0;
+        for (std::uint32_t probe : lookups.probes) {
+            sum += static_cast<std::size_t>(
+                std::lower_bound(lookups.sorted.begin(), lookups.sorted.end(), probe) - lookups.sorted.begin());
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(probe_count));
+}
+
+static void BM_EytzingerLowerBound(benchmark::State& state) {
+    static_tree_lookups<TreeLayout::Eytzinger>(state);
+}
+
+static void BM_VanEmdeBoasLowerBound(benchmark::State& state) {
+    static_tree_lookups<TreeLayout::VanEmdeBoas>(state);
+}
+
+static void BM_BinaryTreeLowerBound(benchmark::State& state) {
+    node_tree_lookups<BinaryTree<std::uint32_t>>(state);
+}
+
+static void BM_StdSetLowerBound(benchmark::State& state) {
+    node_tree_lookups<std::set<std::uint32_t>>(state);
+}
+
+// Key counts 2^10 ... 2^22, 4 KiB to 16 MiB of keys
+static void lookup_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+}
+
+BENCHMARK(BM_SortedArrayLowerBound)->Apply(lookup_sizes);
+BENCHMARK(BM_EytzingerLowerBound)->Apply(lookup_sizes);
+BENCHMARK(BM_VanEmdeBoasLowerBound)->Apply(lookup_sizes);
+BENCHMARK(BM_BinaryTreeLowerBound)->Apply(lookup_sizes);
+BENCHMARK(BM_StdSetLowerBound)->Apply(lookup_sizes);
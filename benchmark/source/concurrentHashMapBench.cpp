@@ -0,0 +1,68 @@
+#include <algorithmCollection/data structures/concurrentHashMap.h>
+#include <algorithmCollection/data structures/hash_map.h>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+#include "benchCommon.h"
+
+// A shared cache under 95% lookups and 5% assignments, run by 1 to 32 threads at once: one HashMap
+// behind a std::mutex, the same behind a std::shared_mutex, and ConcurrentHashMap. Real time per
+// operation shows how each scales with the number of threads.
+
+constexpr std::uint64_t cache_keys = 1 << 16;
+
+// One HashMap behind a single lock, with the interface of ConcurrentHashMap
+template <typename Mutex>
+class LockedMap {
+public:
+    std::optional<std::uint64_t> find(std::uint64_t key) const {
+        std::conditional_t<std::is_same_v<Mutex, std::shared_mutex>, std::shared_lock<Mutex>, std::unique_lock<Mutex>> lock(m_mutex);
+        auto it = m_map.find(key);
+        if (it == m_map.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void insert_or_assign(std::uint64_t key, std::uint64_t value) {
+        std::unique_lock lock(m_mutex);
+        m_map.insert_or_assign(key, value);
+    }
+
+private:
+    mutable Mutex m_mutex;
+    HashMap<std::uint64_t, std::uint64_t> m_map;
+};
+
+template <typename Map>
+void BM_SharedCacheReadMostly(benchmark::State& state) {
+    static Map map;
+    if (state.thread_index() == 0) {
+        for (std::uint64_t key = 0; key < cache_keys; ++key) {
+            map.insert_or_assign(key, key);
+        }
+    }
+
+    // xorshift keeps the key sequence of every thread distinct and cheap to produce
+    std::uint64_t x = 0x9E3779B97F4A7C15ULL * (static_cast<std::uint64_t>(state.thread_index()) + 1);
+    std::uint64_t found = 0;
+    for (auto _ : state) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        const std::uint64_t key = x % cache_keys;
+        if (x % 100 < 5) {
+            map.insert_or_assign(key, x);
+        } else if (auto value = map.find(key)) {
+            found += *value;
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_SharedCacheReadMostly, LockedMap<std::mutex>)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedCacheReadMostly, LockedMap<std::shared_mutex>)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedCacheReadMostly, ConcurrentHashMap<std::uint64_t, std::uint64_t>)->ThreadRange(1, 32)->UseRealTime();
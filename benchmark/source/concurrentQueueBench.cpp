@@ -0,0 +1,222 @@
+#include <algorithmCollection/data structures/deque.h>
+#include <algorithmCollection/data structures/queue.h>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchCommon.h"
+
+// SpscQueue and MpmcQueue against a bounded Deque behind a std::mutex, the usual hand-rolled
+// alternative. Throughput benchmarks move a fixed number of items from producer to consumer
+// threads per iteration (wall-clock time, thread start-up included); the ping-pong benchmark
+// measures the round trip of one item between two threads through a pair of queues.
+
+constexpr std::size_t bench_queue_capacity = 1024;
+constexpr std::size_t items_per_iteration = 1 << 20;
+
+// Waits out a full or empty queue: spins briefly, then yields, so the benchmarks also make progress
+// on machines with fewer cores than threads
+class Backoff {
+public:
+    void wait() {
+        if (++m_spins > 64) {
+            std::this_thread::yield();
+        }
+    }
+
+    void reset() { m_spins = 0; }
+
+private:
+    unsigned m_spins = 0;
+};
+
+// Bounded queue guarded by a mutex, with the interface of the lock-free queues
+template <typename T>
+class LockedQueue {
+public:
+    explicit LockedQueue(std::size_t capacity) : m_capacity(capacity) {}
+
+    bool try_push(const T& value) {
+        std::lock_guard lock(m_mutex);
+        if (m_items.size() == m_capacity) {
+            return false;
+        }
+        m_items.push_back(value);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        std::lock_guard lock(m_mutex);
+        if (m_items.empty()) {
+            return false;
+        }
+        out = m_items.front();
+        m_items.pop_front();
+        return true;
+    }
+
+    template <class InputIt>
+    std::size_t try_push_n(InputIt first, std::size_t count) {
+        std::lock_guard lock(m_mutex);
+        std::size_t pushed = 0;
+        for (; pushed < count && m_items.size() < m_capacity; ++pushed, ++first) {
+            m_items.push_back(*first);
+        }
+        return pushed;
+    }
+
+    template <class OutputIt>
+    std::size_t try_pop_n(OutputIt out, std::size_t count) {
+        std::lock_guard lock(m_mutex);
+        std::size_t popped = 0;
+        for (; popped < count && !m_items.empty(); ++popped, ++out) {
+            *out = m_items.front();
+            m_items.pop_front();
+        }
+        return popped;
+    }
+
+private:
+    std::mutex m_mutex;
+    Deque<T> m_items;
+    std::size_t m_capacity;
+};
+
+// Moves items_per_iteration items from range(0) producers to range(1) consumers, one at a time
+// or, with Batch, up to 32 per call
+template <typename Queue, std::size_t Batch = 1>
+void BM_QueueThroughput(benchmark::State& state) {
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    const auto consumers = static_cast<std::size_t>(state.range(1));
+    const std::size_t per_producer = items_per_iteration / producers;
+    const std::size_t total = per_producer * producers;
+
+    for (auto _ : state) {
+        Queue queue(bench_queue_capacity);
+        std::atomic<std::size_t> consumed{0};
+        std::vector<std::thread> threads;
+
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&] {
+                std::uint64_t batch[Batch] = {};
+                Backoff backoff;
+                for (std::size_t sent = 0; sent < per_producer;) {
+                    std::size_t pushed = 0;
+                    if constexpr (Batch == 1) {
+                        pushed = queue.try_push(sent) ? 1 : 0;
+                    } else {
+                        for (std::size_t i = 0; i < Batch; ++i) {
+                            batch[i] = sent + i;
+                        }
+                        pushed = queue.try_push_n(batch, std::min(Batch, per_producer - sent));
+                    }
+                    if (pushed == 0) {
+                        backoff.wait();
+                    } else {
+                        backoff.reset();
+                        sent += pushed;
+                    }
+                }
+            });
+        }
+        for (std::size_t c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                std::uint64_t batch[Batch];
+                std::uint64_t sum = 0;
+                Backoff backoff;
+                while (consumed.load(std::memory_order_relaxed) < total) {
+                    std::size_t received = 0;
+                    if constexpr (Batch == 1) {
+                        received = queue.try_pop(batch[0]) ? 1 : 0;
+                    } else {
+                        received = queue.try_pop_n(batch, Batch);
+                    }
+                    for (std::size_t i = 0; i < received; ++i) {
+                        sum += batch[i];
+                    }
+                    if (received == 0) {
+                        backoff.wait();
+                    } else {
+                        backoff.reset();
+                        consumed.fetch_add(received, std::memory_order_relaxed);
+                    }
+                }
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * total));
+}
+
+// One thread sends an item and waits for an echo thread to send it back
+template <typename Queue>
+void BM_QueuePingPong(benchmark::State& state) {
+    Queue requests(bench_queue_capacity);
+    Queue replies(bench_queue_capacity);
+    constexpr std::uint64_t stop = ~std::uint64_t{0};
+
+    std::thread echo([&] {
+        std::uint64_t value = 0;
+        Backoff backoff;
+        while (true) {
+            if (!requests.try_pop(value)) {
+                backoff.wait();
+                continue;
+            }
+            backoff.reset();
+            if (value == stop) {
+                return;
+            }
+            while (!replies.try_push(value)) {
+            }
+        }
+    });
+
+    std::uint64_t next = 0;
+    Backoff backoff;
+    for (auto _ : state) {
+        while (!requests.try_push(next)) {
+        }
+        std::uint64_t reply;
+        while (!replies.try_pop(reply)) {
+            backoff.wait();
+        }
+        backoff.reset();
+        benchmark::DoNotOptimize(reply);
+        ++next;
+    }
+
+    while (!requests.try_push(stop)) {
+    }
+    echo.join();
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+using Spsc = SpscQueue<std::uint64_t>;
+using Mpmc = MpmcQueue<std::uint64_t>;
+using Locked = LockedQueue<std::uint64_t>;
+
+inline void single_pair(benchmark::internal::Benchmark* b) {
+    b->Args({1, 1})->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+inline void thread_pairs(benchmark::internal::Benchmark* b) {
+    b->Args({1, 1})->Args({2, 2})->Args({4, 4})->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_QueueThroughput, Spsc)->Apply(single_pair);
+BENCHMARK_TEMPLATE(BM_QueueThroughput, Spsc, 32)->Apply(single_pair);
+BENCHMARK_TEMPLATE(BM_QueueThroughput, Mpmc)->Apply(thread_pairs);
+BENCHMARK_TEMPLATE(BM_QueueThroughput, Mpmc, 32)->Apply(thread_pairs);
+BENCHMARK_TEMPLATE(BM_QueueThroughput, Locked)->Apply(thread_pairs);
+BENCHMARK_TEMPLATE(BM_QueueThroughput, Locked, 32)->Apply(thread_pairs);
+BENCHMARK_TEMPLATE(BM_QueuePingPong, Spsc)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueuePingPong, Mpmc)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueuePingPong, Locked)->UseRealTime();
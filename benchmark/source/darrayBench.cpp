@@ -0,0 +1,140 @@
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithm>
+#include <vector>
+
+#include "sequenceBenchmarks.h"
+
+// DynamicArray against std::vector. Both expose the same interface for these operations, except
+// std::vector has no push_front, which is expressed through insert/erase at begin().
+
+template <typename T>
+using StdVector = std::vector<T>;
+
+// Builds a container of n elements from empty with emplace_back
+template <typename Container>
+void BM_EmplaceBack(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            container.emplace_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(container);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Inserts one element in the middle of n elements and erases it again
+template <typename Container>
+void BM_InsertEraseMiddle(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Container container = make_filled<Container>(n);
+    const T value = make_value<T>(n);
+
+    for (auto _ : state) {
+        container.insert(container.begin() + n / 2, value);
+        container.erase(container.begin() + n / 2);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Adds one element in front of n elements and removes it again
+template <typename Container>
+void BM_PushFront(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Container container = make_filled<Container>(n);
+    const T value = make_value<T>(n);
+
+    for (auto _ : state) {
+        if constexpr (requires { container.push_front(value); }) {
+            container.push_front(value);
+            container.pop_front();
+        } else {
+            container.insert(container.begin(), value);
+            container.erase(container.begin());
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// FIFO use with a size hovering at half of a power-of-two capacity: every iteration erases the oldest
+// element and appends a new one. A shrink rule without hysteresis reallocates on each erase here.
+template <typename Container>
+void BM_EraseFrontChurn(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Container container = make_filled<Container>(2 * n);
+    container.erase(container.begin() + n, container.end());
+    const T value = make_value<T>(n);
+
+    for (auto _ : state) {
+        container.erase(container.begin());
+        container.push_back(value);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Builds a sorted container of n elements by inserting each value at its sorted position, the
+// pattern of sorted batch appends. Shifting makes this quadratic, so sizes stop at 8^5.
+template <typename Container>
+void BM_SortedInsert(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            T value = make_value<T>((i * 2654435761u) % n);
+            auto pos = std::upper_bound(container.begin(), container.end(), value,
+                [](const T& a, const T& b) { return touch(a) < touch(b); });
+            container.emplace(pos, std::move(value));
+        }
+        benchmark::DoNotOptimize(container);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+using HalfGrowthArray = DynamicArray<T, SimpleAllocator<T>, HalfGrowth>;
+
+inline void sorted_insert_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(16, 32768);
+}
+
+BENCHMARK_TEMPLATE(BM_SortedInsert, DynamicArray<int>)->Apply(sorted_insert_sizes);
+BENCHMARK_TEMPLATE(BM_SortedInsert, HalfGrowthArray<int>)->Apply(sorted_insert_sizes);
+BENCHMARK_TEMPLATE(BM_SortedInsert, StdVector<int>)->Apply(sorted_insert_sizes);
+BENCHMARK_TEMPLATE(BM_SortedInsert, DynamicArray<std::string>)->Apply(sorted_insert_sizes);
+BENCHMARK_TEMPLATE(BM_SortedInsert, StdVector<std::string>)->Apply(sorted_insert_sizes);
+
+REGISTER_FOR_ELEMENT_TYPES(BM_PushBack, DynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_PushBack, HalfGrowthArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_PushBack, StdVector);
+REGISTER_FOR_ELEMENT_TYPES(BM_EmplaceBack, DynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_EmplaceBack, StdVector);
+REGISTER_FOR_ELEMENT_TYPES(BM_InsertEraseMiddle, DynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_InsertEraseMiddle, StdVector);
+REGISTER_FOR_ELEMENT_TYPES(BM_EraseFrontChurn, DynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_EraseFrontChurn, StdVector);
+REGISTER_FOR_ELEMENT_TYPES(BM_Iterate, DynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_Iterate, StdVector);
+REGISTER_FOR_ELEMENT_TYPES(BM_Copy, DynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_Copy, StdVector);
+REGISTER_FOR_ELEMENT_TYPES(BM_Move, DynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_Move, StdVector);
+REGISTER_FOR_ELEMENT_TYPES(BM_PushFront, DynamicArray);
+REGISTER_FOR_ELEMENT_TYPES(BM_PushFront, StdVector);
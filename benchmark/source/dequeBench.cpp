@@ -0,0 +1,86 @@
+#include <algorithmCollection/data structures/deque.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <deque>
+
+#include "sequenceBenchmarks.h"
+
+// Deque against std::deque, and against DynamicArray for the front operations DynamicArray pays
+// O(n) shifting for.
+
+template <typename T>
+using StdDeque = std::deque<T>;
+
+// FIFO use at a steady size of n: every iteration appends one element and removes the oldest
+template <typename Container>
+void BM_QueueChurn(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Container container = make_filled<Container>(n);
+    const T value = make_value<T>(n);
+
+    for (auto _ : state) {
+        container.push_back(value);
+        container.pop_front();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Builds a container of n elements from empty with push_front
+template <typename Container>
+void BM_PushFrontBuild(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            container.push_front(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(container);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Reads n elements in a pseudo-random order through operator[]
+template <typename Container>
+void BM_RandomAccess(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const Container container = make_filled<Container>(n);
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            index = (index + 2654435761u) % n;
+            sum += touch(container[index]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// DynamicArray's front operations are quadratic over a whole build, so its sizes stop at 8^5
+inline void front_shift_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(16, 32768);
+}
+
+REGISTER_FOR_ELEMENT_TYPES(BM_PushBack, Deque);
+REGISTER_FOR_ELEMENT_TYPES(BM_PushBack, StdDeque);
+REGISTER_FOR_ELEMENT_TYPES(BM_Iterate, Deque);
+REGISTER_FOR_ELEMENT_TYPES(BM_Iterate, StdDeque);
+REGISTER_FOR_ELEMENT_TYPES(BM_RandomAccess, Deque);
+REGISTER_FOR_ELEMENT_TYPES(BM_RandomAccess, StdDeque);
+REGISTER_FOR_ELEMENT_TYPES(BM_QueueChurn, Deque);
+REGISTER_FOR_ELEMENT_TYPES(BM_QueueChurn, StdDeque);
+REGISTER_FOR_ELEMENT_TYPES(BM_PushFrontBuild, Deque);
+REGISTER_FOR_ELEMENT_TYPES(BM_PushFrontBuild, StdDeque);
+REGISTER_FOR_ELEMENT_TYPES(BM_Copy, Deque);
+REGISTER_FOR_ELEMENT_TYPES(BM_Copy, StdDeque);
+
+BENCHMARK_TEMPLATE(BM_QueueChurn, DynamicArray<int>)->Apply(front_shift_sizes);
+BENCHMARK_TEMPLATE(BM_PushFrontBuild, DynamicArray<int>)->Apply(front_shift_sizes);
@@ -0,0 +1,144 @@
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <algorithmCollection/data structures/intrusive_linkedList.h>
+#include <iterator>
+#include <list>
+#include <vector>
+
+#include "sequenceBenchmarks.h"
+
+// DoubleLinkedList, with SimpleAllocator and with its recommended PoolAllocator, against std::list.
+
+template <typename T>
+using StdList = std::list<T>;
+
+template <typename T>
+using PooledList = PooledDoubleLinkedList<T>;
+
+// Builds a container of n elements from empty with push_front
+template <typename Container>
+void BM_ListPushFront(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            container.push_front(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(container);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Inserts before an iterator held in the middle of n elements and erases the new element again,
+// so the list stays at n elements and every iteration pays one node allocation and one free.
+// The lookup is not timed.
+template <typename Container>
+void BM_ListInsertEraseMiddle(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Container container = make_filled<Container>(n);
+    const T value = make_value<T>(n);
+    auto middle = std::next(container.cbegin(), static_cast<std::ptrdiff_t>(n / 2));
+
+    for (auto _ : state) {
+        auto inserted = container.insert(middle, value);
+        benchmark::DoNotOptimize(inserted);
+        container.erase(inserted);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Sorts n elements inserted in a scrambled order; the list is refilled outside the timed region
+template <typename Container>
+void BM_ListSort(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            container.push_back(make_value<T>((i * 2654435761u) % n));
+        }
+        state.ResumeTiming();
+
+        container.sort([](const T& a, const T& b) { return touch(a) < touch(b); });
+        benchmark::DoNotOptimize(container);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// LRU access pattern: an element known by handle moves to the front of an n element list
+
+struct LruEntry : IntrusiveListHook<> {
+    std::size_t key;
+};
+
+void BM_LruTouchIntrusive(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<LruEntry> entries(n);
+    IntrusiveList<LruEntry> list;
+    for (std::size_t i = 0; i < n; ++i) {
+        entries[i].key = i;
+        list.push_back(entries[i]);
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        LruEntry& entry = entries[i];
+        list.remove(entry);
+        list.push_front(entry);
+        i = (i + 7919) % n;
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_LruTouchStdList(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::list<std::size_t> list;
+    std::vector<std::list<std::size_t>::iterator> handles;
+    handles.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        handles.push_back(list.insert(list.end(), i));
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        list.splice(list.begin(), list, handles[i]);
+        i = (i + 7919) % n;
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+REGISTER_FOR_ELEMENT_TYPES(BM_PushBack, DoubleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_PushBack, PooledList);
+REGISTER_FOR_ELEMENT_TYPES(BM_PushBack, StdList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ListPushFront, DoubleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ListPushFront, PooledList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ListPushFront, StdList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ListInsertEraseMiddle, DoubleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ListInsertEraseMiddle, PooledList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ListInsertEraseMiddle, StdList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ListSort, DoubleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ListSort, PooledList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ListSort, StdList);
+REGISTER_FOR_ELEMENT_TYPES(BM_Iterate, DoubleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_Iterate, PooledList);
+REGISTER_FOR_ELEMENT_TYPES(BM_Iterate, StdList);
+REGISTER_FOR_ELEMENT_TYPES(BM_Copy, DoubleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_Copy, PooledList);
+REGISTER_FOR_ELEMENT_TYPES(BM_Copy, StdList);
+REGISTER_FOR_ELEMENT_TYPES(BM_Move, DoubleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_Move, StdList);
+BENCHMARK(BM_LruTouchIntrusive)->Apply(container_sizes);
+BENCHMARK(BM_LruTouchStdList)->Apply(container_sizes);
@@ -0,0 +1,237 @@
+#include <algorithmCollection/data structures/fixedArray.h>
+#include <array>
+#include <memory>
+#include <numeric>
+
+#include "benchCommon.h"
+
+// FixedArray against std::array. The size is a template parameter, so every point of the sweep is
+// its own instantiation. All arrays are kept on the heap so the 10M element cases fit on any stack;
+// HeapFixedArray additionally pays for the pointer to its separately allocated elements.
+
+template <typename T, std::size_t S>
+using StdArray = std::array<T, S>;
+
+// Creates an array with every element set to a distinct value
+template <typename Array>
+std::unique_ptr<Array> make_fixed() {
+    using T = element_t<Array>;
+    auto array = std::make_unique<Array>();
+    std::size_t i = 0;
+    for (auto& value : *array) {
+        value = make_value<T>(i++);
+    }
+    return array;
+}
+
+// Walks every element once through the array's iterators
+template <typename Array>
+void BM_FixedIterate(benchmark::State& state) {
+    const auto array = make_fixed<Array>();
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const auto& value : *array) {
+            sum += touch(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(array->size()));
+}
+
+// Copy-constructs the array
+template <typename Array>
+void BM_FixedCopy(benchmark::State& state) {
+    const auto source = make_fixed<Array>();
+
+    for (auto _ : state) {
+        auto copy = std::make_unique<Array>(*source);
+        benchmark::DoNotOptimize(copy->begin());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(source->size()));
+}
+
+// Move-constructs the array and moves it back
+template <typename Array>
+void BM_FixedMove(benchmark::State& state) {
+    auto source = make_fixed<Array>();
+
+    for (auto _ : state) {
+        auto moved = std::make_unique<Array>(std::move(*source));
+        benchmark::DoNotOptimize(moved->begin());
+        *source = std::move(*moved);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(source->size()));
+}
+
+// Assigns one value to every element
+template <typename Array>
+void BM_FixedFill(benchmark::State& state) {
+    using T = element_t<Array>;
+    auto array = make_fixed<Array>();
+    const T value = make_value<T>(0);
+
+    for (auto _ : state) {
+        array->fill(value);
+        benchmark::DoNotOptimize(array->begin());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(array->size()));
+}
+
+// Small vectors built and consumed inside a numeric loop: each iteration creates two arrays on the
+// stack, combines them element-wise and reduces the result.
+template <typename Array>
+void BM_FixedSmallVectorMath(benchmark::State& state) {
+    std::uint64_t seed = 1;
+
+    for (auto _ : state) {
+        Array a;
+        Array b;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            a[i] = static_cast<double>(seed + i);
+            b[i] = static_cast<double>(seed * i);
+        }
+        benchmark::DoNotOptimize(a.begin());
+        benchmark::DoNotOptimize(b.begin());
+
+        double dot = 0.0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            dot += a[i] * b[i];
+        }
+        benchmark::DoNotOptimize(dot);
+        ++seed;
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Array().size()));
+}
+
+// dot() and sum() of FixedArray against the left-to-right std::inner_product and std::accumulate
+// over std::array; the FixedArray reductions keep several partial sums the compiler can vectorize
+template <typename Array>
+std::unique_ptr<Array> make_numeric() {
+    using T = element_t<Array>;
+    auto array = std::make_unique<Array>();
+    std::size_t i = 0;
+    for (auto& value : *array) {
+        value = static_cast<T>(i++ % 7 + 1);
+    }
+    return array;
+}
+
+template <typename T, std::size_t S, typename Alloc>
+T bench_dot(const FixedArray<T, S, Alloc>& lhs, const FixedArray<T, S, Alloc>& rhs) {
+    return dot(lhs, rhs);
+}
+
+template <typename T, std::size_t S>
+T bench_dot(const StdArray<T, S>& lhs, const StdArray<T, S>& rhs) {
+    return std::inner_product(lhs.begin(), lhs.end(), rhs.begin(), T{});
+}
+
+template <typename T, std::size_t S, typename Alloc>
+T bench_sum(const FixedArray<T, S, Alloc>& array) {
+    return sum(array);
+}
+
+template <typename T, std::size_t S>
+T bench_sum(const StdArray<T, S>& array) {
+    return std::accumulate(array.begin(), array.end(), T{});
+}
+
+template <typename Array>
+void BM_FixedDot(benchmark::State& state) {
+    const auto lhs = make_numeric<Array>();
+    const auto rhs = make_numeric<Array>();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bench_dot(*lhs, *rhs));
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lhs->size()));
+}
+
+template <typename Array>
+void BM_FixedSum(benchmark::State& state) {
+    const auto array = make_numeric<Array>();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bench_sum(*array));
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(array->size()));
+}
+
+// Element-wise a += b, in place; a plain loop over std::array stays scalar at -O2 since a and b
+// might overlap, FixedArray's blocked loop vectorizes
+template <typename Array>
+void BM_FixedAddAssign(benchmark::State& state) {
+    const auto a = make_numeric<Array>();
+    const auto b = make_numeric<Array>();
+
+    for (auto _ : state) {
+        if constexpr (std::is_same_v<Array, StdArray<element_t<Array>, std::tuple_size_v<Array>>>) {
+            for (std::size_t i = 0; i < a->size(); ++i) {
+                (*a)[i] += (*b)[i];
+            }
+        } else {
+            *a += *b;
+        }
+        benchmark::DoNotOptimize(a->begin());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(a->size()));
+}
+
+#define REGISTER_FIXED_SIZE(fn, T, S)               \
+    BENCHMARK_TEMPLATE(fn, FixedArray<T, S>);       \
+    BENCHMARK_TEMPLATE(fn, HeapFixedArray<T, S>);   \
+    BENCHMARK_TEMPLATE(fn, StdArray<T, S>)
+
+#define REGISTER_FIXED_SIZES(fn, T)             \
+    REGISTER_FIXED_SIZE(fn, T, 16);             \
+    REGISTER_FIXED_SIZE(fn, T, 1024);           \
+    REGISTER_FIXED_SIZE(fn, T, 65536);          \
+    REGISTER_FIXED_SIZE(fn, T, 1048576);        \
+    REGISTER_FIXED_SIZE(fn, T, 10000000)
+
+#define REGISTER_FIXED_BENCHMARK(fn)            \
+    REGISTER_FIXED_SIZES(fn, int);              \
+    REGISTER_FIXED_SIZES(fn, Pod64);            \
+    REGISTER_FIXED_SIZES(fn, std::string)
+
+REGISTER_FIXED_BENCHMARK(BM_FixedIterate);
+REGISTER_FIXED_BENCHMARK(BM_FixedCopy);
+REGISTER_FIXED_BENCHMARK(BM_FixedMove);
+REGISTER_FIXED_BENCHMARK(BM_FixedFill);
+
+#define REGISTER_SMALL_VECTOR_SIZE(S)                                   \
+    BENCHMARK_TEMPLATE(BM_FixedSmallVectorMath, FixedArray<double, S>);     \
+    BENCHMARK_TEMPLATE(BM_FixedSmallVectorMath, HeapFixedArray<double, S>); \
+    BENCHMARK_TEMPLATE(BM_FixedSmallVectorMath, StdArray<double, S>)
+
+REGISTER_SMALL_VECTOR_SIZE(3);
+REGISTER_SMALL_VECTOR_SIZE(4);
+REGISTER_SMALL_VECTOR_SIZE(16);
+
+#define REGISTER_FIXED_MATH_SIZE(fn, T, S)          \
+    BENCHMARK_TEMPLATE(fn, FixedArray<T, S>);       \
+    BENCHMARK_TEMPLATE(fn, StdArray<T, S>)
+
+#define REGISTER_FIXED_MATH(fn)                     \
+    REGISTER_FIXED_MATH_SIZE(fn, float, 8);         \
+    REGISTER_FIXED_MATH_SIZE(fn, float, 256);       \
+    REGISTER_FIXED_MATH_SIZE(fn, float, 4096);      \
+    REGISTER_FIXED_MATH_SIZE(fn, double, 4096);     \
+    REGISTER_FIXED_MATH_SIZE(fn, int, 4096)
+
+REGISTER_FIXED_MATH(BM_FixedDot);
+REGISTER_FIXED_MATH(BM_FixedSum);
+REGISTER_FIXED_MATH(BM_FixedAddAssign);
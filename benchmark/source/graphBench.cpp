@@ -0,0 +1,144 @@
+#include <algorithmCollection/algorithms/threadPool.h>
+#include <algorithmCollection/data structures/graph.h>
+#include <cstdint>
+#include <list>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "benchCommon.h"
+
+// CSR Graph traversals against the adjacency list of linked lists layout, on uniform random
+// undirected graphs of average degree 16. The parallel variants use a pool as wide as the machine.
+
+namespace {
+    constexpr std::size_t average_degree = 16;
+
+    DynamicArray<Edge<std::uint32_t>> random_graph_edges(std::size_t vertices) {
+        std::mt19937_64 rng(42);
+        DynamicArray<Edge<std::uint32_t>> edges;
+        edges.reserve(vertices * average_degree / 2);
+        for (std::size_t i = 0; i < vertices * average_degree / 2; ++i) {
+            edges.push_back({static_cast<std::uint32_t>(rng() % vertices), static_cast<std::uint32_t>(rng() % vertices),
+                static_cast<std::uint32_t>(1 + rng() % 255)});
+        }
+        return edges;
+    }
+
+    // Unweighted and weighted copies of the same undirected graph
+    struct BenchGraphs {
+        Graph<> unweighted;
+        Graph<std::uint32_t> weighted;
+        std::vector<std::list<std::uint32_t>> lists;
+    };
+
+    const BenchGraphs& bench_graphs(std::size_t vertices) {
+        static std::size_t cached_size = 0;
+        static BenchGraphs cached;
+        if (cached_size != vertices) {
+            const auto edges = random_graph_edges(vertices);
+            DynamicArray<Edge<>> plain;
+            plain.reserve(edges.size());
+            for (const auto& edge : edges) {
+                plain.push_back({edge.source, edge.target});
+            }
+            cached.unweighted = Graph<>(vertices, plain, GraphKind::Undirected);
+            cached.weighted = Graph<std::uint32_t>(vertices, edges, GraphKind::Undirected);
+            cached.lists.assign(vertices, {});
+            for (const auto& edge : edges) {
+                cached.lists[edge.source].push_back(edge.target);
+                if (edge.source != edge.target) {
+                    cached.lists[edge.target].push_back(edge.source);
+                }
+            }
+            cached_size = vertices;
+        }
+        return cached;
+    }
+
+    ThreadPool& bench_pool() {
+        static ThreadPool pool;
+        return pool;
+    }
+}
+
+static void BM_BfsLinkedLists(benchmark::State& state) {
+    const auto& graphs = bench_graphs(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::vector<std::uint32_t> parent(graphs.lists.size(), Graph<>::no_vertex);
+        std::queue<std::uint32_t> queue;
+        parent[0] = 0;
+        queue.push(0);
+        while (!queue.empty()) {
+            const std::uint32_t u = queue.front();
+            queue.pop();
+            for (std::uint32_t v : graphs.lists[u]) {
+                if (parent[v] == Graph<>::no_vertex) {
+                    parent[v] = u;
+                    queue.push(v);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(parent.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graphs.unweighted.arc_count()));
+}
+
+static void BM_BfsCsr(benchmark::State& state) {
+    const auto& graphs = bench_graphs(static_cast<std::size_t>(state.range(0)));
+    ThreadPool* pool = state.range(1) != 0 ? &bench_pool() : nullptr;
+    for (auto _ : state) {
+        auto parent = bfs(graphs.unweighted, std::uint32_t{0}, pool);
+        benchmark::DoNotOptimize(parent.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graphs.unweighted.arc_count()));
+}
+
+static void BM_Dijkstra(benchmark::State& state) {
+    const auto& graphs = bench_graphs(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto distance = dijkstra(graphs.weighted, std::uint32_t{0});
+        benchmark::DoNotOptimize(distance.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graphs.weighted.arc_count()));
+}
+
+static void BM_DeltaStepping(benchmark::State& state) {
+    const auto& graphs = bench_graphs(static_cast<std::size_t>(state.range(0)));
+    ThreadPool* pool = state.range(1) != 0 ? &bench_pool() : nullptr;
+    for (auto _ : state) {
+        auto distance = delta_stepping(graphs.weighted, std::uint32_t{0}, std::uint32_t{32}, pool);
+        benchmark::DoNotOptimize(distance.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graphs.weighted.arc_count()));
+}
+
+static void BM_ConnectedComponents(benchmark::State& state) {
+    const auto& graphs = bench_graphs(static_cast<std::size_t>(state.range(0)));
+    ThreadPool* pool = state.range(1) != 0 ? &bench_pool() : nullptr;
+    for (auto _ : state) {
+        auto labels = connected_components(graphs.unweighted, pool);
+        benchmark::DoNotOptimize(labels.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(graphs.unweighted.arc_count()));
+}
+
+// Vertex counts 2^12 ... 2^20, without (0) and with (1) the thread pool
+static void graph_sizes(benchmark::internal::Benchmark* b) {
+    for (std::int64_t vertices = 1 << 12; vertices <= 1 << 20; vertices <<= 4) {
+        b->Args({vertices, 0});
+        b->Args({vertices, 1});
+    }
+}
+
+static void graph_sizes_sequential(benchmark::internal::Benchmark* b) {
+    for (std::int64_t vertices = 1 << 12; vertices <= 1 << 20; vertices <<= 4) {
+        b->Args({vertices});
+    }
+}
+
+BENCHMARK(BM_BfsLinkedLists)->Apply(graph_sizes_sequential)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BfsCsr)->Apply(graph_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Dijkstra)->Apply(graph_sizes_sequential)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DeltaStepping)->Apply(graph_sizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConnectedComponents)->Apply(graph_sizes)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,178 @@
+#include <algorithmCollection/data structures/hash_map.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "benchCommon.h"
+
+// HashMap against std::unordered_map, for int and heap-owning std::string keys. Maps are built and
+// probed in two different shuffled key orders, so neither consecutive probes nor consecutively
+// allocated nodes share cache lines. Every map allocates through
+// CountingAllocator, which reports the bytes the map requested per entry as bytes_per_entry; the
+// per-allocation overhead of the heap, paid once per node by std::unordered_map, is not included.
+
+inline std::size_t counted_bytes = 0;
+
+template <typename T>
+class CountingAllocator {
+public:
+    using value_type = T;
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        counted_bytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        counted_bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+};
+
+template <typename K>
+using FlatHashMap = HashMap<K, std::uint64_t, std::hash<K>, std::equal_to<K>,
+    CountingAllocator<std::pair<const K, std::uint64_t>>>;
+
+template <typename K>
+using StdHashMap = std::unordered_map<K, std::uint64_t, std::hash<K>, std::equal_to<K>,
+    CountingAllocator<std::pair<const K, std::uint64_t>>>;
+
+template <typename Map>
+using map_key_t = typename Map::key_type;
+
+// Keys first..first+n-1 in an order chosen by seed
+template <typename K>
+std::vector<K> shuffled_keys(std::size_t n, std::size_t first = 0, std::uint64_t seed = 42) {
+    std::vector<K> keys;
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys.push_back(make_value<K>(first + i));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(seed));
+    return keys;
+}
+
+// Builds a map holding the keys, reporting the bytes it allocated per entry
+template <typename Map>
+Map make_map(const std::vector<map_key_t<Map>>& keys, benchmark::State& state) {
+    const std::size_t before = counted_bytes;
+    Map map;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        map.emplace(keys[i], i);
+    }
+    state.counters["bytes_per_entry"] = static_cast<double>(counted_bytes - before) / static_cast<double>(keys.size());
+    return map;
+}
+
+// Looks up every key present in the map
+template <typename Map>
+void BM_HashFindHit(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const Map map = make_map<Map>(shuffled_keys<map_key_t<Map>>(n), state);
+    const auto keys = shuffled_keys<map_key_t<Map>>(n, 0, 7);
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const auto& key : keys) {
+            sum += map.find(key)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Looks up as many keys that are not in the map
+template <typename Map>
+void BM_HashFindMiss(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const Map map = make_map<Map>(shuffled_keys<map_key_t<Map>>(n), state);
+    const auto missing = shuffled_keys<map_key_t<Map>>(n, n);
+
+    for (auto _ : state) {
+        std::size_t found = 0;
+        for (const auto& key : missing) {
+            found += map.find(key) != map.end() ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Builds a map of n entries from empty, growing as it goes
+template <typename Map>
+void BM_HashInsert(benchmark::State& state) {
+    const auto keys = shuffled_keys<map_key_t<Map>>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        Map map;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            map.emplace(keys[i], i);
+        }
+        benchmark::DoNotOptimize(map);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Builds a map of n entries with one range insert, which sizes the table once up front
+template <typename Map>
+void BM_HashBulkInsert(benchmark::State& state) {
+    std::vector<typename Map::value_type> entries;
+    for (const auto& key : shuffled_keys<map_key_t<Map>>(static_cast<std::size_t>(state.range(0)))) {
+        entries.emplace_back(key, entries.size());
+    }
+
+    for (auto _ : state) {
+        Map map;
+        map.insert(entries.begin(), entries.end());
+        benchmark::DoNotOptimize(map);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Erases every entry and inserts it again, a steady-state cache update pattern
+template <typename Map>
+void BM_HashEraseInsert(benchmark::State& state) {
+    const auto keys = shuffled_keys<map_key_t<Map>>(static_cast<std::size_t>(state.range(0)));
+    Map map = make_map<Map>(keys, state);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            map.erase(keys[i]);
+            map.emplace(keys[i], i);
+        }
+        benchmark::DoNotOptimize(map);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Entry counts from a few groups up to well past the last level cache
+inline void hash_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(16, 1 << 20);
+}
+
+#define REGISTER_HASH_BENCHMARK(fn)                                         \
+    BENCHMARK_TEMPLATE(fn, FlatHashMap<int>)->Apply(hash_sizes);            \
+    BENCHMARK_TEMPLATE(fn, StdHashMap<int>)->Apply(hash_sizes);             \
+    BENCHMARK_TEMPLATE(fn, FlatHashMap<std::string>)->Apply(hash_sizes);    \
+    BENCHMARK_TEMPLATE(fn, StdHashMap<std::string>)->Apply(hash_sizes)
+
+REGISTER_HASH_BENCHMARK(BM_HashFindHit);
+REGISTER_HASH_BENCHMARK(BM_HashFindMiss);
+REGISTER_HASH_BENCHMARK(BM_HashInsert);
+REGISTER_HASH_BENCHMARK(BM_HashBulkInsert);
+REGISTER_HASH_BENCHMARK(BM_HashEraseInsert);
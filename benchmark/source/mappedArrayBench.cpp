@@ -0,0 +1,84 @@
+#include <algorithmCollection/data structures/mappedArray.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "benchCommon.h"
+
+// Loading n 64 bit values saved to a file: reading them back into a DynamicArray against opening a
+// MappedArray, which costs the same at every size; plus a full pass over the mapped values and the
+// checksum verification that reads every byte. The files stay in the page cache between runs, so
+// this measures the loading work rather than the disk.
+
+namespace {
+    const std::filesystem::path& bench_file(std::size_t n) {
+        static std::size_t cached_size = 0;
+        static const std::filesystem::path path = std::filesystem::temp_directory_path() / "algorithm_collection_bench.bin";
+        if (cached_size != n) {
+            DynamicArray<std::uint64_t> values;
+            values.reserve(n);
+            for (std::uint64_t i = 0; i < n; ++i) {
+                values.push_back(i * 0x9E3779B97F4A7C15ULL);
+            }
+            write_mapped_array(path, values.data());
+            cached_size = n;
+        }
+        return path;
+    }
+}
+
+// Reads the file into a DynamicArray one value at a time, the deserialization MappedArray replaces
+static void BM_ReadIntoDynamicArray(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto& path = bench_file(n);
+    for (auto _ : state) {
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(128);
+        DynamicArray<std::uint64_t> values;
+        values.reserve(n);
+        std::uint64_t value;
+        while (in.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+            values.push_back(value);
+        }
+        benchmark::DoNotOptimize(values.begin());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 8);
+}
+
+static void BM_MappedArrayOpen(benchmark::State& state) {
+    const auto& path = bench_file(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        const MappedArray<std::uint64_t> values(path);
+        benchmark::DoNotOptimize(values.data().data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 8);
+}
+
+static void BM_MappedArrayOpenAndSum(benchmark::State& state) {
+    const auto& path = bench_file(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        const MappedArray<std::uint64_t> values(path);
+        benchmark::DoNotOptimize(column_sum(values.data()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 8);
+}
+
+static void BM_MappedArrayVerify(benchmark::State& state) {
+    const auto& path = bench_file(static_cast<std::size_t>(state.range(0)));
+    const MappedArray<std::uint64_t> values(path);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values.verify_checksums());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 8);
+}
+
+// 2^16 ... 2^24 values, 512 KiB to 128 MiB
+static void file_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(1 << 16, 1 << 24)->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(BM_ReadIntoDynamicArray)->Apply(file_sizes);
+BENCHMARK(BM_MappedArrayOpen)->Apply(file_sizes);
+BENCHMARK(BM_MappedArrayOpenAndSum)->Apply(file_sizes);
+BENCHMARK(BM_MappedArrayVerify)->Apply(file_sizes);
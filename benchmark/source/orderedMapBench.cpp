@@ -0,0 +1,150 @@
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/map.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "benchCommon.h"
+
+// B-tree Map against the red-black tree std::map, for int and heap-owning std::string keys. The maps
+// hold every even key; probes draw random keys, so consecutive probes do not share a path through the
+// tree, and odd probes exercise lower_bound between two stored keys.
+
+template <typename K>
+using BTreeMap = Map<K, std::uint64_t>;
+
+template <typename K>
+using StdMap = std::map<K, std::uint64_t>;
+
+template <typename Tree>
+using tree_key_t = typename Tree::key_type;
+
+// The even keys 0, 2, ..., 2n-2 in ascending order
+template <typename K>
+std::vector<K> even_keys(std::size_t n) {
+    std::vector<K> keys;
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys.push_back(make_value<K>(2 * i));
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// Random keys between 0 and 2n, half of them not in the map
+template <typename K>
+std::vector<K> probe_keys(std::size_t n, std::size_t count = 4096) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<std::size_t> dist(0, 2 * n - 1);
+    std::vector<K> keys;
+    keys.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        keys.push_back(make_value<K>(dist(rng)));
+    }
+    return keys;
+}
+
+// Inserts the even keys in random order, like a map filled by unordered input
+template <typename Tree>
+Tree make_tree(std::size_t n) {
+    auto keys = even_keys<tree_key_t<Tree>>(n);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(7));
+    Tree tree;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        tree.emplace(keys[i], i);
+    }
+    return tree;
+}
+
+// Finds the first element not less than each probe
+template <typename Tree>
+void BM_OrderedLowerBound(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const Tree tree = make_tree<Tree>(n);
+    const auto probes = probe_keys<tree_key_t<Tree>>(n);
+    std::size_t next = 0;
+    for (auto _ : state) {
+        auto it = tree.lower_bound(probes[next]);
+        benchmark::DoNotOptimize(it);
+        next = (next + 1) % probes.size();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+// Seeks to a random key and reads the 64 elements that follow it
+template <typename Tree>
+void BM_OrderedRangeScan(benchmark::State& state) {
+    constexpr std::size_t scan = 64;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const Tree tree = make_tree<Tree>(n);
+    const auto probes = probe_keys<tree_key_t<Tree>>(n);
+    std::size_t next = 0;
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        auto it = tree.lower_bound(probes[next]);
+        for (std::size_t i = 0; i < scan && it != tree.end(); ++i, ++it) {
+            sum += it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+        next = (next + 1) % probes.size();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * scan));
+}
+
+// Builds a map from n keys in random order
+template <typename Tree>
+void BM_OrderedInsert(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto keys = even_keys<tree_key_t<Tree>>(n);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(7));
+    for (auto _ : state) {
+        Tree tree;
+        for (std::size_t i = 0; i < n; ++i) {
+            tree.emplace(keys[i], i);
+        }
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+
+// Builds a map from n sorted key-value pairs: bulk_load for the B-tree, insertion with an end()
+// hint, the fastest way std::map offers, for std::map
+template <typename Tree>
+void BM_OrderedBuildSorted(benchmark::State& state) {
+    using K = tree_key_t<Tree>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto keys = even_keys<K>(n);
+    DynamicArray<std::pair<K, std::uint64_t>> sorted;
+    for (std::size_t i = 0; i < n; ++i) {
+        sorted.push_back({keys[i], i});
+    }
+    for (auto _ : state) {
+        Tree tree;
+        if constexpr (requires { tree.bulk_load(sorted); }) {
+            tree.bulk_load(sorted);
+        } else {
+            for (const auto& value : sorted) {
+                tree.emplace_hint(tree.end(), value);
+            }
+        }
+        benchmark::DoNotOptimize(tree);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+}
+
+inline void ordered_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(64, 1 << 21);
+}
+
+#define REGISTER_ORDERED_BENCHMARK(fn)                                   \
+    BENCHMARK_TEMPLATE(fn, BTreeMap<int>)->Apply(ordered_sizes);         \
+    BENCHMARK_TEMPLATE(fn, StdMap<int>)->Apply(ordered_sizes);           \
+    BENCHMARK_TEMPLATE(fn, BTreeMap<std::string>)->Apply(ordered_sizes); \
+    BENCHMARK_TEMPLATE(fn, StdMap<std::string>)->Apply(ordered_sizes)
+
+REGISTER_ORDERED_BENCHMARK(BM_OrderedLowerBound);
+REGISTER_ORDERED_BENCHMARK(BM_OrderedRangeScan);
+REGISTER_ORDERED_BENCHMARK(BM_OrderedInsert);
+REGISTER_ORDERED_BENCHMARK(BM_OrderedBuildSorted);
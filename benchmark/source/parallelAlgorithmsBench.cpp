@@ -0,0 +1,136 @@
+#include <algorithmCollection/algorithms/parallelAlgorithms.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+
+#include "benchCommon.h"
+
+// The parallel algorithms on a pool as wide as the machine against their sequential std
+// counterparts, over 2^20 ... 2^24 random 64 bit integers. Speedups need as many cores as the pool
+// has workers; on a single core the parallel versions show their overhead instead.
+
+namespace {
+    const DynamicArray<std::uint64_t>& bench_input(std::size_t n) {
+        static std::size_t cached_size = 0;
+        static DynamicArray<std::uint64_t> cached;
+        if (cached_size != n) {
+            std::mt19937_64 rng(42);
+            cached.clear();
+            cached.reserve(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                cached.push_back(rng());
+            }
+            cached_size = n;
+        }
+        return cached;
+    }
+
+    ThreadPool& bench_pool() {
+        static ThreadPool pool;
+        return pool;
+    }
+}
+
+static void BM_StdSort(benchmark::State& state) {
+    const auto& input = bench_input(static_cast<std::size_t>(state.range(0)));
+    DynamicArray<std::uint64_t> values;
+    for (auto _ : state) {
+        state.PauseTiming();
+        values = input;
+        state.ResumeTiming();
+        std::sort(values.begin(), values.end());
+        benchmark::DoNotOptimize(values.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ParallelSort(benchmark::State& state) {
+    const auto& input = bench_input(static_cast<std::size_t>(state.range(0)));
+    DynamicArray<std::uint64_t> values;
+    for (auto _ : state) {
+        state.PauseTiming();
+        values = input;
+        state.ResumeTiming();
+        parallel_sort(bench_pool(), values.data());
+        benchmark::DoNotOptimize(values.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdReduce(benchmark::State& state) {
+    const auto& input = bench_input(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::reduce(input.begin(), input.end(), std::uint64_t{0}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ParallelReduce(benchmark::State& state) {
+    const auto& input = bench_input(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parallel_reduce(bench_pool(), input.data(), std::uint64_t{0}));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdInclusiveScan(benchmark::State& state) {
+    const auto& input = bench_input(static_cast<std::size_t>(state.range(0)));
+    DynamicArray<std::uint64_t> out(input.size());
+    for (auto _ : state) {
+        std::inclusive_scan(input.begin(), input.end(), out.begin());
+        benchmark::DoNotOptimize(out.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ParallelInclusiveScan(benchmark::State& state) {
+    const auto& input = bench_input(static_cast<std::size_t>(state.range(0)));
+    DynamicArray<std::uint64_t> out(input.size());
+    for (auto _ : state) {
+        parallel_inclusive_scan(bench_pool(), input.data(), out.data());
+        benchmark::DoNotOptimize(out.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdStablePartition(benchmark::State& state) {
+    const auto& input = bench_input(static_cast<std::size_t>(state.range(0)));
+    DynamicArray<std::uint64_t> values;
+    for (auto _ : state) {
+        state.PauseTiming();
+        values = input;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(
+            std::stable_partition(values.begin(), values.end(), [](std::uint64_t v) { return v % 2 == 0; }));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ParallelPartition(benchmark::State& state) {
+    const auto& input = bench_input(static_cast<std::size_t>(state.range(0)));
+    DynamicArray<std::uint64_t> values;
+    for (auto _ : state) {
+        state.PauseTiming();
+        values = input;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(
+            parallel_partition(bench_pool(), values.data(), [](std::uint64_t v) { return v % 2 == 0; }));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Element counts 2^20 ... 2^24
+static void parallel_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(1 << 20, 1 << 24)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(BM_StdSort)->Apply(parallel_sizes);
+BENCHMARK(BM_ParallelSort)->Apply(parallel_sizes);
+BENCHMARK(BM_StdReduce)->Apply(parallel_sizes);
+BENCHMARK(BM_ParallelReduce)->Apply(parallel_sizes);
+BENCHMARK(BM_StdInclusiveScan)->Apply(parallel_sizes);
+BENCHMARK(BM_ParallelInclusiveScan)->Apply(parallel_sizes);
+BENCHMARK(BM_StdStablePartition)->Apply(parallel_sizes);
+BENCHMARK(BM_ParallelPartition)->Apply(parallel_sizes);
@@ -0,0 +1,135 @@
+#include <algorithmCollection/data structures/priority_queue.h>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "benchCommon.h"
+
+// d-ary PriorityQueue against std::priority_queue (a binary heap over std::vector). Every queue is a
+// min-heap of 64 bit deadlines, the shape of a timer scheduler.
+
+using Deadline = std::uint64_t;
+
+using StdHeap = std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>>;
+
+template <std::size_t Arity>
+using DaryHeap = PriorityQueue<Deadline, std::greater<Deadline>, Arity>;
+
+// Random deadlines, fixed seed so every queue sees the same sequence
+inline std::vector<Deadline> random_deadlines(std::size_t n) {
+    std::mt19937_64 rng(42);
+    std::vector<Deadline> deadlines(n);
+    for (Deadline& deadline : deadlines) {
+        deadline = rng() % (n * 16 + 1);
+    }
+    return deadlines;
+}
+
+// Moves the earliest deadline later by interval: one sift down for PriorityQueue, the pop-then-push
+// workaround for std::priority_queue
+inline void reschedule(StdHeap& heap, Deadline interval) {
+    const Deadline next = heap.top() + interval;
+    heap.pop();
+    heap.push(next);
+}
+
+template <std::size_t Arity>
+void reschedule(DaryHeap<Arity>& heap, Deadline interval) {
+    heap.replace_top(heap.top() + interval);
+}
+
+// Pushes n random deadlines, then pops them all
+template <typename Heap>
+void BM_HeapPushPop(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const std::vector<Deadline> deadlines = random_deadlines(n);
+
+    for (auto _ : state) {
+        Heap heap;
+        for (Deadline deadline : deadlines) {
+            heap.push(deadline);
+        }
+        Deadline sum = 0;
+        while (!heap.empty()) {
+            sum += heap.top();
+            heap.pop();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Heapifies n random deadlines in one go
+template <typename Heap>
+void BM_HeapBuild(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const std::vector<Deadline> deadlines = random_deadlines(n);
+
+    for (auto _ : state) {
+        Heap heap(deadlines.begin(), deadlines.end());
+        benchmark::DoNotOptimize(heap.top());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Steady state of a scheduler with n pending timers: every iteration fires the earliest one and
+// rearms it one period later
+template <typename Heap>
+void BM_TimerReschedule(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const std::vector<Deadline> deadlines = random_deadlines(n);
+    Heap heap(deadlines.begin(), deadlines.end());
+    std::mt19937_64 rng(7);
+
+    for (auto _ : state) {
+        reschedule(heap, 1 + rng() % (n * 16 + 1));
+        benchmark::DoNotOptimize(heap.top());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Same as BM_TimerReschedule, but timers are rearmed through their handle, and a random pending
+// timer is also moved earlier, which std::priority_queue cannot do without a search
+template <std::size_t Arity>
+void BM_TimerHandleUpdate(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const std::vector<Deadline> deadlines = random_deadlines(n);
+    IndexedPriorityQueue<Deadline, std::greater<Deadline>, Arity> heap;
+    const auto handles = heap.assign(deadlines.begin(), deadlines.end());
+    std::mt19937_64 rng(7);
+
+    for (auto _ : state) {
+        heap.update(heap.top_handle(), heap.top() + 1 + rng() % (n * 16 + 1));
+        const auto handle = handles[rng() % n];
+        const Deadline current = heap.value(handle);
+        heap.decrease_key(handle, current - current / 8);
+        benchmark::DoNotOptimize(heap.top());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+inline void heap_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(64, 2'097'152);
+}
+
+BENCHMARK_TEMPLATE(BM_HeapPushPop, StdHeap)->Apply(heap_sizes);
+BENCHMARK_TEMPLATE(BM_HeapPushPop, DaryHeap<2>)->Apply(heap_sizes);
+BENCHMARK_TEMPLATE(BM_HeapPushPop, DaryHeap<4>)->Apply(heap_sizes);
+BENCHMARK_TEMPLATE(BM_HeapPushPop, DaryHeap<8>)->Apply(heap_sizes);
+
+BENCHMARK_TEMPLATE(BM_HeapBuild, StdHeap)->Apply(heap_sizes);
+BENCHMARK_TEMPLATE(BM_HeapBuild, DaryHeap<4>)->Apply(heap_sizes);
+
+BENCHMARK_TEMPLATE(BM_TimerReschedule, StdHeap)->Apply(heap_sizes);
+BENCHMARK_TEMPLATE(BM_TimerReschedule, DaryHeap<2>)->Apply(heap_sizes);
+BENCHMARK_TEMPLATE(BM_TimerReschedule, DaryHeap<4>)->Apply(heap_sizes);
+BENCHMARK_TEMPLATE(BM_TimerReschedule, DaryHeap<8>)->Apply(heap_sizes);
+
+BENCHMARK_TEMPLATE(BM_TimerHandleUpdate, 2)->Apply(heap_sizes);
+BENCHMARK_TEMPLATE(BM_TimerHandleUpdate, 4)->Apply(heap_sizes);
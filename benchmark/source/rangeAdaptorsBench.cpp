@@ -0,0 +1,101 @@
+#include <algorithmCollection/algorithms/rangeAdaptors.h>
+#include <algorithmCollection/data structures/deque.h>
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <algorithmCollection/data structures/tabular.h>
+#include <ranges>
+#include <span>
+
+#include "benchCommon.h"
+
+// A filter and a transform over a list, once as a lazy pipeline ending in collect_into and once in
+// stages through intermediate DynamicArrays. Then a sum over a scaled deque: element by element,
+// collecting it into a DynamicArray for column_sum, and batched<256> handing column_sum spans
+// gathered without the intermediate array.
+
+namespace {
+    constexpr auto keep = [](int value) { return value % 3 != 0; };
+    constexpr auto score = [](int value) { return value * 7 + 1; };
+    constexpr auto scale = [](float value) { return value * 0.5f; };
+}
+
+static void BM_PipelineStaged(benchmark::State& state) {
+    DoubleLinkedList<int> source;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        source.push_back(make_value<int>(static_cast<std::size_t>(i)));
+    }
+    for (auto _ : state) {
+        DynamicArray<int> kept;
+        for (int value : source) {
+            if (keep(value)) {
+                kept.push_back(value);
+            }
+        }
+        DynamicArray<int> scored;
+        for (int value : kept) {
+            scored.push_back(score(value));
+        }
+        benchmark::DoNotOptimize(scored.back());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PipelineLazy(benchmark::State& state) {
+    DoubleLinkedList<int> source;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        source.push_back(make_value<int>(static_cast<std::size_t>(i)));
+    }
+    for (auto _ : state) {
+        DynamicArray<int> scored;
+        source | std::views::filter(keep) | std::views::transform(score) | collect_into(scored, source.size());
+        benchmark::DoNotOptimize(scored.back());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ScaledSumElementwise(benchmark::State& state) {
+    Deque<float> source;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        source.push_back(static_cast<float>(i % 100));
+    }
+    for (auto _ : state) {
+        float sum = 0;
+        for (float value : source | std::views::transform(scale)) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ScaledSumCollected(benchmark::State& state) {
+    Deque<float> source;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        source.push_back(static_cast<float>(i % 100));
+    }
+    for (auto _ : state) {
+        DynamicArray<float> scaled = source | std::views::transform(scale) | collect();
+        benchmark::DoNotOptimize(column_sum(std::span<const float>(scaled)));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ScaledSumBatched(benchmark::State& state) {
+    Deque<float> source;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        source.push_back(static_cast<float>(i % 100));
+    }
+    for (auto _ : state) {
+        float sum = 0;
+        for (std::span<const float> batch : source | std::views::transform(scale) | batched<256>) {
+            sum += column_sum(batch);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PipelineStaged)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_PipelineLazy)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_ScaledSumElementwise)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_ScaledSumCollected)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_ScaledSumBatched)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
@@ -0,0 +1,69 @@
+#pragma once
+#include "benchCommon.h"
+
+// Benchmarks shared by every sequence container, registered per container in the *Bench.cpp files.
+// Sizes come from state.range(0); throughput is reported as elements per second.
+
+// Builds a container of n elements from empty with push_back
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            container.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(container);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Walks every element once through the container's iterators
+template <typename Container>
+void BM_Iterate(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const Container container = make_filled<Container>(n);
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const auto& value : container) {
+            sum += touch(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Copy-constructs a container of n elements
+template <typename Container>
+void BM_Copy(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const Container source = make_filled<Container>(n);
+
+    for (auto _ : state) {
+        Container copy(source);
+        benchmark::DoNotOptimize(copy);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Move-constructs a container of n elements and moves it back
+template <typename Container>
+void BM_Move(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Container source = make_filled<Container>(n);
+
+    for (auto _ : state) {
+        Container moved(std::move(source));
+        benchmark::DoNotOptimize(moved);
+        source = std::move(moved);
+        benchmark::ClobberMemory();
+    }
+}
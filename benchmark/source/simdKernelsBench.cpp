@@ -0,0 +1,105 @@
+#include <algorithmCollection/data structures/simdKernels.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+#include "benchCommon.h"
+
+// Membership scans over n 32 bit integers with the value absent, so every scan reads the whole
+// array: std::find against the kernels at each SIMD level the machine supports, plus count and
+// the DynamicArray comparisons that now dispatch to the kernels.
+
+namespace {
+    const DynamicArray<std::int32_t>& bench_values(std::size_t n) {
+        static std::size_t cached_size = 0;
+        static DynamicArray<std::int32_t> cached;
+        if (cached_size != n) {
+            std::mt19937 rng(42);
+            cached.clear();
+            for (std::size_t i = 0; i < n; ++i) {
+                cached.push_back(static_cast<std::int32_t>(rng() % 1000000));
+            }
+            cached_size = n;
+        }
+        return cached;
+    }
+
+    constexpr std::int32_t absent = -1;
+}
+
+static void BM_StdFind(benchmark::State& state) {
+    const auto& values = bench_values(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(values.begin(), values.end(), absent));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Second argument: the SimdLevel
+static void BM_SimdFind(benchmark::State& state) {
+    const auto level = static_cast<SimdLevel>(state.range(1));
+    if (level > simd_level()) {
+        state.SkipWithError("SIMD level not supported on this machine");
+        return;
+    }
+    const auto& values = bench_values(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd_detail::find(level, values.begin(), values.size(), absent));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdCount(benchmark::State& state) {
+    const auto& values = bench_values(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(values.begin(), values.end(), 5));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DynamicArrayCount(benchmark::State& state) {
+    const auto& values = bench_values(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values.count(5));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdMismatch(benchmark::State& state) {
+    const auto& values = bench_values(static_cast<std::size_t>(state.range(0)));
+    const DynamicArray<std::int32_t> copy = values;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::mismatch(values.begin(), values.end(), copy.begin()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DynamicArrayCompare(benchmark::State& state) {
+    const auto& values = bench_values(static_cast<std::size_t>(state.range(0)));
+    const DynamicArray<std::int32_t> copy = values;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values <=> copy);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Element counts 2^8 ... 2^16, the request filter's few thousand values in the middle
+static void scan_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(4)->Range(1 << 8, 1 << 16);
+}
+
+static void scan_sizes_and_levels(benchmark::internal::Benchmark* b) {
+    for (std::int64_t n = 1 << 8; n <= 1 << 16; n *= 4) {
+        for (SimdLevel level : {SimdLevel::Portable, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            b->Args({n, static_cast<std::int64_t>(level)});
+        }
+    }
+}
+
+BENCHMARK(BM_StdFind)->Apply(scan_sizes);
+BENCHMARK(BM_SimdFind)->Apply(scan_sizes_and_levels);
+BENCHMARK(BM_StdCount)->Apply(scan_sizes);
+BENCHMARK(BM_DynamicArrayCount)->Apply(scan_sizes);
+BENCHMARK(BM_StdMismatch)->Apply(scan_sizes);
+BENCHMARK(BM_DynamicArrayCompare)->Apply(scan_sizes);
@@ -0,0 +1,126 @@
+#include <algorithmCollection/data structures/single_linkedList.h>
+#include <forward_list>
+#include <mutex>
+#include <vector>
+
+#include "sequenceBenchmarks.h"
+
+// SingleLinkedList, with SimpleAllocator and PoolAllocator, against std::forward_list; and the
+// lock-free ConcurrentStack against a std::vector behind a std::mutex, with 1 to 8 threads pushing
+// and popping the same stack.
+
+template <typename T>
+using StdForwardList = std::forward_list<T>;
+
+template <typename T>
+using PooledForwardList = PooledSingleLinkedList<T>;
+
+// Builds a container of n elements from empty with push_front
+template <typename Container>
+void BM_ForwardListPushFront(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            container.push_front(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(container);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Sorts n elements inserted in a scrambled order; the list is refilled outside the timed region
+template <typename Container>
+void BM_ForwardListSort(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            container.push_front(make_value<T>((i * 2654435761u) % n));
+        }
+        state.ResumeTiming();
+
+        container.sort([](const T& a, const T& b) { return touch(a) < touch(b); });
+        benchmark::DoNotOptimize(container);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Walks every element of an n element list once
+template <typename Container>
+void BM_ForwardListIterate(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Container container;
+    for (std::size_t i = n; i > 0; --i) {
+        container.push_front(make_value<T>(i - 1));
+    }
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const auto& value : container) {
+            sum += touch(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Unbounded stack guarded by a mutex, with the interface of ConcurrentStack
+template <typename T>
+class LockedStack {
+public:
+    void push(const T& value) {
+        std::lock_guard lock(m_mutex);
+        m_items.push_back(value);
+    }
+
+    bool try_pop(T& out) {
+        std::lock_guard lock(m_mutex);
+        if (m_items.empty()) {
+            return false;
+        }
+        out = m_items.back();
+        m_items.pop_back();
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<T> m_items;
+};
+
+// Every thread pushes a value and pops one, the pattern of a free list shared between threads
+template <typename Stack>
+void BM_StackPushPop(benchmark::State& state) {
+    static Stack stack;
+    std::uint64_t value = static_cast<std::uint64_t>(state.thread_index());
+    for (auto _ : state) {
+        stack.push(value);
+        stack.try_pop(value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+REGISTER_FOR_ELEMENT_TYPES(BM_ForwardListPushFront, SingleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ForwardListPushFront, PooledForwardList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ForwardListPushFront, StdForwardList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ForwardListSort, SingleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ForwardListSort, PooledForwardList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ForwardListSort, StdForwardList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ForwardListIterate, SingleLinkedList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ForwardListIterate, PooledForwardList);
+REGISTER_FOR_ELEMENT_TYPES(BM_ForwardListIterate, StdForwardList);
+
+BENCHMARK_TEMPLATE(BM_StackPushPop, ConcurrentStack<std::uint64_t>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_StackPushPop, LockedStack<std::uint64_t>)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,47 @@
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/smallDynamicArray.h>
+#include <vector>
+
+#include "benchCommon.h"
+
+// Many short-lived arrays of a few elements: SmallDynamicArray keeps them inline, the others
+// allocate for every array.
+
+template <typename T>
+using SmallArray8 = SmallDynamicArray<T, 8>;
+
+template <typename T>
+using StdVector = std::vector<T>;
+
+// Builds state.range(0) elements into a fresh array and sums them
+template <typename Container>
+void BM_ShortLivedArray(benchmark::State& state) {
+    using T = element_t<Container>;
+    const auto n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < n; ++i) {
+            container.push_back(make_value<T>(i));
+        }
+
+        std::uint64_t sum = 0;
+        for (const auto& value : container) {
+            sum += touch(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+inline void small_sizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1)->Arg(4)->Arg(8)->Arg(16);
+}
+
+BENCHMARK_TEMPLATE(BM_ShortLivedArray, SmallArray8<int>)->Apply(small_sizes);
+BENCHMARK_TEMPLATE(BM_ShortLivedArray, DynamicArray<int>)->Apply(small_sizes);
+BENCHMARK_TEMPLATE(BM_ShortLivedArray, StdVector<int>)->Apply(small_sizes);
+BENCHMARK_TEMPLATE(BM_ShortLivedArray, SmallArray8<Pod64>)->Apply(small_sizes);
+BENCHMARK_TEMPLATE(BM_ShortLivedArray, DynamicArray<Pod64>)->Apply(small_sizes);
+BENCHMARK_TEMPLATE(BM_ShortLivedArray, StdVector<Pod64>)->Apply(small_sizes);
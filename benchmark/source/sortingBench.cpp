@@ -0,0 +1,150 @@
+#include <algorithmCollection/algorithms/sorting.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "benchCommon.h"
+
+// std::sort against the LSD and MSD radix sorts on random 32 and 64 bit integers and floats;
+// std::lower_bound against branchless_lower_bound with random probes; and std::set_intersection
+// against the galloping sorted_intersection for posting lists of very different lengths, the
+// inverted index case.
+
+namespace {
+    template <typename T>
+    const std::vector<T>& bench_keys(std::size_t n) {
+        static std::size_t cached_size = 0;
+        static std::vector<T> cached;
+        if (cached_size != n) {
+            std::mt19937_64 rng(42);
+            cached.resize(n);
+            for (T& key : cached) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    key = static_cast<T>(static_cast<double>(rng() >> 11) * 0x1.0p-53 * 2e6 - 1e6);
+                } else {
+                    key = static_cast<T>(rng());
+                }
+            }
+            cached_size = n;
+        }
+        return cached;
+    }
+
+    enum class Sort { Std, Lsd, Msd };
+
+    template <typename T, Sort Algorithm>
+    void sort_keys(benchmark::State& state) {
+        const auto& input = bench_keys<T>(static_cast<std::size_t>(state.range(0)));
+        std::vector<T> keys;
+        DynamicArray<T> scratch;
+        for (auto _ : state) {
+            state.PauseTiming();
+            keys = input;
+            state.ResumeTiming();
+            if constexpr (Algorithm == Sort::Std) {
+                std::sort(keys.begin(), keys.end());
+            } else if constexpr (Algorithm == Sort::Lsd) {
+                radix_sort(std::span(keys), scratch);
+            } else {
+                msd_radix_sort(std::span(keys));
+            }
+            benchmark::DoNotOptimize(keys.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // count random documents below limit, sorted and without duplicates
+    std::vector<std::uint32_t> posting_list(std::size_t count, std::uint32_t limit, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        std::vector<std::uint32_t> list(count);
+        for (auto& document : list) {
+            document = static_cast<std::uint32_t>(rng() % limit);
+        }
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        return list;
+    }
+}
+
+static void BM_StdSortUint32(benchmark::State& state) { sort_keys<std::uint32_t, Sort::Std>(state); }
+static void BM_RadixSortUint32(benchmark::State& state) { sort_keys<std::uint32_t, Sort::Lsd>(state); }
+static void BM_MsdRadixSortUint32(benchmark::State& state) { sort_keys<std::uint32_t, Sort::Msd>(state); }
+static void BM_StdSortUint64(benchmark::State& state) { sort_keys<std::uint64_t, Sort::Std>(state); }
+static void BM_RadixSortUint64(benchmark::State& state) { sort_keys<std::uint64_t, Sort::Lsd>(state); }
+static void BM_MsdRadixSortUint64(benchmark::State& state) { sort_keys<std::uint64_t, Sort::Msd>(state); }
+static void BM_StdSortFloat(benchmark::State& state) { sort_keys<float, Sort::Std>(state); }
+static void BM_RadixSortFloat(benchmark::State& state) { sort_keys<float, Sort::Lsd>(state); }
+
+static void BM_StdLowerBound(benchmark::State& state) {
+    std::vector<std::uint32_t> keys = bench_keys<std::uint32_t>(static_cast<std::size_t>(state.range(0)));
+    std::sort(keys.begin(), keys.end());
+    const auto& probes = bench_keys<std::uint32_t>(1 << 12);
+    for (auto _ : state) {
+        std::size_t sum = 0;
+        for (std::uint32_t probe : probes) {
+            sum += static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), probe) - keys.begin());
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t{1 << 12});
+}
+
+static void BM_BranchlessLowerBound(benchmark::State& state) {
+    std::vector<std::uint32_t> keys = bench_keys<std::uint32_t>(static_cast<std::size_t>(state.range(0)));
+    std::sort(keys.begin(), keys.end());
+    const auto& probes = bench_keys<std::uint32_t>(1 << 12);
+    for (auto _ : state) {
+        std::size_t sum = 0;
+        for (std::uint32_t probe : probes) {
+            sum += branchless_lower_bound(std::span<const std::uint32_t>(keys), probe);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t{1 << 12});
+}
+
+// A posting list of 2^20 documents intersected with one of range(0) documents
+static void BM_StdSetIntersection(benchmark::State& state) {
+    const auto large = posting_list(1 << 20, 1 << 24, 1);
+    const auto small = posting_list(static_cast<std::size_t>(state.range(0)), 1 << 24, 2);
+    std::vector<std::uint32_t> out;
+    out.reserve(small.size());
+    for (auto _ : state) {
+        out.clear();
+        std::set_intersection(small.begin(), small.end(), large.begin(), large.end(), std::back_inserter(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_GallopingIntersection(benchmark::State& state) {
+    const auto large = posting_list(1 << 20, 1 << 24, 1);
+    const auto small = posting_list(static_cast<std::size_t>(state.range(0)), 1 << 24, 2);
+    DynamicArray<std::uint32_t> out;
+    for (auto _ : state) {
+        sorted_intersection(std::span(small), std::span(large), out);
+        benchmark::DoNotOptimize(out.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Key counts 2^12 ... 2^20
+static void sort_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+}
+
+BENCHMARK(BM_StdSortUint32)->Apply(sort_sizes);
+BENCHMARK(BM_RadixSortUint32)->Apply(sort_sizes);
+BENCHMARK(BM_MsdRadixSortUint32)->Apply(sort_sizes);
+BENCHMARK(BM_StdSortUint64)->Apply(sort_sizes);
+BENCHMARK(BM_RadixSortUint64)->Apply(sort_sizes);
+BENCHMARK(BM_MsdRadixSortUint64)->Apply(sort_sizes);
+BENCHMARK(BM_StdSortFloat)->Apply(sort_sizes);
+BENCHMARK(BM_RadixSortFloat)->Apply(sort_sizes);
+BENCHMARK(BM_StdLowerBound)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_BranchlessLowerBound)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_StdSetIntersection)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_GallopingIntersection)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
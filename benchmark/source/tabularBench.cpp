@@ -0,0 +1,138 @@
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/tabular.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchCommon.h"
+
+// Aggregating one field of an order table stored as array of structs against the same table as
+// Tabular columns. The struct scan drags every 64 byte row through the cache to use 8 bytes of it.
+
+namespace {
+    struct OrderRow {
+        std::int64_t id;
+        double price;
+        std::int32_t quantity;
+        std::int32_t region;
+        double discount;
+        std::uint64_t customer;
+        std::uint64_t timestamp;
+        std::uint64_t flags;
+        std::uint64_t reserved;
+    };
+
+    static_assert(sizeof(OrderRow) == 64);
+
+    using OrderTable = Tabular<std::int64_t, double, std::int32_t, std::int32_t, double, std::uint64_t, std::uint64_t,
+        std::uint64_t, std::uint64_t>;
+
+    constexpr std::size_t price_column = 1;
+    constexpr std::size_t quantity_column = 2;
+    constexpr std::int32_t quantity_threshold = 50;
+
+    struct Orders {
+        std::vector<OrderRow> rows;
+        OrderTable table;
+    };
+
+    const Orders& bench_orders(std::size_t n) {
+        static std::size_t cached_size = 0;
+        static Orders cached;
+        if (cached_size != n) {
+            std::mt19937_64 rng(42);
+            cached.rows.clear();
+            cached.table.clear();
+            cached.rows.reserve(n);
+            cached.table.reserve(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                const OrderRow row{static_cast<std::int64_t>(i), static_cast<double>(rng() % 10000) / 100.0,
+                    static_cast<std::int32_t>(rng() % 100), static_cast<std::int32_t>(rng() % 16), 0.0, rng(), i, 0, 0};
+                cached.rows.push_back(row);
+                cached.table.push_back(row.id, row.price, row.quantity, row.region, row.discount, row.customer,
+                    row.timestamp, row.flags, row.reserved);
+            }
+            cached_size = n;
+        }
+        return cached;
+    }
+}
+
+static void BM_SumRows(benchmark::State& state) {
+    const Orders& orders = bench_orders(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        double sum = 0;
+        for (const OrderRow& row : orders.rows) {
+            sum += row.price;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SumColumn(benchmark::State& state) {
+    const Orders& orders = bench_orders(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(orders.table.sum<price_column>());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_FilteredSumRows(benchmark::State& state) {
+    const Orders& orders = bench_orders(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        double sum = 0;
+        for (const OrderRow& row : orders.rows) {
+            if (row.quantity > quantity_threshold) {
+                sum += row.price;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_FilteredSumColumns(benchmark::State& state) {
+    const Orders& orders = bench_orders(static_cast<std::size_t>(state.range(0)));
+    RowMask mask;
+    for (auto _ : state) {
+        column_mask(orders.table.column<quantity_column>(), [](std::int32_t q) { return q > quantity_threshold; }, mask);
+        benchmark::DoNotOptimize(orders.table.sum<price_column>(mask));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_MinMaxRows(benchmark::State& state) {
+    const Orders& orders = bench_orders(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::int32_t low = orders.rows[0].quantity;
+        std::int32_t high = low;
+        for (const OrderRow& row : orders.rows) {
+            low = row.quantity < low ? row.quantity : low;
+            high = high < row.quantity ? row.quantity : high;
+        }
+        benchmark::DoNotOptimize(low);
+        benchmark::DoNotOptimize(high);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_MinMaxColumn(benchmark::State& state) {
+    const Orders& orders = bench_orders(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(orders.table.min_max<quantity_column>());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Row counts 2^12 ... 2^22; at the top the struct table is 256 MiB
+static void table_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+}
+
+BENCHMARK(BM_SumRows)->Apply(table_sizes);
+BENCHMARK(BM_SumColumn)->Apply(table_sizes);
+BENCHMARK(BM_FilteredSumRows)->Apply(table_sizes);
+BENCHMARK(BM_FilteredSumColumns)->Apply(table_sizes);
+BENCHMARK(BM_MinMaxRows)->Apply(table_sizes);
+BENCHMARK(BM_MinMaxColumn)->Apply(table_sizes);
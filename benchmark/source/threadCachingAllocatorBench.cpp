@@ -0,0 +1,86 @@
+#include <algorithmCollection/allocators/threadCachingAllocator.h>
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "benchCommon.h"
+
+// Allocation-heavy work run by 1 to 64 threads at once: every thread churns its own containers, the
+// way workers of a pool build and drop per-task state. Real time per item shows how allocation
+// scales; SimpleAllocator goes to the global heap on every node, ThreadCachingAllocator mostly
+// stays in its thread's cache.
+
+template <typename Alloc>
+using ChurnList = DoubleLinkedList<std::uint64_t, Alloc>;
+
+template <typename Alloc>
+using ChurnArray = DynamicArray<std::uint64_t, Alloc>;
+
+// Builds and drops a 256-node list, one allocation per node
+template <typename Alloc>
+void BM_ThreadsListChurn(benchmark::State& state) {
+    for (auto _ : state) {
+        ChurnList<Alloc> list;
+        for (std::uint64_t i = 0; i < 256; ++i) {
+            list.push_back(i);
+        }
+        benchmark::DoNotOptimize(list);
+    }
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+
+// Builds and drops 64 small arrays of up to 48 elements, a handful of growths each
+template <typename Alloc>
+void BM_ThreadsArrayChurn(benchmark::State& state) {
+    for (auto _ : state) {
+        for (std::uint64_t a = 0; a < 64; ++a) {
+            ChurnArray<Alloc> array;
+            for (std::uint64_t i = 0; i < 16 + a % 32; ++i) {
+                array.push_back(i);
+            }
+            benchmark::DoNotOptimize(array);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+
+// Hands every node to the next thread, which frees it: all frees are cross-thread
+template <typename Alloc>
+void BM_ThreadsCrossThreadFree(benchmark::State& state) {
+    constexpr std::size_t slots_per_thread = 64;
+    static std::vector<std::atomic<std::uint64_t*>> slots(slots_per_thread * 64);
+    Alloc alloc;
+    const std::size_t next = static_cast<std::size_t>((state.thread_index() + 1) % state.threads());
+    std::size_t i = 0;
+
+    for (auto _ : state) {
+        std::uint64_t* node = alloc.allocate(4);
+        node[0] = i;
+        std::uint64_t* previous = slots[next * slots_per_thread + i++ % slots_per_thread].exchange(node, std::memory_order_acq_rel);
+        if (previous) {
+            benchmark::DoNotOptimize(previous[0]);
+            alloc.deallocate(previous, 4);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    // The last thread out frees the nodes still parked in the slots
+    static std::atomic<int> finished{0};
+    if (finished.fetch_add(1) + 1 == state.threads()) {
+        for (auto& slot : slots) {
+            alloc.deallocate(slot.exchange(nullptr), 4);
+        }
+        finished.store(0);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ThreadsListChurn, SimpleAllocator<std::uint64_t>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ThreadsListChurn, ThreadCachingAllocator<std::uint64_t>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ThreadsArrayChurn, SimpleAllocator<std::uint64_t>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ThreadsArrayChurn, ThreadCachingAllocator<std::uint64_t>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ThreadsCrossThreadFree, SimpleAllocator<std::uint64_t>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ThreadsCrossThreadFree, ThreadCachingAllocator<std::uint64_t>)->ThreadRange(1, 64)->UseRealTime();
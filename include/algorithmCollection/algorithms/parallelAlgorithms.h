@@ -0,0 +1,298 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "../data structures/dynamicArray.h"
+#include "threadPool.h"
+
+// Parallel algorithms over contiguous spans, e.g. DynamicArray::data(), running on a ThreadPool.
+// grain is the size below which work is not split any further: inputs of at most grain elements,
+// and pools without threads, take the sequential standard algorithm. Loops hand out chunks of
+// grain elements, or fewer larger chunks when that still gives every worker several.
+// Exceptions thrown by element operations are rethrown once the running chunks finished; the
+// range is then left in a valid but unspecified order.
+
+// Default grain: enough elements per chunk to hide the cost of handing chunks to workers
+inline constexpr std::size_t parallel_grain = std::size_t{1} << 14;
+
+namespace parallel_detail {
+    // Chunks per worker a loop is cut into, so that stealing and the shared counter can even out
+    // chunks that run slower than others
+    inline constexpr std::size_t chunks_per_worker = 4;
+
+    inline std::size_t chunk_size(const ThreadPool& pool, std::size_t count, std::size_t grain) noexcept {
+        const std::size_t chunks = pool.concurrency() * chunks_per_worker;
+        return std::max({grain, (count + chunks - 1) / chunks, std::size_t{1}});
+    }
+
+    inline bool sequential(const ThreadPool& pool, std::size_t count, std::size_t grain) noexcept {
+        return pool.concurrency() == 1 || count <= grain;
+    }
+
+    // Uninitialized storage for count elements, filled by moving values in chunk by chunk. Parallel
+    // construction cannot be unwound element by element, so it is limited to nothrow move
+    // constructible types; every slot holds an element once the constructing loop ran.
+    template <typename T>
+    class Scratch {
+    public:
+        explicit Scratch(std::size_t count) : m_data(SimpleAllocator<T>().allocate(count)), m_size(count) {}
+
+        Scratch(const Scratch&) = delete;
+        Scratch& operator=(const Scratch&) = delete;
+
+        ~Scratch() {
+            if (m_constructed) {
+                std::destroy_n(m_data, m_size);
+            }
+            SimpleAllocator<T>().deallocate(m_data, m_size);
+        }
+
+        T* data() noexcept { return m_data; }
+
+        void mark_constructed() noexcept { m_constructed = true; }
+
+    private:
+        T* m_data;
+        std::size_t m_size;
+        bool m_constructed = false;
+    };
+
+    // Merges the sorted runs [a, a + na) and [b, b + nb) into out by moving, splitting the larger
+    // run at its middle and the other at the matching position until pieces are below grain.
+    // Stable: elements of the first run go first among equivalents.
+    template <typename T, class Compare>
+    void merge_runs(ThreadPool& pool, T* a, std::size_t na, T* b, std::size_t nb, T* out, Compare& comp, std::size_t grain) {
+        if (na + nb <= grain) {
+            std::merge(std::make_move_iterator(a), std::make_move_iterator(a + na), std::make_move_iterator(b),
+                std::make_move_iterator(b + nb), out, comp);
+            return;
+        }
+        std::size_t ma;
+        std::size_t mb;
+        if (na >= nb) {
+            ma = na / 2;
+            mb = static_cast<std::size_t>(std::lower_bound(b, b + nb, a[ma], comp) - b);
+        } else {
+            mb = nb / 2;
+            ma = static_cast<std::size_t>(std::upper_bound(a, a + na, b[mb], comp) - a);
+        }
+        pool.invoke([&] { merge_runs(pool, a, ma, b, mb, out, comp, grain); },
+            [&] { merge_runs(pool, a + ma, na - ma, b + mb, nb - mb, out + ma + mb, comp, grain); });
+    }
+
+    // Sorts [data, data + count), leaving the result in buffer instead if into_buffer. The halves
+    // sort into the other array, so each level merges from one array into the other and nothing is
+    // copied back.
+    template <bool Stable, typename T, class Compare>
+    void merge_sort(ThreadPool& pool, T* data, T* buffer, std::size_t count, bool into_buffer, Compare& comp,
+        std::size_t leaf, std::size_t grain) {
+        if (count <= leaf) {
+            if constexpr (Stable) {
+                std::stable_sort(data, data + count, comp);
+            } else {
+                std::sort(data, data + count, comp);
+            }
+            if (into_buffer) {
+                std::move(data, data + count, buffer);
+            }
+            return;
+        }
+        const std::size_t half = count / 2;
+        pool.invoke([&] { merge_sort<Stable>(pool, data, buffer, half, !into_buffer, comp, leaf, grain); },
+            [&] { merge_sort<Stable>(pool, data + half, buffer + half, count - half, !into_buffer, comp, leaf, grain); });
+        T* from = into_buffer ? data : buffer;
+        T* to = into_buffer ? buffer : data;
+        merge_runs(pool, from, half, from + half, count - half, to, comp, grain);
+    }
+
+    template <bool Stable, typename T, class Compare>
+    void sort(ThreadPool& pool, std::span<T> values, Compare& comp, std::size_t grain) {
+        static_assert(std::is_nothrow_move_constructible_v<T>, "Parallel sort requires nothrow move construction");
+        if (sequential(pool, values.size(), grain)) {
+            if constexpr (Stable) {
+                std::stable_sort(values.begin(), values.end(), comp);
+            } else {
+                std::sort(values.begin(), values.end(), comp);
+            }
+            return;
+        }
+        const std::size_t count = values.size();
+        Scratch<T> scratch(count);
+        T* data = values.data();
+        T* buffer = scratch.data();
+        pool.parallel_for(count, chunk_size(pool, count, grain), [&](std::size_t begin, std::size_t end, std::size_t) {
+            std::uninitialized_move(data + begin, data + end, buffer + begin);
+        });
+        scratch.mark_constructed();
+        // The values now live in the scratch array, so it is the one sorted, into values
+        pool.fork_join([&] { merge_sort<Stable>(pool, buffer, data, count, true, comp, chunk_size(pool, count, grain), grain); });
+    }
+}
+
+// Sorts values with comp: a parallel merge sort whose leaves run std::sort, O(n log n) work.
+// Needs a scratch copy of the input; elements must be nothrow move constructible.
+template <typename T, class Compare = std::less<>>
+void parallel_sort(ThreadPool& pool, std::span<T> values, Compare comp = Compare(), std::size_t grain = parallel_grain) {
+    parallel_detail::sort<false>(pool, values, comp, grain);
+}
+
+// As parallel_sort, keeping equivalent elements in their original order
+template <typename T, class Compare = std::less<>>
+void parallel_stable_sort(ThreadPool& pool, std::span<T> values, Compare comp = Compare(),
+    std::size_t grain = parallel_grain) {
+    parallel_detail::sort<true>(pool, values, comp, grain);
+}
+
+// Writes fn(in[i]) to out[i]. out may be in itself. Throws std::invalid_argument if the sizes differ.
+template <typename T, typename U, class Fn>
+void parallel_transform(ThreadPool& pool, std::span<T> in, std::span<U> out, Fn fn, std::size_t grain = parallel_grain) {
+    if (in.size() != out.size()) {
+        throw std::invalid_argument("Output size does not match the input");
+    }
+    pool.parallel_for(in.size(), parallel_detail::chunk_size(pool, in.size(), grain),
+        [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i) {
+                out[i] = fn(in[i]);
+            }
+        });
+}
+
+// Folds values into init with op. The chunks are folded in parallel and their results combined in
+// order, so op has to be associative but need not be commutative; it is called as op(R, element)
+// and op(R, R).
+template <typename T, typename R, class Op = std::plus<>>
+R parallel_reduce(ThreadPool& pool, std::span<T> values, R init, Op op = Op(), std::size_t grain = parallel_grain) {
+    if (parallel_detail::sequential(pool, values.size(), grain)) {
+        return std::accumulate(values.begin(), values.end(), std::move(init), op);
+    }
+    const std::size_t chunk = parallel_detail::chunk_size(pool, values.size(), grain);
+    DynamicArray<std::optional<R>> partials((values.size() + chunk - 1) / chunk);
+    pool.parallel_for(values.size(), chunk, [&](std::size_t begin, std::size_t end, std::size_t) {
+        R sum = static_cast<R>(values[begin]);
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            sum = op(std::move(sum), values[i]);
+        }
+        partials[begin / chunk].emplace(std::move(sum));
+    });
+    for (std::optional<R>& partial : partials) {
+        init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+namespace parallel_detail {
+    // Three passes: every chunk is folded in parallel, the chunk totals are scanned sequentially into
+    // the value each chunk starts from, and every chunk is scanned from its start in parallel.
+    template <bool Inclusive, typename T, typename U, class Op>
+    void scan(ThreadPool& pool, std::span<T> in, std::span<U> out, std::optional<U> init, Op& op, std::size_t grain) {
+        if (in.size() != out.size()) {
+            throw std::invalid_argument("Output size does not match the input");
+        }
+        const auto scan_chunk = [&](std::size_t begin, std::size_t end, std::optional<U> carry) {
+            for (std::size_t i = begin; i < end; ++i) {
+                U value = static_cast<U>(in[i]);
+                if constexpr (Inclusive) {
+                    carry = carry ? op(std::move(*carry), std::move(value)) : std::move(value);
+                    out[i] = *carry;
+                } else {
+                    out[i] = *carry;
+                    carry = op(std::move(*carry), std::move(value));
+                }
+            }
+        };
+        if (sequential(pool, in.size(), grain)) {
+            scan_chunk(0, in.size(), std::move(init));
+            return;
+        }
+
+        const std::size_t chunk = chunk_size(pool, in.size(), grain);
+        DynamicArray<std::optional<U>> starts((in.size() + chunk - 1) / chunk + 1);
+        pool.parallel_for(in.size(), chunk, [&](std::size_t begin, std::size_t end, std::size_t) {
+            U sum = static_cast<U>(in[begin]);
+            for (std::size_t i = begin + 1; i < end; ++i) {
+                sum = op(std::move(sum), static_cast<U>(in[i]));
+            }
+            starts[begin / chunk + 1].emplace(std::move(sum));
+        });
+        starts[0] = std::move(init);
+        for (std::size_t c = 1; c < starts.size(); ++c) {
+            if (starts[c - 1]) {
+                starts[c] = op(*starts[c - 1], std::move(*starts[c]));
+            }
+        }
+        pool.parallel_for(in.size(), chunk, [&](std::size_t begin, std::size_t end, std::size_t) {
+            scan_chunk(begin, end, starts[begin / chunk]);
+        });
+    }
+}
+
+// out[i] = in[0] op ... op in[i]. out may be in itself; op has to be associative.
+// Throws std::invalid_argument if the sizes differ.
+template <typename T, typename U, class Op = std::plus<>>
+void parallel_inclusive_scan(ThreadPool& pool, std::span<T> in, std::span<U> out, Op op = Op(),
+    std::size_t grain = parallel_grain) {
+    parallel_detail::scan<true>(pool, in, out, std::optional<U>(), op, grain);
+}
+
+// out[i] = init op in[0] op ... op in[i - 1], out[0] = init. out may be in itself; op has to be
+// associative. Throws std::invalid_argument if the sizes differ.
+template <typename T, typename U, class Op = std::plus<>>
+void parallel_exclusive_scan(ThreadPool& pool, std::span<T> in, std::span<U> out, U init, Op op = Op(),
+    std::size_t grain = parallel_grain) {
+    parallel_detail::scan<false>(pool, in, out, std::optional<U>(std::move(init)), op, grain);
+}
+
+// Moves the elements satisfying pred in front of the others, keeping the relative order within
+// both groups (a stable partition), and returns how many satisfy it. pred is called once per
+// element. Needs a scratch copy of the input; elements must be nothrow move constructible.
+template <typename T, class Pred>
+std::size_t parallel_partition(ThreadPool& pool, std::span<T> values, Pred pred, std::size_t grain = parallel_grain) {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "Parallel partition requires nothrow move construction");
+    if (parallel_detail::sequential(pool, values.size(), grain)) {
+        return static_cast<std::size_t>(std::stable_partition(values.begin(), values.end(), pred) - values.begin());
+    }
+
+    // Count the matches of every chunk, keeping pred's answers, then place both groups
+    const std::size_t count = values.size();
+    const std::size_t chunk = parallel_detail::chunk_size(pool, count, grain);
+    const std::size_t chunks = (count + chunk - 1) / chunk;
+    DynamicArray<std::uint8_t> selected(count);
+    DynamicArray<std::size_t> matches_before(chunks + 1);
+    pool.parallel_for(count, chunk, [&](std::size_t begin, std::size_t end, std::size_t) {
+        std::size_t matches = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            selected[i] = static_cast<std::uint8_t>(pred(std::as_const(values[i])) ? 1 : 0);
+            matches += selected[i];
+        }
+        matches_before[begin / chunk + 1] = matches;
+    });
+    for (std::size_t c = 1; c <= chunks; ++c) {
+        matches_before[c] += matches_before[c - 1];
+    }
+    const std::size_t total = matches_before[chunks];
+
+    parallel_detail::Scratch<T> scratch(count);
+    T* placed = scratch.data();
+    pool.parallel_for(count, chunk, [&](std::size_t begin, std::size_t end, std::size_t) {
+        std::size_t match = matches_before[begin / chunk];
+        std::size_t other = total + begin - match;
+        for (std::size_t i = begin; i < end; ++i) {
+            ::new (static_cast<void*>(placed + (selected[i] ? match++ : other++))) T(std::move(values[i]));
+        }
+    });
+    scratch.mark_constructed();
+    pool.parallel_for(count, chunk, [&](std::size_t begin, std::size_t end, std::size_t) {
+        std::move(placed + begin, placed + end, values.begin() + static_cast<std::ptrdiff_t>(begin));
+    });
+    return total;
+}
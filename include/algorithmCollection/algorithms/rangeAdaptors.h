@@ -0,0 +1,214 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "../data structures/dynamicArray.h"
+
+// Ends and batching for lazy pipelines over the library's containers. DynamicArray,
+// DoubleLinkedList, Deque, Tabular columns and the other containers are standard ranges, so the
+// stages in between are the std::views adaptors; a pipeline built from them runs in one pass over
+// its source, and nothing in this header allocates storage apart from the destination array:
+//
+//     DynamicArray<int> out;
+//     list | std::views::filter(is_valid) | std::views::transform(score) | collect_into(out);
+//     for (std::span<const float> batch : column | std::views::transform(scale) | batched<256>) {
+//         total += column_sum(batch);
+//     }
+
+namespace range_detail {
+    template <typename R, typename T>
+    inline constexpr bool copies_bytes = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+        && std::is_trivially_copyable_v<T> && std::is_same_v<std::ranges::range_value_t<R>, T>;
+}
+
+// Appends the elements of range to out and returns out. Sized ranges reserve their size up front,
+// so out grows at most once; unsized ones (filters) reserve size_hint more elements if given and
+// otherwise grow as push_back does. Contiguous ranges of trivially copyable T are copied in bulk.
+template <std::ranges::input_range R, typename T, typename Alloc, GrowthPolicy Growth, ShrinkPolicy Shrink>
+    requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+DynamicArray<T, Alloc, Growth, Shrink>& collect_into(R&& range, DynamicArray<T, Alloc, Growth, Shrink>& out,
+    std::size_t size_hint = 0) {
+    if constexpr (range_detail::copies_bytes<R, T>) {
+        const T* first = std::ranges::data(range);
+        out.insert(out.end(), first, first + std::ranges::size(range));
+        return out;
+    } else {
+        if constexpr (std::ranges::sized_range<R>) {
+            out.reserve(out.size() + static_cast<std::size_t>(std::ranges::size(range)));
+        } else if (size_hint != 0) {
+            out.reserve(out.size() + size_hint);
+        }
+        for (auto&& value : range) {
+            out.emplace_back(std::forward<decltype(value)>(value));
+        }
+        return out;
+    }
+}
+
+namespace range_detail {
+    template <typename Array>
+    struct CollectInto {
+        Array& out;
+        std::size_t size_hint;
+
+        template <std::ranges::input_range R>
+        friend Array& operator|(R&& range, CollectInto sink) {
+            return collect_into(std::forward<R>(range), sink.out, sink.size_hint);
+        }
+    };
+
+    struct Collect {
+        std::size_t size_hint;
+
+        template <std::ranges::input_range R>
+        friend DynamicArray<std::ranges::range_value_t<R>> operator|(R&& range, Collect sink) {
+            DynamicArray<std::ranges::range_value_t<R>> out;
+            collect_into(std::forward<R>(range), out, sink.size_hint);
+            return out;
+        }
+    };
+}
+
+// Pipeline end appending to out: range | collect_into(out)
+template <typename T, typename Alloc, GrowthPolicy Growth, ShrinkPolicy Shrink>
+range_detail::CollectInto<DynamicArray<T, Alloc, Growth, Shrink>> collect_into(DynamicArray<T, Alloc, Growth, Shrink>& out,
+    std::size_t size_hint = 0) noexcept {
+    return {out, size_hint};
+}
+
+// Pipeline end returning a new DynamicArray of the range's value type: range | collect()
+inline range_detail::Collect collect(std::size_t size_hint = 0) noexcept {
+    return {size_hint};
+}
+
+// View of a range as consecutive contiguous spans of N elements, the last one shorter if the size
+// is not a multiple of N; meant for SIMD kernels taking spans (simdKernels.h, tabular.h).
+// Contiguous sized ranges are cut into spans of their own elements. Any other range is gathered
+// into a buffer of N values inside the view, one batch at a time, so a span is valid until the
+// iterator advances. It is an input range either way and iterates once; moving the view
+// invalidates its iterators.
+template <std::ranges::view V, std::size_t N>
+    requires std::ranges::input_range<V> && (N > 0)
+class BatchedView : public std::ranges::view_interface<BatchedView<V, N>> {
+    static constexpr bool direct = std::ranges::contiguous_range<V> && std::ranges::sized_range<V>;
+
+    using element_type = std::conditional_t<direct, std::remove_reference_t<std::ranges::range_reference_t<V>>,
+        const std::ranges::range_value_t<V>>;
+
+    // Batches of gathered values; contiguous ranges need none
+    struct NoBuffer {};
+    using Buffer = std::conditional_t<direct, NoBuffer, std::ranges::range_value_t<V>[N]>;
+
+public:
+    using batch_type = std::span<element_type>;
+
+    class iterator {
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = batch_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        batch_type operator*() const { return m_view->current(); }
+
+        iterator& operator++() {
+            m_view->advance();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return it.done(); }
+
+    private:
+        friend class BatchedView;
+
+        explicit iterator(BatchedView* view) noexcept : m_view(view) {}
+
+        bool done() const noexcept { return m_view->m_count == 0; }
+
+        BatchedView* m_view = nullptr;
+    };
+
+    BatchedView() requires std::default_initializable<V> = default;
+
+    explicit BatchedView(V base) : m_base(std::move(base)) {}
+
+    iterator begin() {
+        m_offset = 0;
+        m_count = 0;
+        if constexpr (!direct) {
+            m_current = std::ranges::begin(m_base);
+        }
+        advance();
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    // Number of batches, known up front for sized ranges
+    std::size_t size() requires std::ranges::sized_range<V> {
+        return (static_cast<std::size_t>(std::ranges::size(m_base)) + N - 1) / N;
+    }
+
+    V base() const& requires std::copy_constructible<V> { return m_base; }
+    V base() && { return std::move(m_base); }
+
+private:
+    V m_base = V();
+    [[no_unique_address]] std::conditional_t<direct, NoBuffer, std::ranges::iterator_t<V>> m_current{};
+    [[no_unique_address]] Buffer m_buffer{};
+    std::size_t m_offset = 0;
+    std::size_t m_count = 0;
+
+    batch_type current() const noexcept {
+        if constexpr (direct) {
+            return batch_type(std::ranges::data(m_base) + m_offset, m_count);
+        } else {
+            return batch_type(m_buffer, m_count);
+        }
+    }
+
+    // Moves on to the next batch; an empty one marks the end
+    void advance() {
+        if constexpr (direct) {
+            m_offset += m_count;
+            m_count = std::min(N, static_cast<std::size_t>(std::ranges::size(m_base)) - m_offset);
+        } else {
+            // Locals keep the position in registers; stores to the buffer could alias the members
+            auto current = std::move(m_current);
+            const auto last = std::ranges::end(m_base);
+            std::size_t count = 0;
+            for (; count < N && current != last; ++current) {
+                m_buffer[count++] = *current;
+            }
+            m_current = std::move(current);
+            m_count = count;
+        }
+    }
+};
+
+namespace range_detail {
+    template <std::size_t N>
+    struct Batched {
+        template <std::ranges::viewable_range R>
+        auto operator()(R&& range) const {
+            return BatchedView<std::views::all_t<R>, N>(std::views::all(std::forward<R>(range)));
+        }
+
+        template <std::ranges::viewable_range R>
+        friend auto operator|(R&& range, Batched adaptor) {
+            return adaptor(std::forward<R>(range));
+        }
+    };
+}
+
+// Range adaptor yielding std::span batches of N elements: range | batched<256>
+template <std::size_t N>
+inline constexpr range_detail::Batched<N> batched{};
@@ -0,0 +1,350 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "../data structures/dynamicArray.h"
+
+// Radix sorts for arithmetic keys and searches and set operations over sorted spans, e.g.
+// DynamicArray::data().
+//
+// Radix sorts order keys by bytes instead of comparisons. Floating point keys follow the IEEE
+// total order: -0.0 before 0.0, negative NaNs first and positive NaNs last.
+// - radix_sort and radix_sort_by_key: least significant digit first, stable, one pass per key byte
+//   over the elements and a scratch array of the same size. Bytes that are equal in every key are
+//   skipped, so small values in wide keys cost fewer passes.
+// - msd_radix_sort: most significant digit first, in place and not stable; no scratch array, and
+//   buckets that are sorted on their leading bytes are done early. The better choice for large
+//   arrays of 64 bit keys spread over the whole range, where LSD needs all eight passes.
+
+// Key types the radix sorts accept
+template <typename T>
+concept RadixKey = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+namespace sorting_detail {
+    template <std::size_t Size>
+    struct unsigned_of;
+
+    template <> struct unsigned_of<1> { using type = std::uint8_t; };
+    template <> struct unsigned_of<2> { using type = std::uint16_t; };
+    template <> struct unsigned_of<4> { using type = std::uint32_t; };
+    template <> struct unsigned_of<8> { using type = std::uint64_t; };
+
+    template <typename T>
+    using radix_t = typename unsigned_of<sizeof(T)>::type;
+
+    // Unsigned integer ordering like key: signed integers have the sign bit flipped, negative
+    // floating point values all bits flipped and positive ones the sign bit set
+    template <RadixKey T>
+    constexpr radix_t<T> to_radix(T key) noexcept {
+        using U = radix_t<T>;
+        constexpr U sign = U{1} << (sizeof(U) * 8 - 1);
+        if constexpr (std::is_floating_point_v<T>) {
+            const U bits = std::bit_cast<U>(key);
+            return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+        } else if constexpr (std::is_signed_v<T>) {
+            return static_cast<U>(static_cast<U>(key) ^ sign);
+        } else {
+            return static_cast<U>(key);
+        }
+    }
+
+    inline constexpr std::size_t radix_bits = 8;
+    inline constexpr std::size_t radix_size = std::size_t{1} << radix_bits;
+
+    // Buckets at most this size finish with insertion sort in msd_radix_sort
+    inline constexpr std::size_t msd_cutoff = 32;
+
+    template <typename U>
+    constexpr std::size_t digit(U key, std::size_t shift) noexcept {
+        return static_cast<std::size_t>(key >> shift) & (radix_size - 1);
+    }
+
+    // One counting pass for every byte, then one scatter pass for every byte in which the keys
+    // differ, moving elements between data and buffer; the result ends up back in data
+    template <typename T, class Key>
+    void lsd_sort(T* data, T* buffer, std::size_t n, Key& key) {
+        using U = radix_t<std::remove_cvref_t<std::invoke_result_t<Key&, const T&>>>;
+        constexpr std::size_t passes = sizeof(U);
+        std::size_t counts[passes][radix_size] = {};
+        for (std::size_t i = 0; i < n; ++i) {
+            const U bits = to_radix(std::invoke(key, std::as_const(data[i])));
+            for (std::size_t pass = 0; pass < passes; ++pass) {
+                ++counts[pass][digit(bits, pass * radix_bits)];
+            }
+        }
+
+        T* from = data;
+        T* to = buffer;
+        for (std::size_t pass = 0; pass < passes; ++pass) {
+            const std::size_t shift = pass * radix_bits;
+            std::size_t* offsets = counts[pass];
+            if (offsets[digit(to_radix(std::invoke(key, std::as_const(from[0]))), shift)] == n) {
+                continue;
+            }
+            std::size_t offset = 0;
+            for (std::size_t d = 0; d < radix_size; ++d) {
+                const std::size_t count = offsets[d];
+                offsets[d] = offset;
+                offset += count;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::size_t d = digit(to_radix(std::invoke(key, std::as_const(from[i]))), shift);
+                to[offsets[d]++] = std::move(from[i]);
+            }
+            std::swap(from, to);
+        }
+        if (from != data) {
+            std::move(from, from + n, data);
+        }
+    }
+
+    template <typename T>
+    void insertion_sort(T* data, std::size_t n) noexcept {
+        for (std::size_t i = 1; i < n; ++i) {
+            const T value = data[i];
+            const auto bits = to_radix(value);
+            std::size_t j = i;
+            for (; j > 0 && bits < to_radix(data[j - 1]); --j) {
+                data[j] = data[j - 1];
+            }
+            data[j] = value;
+        }
+    }
+
+    // American flag sort: counts the digit at shift, permutes every element into its bucket by
+    // following swap cycles, then sorts each bucket on the next digit
+    template <typename T>
+    void msd_sort(T* data, std::size_t n, std::size_t shift) noexcept {
+        if (n <= msd_cutoff) {
+            insertion_sort(data, n);
+            return;
+        }
+        std::size_t heads[radix_size] = {};
+        std::size_t tails[radix_size];
+        for (std::size_t i = 0; i < n; ++i) {
+            ++heads[digit(to_radix(data[i]), shift)];
+        }
+        std::size_t offset = 0;
+        for (std::size_t d = 0; d < radix_size; ++d) {
+            const std::size_t count = heads[d];
+            heads[d] = offset;
+            offset += count;
+            tails[d] = offset;
+        }
+
+        std::size_t starts[radix_size];
+        std::copy(std::begin(heads), std::end(heads), std::begin(starts));
+        for (std::size_t d = 0; d < radix_size; ++d) {
+            while (heads[d] < tails[d]) {
+                T value = data[heads[d]];
+                std::size_t target = digit(to_radix(value), shift);
+                while (target != d) {
+                    std::swap(value, data[heads[target]++]);
+                    target = digit(to_radix(value), shift);
+                }
+                data[heads[d]++] = value;
+            }
+        }
+
+        if (shift == 0) {
+            return;
+        }
+        for (std::size_t d = 0; d < radix_size; ++d) {
+            const std::size_t count = tails[d] - starts[d];
+            if (count > 1) {
+                msd_sort(data + starts[d], count, shift - radix_bits);
+            }
+        }
+    }
+
+    struct Identity {
+        template <typename T>
+        constexpr const T& operator()(const T& value) const noexcept { return value; }
+    };
+
+    template <typename T, typename U>
+    concept same_element = std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>>;
+}
+
+// Sorts arithmetic values with an LSD radix sort, using scratch as the buffer between passes.
+// scratch grows to values.size() if it is smaller and keeps its storage for the next call.
+template <RadixKey T, typename Alloc, GrowthPolicy Growth, ShrinkPolicy Shrink>
+void radix_sort(std::span<T> values, DynamicArray<T, Alloc, Growth, Shrink>& scratch) {
+    if (values.size() < 2) {
+        return;
+    }
+    if (scratch.size() < values.size()) {
+        scratch.resize(values.size());
+    }
+    sorting_detail::Identity key;
+    sorting_detail::lsd_sort(values.data(), scratch.begin(), values.size(), key);
+}
+
+template <RadixKey T>
+void radix_sort(std::span<T> values) {
+    DynamicArray<T> scratch;
+    radix_sort(values, scratch);
+}
+
+// Sorts elements by the arithmetic key key(element) with an LSD radix sort, keeping equivalent
+// elements in their order. Elements move between values and scratch once per pass, and key is
+// called once per element and pass, so it should be a cheap member access. scratch is resized with
+// value-initialized elements when it is too small.
+template <typename T, class Key, typename Alloc, GrowthPolicy Growth, ShrinkPolicy Shrink>
+    requires RadixKey<std::remove_cvref_t<std::invoke_result_t<Key&, const T&>>>
+void radix_sort_by_key(std::span<T> values, Key key, DynamicArray<T, Alloc, Growth, Shrink>& scratch) {
+    static_assert(std::is_nothrow_move_assignable_v<T>, "radix_sort_by_key requires nothrow move assignment");
+    if (values.size() < 2) {
+        return;
+    }
+    if (scratch.size() < values.size()) {
+        scratch.resize(values.size());
+    }
+    sorting_detail::lsd_sort(values.data(), scratch.begin(), values.size(), key);
+}
+
+template <typename T, class Key>
+    requires RadixKey<std::remove_cvref_t<std::invoke_result_t<Key&, const T&>>>
+void radix_sort_by_key(std::span<T> values, Key key) {
+    DynamicArray<T> scratch;
+    radix_sort_by_key(values, std::move(key), scratch);
+}
+
+// Sorts arithmetic values in place with an MSD radix sort, without scratch storage. Not stable, which
+// plain values cannot tell apart.
+template <RadixKey T>
+void msd_radix_sort(std::span<T> values) noexcept {
+    sorting_detail::msd_sort(values.data(), values.size(), (sizeof(T) - 1) * sorting_detail::radix_bits);
+}
+
+// Index of the first element not ordered before value, like std::lower_bound, without branches
+// on the comparison: the range halves every step whatever the outcome, which the compiler turns
+// into conditional moves, so the loop runs log2(n) steps with no mispredictions.
+template <typename T, class Compare = std::less<>>
+std::size_t branchless_lower_bound(std::span<T> values, const std::remove_const_t<T>& value, Compare comp = Compare()) {
+    if (values.empty()) {
+        return 0;
+    }
+    const T* base = values.data();
+    std::size_t n = values.size();
+    while (n > 1) {
+        const std::size_t half = n / 2;
+        base = comp(base[half], value) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - values.data()) + (comp(*base, value) ? 1 : 0);
+}
+
+// Index of the first element ordered after value, like std::upper_bound
+template <typename T, class Compare = std::less<>>
+std::size_t branchless_upper_bound(std::span<T> values, const std::remove_const_t<T>& value, Compare comp = Compare()) {
+    if (values.empty()) {
+        return 0;
+    }
+    const T* base = values.data();
+    std::size_t n = values.size();
+    while (n > 1) {
+        const std::size_t half = n / 2;
+        base = comp(value, base[half]) ? base : base + half;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - values.data()) + (comp(value, *base) ? 0 : 1);
+}
+
+namespace sorting_detail {
+    // First index at or after from whose element is not ordered before value. Probes from + 1,
+    // from + 3, from + 7, ... until it passes value, then binary searches the last step, so a
+    // match d elements ahead costs O(log d) comparisons.
+    template <typename T, class Compare>
+    std::size_t gallop(const T* data, std::size_t from, std::size_t n, const T& value, Compare& comp) {
+        if (from >= n || !comp(data[from], value)) {
+            return from;
+        }
+        std::size_t low = from;
+        std::size_t step = 1;
+        std::size_t high = from + 1;
+        while (high < n && comp(data[high], value)) {
+            low = high;
+            step *= 2;
+            high = low + step;
+        }
+        high = std::min(high, n);
+        return low + 1 + branchless_lower_bound(std::span<const T>(data + low + 1, high - low - 1), value, comp);
+    }
+
+    // Below this size ratio a linear merge beats galloping through the larger range
+    inline constexpr std::size_t gallop_ratio = 8;
+}
+
+// Writes the elements of sorted lhs that are also in sorted rhs to out, reusing its storage, with
+// std::set_intersection's multiset semantics. When one range is much shorter, each of its elements
+// gallops through the other, so intersecting k with n elements costs O(k log(n / k)).
+template <typename T, typename U, class Compare = std::less<>, typename Alloc, GrowthPolicy Growth,
+    ShrinkPolicy Shrink>
+    requires sorting_detail::same_element<T, U>
+void sorted_intersection(std::span<T> lhs, std::span<U> rhs, DynamicArray<std::remove_const_t<T>, Alloc, Growth, Shrink>& out,
+    Compare comp = Compare()) {
+    using V = std::remove_const_t<T>;
+    out.clear();
+    std::span<const V> small(lhs);
+    std::span<const V> large(rhs);
+    if (small.size() > large.size()) {
+        std::swap(small, large);
+    }
+    if (small.empty()) {
+        return;
+    }
+    if (large.size() / small.size() < sorting_detail::gallop_ratio) {
+        std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(out), comp);
+        return;
+    }
+    std::size_t position = 0;
+    for (const V& value : small) {
+        position = sorting_detail::gallop(large.data(), position, large.size(), value, comp);
+        if (position == large.size()) {
+            break;
+        }
+        if (!comp(value, large[position])) {
+            out.push_back(value);
+            ++position;
+        }
+    }
+}
+
+// Writes the sorted union of sorted lhs and rhs to out, reusing its storage, with std::set_union's
+// multiset semantics. Runs of one range that fall between two elements of the other are found by
+// galloping and copied as a block.
+template <typename T, typename U, class Compare = std::less<>, typename Alloc, GrowthPolicy Growth,
+    ShrinkPolicy Shrink>
+    requires sorting_detail::same_element<T, U>
+void sorted_union(std::span<T> lhs, std::span<U> rhs, DynamicArray<std::remove_const_t<T>, Alloc, Growth, Shrink>& out,
+    Compare comp = Compare()) {
+    out.clear();
+    out.reserve(lhs.size() + rhs.size());
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < lhs.size() && j < rhs.size()) {
+        if (comp(lhs[i], rhs[j])) {
+            const std::size_t end = sorting_detail::gallop(lhs.data(), i, lhs.size(), rhs[j], comp);
+            out.insert(out.end(), lhs.begin() + i, lhs.begin() + end);
+            i = end;
+        } else if (comp(rhs[j], lhs[i])) {
+            const std::size_t end = sorting_detail::gallop(rhs.data(), j, rhs.size(), lhs[i], comp);
+            out.insert(out.end(), rhs.begin() + j, rhs.begin() + end);
+            j = end;
+        } else {
+            out.push_back(lhs[i]);
+            ++i;
+            ++j;
+        }
+    }
+    out.insert(out.end(), lhs.begin() + i, lhs.end());
+    out.insert(out.end(), rhs.begin() + j, rhs.end());
+}
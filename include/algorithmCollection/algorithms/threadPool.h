@@ -0,0 +1,378 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <memory>
+#include "../data structures/deque.h"
+#include "../data structures/dynamicArray.h"
+
+class ThreadPool;
+
+namespace thread_pool_detail {
+    // Which pool and worker the current thread is running a chunk for
+    struct WorkerSlot {
+        ThreadPool* pool = nullptr;
+        std::size_t index = 0;
+    };
+}
+
+// Fixed set of worker threads for fork-join loops. parallel_for() splits [0, count) into chunks of
+// grain indices which the workers and the calling thread claim from a shared counter until none are
+// left, so uneven chunks balance themselves, and returns once every chunk ran.
+// The calling thread takes part as worker 0, so a pool of n threads runs loops n + 1 wide and a pool
+// without threads runs them inline.
+// invoke() is the fork-join counterpart for recursive algorithms: every worker keeps a deque of
+// forked tasks, runs its own newest task first and, when it runs dry, steals the oldest task of
+// another worker, the largest piece of work left there (work stealing).
+class ThreadPool {
+public:
+    // One thread per hardware thread besides the caller's
+    ThreadPool() : ThreadPool(std::max(std::thread::hardware_concurrency(), 1u) - 1) {}
+
+    explicit ThreadPool(std::size_t thread_count) {
+        m_queues = std::make_unique<TaskQueue[]>(thread_count + 1);
+        m_threads.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            m_threads.push_back(std::thread(&ThreadPool::work, this, i + 1));
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    // Number of workers a loop runs on, the calling thread included
+    std::size_t concurrency() const noexcept { return m_threads.size() + 1; }
+
+    // Calls fn(begin, end, worker) for consecutive chunks of at most grain indices covering
+    // [0, count). worker is below concurrency() and no two chunks with the same worker run at
+    // once, so it can index per-worker scratch. The first exception thrown by fn is rethrown here
+    // after the running chunks finished; chunks not started by then are skipped.
+    // Calls from inside a chunk of the same pool run inline on that worker.
+    template <class Fn>
+    void parallel_for(std::size_t count, std::size_t grain, Fn&& fn) {
+        if (count == 0) {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (count + grain - 1) / grain;
+        if (m_threads.empty() || chunks == 1 || t_worker.pool == this) {
+            const std::size_t worker = t_worker.pool == this ? t_worker.index : 0;
+            for (std::size_t begin = 0; begin < count; begin += grain) {
+                fn(begin, std::min(begin + grain, count), worker);
+            }
+            return;
+        }
+
+        using Callable = std::remove_reference_t<Fn>;
+        Job job;
+        job.context = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+        job.invoke = [](void* context, std::size_t begin, std::size_t end, std::size_t worker) {
+            (*static_cast<Callable*>(context))(begin, end, worker);
+        };
+        job.count = count;
+        job.grain = grain;
+        job.chunks = chunks;
+
+        std::lock_guard<std::mutex> submit(m_submit);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &job;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        const WorkerScope scope(this, 0);
+        run(job, 0);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_active == 0; });
+        m_job = nullptr;
+        lock.unlock();
+
+        if (job.error) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
+    // Runs first() and second() and returns once both finished; second() may run on another worker.
+    // Calls nest: either function may call invoke() again to split its work further, which is how
+    // divide and conquer algorithms spread over the pool. If first() throws, second() is skipped
+    // unless another worker already started it; the exception is rethrown once no task is running.
+    // Inside a parallel_for() chunk both run inline, one after the other.
+    template <class First, class Second>
+    void invoke(First&& first, Second&& second) {
+        if (m_threads.empty() || (t_worker.pool == this && !m_forking.load(std::memory_order_relaxed))) {
+            first();
+            second();
+            return;
+        }
+        if (t_worker.pool != this) {
+            fork_join([&] { invoke(first, second); });
+            return;
+        }
+
+        using Callable = std::remove_reference_t<Second>;
+        Task task;
+        task.context = const_cast<void*>(static_cast<const void*>(std::addressof(second)));
+        task.invoke = [](void* context) { (*static_cast<Callable*>(context))(); };
+        TaskQueue& queue = m_queues[t_worker.index];
+        queue.push(&task);
+
+        std::exception_ptr error;
+        try {
+            first();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Nested invokes leave the queue as they found it, so its newest task is ours unless stolen
+        if (queue.pop_newest() != nullptr) {
+            if (!error) {
+                second();
+            }
+        } else {
+            help_until(task, t_worker.index);
+            if (!error) {
+                error = task.error;
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Runs root() on the calling thread, as worker 0, while the other workers steal the tasks its
+    // invoke() calls fork; a recursive algorithm started this way keeps the workers busy from its
+    // first fork to its last join. Nested calls and pools without threads just call root().
+    template <class Root>
+    void fork_join(Root&& root) {
+        if (m_threads.empty() || t_worker.pool == this) {
+            root();
+            return;
+        }
+        Job job;
+        job.forking = true;
+
+        std::lock_guard<std::mutex> submit(m_submit);
+        m_forking.store(true, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &job;
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        std::exception_ptr error;
+        {
+            const WorkerScope scope(this, 0);
+            try {
+                root();
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        // Every forked task was joined by the invoke() that forked it, so none is left to run
+        job.finished.store(true, std::memory_order_release);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_active == 0; });
+        m_job = nullptr;
+        m_forking.store(false, std::memory_order_relaxed);
+        lock.unlock();
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    struct Job {
+        void* context = nullptr;
+        void (*invoke)(void*, std::size_t, std::size_t, std::size_t) = nullptr;
+        std::size_t count = 0;
+        std::size_t grain = 0;
+        std::size_t chunks = 0;
+        // Set for fork_join() sessions, whose workers steal tasks until finished
+        bool forking = false;
+        std::atomic<bool> finished{false};
+        std::atomic<std::size_t> next{0};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    // A forked invoke() half, owned by the stack frame of the invoke() that forked it
+    struct Task {
+        void* context = nullptr;
+        void (*invoke)(void*) = nullptr;
+        std::exception_ptr error;
+        std::atomic<bool> done{false};
+    };
+
+    // Forked tasks of one worker. The owner pushes and pops the newest end, thieves take the oldest.
+    // The queues are only touched when a task is forked or when a worker runs out of work, so a
+    // plain mutex is cheap enough here.
+    struct alignas(64) TaskQueue {
+        std::mutex mutex;
+        Deque<Task*> tasks;
+
+        void push(Task* task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(task);
+        }
+
+        Task* pop_newest() noexcept {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty()) {
+                return nullptr;
+            }
+            Task* task = tasks.back();
+            tasks.pop_back();
+            return task;
+        }
+
+        Task* steal_oldest() noexcept {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty()) {
+                return nullptr;
+            }
+            Task* task = tasks.front();
+            tasks.pop_front();
+            return task;
+        }
+    };
+
+    using WorkerSlot = thread_pool_detail::WorkerSlot;
+
+    struct WorkerScope {
+        WorkerSlot previous;
+
+        WorkerScope(ThreadPool* pool, std::size_t index) noexcept : previous(t_worker) {
+            t_worker = WorkerSlot{pool, index};
+        }
+
+        ~WorkerScope() { t_worker = previous; }
+    };
+
+    static inline thread_local WorkerSlot t_worker;
+
+    DynamicArray<std::thread> m_threads;
+    std::unique_ptr<TaskQueue[]> m_queues;
+    std::atomic<bool> m_forking{false};
+    std::mutex m_submit;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    Job* m_job = nullptr;
+    std::size_t m_generation = 0;
+    std::size_t m_active = 0;
+    bool m_stop = false;
+
+    static void execute(Task& task) noexcept {
+        try {
+            task.invoke(task.context);
+        } catch (...) {
+            task.error = std::current_exception();
+        }
+        task.done.store(true, std::memory_order_release);
+    }
+
+    // Takes a task from the own queue or, failing that, the oldest task of another worker
+    Task* find_task(std::size_t worker) noexcept {
+        if (Task* task = m_queues[worker].pop_newest()) {
+            return task;
+        }
+        const std::size_t queues = m_threads.size() + 1;
+        for (std::size_t i = 1; i < queues; ++i) {
+            if (Task* task = m_queues[(worker + i) % queues].steal_oldest()) {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    // Waits for a stolen task, running other tasks in the meantime
+    void help_until(const Task& task, std::size_t worker) {
+        while (!task.done.load(std::memory_order_acquire)) {
+            if (Task* other = find_task(worker)) {
+                execute(*other);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void steal_until_finished(Job& job, std::size_t worker) {
+        while (!job.finished.load(std::memory_order_acquire)) {
+            if (Task* task = find_task(worker)) {
+                execute(*task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    static void run(Job& job, std::size_t worker) {
+        while (true) {
+            const std::size_t chunk = job.next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= job.chunks) {
+                return;
+            }
+            const std::size_t begin = chunk * job.grain;
+            try {
+                job.invoke(job.context, begin, std::min(begin + job.grain, job.count), worker);
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(job.error_mutex);
+                    if (!job.error) {
+                        job.error = std::current_exception();
+                    }
+                }
+                job.next.store(job.chunks, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    void work(std::size_t index) {
+        const WorkerScope scope(this, index);
+        std::size_t seen = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wake.wait(lock, [&] { return m_stop || (m_job != nullptr && m_generation != seen); });
+            if (m_stop) {
+                return;
+            }
+            seen = m_generation;
+            Job& job = *m_job;
+            ++m_active;
+            lock.unlock();
+
+            if (job.forking) {
+                steal_until_finished(job, index);
+            } else {
+                run(job, index);
+            }
+
+            lock.lock();
+            if (--m_active == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+};
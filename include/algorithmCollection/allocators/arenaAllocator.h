@@ -0,0 +1,240 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+
+// Monotonic memory arena. Allocations bump a pointer through the current chunk and are only
+// released all at once by reset() or destruction. The arena starts from an optional caller-supplied
+// buffer and grows by requesting geometrically larger chunks from ::operator new.
+class ArenaResource {
+public:
+    static constexpr std::size_t default_chunk_size = 4096;
+
+    explicit ArenaResource(std::size_t initial_chunk_size = default_chunk_size) noexcept
+        : m_next_chunk_size(initial_chunk_size == 0 ? default_chunk_size : initial_chunk_size) {}
+
+    // Serves allocations from `buffer` first; the arena never frees caller-supplied memory.
+    explicit ArenaResource(std::span<std::byte> buffer, std::size_t initial_chunk_size = default_chunk_size) noexcept
+        : m_initial_buffer(buffer),
+        m_current(buffer.data()),
+        m_end(buffer.data() + buffer.size()),
+        m_next_chunk_size(initial_chunk_size == 0 ? default_chunk_size : initial_chunk_size) {}
+
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+
+    ~ArenaResource() {
+        release();
+    }
+
+    // Returns `bytes` of storage aligned to `alignment`, growing the arena if the current chunk is exhausted.
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        if (void* p = bump(bytes, alignment)) {
+            return p;
+        }
+
+        grow(bytes, alignment);
+        return bump(bytes, alignment);
+    }
+
+    // Resizes the most recent allocation in place, which succeeds if p is the last block handed out and
+    // the current chunk has room. Returns false and leaves the block untouched otherwise.
+    bool resize_last(void* p, std::size_t old_bytes, std::size_t new_bytes) noexcept {
+        auto* block = static_cast<std::byte*>(p);
+        if (!block || block + old_bytes != m_current) {
+            return false;
+        }
+        if (new_bytes > old_bytes && new_bytes - old_bytes > static_cast<std::size_t>(m_end - m_current)) {
+            return false;
+        }
+
+        m_current = block + new_bytes;
+        m_used = m_used - old_bytes + new_bytes;
+        return true;
+    }
+
+    // Individual deallocations are no-ops; memory is reclaimed by reset() or release().
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+        static_cast<void>(p);
+        static_cast<void>(bytes);
+        static_cast<void>(alignment);
+    }
+
+    // Invalidates every allocation at once. The largest chunk is kept as a spare so a reused arena
+    // does not go back to the heap for the same workload; all other chunks are freed.
+    void reset() noexcept {
+        if (m_chunks) {
+            free_chunks(m_spare);
+            m_spare = m_chunks;
+            free_chunks(m_spare->next);
+            m_spare->next = nullptr;
+            m_chunks = nullptr;
+        }
+        rewind();
+    }
+
+    // Invalidates every allocation and returns all chunks to the heap.
+    void release() noexcept {
+        free_chunks(m_chunks);
+        free_chunks(m_spare);
+        m_chunks = nullptr;
+        m_spare = nullptr;
+        rewind();
+    }
+
+    // Number of bytes handed out since construction or the last reset, excluding alignment padding
+    std::size_t bytes_allocated() const noexcept { return m_used; }
+
+    // Number of chunks currently held from the heap, including a spare kept by reset()
+    std::size_t chunk_count() const noexcept {
+        std::size_t count = m_spare ? 1 : 0;
+        for (Chunk* chunk = m_chunks; chunk; chunk = chunk->next) {
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    // Header placed at the start of every chunk obtained from the heap
+    struct Chunk {
+        Chunk* next;
+        std::size_t size;
+    };
+
+    static constexpr std::size_t chunk_header_size =
+        (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    static std::byte* chunk_begin(Chunk* chunk) noexcept {
+        return reinterpret_cast<std::byte*>(chunk) + chunk_header_size;
+    }
+
+    void* bump(std::size_t bytes, std::size_t alignment) noexcept {
+        if (!m_current) {
+            return nullptr;
+        }
+
+        auto address = reinterpret_cast<std::uintptr_t>(m_current);
+        auto aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        auto available = static_cast<std::size_t>(m_end - m_current);
+        auto padding = static_cast<std::size_t>(aligned - address);
+
+        if (padding > available || bytes > available - padding) {
+            return nullptr;
+        }
+
+        m_current += padding + bytes;
+        m_used += bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void grow(std::size_t bytes, std::size_t alignment) {
+        std::size_t required = chunk_header_size + bytes + alignment;
+        Chunk* chunk = nullptr;
+
+        if (m_spare && m_spare->size >= required) {
+            chunk = m_spare;
+            m_spare = nullptr;
+        } else {
+            std::size_t size = std::max(m_next_chunk_size, required);
+            chunk = static_cast<Chunk*>(::operator new(size));
+            chunk->size = size;
+
+            if (m_next_chunk_size <= std::numeric_limits<std::size_t>::max() / 2) {
+                m_next_chunk_size *= 2;
+            }
+        }
+
+        chunk->next = m_chunks;
+        m_chunks = chunk;
+
+        m_current = chunk_begin(chunk);
+        m_end = reinterpret_cast<std::byte*>(chunk) + chunk->size;
+    }
+
+    void rewind() noexcept {
+        m_used = 0;
+        m_current = m_initial_buffer.data();
+        m_end = m_initial_buffer.data() + m_initial_buffer.size();
+    }
+
+    static void free_chunks(Chunk* chunk) noexcept {
+        while (chunk) {
+            Chunk* next = chunk->next;
+            ::operator delete(chunk);
+            chunk = next;
+        }
+    }
+
+    std::span<std::byte> m_initial_buffer;
+    std::byte* m_current = nullptr;
+    std::byte* m_end = nullptr;
+    Chunk* m_chunks = nullptr;
+    Chunk* m_spare = nullptr;
+    std::size_t m_next_chunk_size;
+    std::size_t m_used = 0;
+};
+
+// Allocator handle over an ArenaResource. Copies and rebinds share the same arena, so a container
+// rebinding to its node type (e.g. DoubleLinkedList) still allocates from the caller's arena.
+template <typename T>
+class MonotonicArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    explicit MonotonicArenaAllocator(ArenaResource& resource) noexcept
+        : m_resource(&resource) {}
+
+    MonotonicArenaAllocator(const MonotonicArenaAllocator&) = default;
+    MonotonicArenaAllocator& operator=(const MonotonicArenaAllocator&) = default;
+
+    template <typename U>
+    MonotonicArenaAllocator(const MonotonicArenaAllocator<U>& other) noexcept
+        : m_resource(other.resource()) {}
+
+    T* allocate(std::size_t n) const {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (n > max_size()) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) const noexcept {
+        m_resource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    // Grows or shrinks the arena's most recent allocation in place. Returns nullptr if p is not the
+    // last allocation or the chunk is full, and the caller falls back to allocate and copy.
+    T* reallocate(T* p, std::size_t old_n, std::size_t new_n) const noexcept {
+        if (new_n > max_size()) {
+            return nullptr;
+        }
+        return m_resource->resize_last(p, old_n * sizeof(T), new_n * sizeof(T)) ? p : nullptr;
+    }
+
+    constexpr std::size_t max_size() const noexcept {
+        return std::numeric_limits<std::size_t>::max() / sizeof(T);
+    }
+
+    // Returns the arena this allocator draws from
+    ArenaResource* resource() const noexcept { return m_resource; }
+
+    template <typename U>
+    bool operator==(const MonotonicArenaAllocator<U>& other) const noexcept {
+        return m_resource == other.resource();
+    }
+
+private:
+    ArenaResource* m_resource;
+};
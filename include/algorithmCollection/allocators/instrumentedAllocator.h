@@ -0,0 +1,207 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "simpleAllocator.h"
+
+// Counters of the requests an InstrumentedAllocator forwarded: how many, how many bytes, how many are
+// still live and the most that were live at once, and a histogram of request sizes. Thread safe;
+// every allocator copy and rebound copy made from one InstrumentedAllocator records into the same
+// AllocationStats, which must outlive them.
+class AllocationStats {
+public:
+    // Bucket i counts requests of [2^(i-1), 2^i) bytes, bucket 0 those of 0 bytes
+    static constexpr std::size_t histogram_buckets = 65;
+
+    AllocationStats() = default;
+    AllocationStats(const AllocationStats&) = delete;
+    AllocationStats& operator=(const AllocationStats&) = delete;
+
+    // Stats of default-constructed InstrumentedAllocators
+    static AllocationStats& global() noexcept {
+        static AllocationStats stats;
+        return stats;
+    }
+
+    static constexpr std::size_t size_class(std::size_t bytes) noexcept {
+        return static_cast<std::size_t>(std::bit_width(bytes));
+    }
+
+    std::size_t allocations() const noexcept { return m_allocations.load(std::memory_order_relaxed); }
+    std::size_t deallocations() const noexcept { return m_deallocations.load(std::memory_order_relaxed); }
+
+    // Blocks resized by reallocate(); failed attempts, after which the container allocates anew,
+    // are counted separately
+    std::size_t reallocations() const noexcept { return m_reallocations.load(std::memory_order_relaxed); }
+    std::size_t failed_reallocations() const noexcept { return m_failed_reallocations.load(std::memory_order_relaxed); }
+
+    // Bytes requested by allocations and by growing reallocations, over the whole lifetime
+    std::size_t allocated_bytes() const noexcept { return m_allocated_bytes.load(std::memory_order_relaxed); }
+    std::size_t live_bytes() const noexcept { return m_live_bytes.load(std::memory_order_relaxed); }
+    std::size_t peak_bytes() const noexcept { return m_peak_bytes.load(std::memory_order_relaxed); }
+
+    // Allocations and reallocations per size class
+    std::array<std::size_t, histogram_buckets> histogram() const noexcept {
+        std::array<std::size_t, histogram_buckets> counts{};
+        for (std::size_t i = 0; i < histogram_buckets; ++i) {
+            counts[i] = m_histogram[i].load(std::memory_order_relaxed);
+        }
+        return counts;
+    }
+
+    // Zeroes every counter. live_bytes starts from 0 as well, so blocks allocated before the reset
+    // and freed after it make it wrap; reset only while nothing is allocated.
+    void reset() noexcept {
+        for (auto* counter : {&m_allocations, &m_deallocations, &m_reallocations, &m_failed_reallocations,
+                 &m_allocated_bytes, &m_live_bytes, &m_peak_bytes}) {
+            counter->store(0, std::memory_order_relaxed);
+        }
+        for (auto& bucket : m_histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void record_allocation(std::size_t bytes) noexcept {
+        m_allocations.fetch_add(1, std::memory_order_relaxed);
+        m_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        m_histogram[size_class(bytes)].fetch_add(1, std::memory_order_relaxed);
+        add_live(bytes);
+    }
+
+    void record_deallocation(std::size_t bytes) noexcept {
+        m_deallocations.fetch_add(1, std::memory_order_relaxed);
+        m_live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void record_reallocation(std::size_t old_bytes, std::size_t new_bytes, bool resized) noexcept {
+        if (!resized) {
+            m_failed_reallocations.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_reallocations.fetch_add(1, std::memory_order_relaxed);
+        m_histogram[size_class(new_bytes)].fetch_add(1, std::memory_order_relaxed);
+        if (new_bytes > old_bytes) {
+            m_allocated_bytes.fetch_add(new_bytes - old_bytes, std::memory_order_relaxed);
+            add_live(new_bytes - old_bytes);
+        } else {
+            m_live_bytes.fetch_sub(old_bytes - new_bytes, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<std::size_t> m_allocations{0};
+    std::atomic<std::size_t> m_deallocations{0};
+    std::atomic<std::size_t> m_reallocations{0};
+    std::atomic<std::size_t> m_failed_reallocations{0};
+    std::atomic<std::size_t> m_allocated_bytes{0};
+    std::atomic<std::size_t> m_live_bytes{0};
+    std::atomic<std::size_t> m_peak_bytes{0};
+    std::array<std::atomic<std::size_t>, histogram_buckets> m_histogram{};
+
+    void add_live(std::size_t bytes) noexcept {
+        const std::size_t live = m_live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::size_t peak = m_peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !m_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+// Allocator adapter forwarding every request to Inner and recording it in an AllocationStats,
+// e.g. DynamicArray<int, InstrumentedAllocator<SimpleAllocator<int>>> to see what a capacity
+// policy costs. reallocate() is forwarded when Inner has one, so containers keep resizing in place.
+template <typename Inner = SimpleAllocator<std::byte>>
+class InstrumentedAllocator {
+    using inner_traits = std::allocator_traits<Inner>;
+
+    template <typename>
+    friend class InstrumentedAllocator;
+
+public:
+    using value_type = typename inner_traits::value_type;
+    using inner_allocator_type = Inner;
+    using propagate_on_container_copy_assignment = typename inner_traits::propagate_on_container_copy_assignment;
+    using propagate_on_container_move_assignment = typename inner_traits::propagate_on_container_move_assignment;
+    using propagate_on_container_swap = typename inner_traits::propagate_on_container_swap;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = InstrumentedAllocator<typename inner_traits::template rebind_alloc<U>>;
+    };
+
+    // Records into AllocationStats::global()
+    InstrumentedAllocator() noexcept(std::is_nothrow_default_constructible_v<Inner>)
+        : m_inner(), m_stats(&AllocationStats::global()) {}
+
+    explicit InstrumentedAllocator(AllocationStats& stats, const Inner& inner = Inner())
+        : m_inner(inner), m_stats(&stats) {}
+
+    InstrumentedAllocator(const InstrumentedAllocator&) = default;
+
+    template <typename OtherInner>
+    InstrumentedAllocator(const InstrumentedAllocator<OtherInner>& other) noexcept
+        : m_inner(other.m_inner), m_stats(other.m_stats) {}
+
+    InstrumentedAllocator& operator=(const InstrumentedAllocator&) = default;
+
+    // Const like SimpleAllocator's, containers allocate through const references; Inner is mutable
+    value_type* allocate(std::size_t n) const {
+        value_type* p = inner_traits::allocate(m_inner, n);
+        if (p) {
+            m_stats->record_allocation(n * sizeof(value_type));
+        }
+        return p;
+    }
+
+    void deallocate(value_type* p, std::size_t n) const noexcept {
+        if (!p) {
+            return;
+        }
+        m_stats->record_deallocation(n * sizeof(value_type));
+        inner_traits::deallocate(m_inner, p, n);
+    }
+
+    // Forwarded when Inner can resize blocks, see relocation.h
+    value_type* reallocate(value_type* p, std::size_t old_n, std::size_t new_n) const noexcept
+        requires requires(Inner& inner, value_type* q, std::size_t n) {
+            { inner.reallocate(q, n, n) } -> std::same_as<value_type*>;
+        } {
+        value_type* resized = m_inner.reallocate(p, old_n, new_n);
+        m_stats->record_reallocation(old_n * sizeof(value_type), new_n * sizeof(value_type), resized != nullptr);
+        return resized;
+    }
+
+    std::size_t max_size() const noexcept { return inner_traits::max_size(m_inner); }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        inner_traits::construct(m_inner, p, std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    void destroy(U* p) {
+        inner_traits::destroy(m_inner, p);
+    }
+
+    InstrumentedAllocator select_on_container_copy_construction() const {
+        return InstrumentedAllocator(*m_stats, inner_traits::select_on_container_copy_construction(m_inner));
+    }
+
+    const AllocationStats& stats() const noexcept { return *m_stats; }
+
+    const Inner& inner() const noexcept { return m_inner; }
+
+    template <typename OtherInner>
+    bool operator==(const InstrumentedAllocator<OtherInner>& other) const noexcept {
+        return m_stats == other.m_stats && m_inner == other.m_inner;
+    }
+
+private:
+    [[no_unique_address]] mutable Inner m_inner;
+    AllocationStats* m_stats;
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Allocator drawing from a std::pmr::memory_resource chosen at run time, so containers built with it
+// share one type whatever the resource: DynamicArray<int, PolymorphicAllocator<int>> can sit in a
+// std::pmr::monotonic_buffer_resource for one request and a std::pmr::synchronized_pool_resource for
+// the next. Behaves like std::pmr::polymorphic_allocator, which the containers cannot use directly
+// since they allocate through const allocators:
+// - it never propagates; a container keeps the resource it was built with for its whole lifetime,
+//   move assignment between containers on different resources moves the elements one by one, and
+//   copies of a container use the default resource (std::pmr::get_default_resource())
+// - elements are built by uses-allocator construction, so containers nested inside a container draw
+//   from its resource too, including std::pmr containers
+template <typename T = std::byte>
+class PolymorphicAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    PolymorphicAllocator() noexcept
+        : m_resource(std::pmr::get_default_resource()) {}
+
+    // Implicit like std::pmr::polymorphic_allocator, so a resource can be passed where an allocator is expected
+    PolymorphicAllocator(std::pmr::memory_resource* resource) noexcept
+        : m_resource(resource) {}
+
+    PolymorphicAllocator(const PolymorphicAllocator&) = default;
+
+    template <typename U>
+    PolymorphicAllocator(const PolymorphicAllocator<U>& other) noexcept
+        : m_resource(other.resource()) {}
+
+    // Assignment would swap the resource under the storage of a container
+    PolymorphicAllocator& operator=(const PolymorphicAllocator&) = delete;
+
+    T* allocate(std::size_t n) const {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) const noexcept {
+        if (p) {
+            m_resource->deallocate(p, n * sizeof(T), alignof(T));
+        }
+    }
+
+    // Passes this allocator on to elements that take one, see std::uses_allocator
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) const {
+        std::uninitialized_construct_using_allocator(p, *this, std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    void destroy(U* p) const {
+        p->~U();
+    }
+
+    PolymorphicAllocator select_on_container_copy_construction() const noexcept {
+        return PolymorphicAllocator();
+    }
+
+    std::pmr::memory_resource* resource() const noexcept { return m_resource; }
+
+    // Lets elements that are std::pmr containers draw from the same resource
+    template <typename U>
+    operator std::pmr::polymorphic_allocator<U>() const noexcept {
+        return std::pmr::polymorphic_allocator<U>(m_resource);
+    }
+
+    template <typename U>
+    bool operator==(const PolymorphicAllocator<U>& other) const noexcept {
+        return m_resource == other.resource() || *m_resource == *other.resource();
+    }
+
+private:
+    std::pmr::memory_resource* m_resource;
+};
@@ -0,0 +1,280 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+// Owns one free-list pool per node size. Nodes are carved out of contiguous blocks, handed out in
+// address order while a block is fresh and recycled through an intrusive free list in O(1) once
+// freed. Blocks are only returned to the heap when the resource is destroyed.
+// A default-constructed resource is not thread safe; share it between containers used from the
+// same thread. One constructed with pool_synchronized takes a lock around every allocation and
+// may be used from any number of threads.
+struct pool_synchronized_t {
+    explicit pool_synchronized_t() = default;
+};
+
+inline constexpr pool_synchronized_t pool_synchronized{};
+
+class PoolResource {
+public:
+    PoolResource() = default;
+
+    explicit PoolResource(pool_synchronized_t) noexcept : m_synchronized(true) {}
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    // Synchronized resource used by default-constructed PoolAllocators. It is never destroyed, so
+    // containers using it may be static and may move between threads. An explicit unsynchronized
+    // resource avoids the lock for containers that stay on one thread.
+    static PoolResource& shared_default() {
+        static PoolResource* resource = new PoolResource(pool_synchronized);
+        return *resource;
+    }
+
+    ~PoolResource() {
+        while (m_pools) {
+            Pool* next = m_pools->next;
+            m_pools->release();
+            delete m_pools;
+            m_pools = next;
+        }
+    }
+
+    // Fixed-size free-list pool serving nodes of one size and alignment
+    class Pool {
+        friend class PoolResource;
+    public:
+        void* allocate() {
+            if (m_mutex) {
+                std::lock_guard lock(*m_mutex);
+                return allocate_unlocked();
+            }
+            return allocate_unlocked();
+        }
+
+        void deallocate(void* p) noexcept {
+            if (m_mutex) {
+                std::lock_guard lock(*m_mutex);
+                deallocate_unlocked(p);
+            } else {
+                deallocate_unlocked(p);
+            }
+        }
+
+        std::size_t node_size() const noexcept { return m_node_size; }
+
+        // Number of nodes currently handed out
+        std::size_t in_use() const noexcept {
+            if (m_mutex) {
+                std::lock_guard lock(*m_mutex);
+                return m_in_use;
+            }
+            return m_in_use;
+        }
+
+        // Number of blocks requested from the heap
+        std::size_t block_count() const noexcept {
+            if (m_mutex) {
+                std::lock_guard lock(*m_mutex);
+                return m_block_count;
+            }
+            return m_block_count;
+        }
+
+    private:
+        struct FreeNode {
+            FreeNode* next;
+        };
+
+        // Header stored in front of every block so blocks can be released together
+        struct BlockHeader {
+            BlockHeader* next;
+        };
+
+        Pool(std::size_t node_size, std::size_t node_alignment, std::size_t nodes_per_block, std::mutex* mutex)
+            : m_node_size(slot_size(node_size, node_alignment)),
+            m_node_alignment(slot_alignment(node_alignment)),
+            m_nodes_per_block(nodes_per_block == 0 ? 1 : nodes_per_block),
+            m_header_size(round_up(sizeof(BlockHeader), m_node_alignment)),
+            m_mutex(mutex) {}
+
+        void* allocate_unlocked() {
+            if (m_free_list) {
+                FreeNode* node = m_free_list;
+                m_free_list = node->next;
+                ++m_in_use;
+                return node;
+            }
+
+            if (m_bump == m_bump_end) {
+                add_block();
+            }
+
+            void* node = m_bump;
+            m_bump += m_node_size;
+            ++m_in_use;
+            return node;
+        }
+
+        void deallocate_unlocked(void* p) noexcept {
+            auto* node = static_cast<FreeNode*>(p);
+            node->next = m_free_list;
+            m_free_list = node;
+            --m_in_use;
+        }
+
+        static std::size_t round_up(std::size_t value, std::size_t alignment) noexcept {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        // Every slot must be able to hold a free-list link when the node is not in use
+        static std::size_t slot_alignment(std::size_t node_alignment) noexcept {
+            return std::max(node_alignment, alignof(FreeNode));
+        }
+
+        static std::size_t slot_size(std::size_t node_size, std::size_t node_alignment) noexcept {
+            return round_up(std::max(node_size, sizeof(FreeNode)), slot_alignment(node_alignment));
+        }
+
+        void add_block() {
+            std::size_t bytes = m_header_size + m_node_size * m_nodes_per_block;
+            auto* block = static_cast<std::byte*>(::operator new(bytes, std::align_val_t(m_node_alignment)));
+
+            auto* header = reinterpret_cast<BlockHeader*>(block);
+            header->next = m_blocks;
+            m_blocks = header;
+            ++m_block_count;
+
+            m_bump = block + m_header_size;
+            m_bump_end = m_bump + m_node_size * m_nodes_per_block;
+        }
+
+        void release() noexcept {
+            while (m_blocks) {
+                BlockHeader* next = m_blocks->next;
+                ::operator delete(m_blocks, std::align_val_t(m_node_alignment));
+                m_blocks = next;
+            }
+        }
+
+        std::size_t m_node_size;
+        std::size_t m_node_alignment;
+        std::size_t m_nodes_per_block;
+        std::size_t m_header_size;
+        std::mutex* m_mutex;
+        FreeNode* m_free_list = nullptr;
+        BlockHeader* m_blocks = nullptr;
+        std::byte* m_bump = nullptr;
+        std::byte* m_bump_end = nullptr;
+        std::size_t m_in_use = 0;
+        std::size_t m_block_count = 0;
+        Pool* next = nullptr;
+    };
+
+    // Returns the pool serving nodes of `node_size` bytes, creating it with `nodes_per_block` nodes
+    // per block if no allocator has requested this size and alignment yet.
+    Pool& pool_for(std::size_t node_size, std::size_t node_alignment, std::size_t nodes_per_block) {
+        std::unique_lock<std::mutex> lock;
+        if (m_synchronized) {
+            lock = std::unique_lock(m_mutex);
+        }
+        for (Pool* pool = m_pools; pool; pool = pool->next) {
+            if (pool->m_node_size == Pool::slot_size(node_size, node_alignment)
+                && pool->m_node_alignment == Pool::slot_alignment(node_alignment)) {
+                return *pool;
+            }
+        }
+
+        auto* pool = new Pool(node_size, node_alignment, nodes_per_block, m_synchronized ? &m_mutex : nullptr);
+        pool->next = m_pools;
+        m_pools = pool;
+        return *pool;
+    }
+
+    bool synchronized() const noexcept { return m_synchronized; }
+
+private:
+    Pool* m_pools = nullptr;
+    bool m_synchronized = false;
+    std::mutex m_mutex;
+};
+
+// Node allocator backed by a PoolResource. Single-object allocations come from the free-list pool
+// for sizeof(T); array allocations fall through to ::operator new. Copies and rebinds share the
+// resource, so a container rebinding to its node type (DoubleLinkedList) gets a pool sized exactly
+// for its nodes. BlockSize is the number of nodes carved from each block.
+// The allocator is two trivially copyable pointers, so per-node copies stay cheap.
+// The recommended allocator for DoubleLinkedList, see PooledDoubleLinkedList.
+// Default-constructed allocators share the locked PoolResource::shared_default(); containers that
+// stay on one thread skip the lock with a resource of their own.
+template <typename T, std::size_t BlockSize = 1024>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, BlockSize>;
+    };
+
+    // Creates an allocator drawing from PoolResource::shared_default()
+    PoolAllocator()
+        : PoolAllocator(PoolResource::shared_default()) {}
+
+    // Creates an allocator drawing from `resource`, which may be shared by several containers
+    explicit PoolAllocator(PoolResource& resource)
+        : m_resource(&resource),
+        m_pool(&resource.pool_for(sizeof(T), alignof(T), BlockSize)) {}
+
+    PoolAllocator(const PoolAllocator&) = default;
+    PoolAllocator& operator=(const PoolAllocator&) = default;
+
+    template <typename U, std::size_t OtherBlockSize>
+    PoolAllocator(const PoolAllocator<U, OtherBlockSize>& other)
+        : PoolAllocator(*other.resource()) {}
+
+    T* allocate(std::size_t n) const {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (n == 1) {
+            return static_cast<T*>(m_pool->allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    void deallocate(T* p, std::size_t n) const noexcept {
+        if (!p) {
+            return;
+        }
+        if (n == 1) {
+            m_pool->deallocate(p);
+        } else {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        }
+    }
+
+    // Returns the resource shared by this allocator and its copies
+    PoolResource* resource() const noexcept { return m_resource; }
+
+    // Returns the pool serving single-object allocations of T
+    const PoolResource::Pool& pool() const noexcept { return *m_pool; }
+
+    template <typename U, std::size_t OtherBlockSize>
+    bool operator==(const PoolAllocator<U, OtherBlockSize>& other) const noexcept {
+        return m_resource == other.resource();
+    }
+
+private:
+    PoolResource* m_resource;
+    PoolResource::Pool* m_pool;
+};
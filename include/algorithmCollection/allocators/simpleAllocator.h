@@ -1,6 +1,12 @@
 #pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
 #include <utility>
 
+// Stateless heap allocator. Storage for types with at most fundamental alignment comes from
+// std::malloc, so reallocate() can grow a block with std::realloc, which extends it in place or
+// remaps its pages where the heap allows.
 template <typename T>
 class SimpleAllocator {
 public:
@@ -9,24 +15,44 @@ public:
     SimpleAllocator() = default;
     SimpleAllocator(const SimpleAllocator&) = default;
 
+    template <typename U>
+    SimpleAllocator(const SimpleAllocator<U>&) noexcept {}
+
     T* allocate(std::size_t n) {
-        if (n == 0) {
-            return nullptr;
-        }
-        return static_cast<T*>(::operator new(n * sizeof(T)));
+        return allocate_storage(n);
     }
 
     T* allocate(std::size_t n) const {
-        if (n == 0) {
-            return nullptr;
-        }
-        return static_cast<T*>(::operator new(n * sizeof(T)));
+        return allocate_storage(n);
     }
 
-    void deallocate(T* p, std::size_t n) {
-        static_cast<void>(n); // Silence the -werror=unused warning. TODO: use the parameter properly.
-        if (p) {
+    void deallocate(T* p, std::size_t n) const noexcept {
+        static_cast<void>(n);
+        if (!p) {
+            return;
+        }
+
+        if constexpr (uses_malloc) {
             std::free(p);
+        } else {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        }
+    }
+
+    // Resizes the block of old_n objects at p to new_n objects, moving its bytes if the block cannot
+    // be resized in place. Returns nullptr, leaving the block untouched, if that is not possible.
+    // Only valid for trivially relocatable T.
+    T* reallocate(T* p, std::size_t old_n, std::size_t new_n) const noexcept {
+        static_cast<void>(old_n);
+        if constexpr (uses_malloc) {
+            if (new_n == 0 || new_n > static_cast<std::size_t>(-1) / sizeof(T)) {
+                return nullptr;
+            }
+            return static_cast<T*>(std::realloc(static_cast<void*>(p), new_n * sizeof(T)));
+        } else {
+            static_cast<void>(p);
+            static_cast<void>(new_n);
+            return nullptr;
         }
     }
 
@@ -36,11 +62,34 @@ public:
     }
 
     template <typename U>
-    void construct(U* p, const T& value) {
-        new (p) U(value);
+    void destroy(U* p) {
+        p->~U();
+    }
+
+    template <typename U>
+    bool operator==(const SimpleAllocator<U>&) const noexcept {
+        return true;
     }
 
-    void destroy(T* p) {
-        p->~T();
+private:
+    static constexpr bool uses_malloc = alignof(T) <= alignof(std::max_align_t);
+
+    static T* allocate_storage(std::size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        if constexpr (uses_malloc) {
+            void* p = std::malloc(n * sizeof(T));
+            if (!p) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(p);
+        } else {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
     }
-};
\ No newline at end of file
+};
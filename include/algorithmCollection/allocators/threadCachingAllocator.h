@@ -0,0 +1,318 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Process-wide heap behind ThreadCachingAllocator. Requests up to max_block bytes are rounded up to a
+// power-of-two size class and served from a free list cached by the calling thread, so the common
+// allocate/deallocate touches no shared state. Caches refill from and spill to a central free list
+// per size class a batch at a time, which is the only point threads synchronize.
+// Blocks belong to no thread: a block freed on another thread than the one that allocated it simply
+// joins the freeing thread's cache. A thread's cache goes back to the central lists when it exits.
+// Memory is carved from chunks that are kept for the lifetime of the process.
+class ThreadCachingResource {
+public:
+    static constexpr std::size_t min_block = 16;
+    static constexpr std::size_t max_block = 32 * 1024;
+    static constexpr std::size_t size_classes = std::bit_width(max_block / min_block);
+    static constexpr std::size_t chunk_bytes = 256 * 1024;
+
+    // Chunks are aligned to this, so every block is aligned to its size up to chunk_alignment
+    static constexpr std::size_t chunk_alignment = 4096;
+
+    ThreadCachingResource(const ThreadCachingResource&) = delete;
+    ThreadCachingResource& operator=(const ThreadCachingResource&) = delete;
+
+    // Never destroyed: thread caches and containers with static storage still free during exit
+    static ThreadCachingResource& instance() {
+        static ThreadCachingResource* resource = new ThreadCachingResource;
+        return *resource;
+    }
+
+    static constexpr std::size_t size_class(std::size_t bytes) noexcept {
+        return bytes <= min_block ? 0 : static_cast<std::size_t>(std::bit_width(bytes - 1)) - std::bit_width(min_block - 1);
+    }
+
+    static constexpr std::size_t block_size(std::size_t size_class) noexcept {
+        return min_block << size_class;
+    }
+
+    // Blocks moved between a thread cache and the central list at once; a cache holds up to two batches
+    static constexpr std::size_t batch_size(std::size_t size_class) noexcept {
+        return std::clamp<std::size_t>(max_block / block_size(size_class), 2, 64);
+    }
+
+    // Returns a block of block_size(size_class) bytes
+    void* allocate(std::size_t size_class) {
+        if (ThreadCache* cache = local_cache()) {
+            return cache->allocate(size_class, *this);
+        }
+
+        // The calling thread is exiting and its cache is gone
+        std::size_t count = 0;
+        FreeBlock* batch = take_batch(size_class, count);
+        if (batch->next) {
+            give_loose(size_class, batch->next, count - 1);
+        }
+        return batch;
+    }
+
+    void deallocate(void* p, std::size_t size_class) noexcept {
+        auto* block = static_cast<FreeBlock*>(p);
+        if (ThreadCache* cache = local_cache()) {
+            cache->deallocate(block, size_class, *this);
+            return;
+        }
+        block->next = nullptr;
+        give_loose(size_class, block, 1);
+    }
+
+    // Bytes of chunks requested from the heap
+    std::size_t reserved_bytes() const noexcept { return m_reserved.load(std::memory_order_relaxed); }
+
+    // Free blocks of a size class parked in the central list
+    std::size_t central_blocks(std::size_t size_class) {
+        CentralList& central = m_central[size_class];
+        std::lock_guard lock(central.mutex);
+        return central.full_batches * batch_size(size_class) + central.loose_count;
+    }
+
+    // Free blocks of a size class cached by the calling thread
+    static std::size_t cached_blocks(std::size_t size_class) noexcept {
+        ThreadCache* cache = local_cache();
+        return cache ? cache->lists[size_class].count : 0;
+    }
+
+private:
+    // Free blocks link through their first word; the head of a full batch in the central list links
+    // to the next batch through its second word
+    struct FreeBlock {
+        FreeBlock* next;
+        FreeBlock* next_batch;
+    };
+
+    static_assert(sizeof(FreeBlock) <= min_block);
+
+    // Batches of exactly batch_size blocks, blocks handed back by exiting threads, and the unused
+    // rest of the newest chunk
+    struct alignas(64) CentralList {
+        std::mutex mutex;
+        FreeBlock* full = nullptr;
+        std::size_t full_batches = 0;
+        FreeBlock* loose = nullptr;
+        std::size_t loose_count = 0;
+        std::byte* bump = nullptr;
+        std::byte* bump_end = nullptr;
+        std::vector<std::byte*> chunks;
+    };
+
+    struct ThreadCache {
+        struct List {
+            FreeBlock* head = nullptr;
+            std::size_t count = 0;
+        };
+
+        explicit ThreadCache(bool& destroyed) noexcept
+            : destroyed(destroyed) {}
+
+        ThreadCache(const ThreadCache&) = delete;
+        ThreadCache& operator=(const ThreadCache&) = delete;
+
+        ~ThreadCache() {
+            destroyed = true;
+            for (std::size_t c = 0; c < size_classes; ++c) {
+                if (lists[c].head) {
+                    instance().give_loose(c, lists[c].head, lists[c].count);
+                }
+            }
+        }
+
+        void* allocate(std::size_t size_class, ThreadCachingResource& resource) {
+            List& list = lists[size_class];
+            if (!list.head) {
+                list.head = resource.take_batch(size_class, list.count);
+            }
+            FreeBlock* block = list.head;
+            list.head = block->next;
+            --list.count;
+            return block;
+        }
+
+        void deallocate(FreeBlock* block, std::size_t size_class, ThreadCachingResource& resource) noexcept {
+            List& list = lists[size_class];
+            block->next = list.head;
+            list.head = block;
+            const std::size_t batch = batch_size(size_class);
+            if (++list.count < 2 * batch) {
+                return;
+            }
+
+            // Keep one batch, the most recently freed and likely still in cache, and spill the other
+            FreeBlock* last_kept = list.head;
+            for (std::size_t i = 1; i < batch; ++i) {
+                last_kept = last_kept->next;
+            }
+            FreeBlock* spilled = last_kept->next;
+            last_kept->next = nullptr;
+            const std::size_t spilled_count = list.count - batch;
+            list.count = batch;
+            // A cache refilled from the loose blocks may hold more than two batches
+            if (spilled_count == batch) {
+                resource.give_batch(size_class, spilled);
+            } else {
+                resource.give_loose(size_class, spilled, spilled_count);
+            }
+        }
+
+        std::array<List, size_classes> lists{};
+        bool& destroyed;
+    };
+
+    ThreadCachingResource() = default;
+
+    // nullptr once the calling thread has destroyed its cache during exit
+    static ThreadCache* local_cache() noexcept {
+        thread_local constinit bool destroyed = false;
+        if (destroyed) {
+            return nullptr;
+        }
+        thread_local ThreadCache cache(destroyed);
+        return &cache;
+    }
+
+    // Hands out a chain of free blocks and its length, carving a new batch when the central list is empty
+    FreeBlock* take_batch(std::size_t size_class, std::size_t& count) {
+        CentralList& central = m_central[size_class];
+        const std::size_t size = block_size(size_class);
+        const std::size_t batch = batch_size(size_class);
+        std::byte* carved;
+        {
+            std::lock_guard lock(central.mutex);
+            if (central.full) {
+                FreeBlock* head = central.full;
+                central.full = head->next_batch;
+                --central.full_batches;
+                count = batch;
+                return head;
+            }
+            if (central.loose) {
+                FreeBlock* head = central.loose;
+                count = central.loose_count;
+                central.loose = nullptr;
+                central.loose_count = 0;
+                return head;
+            }
+
+            if (central.bump == central.bump_end) {
+                add_chunk(central);
+            }
+            carved = central.bump;
+            central.bump += size * batch;
+        }
+
+        // Chunk sizes are multiples of every batch's bytes, so a batch never straddles two chunks
+        for (std::size_t i = 0; i + 1 < batch; ++i) {
+            reinterpret_cast<FreeBlock*>(carved + i * size)->next = reinterpret_cast<FreeBlock*>(carved + (i + 1) * size);
+        }
+        reinterpret_cast<FreeBlock*>(carved + (batch - 1) * size)->next = nullptr;
+        count = batch;
+        return reinterpret_cast<FreeBlock*>(carved);
+    }
+
+    // Takes back a chain of exactly batch_size blocks
+    void give_batch(std::size_t size_class, FreeBlock* head) noexcept {
+        CentralList& central = m_central[size_class];
+        std::lock_guard lock(central.mutex);
+        head->next_batch = central.full;
+        central.full = head;
+        ++central.full_batches;
+    }
+
+    // Takes back a chain of any length
+    void give_loose(std::size_t size_class, FreeBlock* head, std::size_t count) noexcept {
+        FreeBlock* tail = head;
+        while (tail->next) {
+            tail = tail->next;
+        }
+
+        CentralList& central = m_central[size_class];
+        std::lock_guard lock(central.mutex);
+        tail->next = central.loose;
+        central.loose = head;
+        central.loose_count += count;
+    }
+
+    void add_chunk(CentralList& central) {
+        central.chunks.reserve(central.chunks.size() + 1);
+        auto* chunk = static_cast<std::byte*>(::operator new(chunk_bytes, std::align_val_t(chunk_alignment)));
+        central.chunks.push_back(chunk);
+        central.bump = chunk;
+        central.bump_end = chunk + chunk_bytes;
+        m_reserved.fetch_add(chunk_bytes, std::memory_order_relaxed);
+    }
+
+    std::array<CentralList, size_classes> m_central;
+    std::atomic<std::size_t> m_reserved{0};
+};
+
+// Stateless allocator drawing from ThreadCachingResource, a drop-in for SimpleAllocator in containers
+// that are filled and drained by many threads at once. Requests above max_block bytes, and types
+// aligned beyond chunk_alignment, go to ::operator new directly.
+// Every thread caches up to two batches per size class, at most 64 KiB for the 16 KiB and 32 KiB
+// classes and less for the smaller ones.
+template <typename T>
+class ThreadCachingAllocator {
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    ThreadCachingAllocator() = default;
+    ThreadCachingAllocator(const ThreadCachingAllocator&) = default;
+
+    template <typename U>
+    ThreadCachingAllocator(const ThreadCachingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) const {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        const std::size_t bytes = n * sizeof(T);
+        if (cached(bytes)) {
+            return static_cast<T*>(ThreadCachingResource::instance().allocate(ThreadCachingResource::size_class(bytes)));
+        }
+        return static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+    }
+
+    void deallocate(T* p, std::size_t n) const noexcept {
+        if (!p) {
+            return;
+        }
+
+        const std::size_t bytes = n * sizeof(T);
+        if (cached(bytes)) {
+            ThreadCachingResource::instance().deallocate(p, ThreadCachingResource::size_class(bytes));
+        } else {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        }
+    }
+
+    template <typename U>
+    bool operator==(const ThreadCachingAllocator<U>&) const noexcept {
+        return true;
+    }
+
+private:
+    static constexpr bool cached(std::size_t bytes) noexcept {
+        return bytes <= ThreadCachingResource::max_block && alignof(T) <= ThreadCachingResource::chunk_alignment;
+    }
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Allocator propagation shared by the containers, following the rules of the standard containers.
+// An allocator moves to another container on copy assignment, move assignment or swap only if its
+// propagate_on_container_* trait says so; otherwise each container keeps the allocator it was built
+// with. Move assignment between containers whose allocators then differ moves the elements one by one
+// into the target's own storage, and swapping such containers is not supported.
+namespace propagation_detail {
+template <typename Alloc>
+using traits = std::allocator_traits<Alloc>;
+
+template <typename Alloc>
+constexpr bool equal(const Alloc& lhs, const Alloc& rhs) noexcept {
+    if constexpr (traits<Alloc>::is_always_equal::value) {
+        return true;
+    } else {
+        return lhs == rhs;
+    }
+}
+
+// Move assignment can always take over the storage of the source
+template <typename Alloc>
+inline constexpr bool move_steals_storage_v =
+    traits<Alloc>::propagate_on_container_move_assignment::value || traits<Alloc>::is_always_equal::value;
+
+// The allocator a copy-assigned container ends up with
+template <typename Alloc>
+constexpr const Alloc& copy_assignment_allocator(const Alloc& target, const Alloc& source) noexcept {
+    if constexpr (traits<Alloc>::propagate_on_container_copy_assignment::value) {
+        return source;
+    } else {
+        return target;
+    }
+}
+
+// Swaps the allocators of two containers if Propagate is std::true_type
+template <typename Propagate, typename Alloc>
+constexpr void swap_if(Alloc& lhs, Alloc& rhs) noexcept {
+    if constexpr (Propagate::value) {
+        using std::swap;
+        swap(lhs, rhs);
+    }
+}
+
+template <typename Alloc>
+constexpr void swap_on_copy_assignment(Alloc& lhs, Alloc& rhs) noexcept {
+    swap_if<typename traits<Alloc>::propagate_on_container_copy_assignment>(lhs, rhs);
+}
+
+template <typename Alloc>
+constexpr void swap_on_swap(Alloc& lhs, Alloc& rhs) noexcept {
+    swap_if<typename traits<Alloc>::propagate_on_container_swap>(lhs, rhs);
+}
+
+// Takes the source's allocator on move assignment if it propagates
+template <typename Alloc>
+constexpr void move_assign(Alloc& target, Alloc& source) noexcept {
+    if constexpr (traits<Alloc>::propagate_on_container_move_assignment::value) {
+        target = std::move(source);
+    }
+}
+
+template <typename Alloc>
+constexpr Alloc select_on_copy(const Alloc& alloc) {
+    return traits<Alloc>::select_on_container_copy_construction(alloc);
+}
+}
@@ -0,0 +1,1208 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "allocatorPropagation.h"
+#include "dynamicArray.h"
+#include "relocation.h"
+
+// B-tree engine shared by the ordered containers (map.h, set.h, multimap.h, multiset.h).
+//
+// Each node stores up to node_values sorted elements in one array sized to about NodeBytes, so a
+// lookup reads a few contiguous cache lines per level instead of one node per element as in a
+// red-black tree, and the tree is only log_B(n) levels deep. Every node but the root is at least
+// half full. In-order iteration walks the elements of each leaf contiguously.
+//
+// A Policy describes the element type:
+//     using key_type; using value_type;
+//     static const key_type& key(const value_type&)    the key of an element
+//     static auto transfer(value_type&)                constructor argument moving an element out of
+//                                                      a slot that is destroyed right after
+//     static constexpr bool constant_iterators         whether iterators only give const access
+// Multi selects whether equal keys may be stored more than once; equal elements keep their
+// insertion order.
+//
+// Elements move between nodes when the tree changes shape, so inserting or erasing invalidates
+// every iterator, pointer and reference into the container.
+namespace btree_detail {
+    // Selects the argument type of lookups: any type with a transparent Compare, else the key type
+    template <bool Transparent>
+    struct KeyArg {
+        template <class K, class Key>
+        using type = Key;
+    };
+
+    template <>
+    struct KeyArg<true> {
+        template <class K, class Key>
+        using type = K;
+    };
+}
+
+template <typename Policy, typename Compare, typename Alloc, bool Multi, std::size_t NodeBytes = 256>
+class BTree {
+public:
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<value_type>;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    // Elements per node: as many as fit into NodeBytes next to the node header, at least three
+    static constexpr size_type node_values = std::clamp<size_type>(
+        (NodeBytes - 2 * sizeof(void*)) / sizeof(value_type), 3, UINT16_MAX);
+    static constexpr size_type min_values = (node_values - 1) / 2;
+
+protected:
+    static constexpr bool is_transparent = requires { typename Compare::is_transparent; };
+
+    template <class K>
+    using key_arg = typename btree_detail::KeyArg<is_transparent>::template type<K, key_type>;
+
+private:
+    struct InternalNode;
+
+    struct Node {
+        InternalNode* parent;
+        std::uint16_t position; // Index among the parent's children
+        std::uint16_t count;
+        bool leaf;
+        alignas(value_type) std::byte storage[node_values * sizeof(value_type)];
+
+        value_type* values() noexcept { return reinterpret_cast<value_type*>(storage); }
+        const value_type* values() const noexcept { return reinterpret_cast<const value_type*>(storage); }
+        value_type& value(size_type i) noexcept { return values()[i]; }
+        const value_type& value(size_type i) const noexcept { return values()[i]; }
+    };
+
+    struct InternalNode : Node {
+        Node* children[node_values + 1];
+    };
+
+    using leaf_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using internal_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<InternalNode>;
+
+    static Node* child(Node* node, size_type i) noexcept { return static_cast<InternalNode*>(node)->children[i]; }
+    static const Node* child(const Node* node, size_type i) noexcept {
+        return static_cast<const InternalNode*>(node)->children[i];
+    }
+
+    template <bool Const>
+    class Iterator {
+        static constexpr bool is_constant = Const || Policy::constant_iterators;
+        using node_pointer = std::conditional_t<Const, const Node*, Node*>;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<is_constant, const value_type*, value_type*>;
+        using reference = std::conditional_t<is_constant, const value_type&, value_type&>;
+
+        Iterator() = default;
+
+        // Non-const to const conversion
+        template <bool OtherConst> requires (Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other) noexcept : m_node(other.m_node), m_position(other.m_position) {}
+
+        reference operator*() const noexcept { return m_node->value(m_position); }
+        pointer operator->() const noexcept { return &m_node->value(m_position); }
+
+        Iterator& operator++() noexcept {
+            increment();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator temp(*this);
+            increment();
+            return temp;
+        }
+
+        Iterator& operator--() noexcept {
+            decrement();
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator temp(*this);
+            decrement();
+            return temp;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.m_node == rhs.m_node && lhs.m_position == rhs.m_position;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class BTree;
+        friend class Iterator<true>;
+
+        Iterator(node_pointer node, size_type position) noexcept : m_node(node), m_position(position) {}
+
+        // The end iterator is one past the last value of the root
+        void increment() noexcept {
+            if (!m_node->leaf) {
+                // The successor is the first value of the leftmost leaf of the right subtree
+                node_pointer node = child(m_node, m_position + 1);
+                while (!node->leaf) {
+                    node = child(node, 0);
+                }
+                m_node = node;
+                m_position = 0;
+                return;
+            }
+
+            if (++m_position < m_node->count) {
+                return;
+            }
+
+            // Past the last value of a leaf: climb to the first ancestor with a value to the right
+            while (m_node->parent && m_position == m_node->count) {
+                m_position = m_node->position;
+                m_node = m_node->parent;
+            }
+        }
+
+        void decrement() noexcept {
+            if (!m_node->leaf) {
+                // The predecessor is the last value of the rightmost leaf of the left subtree
+                node_pointer node = child(m_node, m_position);
+                while (!node->leaf) {
+                    node = child(node, node->count);
+                }
+                m_node = node;
+                m_position = node->count - 1u;
+                return;
+            }
+
+            if (m_position > 0) {
+                --m_position;
+                return;
+            }
+
+            // Before the first value of a leaf: climb to the first ancestor with a value to the left
+            while (m_node->parent && m_position == 0) {
+                m_position = m_node->position;
+                m_node = m_node->parent;
+            }
+            --m_position;
+        }
+
+        node_pointer m_node = nullptr;
+        size_type m_position = 0;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using insert_return_type = std::conditional_t<Multi, iterator, std::pair<iterator, bool>>;
+
+    BTree() = default;
+
+    explicit BTree(const Compare& comp, const allocator_type& alloc = allocator_type())
+        : m_comp(comp), m_allocator(alloc) {}
+
+    explicit BTree(const allocator_type& alloc) : m_allocator(alloc) {}
+
+    template <class InputIt>
+    BTree(InputIt first, InputIt last, const Compare& comp = Compare(), const allocator_type& alloc = allocator_type())
+        : BTree(comp, alloc) {
+        insert(first, last);
+    }
+
+    BTree(std::initializer_list<value_type> values, const Compare& comp = Compare(),
+        const allocator_type& alloc = allocator_type())
+        : BTree(values.begin(), values.end(), comp, alloc) {}
+
+    BTree(const BTree& other)
+        : BTree(other, propagation_detail::select_on_copy(other.m_allocator)) {}
+
+    BTree(const BTree& other, const allocator_type& alloc) : m_comp(other.m_comp), m_allocator(alloc) {
+        if (other.m_root) {
+            m_root = clone(other.m_root, nullptr);
+            m_size = other.m_size;
+        }
+    }
+
+    BTree(BTree&& other) noexcept
+        : m_root(std::exchange(other.m_root, nullptr)), m_size(std::exchange(other.m_size, 0)),
+          m_comp(std::move(other.m_comp)), m_allocator(std::move(other.m_allocator)) {}
+
+    // Takes over the nodes of other if `alloc` equals its allocator, otherwise moves the elements
+    // into new nodes of the same shape and clears other
+    BTree(BTree&& other, const allocator_type& alloc) : m_comp(other.m_comp), m_allocator(alloc) {
+        if (propagation_detail::equal(m_allocator, other.m_allocator)) {
+            swap_nodes(other);
+        } else if (other.m_root) {
+            m_root = clone(other.m_root, nullptr);
+            m_size = other.m_size;
+            other.clear();
+        }
+    }
+
+    ~BTree() {
+        clear();
+    }
+
+    // Keeps this tree's allocator unless it propagates on copy assignment
+    BTree& operator=(const BTree& other) {
+        if (this != &other) {
+            BTree copy(other, propagation_detail::copy_assignment_allocator(m_allocator, other.m_allocator));
+            swap_nodes(copy);
+            propagation_detail::swap_on_copy_assignment(m_allocator, copy.m_allocator);
+        }
+        return *this;
+    }
+
+    // Takes over the nodes of other when the allocator propagates on move assignment or both
+    // allocators are equal; otherwise other's elements are moved into new nodes
+    BTree& operator=(BTree&& other) noexcept(propagation_detail::move_steals_storage_v<allocator_type>) {
+        if (this != &other) {
+            if constexpr (!propagation_detail::move_steals_storage_v<allocator_type>) {
+                if (!propagation_detail::equal(m_allocator, other.m_allocator)) {
+                    BTree moved(std::move(other), m_allocator);
+                    swap_nodes(moved);
+                    return *this;
+                }
+            }
+            // Release the current elements with the allocator that created them
+            clear();
+            m_root = std::exchange(other.m_root, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_comp = std::move(other.m_comp);
+            propagation_detail::move_assign(m_allocator, other.m_allocator);
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(leftmost(), 0); }
+    const_iterator begin() const noexcept { return const_iterator(leftmost(), 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(m_root, m_root ? m_root->count : 0); }
+    const_iterator end() const noexcept { return const_iterator(m_root, m_root ? m_root->count : 0); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // Returns the number of elements
+    size_type size() const noexcept { return m_size; }
+
+    // Checks whether the tree holds no elements
+    bool empty() const noexcept { return m_size == 0; }
+
+    size_type max_size() const noexcept {
+        return std::allocator_traits<allocator_type>::max_size(m_allocator);
+    }
+
+    // Number of levels, zero for an empty tree
+    size_type height() const noexcept {
+        size_type levels = 0;
+        for (const Node* node = m_root; node; node = node->leaf ? nullptr : child(node, 0)) {
+            ++levels;
+        }
+        return levels;
+    }
+
+    key_compare key_comp() const { return m_comp; }
+    allocator_type get_allocator() const noexcept { return m_allocator; }
+
+    // Destroys every element and frees every node
+    void clear() noexcept {
+        if (m_root) {
+            destroy_subtree(m_root);
+            m_root = nullptr;
+        }
+        m_size = 0;
+    }
+
+    // Inserts value; containers with unique keys only do so if no element with an equal key exists
+    insert_return_type insert(const value_type& value) {
+        return insert_with_key(Policy::key(value), value);
+    }
+
+    insert_return_type insert(value_type&& value) {
+        return insert_with_key(Policy::key(value), std::move(value));
+    }
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> values) {
+        insert(values.begin(), values.end());
+    }
+
+    // Constructs an element from args and inserts it like insert()
+    template <class... Args>
+    insert_return_type emplace(Args&&... args) {
+        if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, value_type> && ...)) {
+            return insert_with_key(Policy::key(args...), std::forward<Args>(args)...);
+        } else {
+            // The key is only known once the element exists, so it is built outside the tree first
+            Staged staged(m_allocator, std::forward<Args>(args)...);
+            return insert_with_key(Policy::key(staged.value()), Policy::transfer(staged.value()));
+        }
+    }
+
+    // Replaces the contents with the sorted range [first, last) in O(n). Nodes are filled left to
+    // right without any search or split; the rightmost nodes are topped up from their left
+    // neighbours at the end. Throws std::invalid_argument, leaving the tree empty, if the range is
+    // not sorted (or, for unique keys, holds equal keys).
+    template <class InputIt>
+    void bulk_load(InputIt first, InputIt last) {
+        clear();
+        BulkLoader loader(*this);
+        for (; first != last; ++first) {
+            loader.append(*first);
+        }
+        loader.finish();
+    }
+
+    template <class T, class A, GrowthPolicy G, ShrinkPolicy S>
+    void bulk_load(const DynamicArray<T, A, G, S>& values) {
+        bulk_load(values.begin(), values.end());
+    }
+
+    // Moves the elements of a sorted array into the tree, leaving the array empty
+    template <class T, class A, GrowthPolicy G, ShrinkPolicy S>
+    void bulk_load(DynamicArray<T, A, G, S>&& values) {
+        bulk_load(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+        values.clear();
+    }
+
+    // Returns an iterator to an element with an equal key (the first one for multi trees), or end()
+    template <class K = key_type>
+    iterator find(const key_arg<K>& key) {
+        iterator it = lower_bound(key);
+        return it != end() && !m_comp(key, Policy::key(*it)) ? it : end();
+    }
+
+    template <class K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        const_iterator it = lower_bound(key);
+        return it != end() && !m_comp(key, Policy::key(*it)) ? it : end();
+    }
+
+    template <class K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return find(key) != end();
+    }
+
+    template <class K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        if constexpr (Multi) {
+            auto [first, last] = equal_range(key);
+            return static_cast<size_type>(std::distance(first, last));
+        } else {
+            return contains(key) ? 1 : 0;
+        }
+    }
+
+    // Returns an iterator to the first element whose key is not less than key
+    template <class K = key_type>
+    iterator lower_bound(const key_arg<K>& key) {
+        auto [node, position] = lower_bound_position(key);
+        return iterator(node, position);
+    }
+
+    template <class K = key_type>
+    const_iterator lower_bound(const key_arg<K>& key) const {
+        auto [node, position] = lower_bound_position(key);
+        return const_iterator(node, position);
+    }
+
+    // Returns an iterator to the first element whose key is greater than key
+    template <class K = key_type>
+    iterator upper_bound(const key_arg<K>& key) {
+        auto [node, position] = upper_bound_position(key);
+        return iterator(node, position);
+    }
+
+    template <class K = key_type>
+    const_iterator upper_bound(const key_arg<K>& key) const {
+        auto [node, position] = upper_bound_position(key);
+        return const_iterator(node, position);
+    }
+
+    template <class K = key_type>
+    std::pair<iterator, iterator> equal_range(const key_arg<K>& key) {
+        if constexpr (Multi) {
+            return {lower_bound(key), upper_bound(key)};
+        } else {
+            iterator it = find(key);
+            if (it == end()) {
+                return {it, it};
+            }
+            iterator next = it;
+            return {it, ++next};
+        }
+    }
+
+    template <class K = key_type>
+    std::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const {
+        if constexpr (Multi) {
+            return {lower_bound(key), upper_bound(key)};
+        } else {
+            const_iterator it = find(key);
+            if (it == end()) {
+                return {it, it};
+            }
+            const_iterator next = it;
+            return {it, ++next};
+        }
+    }
+
+    // Removes the element at pos and returns an iterator to the element after it
+    iterator erase(const_iterator pos) {
+        auto* node = const_cast<Node*>(pos.m_node);
+        const size_type index = pos.m_position;
+        iterator next;
+
+        destroy_value(node->value(index));
+        if (node->leaf) {
+            close_gap(node, index);
+            next = iterator(node, index);
+        } else {
+            // Move the successor, the first value of the leftmost leaf of the right subtree, into the
+            // vacated slot, then take it out of its leaf
+            Node* leaf = child(node, index + 1);
+            while (!leaf->leaf) {
+                leaf = child(leaf, 0);
+            }
+            move_value(&leaf->value(0), &node->value(index));
+            close_gap(leaf, 0);
+            next = iterator(node, index);
+            node = leaf;
+        }
+        --m_size;
+
+        rebalance_after_erase(node, next);
+
+        // A position past the end of a leaf refers to the next separator up the tree
+        while (next.m_node && next.m_node->parent && next.m_position == next.m_node->count) {
+            next.m_position = next.m_node->position;
+            next.m_node = next.m_node->parent;
+        }
+        return next;
+    }
+
+    iterator erase(iterator pos) {
+        return erase(const_iterator(pos));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        if (first == cbegin() && last == cend()) {
+            clear();
+            return end();
+        }
+
+        // Erasing moves elements between nodes, so the end of the range is tracked by distance
+        auto remaining = std::distance(first, last);
+        iterator it(const_cast<Node*>(first.m_node), first.m_position);
+        for (; remaining > 0; --remaining) {
+            it = erase(it);
+        }
+        return it;
+    }
+
+    // Removes every element with an equal key, returns the number of removed elements
+    template <class K = key_type>
+    size_type erase(const key_arg<K>& key) {
+        auto [first, last] = equal_range(key);
+        const auto removed = static_cast<size_type>(std::distance(first, last));
+        erase(first, last);
+        return removed;
+    }
+
+    // Allocators are swapped only if they propagate on swap; otherwise they must be equal
+    void swap(BTree& other) noexcept {
+        swap_nodes(other);
+        propagation_detail::swap_on_swap(m_allocator, other.m_allocator);
+    }
+
+    friend void swap(BTree& lhs, BTree& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const BTree& lhs, const BTree& rhs) {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!=(const BTree& lhs, const BTree& rhs) {
+        return !(lhs == rhs);
+    }
+
+protected:
+    // Finds the element with an equal key for unique trees, or constructs one from args in its
+    // sorted position. Multi trees insert behind the elements with an equal key.
+    template <class K, class... Args>
+    insert_return_type insert_with_key(const K& key, Args&&... args) {
+        if (!m_root) {
+            m_root = new_leaf();
+        }
+
+        Node* node = m_root;
+        while (true) {
+            size_type position;
+            if constexpr (Multi) {
+                position = upper_index(node, key);
+            } else {
+                position = lower_index(node, key);
+                if (position < node->count && !m_comp(key, Policy::key(node->value(position)))) {
+                    return {iterator(node, position), false};
+                }
+            }
+
+            if (node->leaf) {
+                iterator it = insert_at(node, position, std::forward<Args>(args)...);
+                if constexpr (Multi) {
+                    return it;
+                } else {
+                    return {it, true};
+                }
+            }
+            node = child(node, position);
+        }
+    }
+
+private:
+    Node* m_root = nullptr;
+    size_type m_size = 0;
+    [[no_unique_address]] Compare m_comp{};
+    [[no_unique_address]] allocator_type m_allocator{};
+
+    // Element constructed outside the tree, destroyed when it goes out of scope
+    class Staged {
+    public:
+        template <class... Args>
+        explicit Staged(allocator_type& alloc, Args&&... args) : m_alloc(alloc) {
+            std::allocator_traits<allocator_type>::construct(m_alloc, ptr(), std::forward<Args>(args)...);
+        }
+
+        Staged(const Staged&) = delete;
+        Staged& operator=(const Staged&) = delete;
+
+        ~Staged() { std::allocator_traits<allocator_type>::destroy(m_alloc, ptr()); }
+
+        value_type& value() noexcept { return *ptr(); }
+
+    private:
+        value_type* ptr() noexcept { return reinterpret_cast<value_type*>(m_buffer); }
+
+        allocator_type& m_alloc;
+        alignas(value_type) std::byte m_buffer[sizeof(value_type)];
+    };
+
+    // Builds a tree from sorted elements by appending them to its right edge
+    class BulkLoader {
+    public:
+        explicit BulkLoader(BTree& tree) noexcept : m_tree(tree) {}
+
+        BulkLoader(const BulkLoader&) = delete;
+        BulkLoader& operator=(const BulkLoader&) = delete;
+
+        ~BulkLoader() {
+            if (!m_finished) {
+                m_tree.clear();
+            }
+        }
+
+        template <class Arg>
+        void append(Arg&& arg) {
+            if (!m_leaf) {
+                m_tree.m_root = m_leaf = m_tree.new_leaf();
+            }
+
+            if (m_leaf->count < node_values) {
+                value_type* slot = &m_leaf->value(m_leaf->count);
+                m_tree.construct_value(slot, std::forward<Arg>(arg));
+                check_order(slot);
+                ++m_leaf->count;
+            } else {
+                append_separator(std::forward<Arg>(arg));
+            }
+            m_last = m_leaf->count > 0 ? &m_leaf->value(m_leaf->count - 1u) : m_last;
+            ++m_tree.m_size;
+        }
+
+        // Tops up the right edge: every node on it except the root must be at least half full.
+        // Their left neighbours are full, so borrowing from them never lets those underflow.
+        void finish() noexcept {
+            Node* node = m_tree.m_root;
+            while (node && !node->leaf) {
+                auto* parent = static_cast<InternalNode*>(node);
+                Node* last = parent->children[parent->count];
+                while (last->count < min_values) {
+                    m_tree.borrow_from_left(parent, parent->count, nullptr);
+                }
+                node = last;
+            }
+            m_finished = true;
+        }
+
+    private:
+        BTree& m_tree;
+        Node* m_leaf = nullptr;
+        const value_type* m_last = nullptr;
+        bool m_finished = false;
+
+        // Makes a full rightmost leaf's successor a separator in the lowest ancestor with room, and
+        // hangs a new, empty right edge below it
+        template <class Arg>
+        void append_separator(Arg&& arg) {
+            InternalNode* node = m_leaf->parent;
+            size_type levels = 1;
+            while (node && node->count == node_values) {
+                node = node->parent;
+                ++levels;
+            }
+
+            // Allocate every node first, so a failure leaves the tree as it was
+            Node* fresh[64];
+            size_type allocated = 0;
+            const size_type needed = levels + (node ? 0 : 1);
+            try {
+                for (; allocated < needed; ++allocated) {
+                    fresh[allocated] = allocated + 1 == levels ? m_tree.new_leaf() : m_tree.new_internal();
+                }
+            } catch (...) {
+                for (size_type i = 0; i < allocated; ++i) {
+                    m_tree.free_node(fresh[i]);
+                }
+                throw;
+            }
+
+            // fresh[0, levels - 1) are the new internal nodes top-down, fresh[levels - 1] the new
+            // leaf and fresh[levels] a new root, if one is needed
+            if (!node) {
+                auto* root = static_cast<InternalNode*>(fresh[levels]);
+                root->children[0] = m_tree.m_root;
+                m_tree.m_root->parent = root;
+                m_tree.m_root->position = 0;
+                m_tree.m_root = root;
+                node = root;
+            }
+
+            value_type* slot = &node->value(node->count);
+            try {
+                m_tree.construct_value(slot, std::forward<Arg>(arg));
+                check_order(slot);
+            } catch (...) {
+                for (size_type i = 0; i < levels; ++i) {
+                    m_tree.free_node(fresh[i]);
+                }
+                throw;
+            }
+            ++node->count;
+            m_last = slot;
+
+            Node* parent = node;
+            for (size_type i = 0; i < levels; ++i) {
+                attach(static_cast<InternalNode*>(parent), parent->count, fresh[i]);
+                parent = fresh[i];
+            }
+            m_leaf = fresh[levels - 1];
+        }
+
+        // Throws, destroying the element at slot, if it is out of order
+        void check_order(value_type* slot) {
+            if (!m_last) {
+                m_last = slot;
+                return;
+            }
+
+            const auto& key = Policy::key(*slot);
+            const auto& previous = Policy::key(*m_last);
+            const bool in_order = Multi ? !m_tree.m_comp(key, previous) : m_tree.m_comp(previous, key);
+            if (!in_order) {
+                m_tree.destroy_value(*slot);
+                throw std::invalid_argument("Bulk load range is not sorted");
+            }
+        }
+    };
+
+    // Linking nodes
+
+    Node* new_leaf() {
+        leaf_allocator alloc(m_allocator);
+        Node* node = std::allocator_traits<leaf_allocator>::allocate(alloc, 1);
+        ::new (static_cast<void*>(node)) Node;
+        node->parent = nullptr;
+        node->position = 0;
+        node->count = 0;
+        node->leaf = true;
+        return node;
+    }
+
+    InternalNode* new_internal() {
+        internal_allocator alloc(m_allocator);
+        InternalNode* node = std::allocator_traits<internal_allocator>::allocate(alloc, 1);
+        ::new (static_cast<void*>(node)) InternalNode;
+        node->parent = nullptr;
+        node->position = 0;
+        node->count = 0;
+        node->leaf = false;
+        return node;
+    }
+
+    // Frees a node without touching its elements
+    void free_node(Node* node) noexcept {
+        if (node->leaf) {
+            leaf_allocator alloc(m_allocator);
+            std::allocator_traits<leaf_allocator>::deallocate(alloc, node, 1);
+        } else {
+            internal_allocator alloc(m_allocator);
+            std::allocator_traits<internal_allocator>::deallocate(alloc, static_cast<InternalNode*>(node), 1);
+        }
+    }
+
+    void destroy_subtree(Node* node) noexcept {
+        for (size_type i = 0; i < node->count; ++i) {
+            destroy_value(node->value(i));
+        }
+        if (!node->leaf) {
+            for (size_type i = 0; i <= node->count; ++i) {
+                destroy_subtree(child(node, i));
+            }
+        }
+        free_node(node);
+    }
+
+    // Exchanges everything but the allocators
+    void swap_nodes(BTree& other) noexcept {
+        using std::swap;
+        swap(m_root, other.m_root);
+        swap(m_size, other.m_size);
+        swap(m_comp, other.m_comp);
+    }
+
+    // Copies a subtree node by node; the values are moved out of source when SourceNode is not const
+    template <class SourceNode>
+    Node* clone(SourceNode* source, InternalNode* parent) {
+        Node* node = source->leaf ? new_leaf() : static_cast<Node*>(new_internal());
+        node->parent = parent;
+        node->position = source->position;
+
+        size_type children = 0;
+        try {
+            for (; node->count < source->count; ++node->count) {
+                if constexpr (std::is_const_v<SourceNode>) {
+                    construct_value(&node->value(node->count), source->value(node->count));
+                } else {
+                    construct_value(&node->value(node->count), std::move(source->value(node->count)));
+                }
+            }
+            if (!source->leaf) {
+                for (; children <= source->count; ++children) {
+                    static_cast<InternalNode*>(node)->children[children] =
+                        clone(child(source, children), static_cast<InternalNode*>(node));
+                }
+            }
+        } catch (...) {
+            for (size_type i = 0; i < node->count; ++i) {
+                destroy_value(node->value(i));
+            }
+            for (size_type i = 0; i < children; ++i) {
+                destroy_subtree(child(node, i));
+            }
+            free_node(node);
+            throw;
+        }
+        return node;
+    }
+
+    static void attach(InternalNode* parent, size_type index, Node* node) noexcept {
+        parent->children[index] = node;
+        node->parent = parent;
+        node->position = static_cast<std::uint16_t>(index);
+    }
+
+    Node* leftmost() const noexcept {
+        Node* node = m_root;
+        while (node && !node->leaf) {
+            node = child(node, 0);
+        }
+        return node;
+    }
+
+    // Element storage
+
+    template <class... Args>
+    void construct_value(value_type* slot, Args&&... args) {
+        std::allocator_traits<allocator_type>::construct(m_allocator, slot, std::forward<Args>(args)...);
+    }
+
+    void destroy_value(value_type& value) noexcept {
+        std::allocator_traits<allocator_type>::destroy(m_allocator, &value);
+    }
+
+    // Moves the element at from into the empty slot at to, leaving from empty
+    void move_value(value_type* from, value_type* to) noexcept {
+        if constexpr (is_trivially_relocatable_v<value_type>) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(value_type));
+        } else {
+            construct_value(to, Policy::transfer(*from));
+            destroy_value(*from);
+        }
+    }
+
+    // Moves count elements starting at from to the empty slots at to; the ranges may overlap
+    void move_values(value_type* from, value_type* to, size_type count) noexcept {
+        if (count == 0 || from == to) {
+            return;
+        }
+        if constexpr (is_trivially_relocatable_v<value_type>) {
+            std::memmove(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(value_type));
+        } else if (to < from) {
+            for (size_type i = 0; i < count; ++i) {
+                move_value(from + i, to + i);
+            }
+        } else {
+            for (size_type i = count; i > 0; --i) {
+                move_value(from + i - 1, to + i - 1);
+            }
+        }
+    }
+
+    // Removes the empty slot at index of node by shifting the elements behind it forward
+    void close_gap(Node* node, size_type index) noexcept {
+        move_values(&node->value(index + 1), &node->value(index), node->count - index - 1u);
+        --node->count;
+    }
+
+    // Moves children [first, first + count) of from to [dest, dest + count) of to
+    static void move_children(InternalNode* from, size_type first, InternalNode* to, size_type dest, size_type count) noexcept {
+        if (from == to && dest > first) {
+            for (size_type i = count; i > 0; --i) {
+                attach(to, dest + i - 1, from->children[first + i - 1]);
+            }
+        } else {
+            for (size_type i = 0; i < count; ++i) {
+                attach(to, dest + i, from->children[first + i]);
+            }
+        }
+    }
+
+    // Searching
+
+    // Keys cheap enough to compare that a node search should not branch on the comparisons, which it
+    // would mispredict half of the time. For keys behind a pointer, such as strings, speculating down
+    // a predicted branch loads the next key early and wins instead.
+    static constexpr bool branchless_search = std::is_arithmetic_v<key_type> || std::is_pointer_v<key_type>;
+
+    // First position in node whose key is not less than key
+    template <class K>
+    size_type lower_index(const Node* node, const K& key) const {
+        const value_type* values = node->values();
+        if constexpr (branchless_search) {
+            if (node->count == 0) {
+                return 0;
+            }
+            size_type base = 0;
+            for (size_type length = node->count; length > 1; length -= length / 2) {
+                base = m_comp(Policy::key(values[base + length / 2]), key) ? base + length / 2 : base;
+            }
+            return base + (m_comp(Policy::key(values[base]), key) ? 1 : 0);
+        } else {
+            size_type low = 0;
+            size_type high = node->count;
+            while (low < high) {
+                const size_type mid = (low + high) / 2;
+                if (m_comp(Policy::key(values[mid]), key)) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+            return low;
+        }
+    }
+
+    // First position in node whose key is greater than key
+    template <class K>
+    size_type upper_index(const Node* node, const K& key) const {
+        const value_type* values = node->values();
+        if constexpr (branchless_search) {
+            if (node->count == 0) {
+                return 0;
+            }
+            size_type base = 0;
+            for (size_type length = node->count; length > 1; length -= length / 2) {
+                base = m_comp(key, Policy::key(values[base + length / 2])) ? base : base + length / 2;
+            }
+            return base + (m_comp(key, Policy::key(values[base])) ? 0 : 1);
+        } else {
+            size_type low = 0;
+            size_type high = node->count;
+            while (low < high) {
+                const size_type mid = (low + high) / 2;
+                if (m_comp(key, Policy::key(values[mid]))) {
+                    high = mid;
+                } else {
+                    low = mid + 1;
+                }
+            }
+            return low;
+        }
+    }
+
+    // Turns a position past the end of a leaf into the separator it refers to
+    static std::pair<Node*, size_type> climb(Node* node, size_type position) noexcept {
+        while (node->parent && position == node->count) {
+            position = node->position;
+            node = node->parent;
+        }
+        return {node, position};
+    }
+
+    template <class K>
+    std::pair<Node*, size_type> lower_bound_position(const K& key) const {
+        Node* node = m_root;
+        if (!node) {
+            return {nullptr, 0};
+        }
+        while (true) {
+            const size_type position = lower_index(node, key);
+            if constexpr (!Multi) {
+                // Keys are unique, so an equal separator is the answer
+                if (position < node->count && !m_comp(key, Policy::key(node->value(position)))) {
+                    return {node, position};
+                }
+            }
+            if (node->leaf) {
+                return climb(node, position);
+            }
+            node = child(node, position);
+        }
+    }
+
+    template <class K>
+    std::pair<Node*, size_type> upper_bound_position(const K& key) const {
+        Node* node = m_root;
+        if (!node) {
+            return {nullptr, 0};
+        }
+        while (true) {
+            const size_type position = upper_index(node, key);
+            if (node->leaf) {
+                return climb(node, position);
+            }
+            node = child(node, position);
+        }
+    }
+
+    // Inserting
+
+    template <class... Args>
+    iterator insert_at(Node* node, size_type position, Args&&... args) {
+        // Build the element first: a throwing constructor leaves the tree untouched, and args may
+        // refer to elements that move while the tree makes room
+        Staged staged(m_allocator, std::forward<Args>(args)...);
+
+        if (node->count == node_values) {
+            constexpr size_type mid = node_values / 2;
+            Node* sibling = split(node);
+            if (position > mid) {
+                node = sibling;
+                position -= mid + 1;
+            }
+        }
+
+        move_values(&node->value(position), &node->value(position + 1), node->count - position);
+        construct_value(&node->value(position), Policy::transfer(staged.value()));
+        ++node->count;
+        ++m_size;
+        return iterator(node, position);
+    }
+
+    // Splits a full node in two around its middle element, which moves up into the parent. Splits
+    // full ancestors first. Returns the new right half.
+    Node* split(Node* node) {
+        Node* sibling = node->leaf ? new_leaf() : static_cast<Node*>(new_internal());
+        try {
+            if (node == m_root) {
+                InternalNode* root = new_internal();
+                attach(root, 0, node);
+                m_root = root;
+            } else if (node->parent->count == node_values) {
+                split(node->parent);
+            }
+        } catch (...) {
+            free_node(sibling);
+            throw;
+        }
+
+        constexpr size_type mid = node_values / 2;
+        const size_type moved = node->count - mid - 1u;
+        move_values(&node->value(mid + 1), &sibling->value(0), moved);
+        if (!node->leaf) {
+            move_children(static_cast<InternalNode*>(node), mid + 1, static_cast<InternalNode*>(sibling), 0, moved + 1);
+        }
+        sibling->count = static_cast<std::uint16_t>(moved);
+
+        InternalNode* parent = node->parent;
+        const size_type index = node->position;
+        move_values(&parent->value(index), &parent->value(index + 1), parent->count - index);
+        move_children(parent, index + 1, parent, index + 2, parent->count - index);
+        move_value(&node->value(mid), &parent->value(index));
+        attach(parent, index + 1, sibling);
+        ++parent->count;
+        node->count = static_cast<std::uint16_t>(mid);
+        return sibling;
+    }
+
+    // Erasing. Each step that moves elements between nodes also moves the tracked iterator, so erase
+    // can return the position of the element after the erased one.
+
+    static void track(iterator* tracked, const Node* from, size_type from_position, Node* to, size_type to_position) noexcept {
+        if (tracked && tracked->m_node == from && tracked->m_position == from_position) {
+            *tracked = iterator(to, to_position);
+        }
+    }
+
+    // Moves the last element of the left sibling of children[index] up into the parent and the
+    // separator down into the front of children[index]
+    void borrow_from_left(InternalNode* parent, size_type index, iterator* tracked) noexcept {
+        Node* node = parent->children[index];
+        Node* left = parent->children[index - 1];
+        const size_type left_count = left->count;
+
+        if (tracked && tracked->m_node == node) {
+            ++tracked->m_position;
+        } else {
+            track(tracked, parent, index - 1, node, 0);
+            track(tracked, left, left_count - 1, parent, index - 1);
+            track(tracked, left, left_count, node, 0);
+        }
+
+        move_values(&node->value(0), &node->value(1), node->count);
+        move_value(&parent->value(index - 1), &node->value(0));
+        move_value(&left->value(left_count - 1), &parent->value(index - 1));
+        if (!node->leaf) {
+            auto* inner = static_cast<InternalNode*>(node);
+            move_children(inner, 0, inner, 1, node->count + 1u);
+            attach(inner, 0, static_cast<InternalNode*>(left)->children[left_count]);
+        }
+        ++node->count;
+        --left->count;
+    }
+
+    // Moves the first element of the right sibling of children[index] up into the parent and the
+    // separator down onto the end of children[index]
+    void borrow_from_right(InternalNode* parent, size_type index, iterator* tracked) noexcept {
+        Node* node = parent->children[index];
+        Node* right = parent->children[index + 1];
+        const size_type node_count = node->count;
+
+        if (tracked && tracked->m_node == right && tracked->m_position > 0) {
+            --tracked->m_position;
+        } else {
+            track(tracked, parent, index, node, node_count);
+            track(tracked, right, 0, parent, index);
+        }
+
+        move_value(&parent->value(index), &node->value(node_count));
+        move_value(&right->value(0), &parent->value(index));
+        move_values(&right->value(1), &right->value(0), right->count - 1u);
+        if (!node->leaf) {
+            auto* inner = static_cast<InternalNode*>(node);
+            auto* right_inner = static_cast<InternalNode*>(right);
+            attach(inner, node_count + 1, right_inner->children[0]);
+            move_children(right_inner, 1, right_inner, 0, right->count);
+        }
+        ++node->count;
+        --right->count;
+    }
+
+    // Merges children[index + 1] and the separator between them into children[index]
+    void merge(InternalNode* parent, size_type index, iterator* tracked) noexcept {
+        Node* left = parent->children[index];
+        Node* right = parent->children[index + 1];
+        const size_type left_count = left->count;
+
+        if (tracked) {
+            if (tracked->m_node == right) {
+                *tracked = iterator(left, left_count + 1 + tracked->m_position);
+            } else if (tracked->m_node == parent && tracked->m_position > index) {
+                --tracked->m_position;
+            } else {
+                track(tracked, parent, index, left, left_count);
+            }
+        }
+
+        move_value(&parent->value(index), &left->value(left_count));
+        move_values(&right->value(0), &left->value(left_count + 1), right->count);
+        if (!left->leaf) {
+            move_children(static_cast<InternalNode*>(right), 0, static_cast<InternalNode*>(left), left_count + 1,
+                right->count + 1u);
+        }
+        left->count = static_cast<std::uint16_t>(left_count + 1 + right->count);
+
+        move_values(&parent->value(index + 1), &parent->value(index), parent->count - index - 1u);
+        move_children(parent, index + 2, parent, index + 1, parent->count - index - 1u);
+        --parent->count;
+        free_node(right);
+    }
+
+    // Restores the minimum fill of node and its ancestors after one of its elements was removed
+    void rebalance_after_erase(Node* node, iterator& tracked) noexcept {
+        while (node != m_root && node->count < min_values) {
+            InternalNode* parent = node->parent;
+            const size_type index = node->position;
+            if (index > 0 && parent->children[index - 1]->count > min_values) {
+                borrow_from_left(parent, index, &tracked);
+                return;
+            }
+            if (index < parent->count && parent->children[index + 1]->count > min_values) {
+                borrow_from_right(parent, index, &tracked);
+                return;
+            }
+            merge(parent, index > 0 ? index - 1 : index, &tracked);
+            node = parent;
+        }
+
+        if (m_root->count > 0) {
+            return;
+        }
+
+        // The root ran out of elements: the tree loses a level, or becomes empty
+        Node* old_root = m_root;
+        if (old_root->leaf) {
+            m_root = nullptr;
+            tracked = iterator(nullptr, 0);
+        } else {
+            m_root = child(old_root, 0);
+            m_root->parent = nullptr;
+            m_root->position = 0;
+            if (tracked.m_node == old_root) {
+                tracked = iterator(m_root, m_root->count);
+            }
+        }
+        free_node(old_root);
+    }
+};
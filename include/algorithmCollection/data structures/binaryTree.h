@@ -0,0 +1,837 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "allocatorPropagation.h"
+#include "dynamicArray.h"
+
+namespace tree_detail {
+    inline void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        static_cast<void>(address);
+#endif
+    }
+
+    // Positions in a complete binary tree of the given height: BFS indices count from 1 at the root,
+    // left child 2i, right child 2i + 1; ranks are the 0-based in-order positions.
+    inline std::size_t bfs_to_rank(std::size_t index, std::size_t height) noexcept {
+        const std::size_t depth = static_cast<std::size_t>(std::bit_width(index)) - 1;
+        const std::size_t within = index - (std::size_t{1} << depth);
+        return ((2 * within + 1) << (height - 1 - depth)) - 1;
+    }
+
+    inline std::size_t rank_to_bfs(std::size_t rank, std::size_t height) noexcept {
+        const std::size_t in_order = rank + 1;
+        const std::size_t above_leaves = static_cast<std::size_t>(std::countr_zero(in_order));
+        const std::size_t depth = height - 1 - above_leaves;
+        return (std::size_t{1} << depth) + (in_order >> (above_leaves + 1));
+    }
+}
+
+// Memory order of a StaticSearchTree
+enum class TreeLayout {
+    // Breadth-first order, the children of node i at 2i and 2i + 1. The first levels share cache
+    // lines and the descendants a few levels down are contiguous, so they can be prefetched.
+    Eytzinger,
+    // Recursive van Emde Boas order: the top half of the levels is stored first, then each subtree
+    // hanging below it, each laid out the same way. Every subtree of height h spans about 2^h
+    // nodes, so a search touches O(log_B n) blocks for any block size B.
+    VanEmdeBoas,
+};
+
+// Immutable sorted keys stored as an implicit balanced search tree, without child pointers: a
+// lookup descends a fixed number of levels with one branch-free comparison each instead of the
+// unpredictable halving of a binary search over the sorted array.
+// Lookups return ranks, the position of the result in sorted order, so payloads can live in a
+// separate array sorted like the keys; operator[] maps a rank back to its key.
+// The tree is padded to a complete tree with copies of the largest key, at most doubling storage.
+template <typename T, TreeLayout Layout = TreeLayout::Eytzinger, typename Compare = std::less<T>>
+class StaticSearchTree {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+
+    static constexpr TreeLayout layout_kind = Layout;
+
+    StaticSearchTree() = default;
+
+    // Builds the tree from a range sorted under comp, O(n). Throws std::invalid_argument if the range
+    // is not sorted.
+    template <std::input_iterator InputIt>
+    StaticSearchTree(InputIt first, InputIt last, const Compare& comp = Compare()) : m_comp(comp) {
+        DynamicArray<T> sorted;
+        for (; first != last; ++first) {
+            sorted.push_back(*first);
+        }
+        build(sorted.data());
+    }
+
+    explicit StaticSearchTree(std::span<const T> sorted, const Compare& comp = Compare()) : m_comp(comp) {
+        build(sorted);
+    }
+
+    StaticSearchTree(std::initializer_list<T> sorted, const Compare& comp = Compare())
+        : StaticSearchTree(std::span<const T>(sorted.begin(), sorted.size()), comp) {}
+
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    // Levels every lookup descends
+    size_type height() const noexcept { return m_height; }
+
+    // Rank of the first key not less than key, size() if there is none
+    template <class K>
+    size_type lower_bound(const K& key) const {
+        return descend(key, [this](const T& node, const K& probe) { return m_comp(node, probe); });
+    }
+
+    // Rank of the first key greater than key, size() if there is none
+    template <class K>
+    size_type upper_bound(const K& key) const {
+        return descend(key, [this](const T& node, const K& probe) { return !m_comp(probe, node); });
+    }
+
+    // Rank of a key equivalent to key, size() if there is none
+    template <class K>
+    size_type find(const K& key) const {
+        const size_type rank = lower_bound(key);
+        return rank != m_size && !m_comp(key, (*this)[rank]) ? rank : m_size;
+    }
+
+    template <class K>
+    bool contains(const K& key) const {
+        return find(key) != m_size;
+    }
+
+    // Key of the given rank
+    const T& operator[](size_type rank) const noexcept {
+        return m_nodes[slot_of(tree_detail::rank_to_bfs(rank, m_height))];
+    }
+
+    const T& at(size_type rank) const {
+        if (rank >= m_size) {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[rank];
+    }
+
+    // The keys in memory order, padding included
+    std::span<const T> layout() const noexcept { return m_nodes.data(); }
+
+private:
+    // Elements per cache line, how many descendants of a node four levels down share a line
+    static constexpr size_type line_values = sizeof(T) >= 64 ? 1 : 64 / sizeof(T);
+
+    DynamicArray<T> m_nodes;
+    size_type m_size = 0;
+    size_type m_height = 0;
+    [[no_unique_address]] Compare m_comp{};
+
+    // van Emde Boas position tables, indexed by depth (Brodal, Fagerberg and Jacob): a node at
+    // depth d roots one of the bottom trees of the recursion level that splits at d. Its top tree,
+    // rooted at depth m_top_depth[d], has m_top[d] nodes and each bottom tree m_bottom[d].
+    std::array<size_type, 64> m_top{};
+    std::array<size_type, 64> m_bottom{};
+    std::array<size_type, 64> m_top_depth{};
+
+    void build(std::span<const T> sorted) {
+        for (size_type i = 1; i < sorted.size(); ++i) {
+            if (m_comp(sorted[i], sorted[i - 1])) {
+                throw std::invalid_argument("Range is not sorted");
+            }
+        }
+        m_size = sorted.size();
+        m_height = static_cast<size_type>(std::bit_width(m_size));
+        if (m_size == 0) {
+            return;
+        }
+        const size_type slots = (size_type{1} << m_height) - 1;
+        if constexpr (Layout == TreeLayout::VanEmdeBoas) {
+            split_levels(0, m_height);
+        }
+
+        m_nodes.reserve(slots);
+        DynamicArray<size_type> bfs_of_slot;
+        if constexpr (Layout == TreeLayout::Eytzinger) {
+            for (size_type index = 1; index <= slots; ++index) {
+                m_nodes.push_back(key_of_rank(sorted, tree_detail::bfs_to_rank(index, m_height)));
+            }
+        } else {
+            // Position of every node in BFS order, computed from its ancestors like a lookup does
+            DynamicArray<size_type> slot_of_bfs(slots + 1);
+            bfs_of_slot.resize(slots);
+            for (size_type index = 1; index <= slots; ++index) {
+                const size_type depth = static_cast<size_type>(std::bit_width(index)) - 1;
+                size_type slot = 0;
+                if (depth > 0) {
+                    const size_type ancestor = index >> (depth - m_top_depth[depth]);
+                    slot = slot_of_bfs[ancestor] + m_top[depth] + (index & m_top[depth]) * m_bottom[depth];
+                }
+                slot_of_bfs[index] = slot;
+                bfs_of_slot[slot] = index;
+            }
+            for (size_type slot = 0; slot < slots; ++slot) {
+                m_nodes.push_back(key_of_rank(sorted, tree_detail::bfs_to_rank(bfs_of_slot[slot], m_height)));
+            }
+        }
+    }
+
+    static const T& key_of_rank(std::span<const T> sorted, size_type rank) noexcept {
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+
+    void split_levels(size_type top_depth, size_type levels) {
+        if (levels <= 1) {
+            return;
+        }
+        const size_type top_levels = levels / 2;
+        const size_type depth = top_depth + top_levels;
+        m_top[depth] = (size_type{1} << top_levels) - 1;
+        m_bottom[depth] = (size_type{1} << (levels - top_levels)) - 1;
+        m_top_depth[depth] = top_depth;
+        split_levels(top_depth, top_levels);
+        split_levels(depth, levels - top_levels);
+    }
+
+    // Memory slot of a BFS index; the van Emde Boas slot is recomputed along the root path
+    size_type slot_of(size_type index) const noexcept {
+        if constexpr (Layout == TreeLayout::Eytzinger) {
+            return index - 1;
+        } else {
+            const size_type depth = static_cast<size_type>(std::bit_width(index)) - 1;
+            size_type slots[64];
+            slots[0] = 0;
+            for (size_type d = 1; d <= depth; ++d) {
+                const size_type ancestor = index >> (depth - d);
+                slots[d] = slots[m_top_depth[d]] + m_top[d] + (ancestor & m_top[d]) * m_bottom[d];
+            }
+            return slots[depth];
+        }
+    }
+
+    // Walks all m_height levels, going right wherever go_right(node, key) holds. The last node the
+    // walk went left at is the result: strip the trailing right turns and that one left turn from
+    // the final index.
+    template <class K, class GoRight>
+    size_type descend(const K& key, GoRight go_right) const {
+        if (m_size == 0) {
+            return 0;
+        }
+        const T* nodes = m_nodes.begin();
+        size_type index = 1;
+        if constexpr (Layout == TreeLayout::Eytzinger) {
+            const size_type slots = m_nodes.size();
+            for (size_type level = 0; level < m_height; ++level) {
+                // The line holding this node's descendants log2(line_values) levels down
+                tree_detail::prefetch(nodes + std::min(index * line_values, slots) - 1);
+                index = 2 * index + static_cast<size_type>(go_right(nodes[index - 1], key));
+            }
+        } else {
+            size_type slots[64];
+            slots[0] = 0;
+            index = 2 + static_cast<size_type>(go_right(nodes[0], key));
+            for (size_type depth = 1; depth < m_height; ++depth) {
+                slots[depth] = slots[m_top_depth[depth]] + m_top[depth] + (index & m_top[depth]) * m_bottom[depth];
+                index = 2 * index + static_cast<size_type>(go_right(nodes[slots[depth]], key));
+            }
+        }
+        index >>= std::countr_one(index) + 1;
+        return index == 0 ? m_size : tree_detail::bfs_to_rank(index, m_height);
+    }
+};
+
+template <typename T>
+using EytzingerTree = StaticSearchTree<T, TreeLayout::Eytzinger>;
+
+template <typename T>
+using VanEmdeBoasTree = StaticSearchTree<T, TreeLayout::VanEmdeBoas>;
+
+// Ordered set on an AVL tree: one allocated node per element with parent and child pointers, for
+// sets that change too often to rebuild a StaticSearchTree. Subtree heights differ by at most one,
+// so the depth stays below 1.44 log2(n + 2).
+// Nodes never move, so iterators and references stay valid until their element is erased.
+template <typename T, typename Compare = std::less<T>, typename Alloc = SimpleAllocator<T>>
+class BinaryTree {
+    struct Node;
+
+public:
+    using key_type = T;
+    using value_type = T;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+
+private:
+    struct NodeBase {
+        NodeBase* parent;
+        NodeBase* left;
+        NodeBase* right;
+        // Height of the subtree, 1 for a leaf; 0 marks the header
+        int height;
+    };
+
+    struct Node : NodeBase {
+        T value;
+
+        // Allocators doing uses-allocator construction (PolymorphicAllocator) pass themselves on to
+        // the element through the allocator_arg_t constructor
+        using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+
+        template <class... Args>
+        explicit Node(std::in_place_t, Args&&... args)
+            : NodeBase{nullptr, nullptr, nullptr, 1}, value(std::forward<Args>(args)...) {}
+
+        template <class... Args>
+        Node(std::allocator_arg_t, const allocator_type& alloc, std::in_place_t, Args&&... args)
+            : NodeBase{nullptr, nullptr, nullptr, 1}, value(std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...)) {}
+    };
+
+public:
+    // In-order iterator; elements are keys, so they are never mutable
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return static_cast<const Node*>(m_node)->value; }
+        pointer operator->() const { return &static_cast<const Node*>(m_node)->value; }
+
+        const_iterator& operator++() {
+            m_node = BinaryTree::next(m_node);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        const_iterator& operator--() {
+            m_node = BinaryTree::previous(m_node);
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator temp(*this);
+            --*this;
+            return temp;
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) { return lhs.m_node == rhs.m_node; }
+
+    private:
+        friend class BinaryTree;
+
+        explicit const_iterator(const NodeBase* node) : m_node(node) {}
+
+        const NodeBase* m_node = nullptr;
+    };
+
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using reverse_iterator = const_reverse_iterator;
+
+    BinaryTree() { reset_header(); }
+
+    explicit BinaryTree(const Compare& comp, const Alloc& alloc = Alloc()) : m_comp(comp), m_allocator(alloc) {
+        reset_header();
+    }
+
+    BinaryTree(std::initializer_list<T> values) : BinaryTree() {
+        for (const T& value : values) {
+            insert(value);
+        }
+    }
+
+    BinaryTree(const BinaryTree& other)
+        : BinaryTree(other, propagation_detail::select_on_copy(other.m_allocator)) {}
+
+    BinaryTree(const BinaryTree& other, const allocator_type& alloc) : m_comp(other.m_comp), m_allocator(alloc) {
+        reset_header();
+        copy_from(other);
+    }
+
+    BinaryTree(BinaryTree&& other) noexcept : m_comp(std::move(other.m_comp)), m_allocator(std::move(other.m_allocator)) {
+        reset_header();
+        steal(other);
+    }
+
+    // Takes over the nodes of other if `alloc` equals its allocator, otherwise moves the elements
+    // into new nodes of the same shape and clears other
+    BinaryTree(BinaryTree&& other, const allocator_type& alloc) : m_comp(other.m_comp), m_allocator(alloc) {
+        reset_header();
+        if (propagation_detail::equal(m_allocator, other.m_allocator)) {
+            steal(other);
+        } else {
+            copy_from(other);
+            other.clear();
+        }
+    }
+
+    ~BinaryTree() { clear(); }
+
+    // Keeps this tree's allocator unless it propagates on copy assignment
+    BinaryTree& operator=(const BinaryTree& other) {
+        if (this != &other) {
+            BinaryTree copy(other, propagation_detail::copy_assignment_allocator(m_allocator, other.m_allocator));
+            swap_nodes(copy);
+            propagation_detail::swap_on_copy_assignment(m_allocator, copy.m_allocator);
+        }
+        return *this;
+    }
+
+    // Takes over the nodes of other when the allocator propagates on move assignment or both
+    // allocators are equal; otherwise other's elements are moved into new nodes
+    BinaryTree& operator=(BinaryTree&& other) noexcept(propagation_detail::move_steals_storage_v<allocator_type>) {
+        if (this != &other) {
+            if constexpr (!propagation_detail::move_steals_storage_v<allocator_type>) {
+                if (!propagation_detail::equal(m_allocator, other.m_allocator)) {
+                    BinaryTree moved(std::move(other), m_allocator);
+                    swap_nodes(moved);
+                    return *this;
+                }
+            }
+            clear();
+            m_comp = std::move(other.m_comp);
+            propagation_detail::move_assign(m_allocator, other.m_allocator);
+            steal(other);
+        }
+        return *this;
+    }
+
+    const_iterator begin() const noexcept { return const_iterator(m_header.left); }
+    const_iterator end() const noexcept { return const_iterator(&m_header); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    // Levels of the tree, 0 when empty
+    size_type height() const noexcept { return m_header.parent == nullptr ? 0 : static_cast<size_type>(m_header.parent->height); }
+
+    std::pair<iterator, bool> insert(const T& value) { return emplace(value); }
+    std::pair<iterator, bool> insert(T&& value) { return emplace(std::move(value)); }
+
+    // Inserts the element if no equivalent one is present. Returns its position and whether it
+    // was inserted.
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        Node* node = create_node(std::forward<Args>(args)...);
+        NodeBase* parent = &m_header;
+        NodeBase* current = m_header.parent;
+        bool left = true;
+        while (current != nullptr) {
+            parent = current;
+            if (m_comp(node->value, value_of(current))) {
+                current = current->left;
+                left = true;
+            } else if (m_comp(value_of(current), node->value)) {
+                current = current->right;
+                left = false;
+            } else {
+                destroy_node(node);
+                return {iterator(current), false};
+            }
+        }
+
+        node->parent = parent;
+        if (parent == &m_header) {
+            m_header.parent = node;
+            m_header.left = node;
+            m_header.right = node;
+        } else if (left) {
+            parent->left = node;
+            if (parent == m_header.left) {
+                m_header.left = node;
+            }
+        } else {
+            parent->right = node;
+            if (parent == m_header.right) {
+                m_header.right = node;
+            }
+        }
+        ++m_size;
+        retrace(parent);
+        return {iterator(node), true};
+    }
+
+    // Removes the element at pos and returns the position after it
+    iterator erase(const_iterator pos) {
+        NodeBase* node = const_cast<NodeBase*>(pos.m_node);
+        NodeBase* following = next(node);
+        if (m_header.left == node) {
+            m_header.left = following;
+        }
+        if (m_header.right == node) {
+            m_header.right = previous(node);
+        }
+
+        NodeBase* retrace_from;
+        if (node->left == nullptr || node->right == nullptr) {
+            NodeBase* child = node->left != nullptr ? node->left : node->right;
+            if (child != nullptr) {
+                child->parent = node->parent;
+            }
+            replace_child(node->parent, node, child);
+            retrace_from = node->parent;
+        } else {
+            // The successor has no left child; it takes node's place
+            NodeBase* successor = following;
+            if (successor->parent != node) {
+                NodeBase* successor_parent = successor->parent;
+                successor_parent->left = successor->right;
+                if (successor->right != nullptr) {
+                    successor->right->parent = successor_parent;
+                }
+                successor->right = node->right;
+                node->right->parent = successor;
+                retrace_from = successor_parent;
+            } else {
+                retrace_from = successor;
+            }
+            successor->left = node->left;
+            node->left->parent = successor;
+            successor->parent = node->parent;
+            successor->height = node->height;
+            replace_child(node->parent, node, successor);
+        }
+
+        destroy_node(static_cast<Node*>(node));
+        --m_size;
+        if (m_size == 0) {
+            reset_header();
+        } else {
+            retrace(retrace_from);
+        }
+        return iterator(following);
+    }
+
+    // Removes the element equivalent to key, returns how many were removed
+    template <class K>
+    size_type erase(const K& key) {
+        const const_iterator it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    template <class K>
+    const_iterator find(const K& key) const {
+        const const_iterator it = lower_bound(key);
+        return it != end() && !m_comp(key, *it) ? it : end();
+    }
+
+    template <class K>
+    bool contains(const K& key) const {
+        return find(key) != end();
+    }
+
+    // First element not less than key
+    template <class K>
+    const_iterator lower_bound(const K& key) const {
+        const NodeBase* result = &m_header;
+        const NodeBase* current = m_header.parent;
+        while (current != nullptr) {
+            if (!m_comp(value_of(current), key)) {
+                result = current;
+                current = current->left;
+            } else {
+                current = current->right;
+            }
+        }
+        return const_iterator(result);
+    }
+
+    // First element greater than key
+    template <class K>
+    const_iterator upper_bound(const K& key) const {
+        const NodeBase* result = &m_header;
+        const NodeBase* current = m_header.parent;
+        while (current != nullptr) {
+            if (m_comp(key, value_of(current))) {
+                result = current;
+                current = current->left;
+            } else {
+                current = current->right;
+            }
+        }
+        return const_iterator(result);
+    }
+
+    void clear() noexcept {
+        destroy_subtree(m_header.parent);
+        m_size = 0;
+        reset_header();
+    }
+
+    // Allocators are swapped only if they propagate on swap; otherwise they must be equal
+    void swap(BinaryTree& other) noexcept {
+        swap_nodes(other);
+        propagation_detail::swap_on_swap(m_allocator, other.m_allocator);
+    }
+
+    friend void swap(BinaryTree& lhs, BinaryTree& rhs) noexcept { lhs.swap(rhs); }
+
+    friend bool operator==(const BinaryTree& lhs, const BinaryTree& rhs) {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+private:
+    // parent is the root, left and right the first and last element; an empty tree points left and
+    // right back at the header so begin() == end()
+    NodeBase m_header{nullptr, nullptr, nullptr, 0};
+    size_type m_size = 0;
+    [[no_unique_address]] Compare m_comp{};
+    [[no_unique_address]] allocator_type m_allocator{};
+
+    static const T& value_of(const NodeBase* node) noexcept { return static_cast<const Node*>(node)->value; }
+
+    static int height_of(const NodeBase* node) noexcept { return node == nullptr ? 0 : node->height; }
+
+    static void update_height(NodeBase* node) noexcept {
+        node->height = 1 + std::max(height_of(node->left), height_of(node->right));
+    }
+
+    template <class NodePtr>
+    static NodePtr next(NodePtr node) noexcept {
+        if (node->right != nullptr) {
+            node = node->right;
+            while (node->left != nullptr) {
+                node = node->left;
+            }
+            return node;
+        }
+        NodePtr parent = node->parent;
+        while (parent->height != 0 && node == parent->right) {
+            node = parent;
+            parent = parent->parent;
+        }
+        return parent;
+    }
+
+    template <class NodePtr>
+    static NodePtr previous(NodePtr node) noexcept {
+        if (node->height == 0) {
+            return node->right;
+        }
+        if (node->left != nullptr) {
+            node = node->left;
+            while (node->right != nullptr) {
+                node = node->right;
+            }
+            return node;
+        }
+        NodePtr parent = node->parent;
+        while (parent->height != 0 && node == parent->left) {
+            node = parent;
+            parent = parent->parent;
+        }
+        return parent;
+    }
+
+    void reset_header() noexcept {
+        m_header.parent = nullptr;
+        m_header.left = &m_header;
+        m_header.right = &m_header;
+    }
+
+    void replace_child(NodeBase* parent, NodeBase* old_child, NodeBase* new_child) noexcept {
+        if (parent == &m_header) {
+            m_header.parent = new_child;
+        } else if (parent->left == old_child) {
+            parent->left = new_child;
+        } else {
+            parent->right = new_child;
+        }
+    }
+
+    NodeBase* rotate_left(NodeBase* node) noexcept {
+        NodeBase* pivot = node->right;
+        node->right = pivot->left;
+        if (pivot->left != nullptr) {
+            pivot->left->parent = node;
+        }
+        pivot->parent = node->parent;
+        replace_child(node->parent, node, pivot);
+        pivot->left = node;
+        node->parent = pivot;
+        update_height(node);
+        update_height(pivot);
+        return pivot;
+    }
+
+    NodeBase* rotate_right(NodeBase* node) noexcept {
+        NodeBase* pivot = node->left;
+        node->left = pivot->right;
+        if (pivot->right != nullptr) {
+            pivot->right->parent = node;
+        }
+        pivot->parent = node->parent;
+        replace_child(node->parent, node, pivot);
+        pivot->right = node;
+        node->parent = pivot;
+        update_height(node);
+        update_height(pivot);
+        return pivot;
+    }
+
+    // Restores the AVL balance at node with one or two rotations; returns the subtree's new root
+    NodeBase* rebalance(NodeBase* node) noexcept {
+        const int balance = height_of(node->left) - height_of(node->right);
+        if (balance > 1) {
+            if (height_of(node->left->left) < height_of(node->left->right)) {
+                rotate_left(node->left);
+            }
+            return rotate_right(node);
+        }
+        if (balance < -1) {
+            if (height_of(node->right->right) < height_of(node->right->left)) {
+                rotate_right(node->right);
+            }
+            return rotate_left(node);
+        }
+        update_height(node);
+        return node;
+    }
+
+    // Rebalances from node up to the root, stopping once a subtree's height is unchanged
+    void retrace(NodeBase* node) noexcept {
+        while (node != &m_header) {
+            const int before = node->height;
+            NodeBase* top = rebalance(node);
+            if (top == node && top->height == before) {
+                return;
+            }
+            node = top->parent;
+        }
+    }
+
+    template <class... Args>
+    Node* create_node(Args&&... args) {
+        Node* node = std::allocator_traits<allocator_type>::allocate(m_allocator, 1);
+        try {
+            std::allocator_traits<allocator_type>::construct(m_allocator, node, std::in_place, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator_traits<allocator_type>::deallocate(m_allocator, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroy_node(Node* node) noexcept {
+        std::allocator_traits<allocator_type>::destroy(m_allocator, node);
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, node, 1);
+    }
+
+    void destroy_subtree(NodeBase* node) noexcept {
+        while (node != nullptr) {
+            destroy_subtree(node->right);
+            NodeBase* left = node->left;
+            destroy_node(static_cast<Node*>(node));
+            node = left;
+        }
+    }
+
+    // Exchanges the nodes and comparators, re-pointing the roots at their new headers
+    void swap_nodes(BinaryTree& other) noexcept {
+        using std::swap;
+        swap(m_header, other.m_header);
+        swap(m_size, other.m_size);
+        swap(m_comp, other.m_comp);
+        relink_header();
+        other.relink_header();
+    }
+
+    void relink_header() noexcept {
+        if (m_header.parent == nullptr) {
+            reset_header();
+        } else {
+            m_header.parent->parent = &m_header;
+        }
+    }
+
+    // Copies the shape of other's tree node by node, O(n) without comparisons; the elements are
+    // moved out of other when Source is not const
+    template <class Source>
+    void copy_from(Source& other) {
+        if (other.m_header.parent == nullptr) {
+            return;
+        }
+        try {
+            using SourceNode = std::conditional_t<std::is_const_v<Source>, const NodeBase, NodeBase>;
+            m_header.parent = clone(static_cast<SourceNode*>(other.m_header.parent), &m_header);
+        } catch (...) {
+            clear();
+            throw;
+        }
+        m_size = other.m_size;
+        NodeBase* first = m_header.parent;
+        while (first->left != nullptr) {
+            first = first->left;
+        }
+        NodeBase* last = m_header.parent;
+        while (last->right != nullptr) {
+            last = last->right;
+        }
+        m_header.left = first;
+        m_header.right = last;
+    }
+
+    // Links each clone into place as soon as it exists, so a throw leaves a tree clear() can free
+    template <class SourceNode>
+    NodeBase* clone(SourceNode* source, NodeBase* parent) {
+        Node* copy;
+        if constexpr (std::is_const_v<SourceNode>) {
+            copy = create_node(value_of(source));
+        } else {
+            copy = create_node(std::move(static_cast<Node*>(source)->value));
+        }
+        copy->parent = parent;
+        copy->height = source->height;
+        if (parent == &m_header) {
+            m_header.parent = copy;
+        }
+        if (source->left != nullptr) {
+            copy->left = clone(static_cast<SourceNode*>(source->left), copy);
+        }
+        if (source->right != nullptr) {
+            copy->right = clone(static_cast<SourceNode*>(source->right), copy);
+        }
+        return copy;
+    }
+
+    void steal(BinaryTree& other) noexcept {
+        if (other.m_header.parent == nullptr) {
+            return;
+        }
+        m_header = other.m_header;
+        m_header.parent->parent = &m_header;
+        m_size = other.m_size;
+        other.m_size = 0;
+        other.reset_header();
+    }
+};
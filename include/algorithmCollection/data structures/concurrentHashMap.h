@@ -0,0 +1,271 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "hash_map.h"
+
+// Hash map shared by many threads, split into Shards independent HashMaps with a reader-writer lock
+// each. The top bits of a key's hash pick its shard, so threads working on different keys rarely
+// meet on one lock, and any number of threads look up keys of the same shard at once. Shards sit on
+// cache lines of their own, so writes to one shard do not slow down readers of its neighbours.
+// Elements never leave their shard's lock: lookups return copies or run a callback on the element
+// while the lock is held. Callbacks must not call back into the map. Operations on the whole map
+// (size, clear, for_each) visit the shards one after the other and see no single point in time.
+// The allocator is called from several threads at once, so it must be thread safe.
+// Lookups accept any key type when both Hash and Eq declare is_transparent.
+template <typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>,
+    typename Alloc = SimpleAllocator<std::pair<const K, V>>, std::size_t Shards = 64>
+class ConcurrentHashMap {
+    static_assert(std::has_single_bit(Shards), "ConcurrentHashMap shard count must be a power of two");
+
+    static constexpr bool is_transparent = requires {
+        typename Hash::is_transparent;
+        typename Eq::is_transparent;
+    };
+
+    template <class Key>
+    using key_arg = typename hash_detail::KeyArg<is_transparent>::template type<Key, K>;
+
+    using map_type = HashMap<K, V, Hash, Eq, Alloc>;
+
+    struct alignas(64) Shard {
+        Shard() = default;
+
+        Shard(const Hash& hash, const Eq& eq, const typename map_type::allocator_type& alloc)
+            : map(0, hash, eq, alloc) {}
+
+        mutable std::shared_mutex mutex;
+        map_type map;
+    };
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = Eq;
+    using allocator_type = typename map_type::allocator_type;
+
+    static constexpr size_type shard_count = Shards;
+
+    ConcurrentHashMap() = default;
+
+    explicit ConcurrentHashMap(const Hash& hash, const Eq& eq = Eq(), const allocator_type& alloc = allocator_type())
+        : m_shards(make_shards(hash, eq, alloc, std::make_index_sequence<Shards>())), m_hash(hash) {}
+
+    explicit ConcurrentHashMap(const allocator_type& alloc)
+        : ConcurrentHashMap(Hash(), Eq(), alloc) {}
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    // Returns a copy of the value stored under key
+    template <class Key = key_type>
+    std::optional<V> find(const key_arg<Key>& key) const {
+        const Shard& shard = shard_of(key);
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    template <class Key = key_type>
+    bool contains(const key_arg<Key>& key) const {
+        const Shard& shard = shard_of(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.map.contains(key);
+    }
+
+    // Calls f(const V&) on the value stored under key while readers of its shard hold the lock;
+    // returns whether the key was found
+    template <class Key = key_type, class F>
+    bool visit(const key_arg<Key>& key, F&& f) const {
+        const Shard& shard = shard_of(key);
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return false;
+        }
+        std::invoke(std::forward<F>(f), std::as_const(it->second));
+        return true;
+    }
+
+    // Calls f(V&) on the value stored under key with its shard locked exclusively; returns whether
+    // the key was found
+    template <class Key = key_type, class F>
+    bool update(const key_arg<Key>& key, F&& f) {
+        Shard& shard = shard_of(key);
+        std::unique_lock lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return false;
+        }
+        std::invoke(std::forward<F>(f), it->second);
+        return true;
+    }
+
+    // Inserts a value constructed from args under key if the key is not present yet; returns
+    // whether it was inserted. Nothing is constructed when the key is present.
+    template <class... Args>
+    bool try_emplace(const key_type& key, Args&&... args) {
+        Shard& shard = shard_of(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+    }
+
+    template <class... Args>
+    bool try_emplace(key_type&& key, Args&&... args) {
+        Shard& shard = shard_of(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.try_emplace(std::move(key), std::forward<Args>(args)...).second;
+    }
+
+    // Assigns value to the element with key, inserting it if the key is not present yet; returns
+    // whether it was inserted
+    template <class M>
+    bool insert_or_assign(const key_type& key, M&& value) {
+        Shard& shard = shard_of(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.insert_or_assign(key, std::forward<M>(value)).second;
+    }
+
+    template <class M>
+    bool insert_or_assign(key_type&& key, M&& value) {
+        Shard& shard = shard_of(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.insert_or_assign(std::move(key), std::forward<M>(value)).second;
+    }
+
+    // Returns a copy of the value stored under key, first storing make() there if the key is not
+    // present. Present keys only take the shared lock. make runs with the shard locked exclusively,
+    // so it is called at most once per key however many threads ask for it at the same time.
+    template <class F>
+    V compute_if_absent(const key_type& key, F&& make) {
+        Shard& shard = shard_of(key);
+        {
+            std::shared_lock lock(shard.mutex);
+            auto it = shard.map.find(key);
+            if (it != shard.map.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            it = shard.map.try_emplace(key, std::invoke(std::forward<F>(make))).first;
+        }
+        return it->second;
+    }
+
+    // Removes the element with key; returns the number of elements removed
+    template <class Key = key_type>
+    size_type erase(const key_arg<Key>& key) {
+        Shard& shard = shard_of(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.erase(key);
+    }
+
+    // Removes every element for which pred(const value_type&) is true, one shard at a time
+    template <class Pred>
+    size_type erase_if(Pred pred) {
+        size_type removed = 0;
+        for (Shard& shard : m_shards) {
+            std::unique_lock lock(shard.mutex);
+            for (auto it = shard.map.begin(); it != shard.map.end();) {
+                if (pred(std::as_const(*it))) {
+                    it = shard.map.erase(it);
+                    ++removed;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        return removed;
+    }
+
+    // Calls f(const value_type&) on every element, holding one shard's shared lock at a time
+    template <class F>
+    void for_each(F f) const {
+        for (const Shard& shard : m_shards) {
+            std::shared_lock lock(shard.mutex);
+            for (const value_type& value : shard.map) {
+                f(value);
+            }
+        }
+    }
+
+    // Sum of the shard sizes, each read under its lock; may be stale while other threads write
+    size_type size() const {
+        size_type total = 0;
+        for (const Shard& shard : m_shards) {
+            std::shared_lock lock(shard.mutex);
+            total += shard.map.size();
+        }
+        return total;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    void clear() {
+        for (Shard& shard : m_shards) {
+            std::unique_lock lock(shard.mutex);
+            shard.map.clear();
+        }
+    }
+
+    // Makes room for count elements spread evenly over the shards, with some slack for imbalance
+    void reserve(size_type count) {
+        const size_type per_shard = count / Shards + count / (Shards * 8) + 1;
+        for (Shard& shard : m_shards) {
+            std::unique_lock lock(shard.mutex);
+            shard.map.reserve(per_shard);
+        }
+    }
+
+    // Shard of a key, stable for the lifetime of the map
+    template <class Key = key_type>
+    size_type shard_index(const key_arg<Key>& key) const {
+        if constexpr (Shards == 1) {
+            return 0;
+        } else {
+            constexpr int shift = std::numeric_limits<size_type>::digits - std::countr_zero(Shards);
+            return hash_detail::mix(static_cast<size_type>(m_hash(key))) >> shift;
+        }
+    }
+
+    hasher hash_function() const { return m_hash; }
+
+    allocator_type get_allocator() const { return m_shards[0].map.get_allocator(); }
+
+private:
+    std::array<Shard, Shards> m_shards;
+    [[no_unique_address]] Hash m_hash{};
+
+    template <std::size_t... I>
+    static std::array<Shard, Shards> make_shards(const Hash& hash, const Eq& eq, const allocator_type& alloc,
+        std::index_sequence<I...>) {
+        return {((void)I, Shard(hash, eq, alloc))...};
+    }
+
+    template <class Key>
+    Shard& shard_of(const Key& key) {
+        return m_shards[shard_index<Key>(key)];
+    }
+
+    template <class Key>
+    const Shard& shard_of(const Key& key) const {
+        return m_shards[shard_index<Key>(key)];
+    }
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+// Opt-in counters of the storage events of DynamicArray and SmallDynamicArray: how often a
+// container type grew or shrank its buffer, how many of those resizes the allocator's reallocate()
+// served, and how many elements were relocated to a new buffer.
+// Defining ALGORITHM_COLLECTION_CONTAINER_STATS before the first include turns them on; without it
+// the recording compiles away. Define it for the whole program, not per translation unit.
+#ifdef ALGORITHM_COLLECTION_CONTAINER_STATS
+constexpr bool container_stats_enabled = true;
+#else
+constexpr bool container_stats_enabled = false;
+#endif
+
+// Counters shared by every container of one type, thread safe
+class ContainerStats {
+public:
+    ContainerStats() = default;
+    ContainerStats(const ContainerStats&) = delete;
+    ContainerStats& operator=(const ContainerStats&) = delete;
+
+    // Buffer reallocations to a larger capacity, by insertions, resize or reserve
+    std::size_t grows() const noexcept { return m_grows.load(std::memory_order_relaxed); }
+
+    // Buffer reallocations to a smaller capacity, by shrink_to_fit, shrink_to or the shrink policy
+    std::size_t shrinks() const noexcept { return m_shrinks.load(std::memory_order_relaxed); }
+
+    // Grows and shrinks served by the allocator's reallocate() instead of a new buffer; the bytes
+    // realloc may move are not counted as relocated elements
+    std::size_t in_place_resizes() const noexcept { return m_in_place.load(std::memory_order_relaxed); }
+
+    // Elements moved from an old buffer to a new one
+    std::size_t relocated_elements() const noexcept { return m_relocated.load(std::memory_order_relaxed); }
+
+    void reset() noexcept {
+        m_grows.store(0, std::memory_order_relaxed);
+        m_shrinks.store(0, std::memory_order_relaxed);
+        m_in_place.store(0, std::memory_order_relaxed);
+        m_relocated.store(0, std::memory_order_relaxed);
+    }
+
+    void record_resize(std::size_t old_capacity, std::size_t new_capacity, std::size_t relocated, bool in_place) noexcept {
+        (new_capacity > old_capacity ? m_grows : m_shrinks).fetch_add(1, std::memory_order_relaxed);
+        if (in_place) {
+            m_in_place.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_relocated.fetch_add(relocated, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::size_t> m_grows{0};
+    std::atomic<std::size_t> m_shrinks{0};
+    std::atomic<std::size_t> m_in_place{0};
+    std::atomic<std::size_t> m_relocated{0};
+};
+
+// Counters of one container type, e.g. container_stats<DynamicArray<int>>(); they stay zero unless
+// ALGORITHM_COLLECTION_CONTAINER_STATS is defined
+template <typename Container>
+ContainerStats& container_stats() noexcept {
+    static ContainerStats stats;
+    return stats;
+}
+
+namespace container_stats_detail {
+template <typename Container>
+constexpr void record_resize(std::size_t old_capacity, std::size_t new_capacity, std::size_t relocated, bool in_place) noexcept {
+    if constexpr (container_stats_enabled) {
+        if (!std::is_constant_evaluated()) {
+            container_stats<Container>().record_resize(old_capacity, new_capacity, relocated, in_place);
+        }
+    }
+}
+}
@@ -0,0 +1,710 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "allocatorPropagation.h"
+
+// Double-ended queue stored in fixed-size blocks.
+// A ring buffer of block pointers (the map) lists the blocks in order, so pushing onto either end
+// is amortized O(1): it fills the end block, takes a fresh block when that is full and only
+// doubles the map, copying block pointers but no elements, when the ring runs out of slots.
+// Elements never move, so pushing and popping at the ends keeps references to the other elements
+// valid. Iterators are invalidated by pushes, as with std::deque, but stay valid across pops of
+// other elements. Random access is one map lookup.
+// A block emptied by popping is kept as a spare for the next push, so a deque used as a FIFO stops
+// allocating once it has reached its working size.
+template <typename T, typename Alloc = SimpleAllocator<T>, std::size_t BlockBytes = 4096>
+class Deque {
+    template <bool Const>
+    class Iterator;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Elements per block: a power of two filling BlockBytes, at least 16
+    static constexpr size_type block_size = std::max<size_type>(std::bit_floor(BlockBytes / sizeof(T)), 16);
+
+private:
+    static constexpr size_type block_shift = std::countr_zero(block_size);
+    static constexpr size_type min_map_capacity = 8;
+
+    using map_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T*>;
+
+    template <bool Const>
+    class Iterator {
+        using deque_pointer = std::conditional_t<Const, const Deque*, Deque*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+
+        // Non-const to const conversion
+        template <bool OtherConst> requires (Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : m_current(other.m_current), m_first(other.m_first), m_block(other.m_block), m_deque(other.m_deque) {}
+
+        reference operator*() const noexcept { return *m_current; }
+        pointer operator->() const noexcept { return m_current; }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        Iterator& operator++() noexcept {
+            if (++m_current == m_first + block_size) {
+                // The end position on a block boundary has no block: it is represented by null
+                // pointers, so comparing iterators only compares m_current
+                ++m_block;
+                const size_type index = block_index();
+                m_first = index < m_deque->m_blocks ? m_deque->block(index) : nullptr;
+                m_current = m_first;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        Iterator& operator--() noexcept {
+            if (m_current == m_first) {
+                --m_block;
+                m_first = m_deque->block(block_index());
+                m_current = m_first + block_size;
+            }
+            --m_current;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator temp(*this);
+            --*this;
+            return temp;
+        }
+
+        Iterator& operator+=(difference_type n) noexcept {
+            const auto offset = static_cast<difference_type>(m_current - m_first) + n;
+            if (m_first && offset >= 0 && offset < static_cast<difference_type>(block_size)) {
+                m_current = m_first + offset;
+            } else {
+                *this = m_deque->template iterator_at<Const>(static_cast<size_type>(position() + n));
+            }
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n) noexcept { return *this += -n; }
+
+        friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+        friend Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; }
+        friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.position() - rhs.position();
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.m_current == rhs.m_current;
+        }
+
+        friend std::strong_ordering operator<=>(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.position() <=> rhs.position();
+        }
+
+    private:
+        friend class Deque;
+        friend class Iterator<true>;
+
+        Iterator(pointer current, pointer first, size_type block, deque_pointer deque) noexcept
+            : m_current(current), m_first(first), m_block(block), m_deque(deque) {}
+
+        // Index of the block in the deque's current blocks
+        size_type block_index() const noexcept { return m_block - m_deque->m_first_block; }
+
+        // Position counted from the start of the first block
+        difference_type position() const noexcept {
+            return static_cast<difference_type>(block_index() * block_size) + (m_current - m_first);
+        }
+
+        pointer m_current = nullptr;
+        pointer m_first = nullptr;
+        size_type m_block = 0; // Block number, see m_first_block
+
+        deque_pointer m_deque = nullptr;
+    };
+
+public:
+    Deque() = default;
+
+    // Creates an empty deque drawing its storage from `alloc`
+    explicit Deque(const allocator_type& alloc) : m_allocator(alloc) {}
+
+    explicit Deque(size_type count, const allocator_type& alloc = allocator_type()) : m_allocator(alloc) {
+        guarded([&] { resize(count); });
+    }
+
+    Deque(size_type count, const T& value, const allocator_type& alloc = allocator_type()) : m_allocator(alloc) {
+        guarded([&] { resize(count, value); });
+    }
+
+    template <std::input_iterator InputIt>
+    Deque(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : m_allocator(alloc) {
+        guarded([&] { append(first, last); });
+    }
+
+    Deque(std::initializer_list<T> values, const allocator_type& alloc = allocator_type())
+        : Deque(values.begin(), values.end(), alloc) {}
+
+    Deque(const Deque& other)
+        : Deque(other, propagation_detail::select_on_copy(other.m_allocator)) {}
+
+    Deque(const Deque& other, const allocator_type& alloc) : m_allocator(alloc) {
+        guarded([&] { append(other.begin(), other.end()); });
+    }
+
+    Deque(Deque&& other) noexcept
+        : m_map(std::exchange(other.m_map, nullptr)),
+          m_map_capacity(std::exchange(other.m_map_capacity, 0)),
+          m_map_head(std::exchange(other.m_map_head, 0)),
+          m_blocks(std::exchange(other.m_blocks, 0)),
+          m_first_block(std::exchange(other.m_first_block, 0)),
+          m_offset(std::exchange(other.m_offset, 0)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_spare(std::exchange(other.m_spare, nullptr)),
+          m_cursors(std::exchange(other.m_cursors, Cursors{})),
+          m_allocator(std::move(other.m_allocator)) {}
+
+    // Takes over the storage of other if `alloc` equals its allocator, otherwise moves the elements
+    Deque(Deque&& other, const allocator_type& alloc) : m_allocator(alloc) {
+        if (propagation_detail::equal(m_allocator, other.m_allocator)) {
+            swap_storage(other);
+        } else {
+            guarded([&] { append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())); });
+        }
+    }
+
+    ~Deque() {
+        release_storage();
+    }
+
+    // Keeps this deque's allocator unless it propagates on copy assignment
+    Deque& operator=(const Deque& other) {
+        if (this != &other) {
+            Deque copy(other, propagation_detail::copy_assignment_allocator(m_allocator, other.m_allocator));
+            swap_storage(copy);
+            propagation_detail::swap_on_copy_assignment(m_allocator, copy.m_allocator);
+        }
+        return *this;
+    }
+
+    // Takes over the storage of other when the allocator propagates on move assignment or both
+    // allocators are equal; otherwise other's elements are moved into this deque's own storage
+    Deque& operator=(Deque&& other) noexcept(propagation_detail::move_steals_storage_v<allocator_type>) {
+        if (this != &other) {
+            if constexpr (!propagation_detail::move_steals_storage_v<allocator_type>) {
+                if (!propagation_detail::equal(m_allocator, other.m_allocator)) {
+                    Deque moved(std::move(other), m_allocator);
+                    swap_storage(moved);
+                    return *this;
+                }
+            }
+
+            // Release the current storage with the allocator that created it
+            release_storage();
+            m_map = std::exchange(other.m_map, nullptr);
+            m_map_capacity = std::exchange(other.m_map_capacity, 0);
+            m_map_head = std::exchange(other.m_map_head, 0);
+            m_blocks = std::exchange(other.m_blocks, 0);
+            m_first_block = std::exchange(other.m_first_block, 0);
+            m_offset = std::exchange(other.m_offset, 0);
+            m_size = std::exchange(other.m_size, 0);
+            m_spare = std::exchange(other.m_spare, nullptr);
+            m_cursors = std::exchange(other.m_cursors, Cursors{});
+            propagation_detail::move_assign(m_allocator, other.m_allocator);
+        }
+        return *this;
+    }
+
+    Deque& operator=(std::initializer_list<T> values) {
+        Deque copy(values, m_allocator);
+        swap(copy);
+        return *this;
+    }
+
+    bool operator==(const Deque& rhs) const {
+        return m_size == rhs.m_size && std::equal(begin(), end(), rhs.begin());
+    }
+
+    auto operator<=>(const Deque& rhs) const {
+        return std::lexicographical_compare_three_way(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    iterator begin() noexcept { return iterator(m_cursors.front, m_cursors.front_block, m_first_block, this); }
+    const_iterator begin() const noexcept { return const_iterator(m_cursors.front, m_cursors.front_block, m_first_block, this); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return end_iterator<false>(); }
+    const_iterator end() const noexcept { return end_iterator<true>(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // Returns the element at index, without bounds checking
+    T& operator[](size_type index) noexcept { return element(m_offset + index); }
+    const T& operator[](size_type index) const noexcept { return element(m_offset + index); }
+
+    // Access element by index, throws if not within the bounds of the deque
+    T& at(size_type index) {
+        if (index >= m_size) {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    const T& at(size_type index) const {
+        if (index >= m_size) {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Returns a reference to the first element
+    T& front() {
+        if (empty()) {
+            throw std::out_of_range("Deque is empty");
+        }
+        return *m_cursors.front;
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::out_of_range("Deque is empty");
+        }
+        return *m_cursors.front;
+    }
+
+    // Returns a reference to the last element
+    T& back() {
+        if (empty()) {
+            throw std::out_of_range("Deque is empty");
+        }
+        return *(m_cursors.back - 1);
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::out_of_range("Deque is empty");
+        }
+        return *(m_cursors.back - 1);
+    }
+
+    // Returns number of elements in the deque
+    size_type size() const noexcept { return m_size; }
+
+    // Checks whether the deque is empty or not
+    bool empty() const noexcept { return m_size == 0; }
+
+    size_type max_size() const noexcept {
+        return std::allocator_traits<allocator_type>::max_size(m_allocator);
+    }
+
+    allocator_type get_allocator() const noexcept { return m_allocator; }
+
+    // Appends a new element constructed from args
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_cursors.back != m_cursors.back_limit) {
+            std::allocator_traits<allocator_type>::construct(m_allocator, m_cursors.back, std::forward<Args>(args)...);
+            ++m_size;
+            return *m_cursors.back++;
+        }
+
+        // The last block is full, or there is none
+        const size_type position = m_offset + m_size;
+        const bool new_block = (position >> block_shift) == m_blocks;
+        if (new_block) {
+            reserve_map_slot();
+            T* fresh = acquire_block();
+            m_map[slot(m_blocks)] = fresh;
+            ++m_blocks;
+        }
+
+        T* slot_pointer = &element(position);
+        try {
+            std::allocator_traits<allocator_type>::construct(m_allocator, slot_pointer, std::forward<Args>(args)...);
+        } catch (...) {
+            if (new_block) {
+                --m_blocks;
+                release_block(m_map[slot(m_blocks)]);
+            }
+            throw;
+        }
+        ++m_size;
+        refresh_cursors();
+        return *slot_pointer;
+    }
+
+    // Prepends a new element constructed from args
+    template <class... Args>
+    T& emplace_front(Args&&... args) {
+        if (m_cursors.front != m_cursors.front_block) {
+            std::allocator_traits<allocator_type>::construct(m_allocator, m_cursors.front - 1, std::forward<Args>(args)...);
+            --m_offset;
+            ++m_size;
+            return *--m_cursors.front;
+        }
+
+        // The first block is full, or there is none
+        const bool new_block = m_offset == 0;
+        if (new_block) {
+            reserve_map_slot();
+            T* fresh = acquire_block();
+            m_map_head = (m_map_head - 1) & (m_map_capacity - 1);
+            m_map[m_map_head] = fresh;
+            ++m_blocks;
+            --m_first_block;
+            m_offset = block_size;
+        }
+
+        T* slot_pointer = &element(m_offset - 1);
+        try {
+            std::allocator_traits<allocator_type>::construct(m_allocator, slot_pointer, std::forward<Args>(args)...);
+        } catch (...) {
+            if (new_block) {
+                release_block(m_map[m_map_head]);
+                m_map_head = (m_map_head + 1) & (m_map_capacity - 1);
+                --m_blocks;
+                ++m_first_block;
+                m_offset = 0;
+            }
+            throw;
+        }
+        --m_offset;
+        ++m_size;
+        refresh_cursors();
+        return *slot_pointer;
+    }
+
+    // Add an element to the end of the deque
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    // Add an element to the front of the deque
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    // Remove the last element from the deque
+    void pop_back() {
+        if (empty()) {
+            throw std::logic_error("Deque is empty");
+        }
+
+        if (m_size > 1 && m_cursors.back - 1 != m_cursors.back_limit - block_size) {
+            --m_cursors.back;
+            std::allocator_traits<allocator_type>::destroy(m_allocator, m_cursors.back);
+            --m_size;
+            return;
+        }
+
+        // The element is the last one, or alone in its block
+
+        std::allocator_traits<allocator_type>::destroy(m_allocator, &element(m_offset + m_size - 1));
+        --m_size;
+        if (m_size == 0) {
+            release_blocks();
+        } else if (((m_offset + m_size - 1) >> block_shift) + 1 < m_blocks) {
+            // The last block ran empty
+            --m_blocks;
+            release_block(m_map[slot(m_blocks)]);
+        }
+        refresh_cursors();
+    }
+
+    // Remove the first element from the deque
+    void pop_front() {
+        if (empty()) {
+            throw std::logic_error("Deque is empty");
+        }
+
+        if (m_size > 1 && m_cursors.front + 1 != m_cursors.front_block + block_size) {
+            std::allocator_traits<allocator_type>::destroy(m_allocator, m_cursors.front);
+            ++m_cursors.front;
+            ++m_offset;
+            --m_size;
+            return;
+        }
+
+        // The element is the last one, or alone in its block
+
+        std::allocator_traits<allocator_type>::destroy(m_allocator, &element(m_offset));
+        ++m_offset;
+        --m_size;
+        if (m_size == 0) {
+            release_blocks();
+        } else if (m_offset == block_size) {
+            // The first block ran empty
+            release_block(m_map[m_map_head]);
+            m_map_head = (m_map_head + 1) & (m_map_capacity - 1);
+            --m_blocks;
+            ++m_first_block;
+            m_offset = 0;
+        }
+        refresh_cursors();
+    }
+
+    // Resizes the deque to count elements, appending value-initialized or copied elements, or
+    // removing elements from the end
+    void resize(size_type count) {
+        while (m_size > count) {
+            pop_back();
+        }
+        while (m_size < count) {
+            emplace_back();
+        }
+    }
+
+    void resize(size_type count, const T& value) {
+        while (m_size > count) {
+            pop_back();
+        }
+        while (m_size < count) {
+            emplace_back(value);
+        }
+    }
+
+    // Erase all elements. One block is kept for the next push.
+    void clear() noexcept {
+        destroy_elements();
+        m_size = 0;
+        release_blocks();
+    }
+
+    // Frees the spare block and shrinks the map to fit the blocks in use
+    void shrink_to_fit() {
+        if (m_spare) {
+            std::allocator_traits<allocator_type>::deallocate(m_allocator, m_spare, block_size);
+            m_spare = nullptr;
+        }
+        const size_type fitting = std::max(std::bit_ceil(m_blocks), min_map_capacity);
+        if (m_map && (m_blocks == 0 || fitting < m_map_capacity)) {
+            if (m_blocks == 0) {
+                deallocate_map();
+            } else {
+                reallocate_map(fitting);
+            }
+        }
+    }
+
+    // Exchanges the contents of the deque with those of other. Allocators are swapped only if they
+    // propagate on swap; otherwise they must be equal.
+    void swap(Deque& other) noexcept {
+        swap_storage(other);
+        propagation_detail::swap_on_swap(m_allocator, other.m_allocator);
+    }
+
+    friend void swap(Deque& lhs, Deque& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+private:
+    T** m_map = nullptr;
+    size_type m_map_capacity = 0; // Zero or a power of two
+    size_type m_map_head = 0;     // Map slot of the first block
+    size_type m_blocks = 0;       // Blocks in use, following the first one around the ring
+    // Number of the first block. Iterators hold block numbers, which only change when a block is
+    // added at the front, so popping a block off the front leaves the other iterators valid.
+    size_type m_first_block = 0;
+    size_type m_offset = 0;       // Index of the first element in the first block
+    size_type m_size = 0;
+    T* m_spare = nullptr;
+
+    // Pointers to the end elements, so pushes and pops that stay within the end blocks skip the map.
+    // All null if there is no block.
+    struct Cursors {
+        T* front = nullptr;       // First element
+        T* front_block = nullptr; // Start of the first block
+        T* back = nullptr;        // One past the last element
+        T* back_limit = nullptr;  // End of the last block
+    };
+
+    Cursors m_cursors;
+    [[no_unique_address]] allocator_type m_allocator{};
+
+    // Recomputes the cursors after the blocks in use changed
+    void refresh_cursors() noexcept {
+        if (m_blocks == 0) {
+            m_cursors = Cursors{};
+            return;
+        }
+        T* last = block(m_blocks - 1);
+        m_cursors.front_block = block(0);
+        m_cursors.front = m_cursors.front_block + m_offset;
+        m_cursors.back_limit = last + block_size;
+        m_cursors.back = last + ((m_offset + m_size - 1) & (block_size - 1)) + 1;
+    }
+
+    size_type slot(size_type block_index) const noexcept {
+        return (m_map_head + block_index) & (m_map_capacity - 1);
+    }
+
+    T* block(size_type block_index) const noexcept { return m_map[slot(block_index)]; }
+
+    // Element at position, counted from the start of the first block
+    T& element(size_type position) const noexcept {
+        return block(position >> block_shift)[position & (block_size - 1)];
+    }
+
+    template <bool Const>
+    Iterator<Const> iterator_at(size_type position) const noexcept {
+        using deque_pointer = std::conditional_t<Const, const Deque*, Deque*>;
+        auto* self = const_cast<deque_pointer>(this);
+        // The end position on a block boundary has no block
+        const size_type block_index = position >> block_shift;
+        if (block_index == m_blocks) {
+            return Iterator<Const>(nullptr, nullptr, m_first_block + block_index, self);
+        }
+        T* first = block(block_index);
+        return Iterator<Const>(first + (position & (block_size - 1)), first, m_first_block + block_index, self);
+    }
+
+    template <bool Const>
+    Iterator<Const> end_iterator() const noexcept {
+        using deque_pointer = std::conditional_t<Const, const Deque*, Deque*>;
+        auto* self = const_cast<deque_pointer>(this);
+        if (m_cursors.back == m_cursors.back_limit) {
+            return Iterator<Const>(nullptr, nullptr, m_first_block + m_blocks, self);
+        }
+        return Iterator<Const>(m_cursors.back, m_cursors.back_limit - block_size, m_first_block + m_blocks - 1, self);
+    }
+
+    // Exchanges everything but the allocators
+    void swap_storage(Deque& other) noexcept {
+        using std::swap;
+        swap(m_map, other.m_map);
+        swap(m_map_capacity, other.m_map_capacity);
+        swap(m_map_head, other.m_map_head);
+        swap(m_blocks, other.m_blocks);
+        swap(m_first_block, other.m_first_block);
+        swap(m_offset, other.m_offset);
+        swap(m_size, other.m_size);
+        swap(m_spare, other.m_spare);
+        swap(m_cursors, other.m_cursors);
+    }
+
+    template <class InputIt>
+    void append(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    // Runs fill, releasing everything it built if it throws; for constructors, where the
+    // destructor does not run
+    template <class Fill>
+    void guarded(Fill fill) {
+        try {
+            fill();
+        } catch (...) {
+            release_storage();
+            throw;
+        }
+    }
+
+    T* acquire_block() {
+        if (m_spare) {
+            return std::exchange(m_spare, nullptr);
+        }
+        return std::allocator_traits<allocator_type>::allocate(m_allocator, block_size);
+    }
+
+    void release_block(T* block_pointer) noexcept {
+        if (!m_spare) {
+            m_spare = block_pointer;
+        } else {
+            std::allocator_traits<allocator_type>::deallocate(m_allocator, block_pointer, block_size);
+        }
+    }
+
+    // Releases every block in use once the elements are gone
+    void release_blocks() noexcept {
+        for (size_type i = 0; i < m_blocks; ++i) {
+            release_block(block(i));
+        }
+        m_blocks = 0;
+        m_offset = 0;
+        m_map_head = 0;
+        m_cursors = Cursors{};
+    }
+
+    // Makes room in the map for one more block at either end
+    void reserve_map_slot() {
+        if (m_blocks == m_map_capacity) {
+            reallocate_map(std::max(m_map_capacity * 2, min_map_capacity));
+        }
+    }
+
+    // Moves the block pointers, in order, to the front of a new map
+    void reallocate_map(size_type capacity) {
+        map_allocator alloc(m_allocator);
+        T** map = std::allocator_traits<map_allocator>::allocate(alloc, capacity);
+        for (size_type i = 0; i < m_blocks; ++i) {
+            map[i] = block(i);
+        }
+        deallocate_map();
+        m_map = map;
+        m_map_capacity = capacity;
+        m_map_head = 0;
+    }
+
+    void deallocate_map() noexcept {
+        if (m_map) {
+            map_allocator alloc(m_allocator);
+            std::allocator_traits<map_allocator>::deallocate(alloc, m_map, m_map_capacity);
+            m_map = nullptr;
+            m_map_capacity = 0;
+            m_map_head = 0;
+        }
+    }
+
+    void destroy_elements() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < m_size; ++i) {
+                std::allocator_traits<allocator_type>::destroy(m_allocator, &element(m_offset + i));
+            }
+        }
+    }
+
+    // Destroys the elements and frees all storage
+    void release_storage() noexcept {
+        clear();
+        if (m_spare) {
+            std::allocator_traits<allocator_type>::deallocate(m_allocator, m_spare, block_size);
+            m_spare = nullptr;
+        }
+        deallocate_map();
+    }
+};
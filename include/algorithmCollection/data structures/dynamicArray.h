@@ -7,10 +7,25 @@
 #include <cstddef>
 #include <cstring>
 #include <compare>
+#include <new>
 #include "../allocators/simpleAllocator.h"
-
-// Dynamic-sized array which increases size when at capacity
-template <typename T, typename Alloc = SimpleAllocator<T>>
+#include "growthPolicy.h"
+#include "relocation.h"
+#include "allocatorPropagation.h"
+#include "containerStats.h"
+#include "simdKernels.h"
+
+// Dynamic-sized array which increases size when at capacity.
+// Growth decides the capacity an insertion that does not fit grows to, Shrink when erasing gives
+// capacity back, see growthPolicy.h.
+// Trivially relocatable element types (see relocation.h) are grown and shifted with memcpy/memmove,
+// and resized in place through the allocator's reallocate() when it has one.
+// Comparisons and find/count/contains on arithmetic element types run the SIMD kernels of
+// simdKernels.h.
+// Buffer reallocations are counted in container_stats<DynamicArray<...>>() when
+// ALGORITHM_COLLECTION_CONTAINER_STATS is defined, see containerStats.h.
+template <typename T, typename Alloc = SimpleAllocator<T>, GrowthPolicy Growth = DoublingGrowth,
+    ShrinkPolicy Shrink = HysteresisShrink<>>
 class DynamicArray {
 public:
     using iterator = T*;
@@ -24,6 +39,9 @@ public:
     using size_type = std::size_t;
     using reference = T&;
     using const_reference = const T&;
+    using allocator_type = Alloc;
+    using growth_policy = Growth;
+    using shrink_policy = Shrink;
 
     constexpr iterator begin() noexcept { return m_data.get(); }
     constexpr const_iterator begin() const noexcept { return m_data.get(); }
@@ -45,6 +63,14 @@ public:
         m_data(nullptr, ArrayDeleter<T, Alloc>()),
         m_allocator(Alloc()) {}
 
+    // Creates an empty array drawing its storage from `alloc`
+    constexpr explicit DynamicArray(const Alloc& alloc)
+        : m_size(0),
+        m_capacity(0),
+        m_original_capacity(0),
+        m_data(nullptr, ArrayDeleter<T, Alloc>(alloc, 0, 0)),
+        m_allocator(alloc) {}
+
     constexpr explicit DynamicArray(std::size_t size, const Alloc& alloc = Alloc())
         : m_size(size),
         m_capacity(size),
@@ -75,18 +101,20 @@ public:
         m_allocator(alloc) {
         size_t i = 0;
         for (const auto& value : values) {
-            alloc.construct(m_data.get() + i, value);
+            std::allocator_traits<Alloc>::construct(m_allocator, m_data.get() + i, value);
             ++i;
         }
     }
 
+    // Copies use the allocator chosen by select_on_container_copy_construction
     constexpr DynamicArray(const DynamicArray& other)
-        : m_size(other.m_size),
-        m_capacity(other.m_size),
-        m_original_capacity(other.m_original_capacity),
-        m_data(other.m_allocator.allocate(other.size()), ArrayDeleter<T, Alloc>(m_allocator, m_size, m_capacity)),
-        m_allocator(other.m_allocator) {
-        std::uninitialized_copy(other.m_data.get(), other.m_data.get() + other.m_size, m_data.get());
+        : DynamicArray(other, propagation_detail::select_on_copy(other.m_allocator)) {}
+
+    // Copies the elements of other into storage obtained from `alloc`
+    constexpr DynamicArray(const DynamicArray& other, const Alloc& alloc)
+        : DynamicArray(alloc) {
+        m_original_capacity = other.m_original_capacity;
+        append_elements(other.m_data.get(), other.m_size);
     }
 
     constexpr DynamicArray(DynamicArray&& other)
@@ -99,6 +127,18 @@ public:
         other.m_capacity = 0;
     }
 
+    // Takes over the storage of other if `alloc` equals its allocator, otherwise moves the elements
+    // one by one into storage obtained from `alloc`
+    constexpr DynamicArray(DynamicArray&& other, const Alloc& alloc)
+        : DynamicArray(alloc) {
+        m_original_capacity = other.m_original_capacity;
+        if (propagation_detail::equal(m_allocator, other.m_allocator)) {
+            take_storage(other);
+        } else {
+            append_elements(std::make_move_iterator(other.m_data.get()), other.m_size);
+        }
+    }
+
     ~DynamicArray() {
         for (size_t i = 0; i < m_size; ++i) {
             std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get() + i);
@@ -106,17 +146,32 @@ public:
         std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
     }
 
-    // Overloading the copy assignment operator to copy data from another DynamicArray object.
-    constexpr DynamicArray& operator=(const DynamicArray& other) noexcept {
+    // Copies the elements of other, keeping this array's allocator unless it propagates on copy assignment
+    constexpr DynamicArray& operator=(const DynamicArray& other) {
         if (this != &other) {
-            if (m_capacity < other.m_size) {
-                auto new_data = std::allocator_traits<Alloc>::allocate(m_allocator, other.m_size);
-
-                if constexpr (!std::is_trivially_copyable_v<T>) {
-                    std::uninitialized_copy(other.m_data.get(), other.m_data.get() + other.m_size, new_data);
+            if constexpr (std::allocator_traits<Alloc>::propagate_on_container_copy_assignment::value) {
+                if (!propagation_detail::equal(m_allocator, other.m_allocator)) {
+                    // The current storage has to go back to the allocator that created it
+                    clear();
                 }
-                else {
-                    std::memcpy(new_data, other.m_data.get(), other.size() * sizeof(T));
+                m_allocator = other.m_allocator;
+            }
+
+            if (m_capacity < other.m_size) {
+                T* new_data = std::allocator_traits<Alloc>::allocate(m_allocator, other.m_size);
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    std::memcpy(static_cast<void*>(new_data), other.m_data.get(), other.m_size * sizeof(T));
+                } else {
+                    std::size_t constructed = 0;
+                    try {
+                        for (; constructed < other.m_size; ++constructed) {
+                            std::allocator_traits<Alloc>::construct(m_allocator, new_data + constructed, other.m_data.get()[constructed]);
+                        }
+                    } catch (...) {
+                        std::destroy_n(new_data, constructed);
+                        std::allocator_traits<Alloc>::deallocate(m_allocator, new_data, other.m_size);
+                        throw;
+                    }
                 }
 
                 std::destroy_n(m_data.get(), m_size);
@@ -128,25 +183,39 @@ public:
                 m_size = other.m_size;
             }
             else {
-                std::copy(other.m_data.get(), other.m_data.get() + other.m_size, m_data.get());
-
+                // Assign over the live elements and construct the rest in place
+                std::size_t assigned = std::min(m_size, other.m_size);
+                std::copy(other.m_data.get(), other.m_data.get() + assigned, m_data.get());
                 if (m_size > other.m_size) {
                     std::destroy(m_data.get() + other.m_size, m_data.get() + m_size);
+                    m_size = other.m_size;
+                } else {
+                    m_size = assigned;
+                    append_elements(other.m_data.get() + assigned, other.m_size - assigned);
                 }
-
-                m_size = other.m_size;
             }
         }
         return *this;
     }
 
-    // Overloading the assignment operator to handle move semantics
-    constexpr DynamicArray& operator=(DynamicArray&& other) noexcept {
-        m_size = other.m_size;
-        m_capacity = other.m_capacity;
-        m_original_capacity = other.m_original_capacity;
-        m_data = std::move(other.m_data);
-        other.m_size = 0;
+    // Takes over the storage of other when the allocator propagates on move assignment or both
+    // allocators are equal; otherwise other's elements are moved one by one into this array's storage
+    constexpr DynamicArray& operator=(DynamicArray&& other) noexcept(propagation_detail::move_steals_storage_v<Alloc>) {
+        if (this != &other) {
+            if constexpr (!propagation_detail::move_steals_storage_v<Alloc>) {
+                if (!propagation_detail::equal(m_allocator, other.m_allocator)) {
+                    clear();
+                    append_elements(std::make_move_iterator(other.m_data.get()), other.m_size);
+                    return *this;
+                }
+            }
+
+            // Release the current elements with the allocator that created them
+            clear();
+            propagation_detail::move_assign(m_allocator, other.m_allocator);
+            m_original_capacity = other.m_original_capacity;
+            take_storage(other);
+        }
 
         return *this;
     }
@@ -155,21 +224,27 @@ public:
         if (this->size() != rhs.size()) {
             return false;
         }
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return simd_equal(data(), rhs.data());
+            }
+        }
         return std::equal(this->begin(), this->end(), rhs.begin());
     }
 
-    constexpr std::strong_ordering operator<=>(const DynamicArray<T, Alloc>& rhs) const {
-        if (size() < rhs.size()) {
-            return std::strong_ordering::less;
-        } else if (size() > rhs.size()) {
-            return std::strong_ordering::greater;
+    // Shorter arrays order first; arrays of one size compare their elements lexicographically
+    constexpr auto operator<=>(const DynamicArray& rhs) const requires std::three_way_comparable<T> {
+        using Ordering = std::compare_three_way_result_t<T>;
+        if (size() != rhs.size()) {
+            return Ordering(size() <=> rhs.size());
         }
 
-        auto mismatch = std::mismatch(begin(), end(), rhs.begin());
-        if (mismatch.first == end()) {
-            return std::strong_ordering::equal;
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return Ordering(simd_compare(data(), rhs.data()));
+            }
         }
-        return *(mismatch.first) <=> *(mismatch.second);
+        return Ordering(std::lexicographical_compare_three_way(begin(), end(), rhs.begin(), rhs.end()));
     }
 
     // Returns a reference to the element stored at the specified index in the array.
@@ -192,6 +267,30 @@ public:
         return { m_data.get(), m_size }; 
     }
 
+    // Returns an iterator to the first element equal to value, or end() if there is none
+    constexpr iterator find(const T& value) {
+        return begin() + find_index(value);
+    }
+
+    constexpr const_iterator find(const T& value) const {
+        return begin() + find_index(value);
+    }
+
+    // Checks whether an element equal to value is stored in the array
+    constexpr bool contains(const T& value) const {
+        return find_index(value) != m_size;
+    }
+
+    // Returns the number of elements equal to value
+    constexpr std::size_t count(const T& value) const {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return simd_count(data(), value);
+            }
+        }
+        return static_cast<std::size_t>(std::count(begin(), end(), value));
+    }
+
     // Return number of elements in the array
     constexpr std::size_t size() const noexcept { 
         return m_size; 
@@ -219,14 +318,21 @@ public:
 
     constexpr void assign(std::size_t count, const T& value) {
         if (count > m_capacity) {
-            std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get(), m_data.get() + m_size);
-            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
-
-            m_data.reset(std::allocator_traits<Alloc>::allocate(m_allocator, count));
-            m_capacity = count;
+            T copy(value);
+            clear();
+            reallocate(count);
+            alloc_uninitialized_fill_n(m_allocator, m_data.get(), count, copy);
+            m_size = count;
+            return;
         }
 
-        std::fill_n(m_data.get(), count, value);
+        std::fill_n(m_data.get(), std::min(count, m_size), value);
+        if (count > m_size) {
+            alloc_uninitialized_fill(m_allocator, end(), m_data.get() + count, value);
+        }
+        else {
+            std::destroy(m_data.get() + count, end());
+        }
         m_size = count;
     }
 
@@ -234,19 +340,26 @@ public:
         assign(ilist.begin(), ilist.end());
     }
 
-    template <class InputIt>
+    template <class InputIt, std::enable_if_t<!std::is_integral_v<InputIt>, int> = 0>
     constexpr void assign(InputIt first, InputIt last) {
-        auto count = std::distance(first, last);
+        auto count = static_cast<std::size_t>(std::distance(first, last));
         if (count > m_capacity) {
-            std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get(), m_data.get() + m_size);
-            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
-
-            m_data.reset(std::allocator_traits<Alloc>::allocate(m_allocator, count));
-            m_capacity = count;
+            clear();
+            reallocate(count);
+            alloc_uninitialized_copy(m_allocator, first, last, m_data.get());
+            m_size = count;
+            return;
         }
 
-        std::uninitialized_copy(first, last, m_data.get());
-        std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get() + m_size);
+        auto assigned = std::min(count, m_size);
+        auto mid = std::next(first, static_cast<std::ptrdiff_t>(assigned));
+        std::copy(first, mid, m_data.get());
+        if (count > m_size) {
+            alloc_uninitialized_copy(m_allocator, mid, last, end());
+        }
+        else {
+            std::destroy(m_data.get() + count, end());
+        }
         m_size = count;
     }
 
@@ -306,45 +419,23 @@ public:
     // Note: If `new_capacity` is less than or equal to the current size of the custom array, the function does nothing.
     constexpr void reserve(std::size_t new_capacity) {
         if (new_capacity > m_capacity) {
-            auto new_data = std::allocator_traits<Alloc>::allocate(m_allocator, new_capacity);
-
-            if (!new_data) {
-                throw std::bad_alloc();
-            }
-
-            if (new_data != m_data.get()) {
-                std::uninitialized_move(m_data.get(), m_data.get() + m_size, new_data);
-
-                ArrayDeleter<T, Alloc> old_data_deleter(m_allocator, m_size, m_capacity);
-                old_data_deleter(m_data.release());
-
-                auto new_data_ptr = std::unique_ptr<T[], ArrayDeleter<T, Alloc>>(new_data,
-                    ArrayDeleter<T, Alloc>(m_allocator, m_size, new_capacity));
-                m_data = std::move(new_data_ptr);
-                m_capacity = new_capacity;
-                m_data.get_deleter().m_capacity = new_capacity;
-                m_data.get_deleter().m_size = m_size;
-            }
+            reallocate(new_capacity);
         }
     }
 
-    // Reduce memory usage by freeing unused allocated memory  
+    // Reduce memory usage by freeing unused allocated memory. Does nothing under NeverShrink.
     constexpr void shrink_to_fit() {
-        if (m_capacity > m_size) {
-            auto new_data = std::allocator_traits<Alloc>::allocate(m_allocator, m_size);
+        shrink_to(m_size);
+    }
 
-            if constexpr (!std::is_trivially_copyable_v<T>) {
-                std::uninitialized_copy(m_data.get(), m_data.get() + m_size, new_data);
+    // Reduces the capacity to max(new_capacity, size()) if that is smaller than the current capacity.
+    // Does nothing under NeverShrink.
+    constexpr void shrink_to(std::size_t new_capacity) {
+        if constexpr (Shrink::explicit_shrink) {
+            new_capacity = std::max(new_capacity, m_size);
+            if (new_capacity < m_capacity) {
+                reallocate(new_capacity);
             }
-            else {
-                std::memcpy(new_data, m_data.get(), m_size * sizeof(T));
-            }
-
-            std::destroy_n(m_data.get(), m_size);
-            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
-
-            m_data.reset(new_data);
-            m_capacity = m_size;
         }
     }
 
@@ -373,77 +464,103 @@ public:
             throw std::out_of_range("Invalid index");
         }
 
-        auto insert_index = begin() + std::distance(cbegin(), index);
+        std::size_t offset = index - cbegin();
+        if (count == 0) {
+            return begin() + offset;
+        }
 
         if (m_size + count > m_capacity) {
-            std::size_t new_capacity = m_capacity == 0 ? 1 : m_capacity * 2;
-            T* new_data = std::allocator_traits<Alloc>::allocate(m_allocator, new_capacity);
-
-            std::uninitialized_fill_n(new_data + (insert_index - m_data.get()), count, value);
-            std::uninitialized_move_n(m_data.get(), insert_index - m_data.get(), new_data);
-            std::uninitialized_move_n(insert_index, m_size - (insert_index - m_data.get()), new_data + (insert_index - m_data.get()) + count);
-
-            auto first = insert_index;
-            auto last = insert_index + count;
-
-            for (; first != last; ++first) {
-                std::allocator_traits<Alloc>::destroy(m_allocator, std::addressof(*first));
+            reallocate_with_gap(grown_capacity(m_size + count), offset, count, [&](T* gap) {
+                alloc_uninitialized_fill_n(m_allocator, gap, count, value);
+            });
+            return begin() + offset;
+        }
+
+        // value may refer to an element that is about to be shifted
+        T copy(value);
+        T* pos = begin() + offset;
+        T* old_end = end();
+        std::size_t after = m_size - offset;
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            shift_relocate(pos, old_end, static_cast<std::ptrdiff_t>(count));
+            try {
+                alloc_uninitialized_fill_n(m_allocator, pos, count, copy);
+            } catch (...) {
+                shift_relocate(pos + count, old_end + count, -static_cast<std::ptrdiff_t>(count));
+                throw;
             }
-
-            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
-
-            m_data.reset(new_data);
-            m_capacity = new_capacity;
-            m_size += count;
+        }
+        else if (after > count) {
+            alloc_uninitialized_move(m_allocator, old_end - count, old_end, old_end);
+            std::move_backward(pos, old_end - count, old_end);
+            std::fill_n(pos, count, copy);
         }
         else {
-            std::uninitialized_move_n(insert_index, m_size - (insert_index - m_data.get()), insert_index + count);
-            std::uninitialized_fill_n(insert_index, count, value);
-
-            m_size += count;
+            alloc_uninitialized_fill_n(m_allocator, old_end, count - after, copy);
+            alloc_uninitialized_move(m_allocator, pos, old_end, pos + count);
+            std::fill(pos, old_end, copy);
         }
+        m_size += count;
 
-        return insert_index;
+        return pos;
     }
 
     constexpr iterator insert(const_iterator index, std::initializer_list<T> ilist) {
         return insert(index, ilist.begin(), ilist.end());
     }
 
-    template <class InputIt>
+    template <class InputIt, std::enable_if_t<!std::is_integral_v<InputIt>, int> = 0>
     constexpr iterator insert(const_iterator index, InputIt first, InputIt last) {
         if (index < cbegin() || index > cend()) {
             throw std::out_of_range("Invalid index");
         }
 
-        auto count = std::distance(first, last);
-        auto insert_index = begin() + std::distance(cbegin(), index);
+        std::size_t offset = index - cbegin();
+        auto count = static_cast<std::size_t>(std::distance(first, last));
+        if (count == 0) {
+            return begin() + offset;
+        }
 
         if (m_size + count > m_capacity) {
-            std::size_t new_capacity = std::max(m_capacity * 2, m_size + count);
-            T* new_data = std::allocator_traits<Alloc>::allocate(m_allocator, new_capacity);
-
-            std::uninitialized_move_n(m_data.get(), insert_index - m_data.get(), new_data);
-            std::uninitialized_copy(first, last, new_data + (insert_index - m_data.get()));
-            std::uninitialized_move_n(insert_index, m_size - (insert_index - m_data.get()), new_data + (insert_index - m_data.get()) + count);
-
-            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
-
-            m_data.reset(new_data);
-            m_capacity = new_capacity;
-            m_size += count;
+            reallocate_with_gap(grown_capacity(m_size + count), offset, count, [&](T* gap) {
+                alloc_uninitialized_copy(m_allocator, first, last, gap);
+            });
+            return begin() + offset;
+        }
+
+        T* pos = begin() + offset;
+        T* old_end = end();
+        std::size_t after = m_size - offset;
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            shift_relocate(pos, old_end, static_cast<std::ptrdiff_t>(count));
+            try {
+                alloc_uninitialized_copy(m_allocator, first, last, pos);
+            } catch (...) {
+                shift_relocate(pos + count, old_end + count, -static_cast<std::ptrdiff_t>(count));
+                throw;
+            }
+        }
+        else if (after > count) {
+            alloc_uninitialized_move(m_allocator, old_end - count, old_end, old_end);
+            std::move_backward(pos, old_end - count, old_end);
+            std::copy(first, last, pos);
         }
         else {
-            std::uninitialized_move_n(insert_index, m_size - (insert_index - m_data.get()), insert_index + count);
-            std::uninitialized_copy(first, last, insert_index);
-
-            m_size += count;
+            auto mid = std::next(first, static_cast<std::ptrdiff_t>(after));
+            alloc_uninitialized_copy(m_allocator, mid, last, old_end);
+            alloc_uninitialized_move(m_allocator, pos, old_end, pos + count);
+            std::copy(first, mid, pos);
         }
+        m_size += count;
 
-        return insert_index;
+        return pos;
     }
 
-    // Appends a new element before index in the array.
+    // Constructs a new element before index. With spare capacity the tail is shifted up by one in
+    // place; otherwise the array grows by its growth policy, so repeated emplaces cost amortized
+    // O(1) reallocations.
     template <class... Args>
     constexpr iterator emplace(const_iterator index, Args&&... args) {
         // Convert the iterator to a pointer offset
@@ -454,32 +571,34 @@ public:
         }
 
         if (m_size == m_capacity) {
-            m_capacity = m_capacity == 0 ? 1 : m_capacity * 2;
+            reallocate_with_gap(grown_capacity(m_size + 1), index_offset, 1, [&](T* gap) {
+                std::allocator_traits<Alloc>::construct(m_allocator, gap, std::forward<Args>(args)...);
+            });
         }
-
-        // Allocate memory for the new array
-        auto new_data = std::allocator_traits<Alloc>::allocate(m_allocator, m_capacity);
-
-        // Copy the elements before the insertion point to the new array
-        std::uninitialized_copy(m_data.get(), m_data.get() + index_offset, new_data);
-
-        // Construct the new element in the new array
-        std::allocator_traits<Alloc>::construct(m_allocator, new_data + index_offset, std::forward<Args>(args)...);
-
-        // Copy the elements after the insertion point to the new array
-        std::uninitialized_copy(m_data.get() + index_offset, m_data.get() + m_size, new_data + index_offset + 1);
-
-        // Destroy the old elements
-        for (std::size_t destroy_index = 0; destroy_index < m_size; ++destroy_index) {
-            std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get() + destroy_index);
+        else if (index_offset == m_size) {
+            std::allocator_traits<Alloc>::construct(m_allocator, end(), std::forward<Args>(args)...);
+            ++m_size;
         }
+        else if constexpr (is_trivially_relocatable_v<T>) {
+            // Build the element off to the side first, args may refer to elements that are about to be shifted
+            alignas(T) std::byte staged[sizeof(T)];
+            std::allocator_traits<Alloc>::construct(m_allocator, reinterpret_cast<T*>(staged), std::forward<Args>(args)...);
 
-        // Deallocate the memory used by the old array
-        std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
+            T* pos = begin() + index_offset;
+            shift_relocate(pos, end(), 1);
+            std::memcpy(static_cast<void*>(pos), staged, sizeof(T));
+            ++m_size;
+        }
+        else {
+            // Build the element first, args may refer to elements that are about to be shifted
+            T value(std::forward<Args>(args)...);
+            T* pos = begin() + index_offset;
 
-        // Point to the new array
-        m_data.reset(new_data);
-        ++m_size;
+            std::allocator_traits<Alloc>::construct(m_allocator, end(), std::move(back()));
+            std::move_backward(pos, end() - 1, end());
+            *pos = std::move(value);
+            ++m_size;
+        }
 
         // Return an iterator pointing to the new element
         return m_data.get() + index_offset;
@@ -489,11 +608,14 @@ public:
     template <class... Args>
     constexpr T& emplace_back(Args&&... args) {
         if (m_size == m_capacity) {
-            reserve(m_capacity == 0 ? 1 : m_capacity * 2);
+            reallocate_with_gap(grown_capacity(m_size + 1), m_size, 1, [&](T* gap) {
+                std::allocator_traits<Alloc>::construct(m_allocator, gap, std::forward<Args>(args)...);
+            });
+        }
+        else {
+            std::allocator_traits<Alloc>::construct(m_allocator, end(), std::forward<Args>(args)...);
+            ++m_size;
         }
-
-        std::allocator_traits<Alloc>::construct(m_allocator, end(), std::forward<Args>(args)...);
-        ++m_size;
 
         return back();
     }
@@ -505,17 +627,22 @@ public:
         }
 
         auto erase_index = begin() + (index - cbegin());
-        std::allocator_traits<Alloc>::destroy(m_allocator, erase_index);
 
-        std::move(erase_index + 1, end(), erase_index);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::allocator_traits<Alloc>::destroy(m_allocator, erase_index);
+            shift_relocate(erase_index + 1, end(), -1);
+        }
+        else {
+            // Shift the tail down over the erased element, then destroy the now unused last slot
+            std::move(erase_index + 1, end(), erase_index);
+            std::allocator_traits<Alloc>::destroy(m_allocator, end() - 1);
+        }
 
         --m_size;
+        std::size_t offset = erase_index - begin();
+        shrink_after_erase();
 
-        if (m_size < m_capacity / 2) {
-            shrink_to_fit();
-        }
-
-        return erase_index;
+        return begin() + offset;
     }
 
     // Remove elements in range [first, last]
@@ -526,111 +653,70 @@ public:
 
         auto first_index = begin() + std::distance(cbegin(), first);
         auto last_index = begin() + std::distance(cbegin(), last);
-        auto num_to_move = std::distance(last_index, end());
 
-        for (; first_index != last_index; ++first_index) {
-            std::allocator_traits<Alloc>::destroy(m_allocator, first_index);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            for (auto it = first_index; it != last_index; ++it) {
+                std::allocator_traits<Alloc>::destroy(m_allocator, it);
+            }
+            shift_relocate(last_index, end(), -(last_index - first_index));
+        }
+        else {
+            // Shift the tail down over the erased range, then destroy the now unused trailing slots
+            auto new_end = std::move(last_index, end(), first_index);
+            for (auto it = new_end; it != end(); ++it) {
+                std::allocator_traits<Alloc>::destroy(m_allocator, it);
+            }
         }
 
-        std::move(last_index, end(), first_index);
         m_size -= std::distance(first, last);
+        std::size_t offset = first_index - begin();
+        shrink_after_erase();
 
-        if (m_size < m_capacity / 2) {
-            shrink_to_fit();
-        }
-
-        return first_index;
+        return begin() + offset;
     }
 
     // Resizes array to contain 'count' of elements of type 'value'
     constexpr void resize(std::size_t count, const T& value = T()) {
         if (count < m_size) {
-            std::size_t old_size = m_size;
+            std::destroy(m_data.get() + count, end());
             m_size = count;
-            for (std::size_t i = count; i < old_size; ++i) {
-                std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get() + i);
-            }
         }
         else if (count > m_size && count <= m_capacity) {
-            std::uninitialized_fill(m_data.get() + m_size, m_data.get() + count, value);
+            alloc_uninitialized_fill(m_allocator, end(), m_data.get() + count, value);
             m_size = count;
         }
-        else {
-            auto new_data = std::allocator_traits<Alloc>::allocate(m_allocator, count);
-            std::uninitialized_copy(m_data.get(), m_data.get() + m_size, new_data);
-            std::uninitialized_fill(new_data + m_size, new_data + count, value);
-            std::size_t old_size = m_size;
-            m_size = count;
-            for (std::size_t index = 0; index < old_size; ++index) {
-                std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get() + index);
-            }
-            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
-            m_data.reset(new_data);
-            m_capacity = count;
+        else if (count > m_size) {
+            std::size_t extra = count - m_size;
+            reallocate_with_gap(grown_capacity(count), m_size, extra, [&](T* gap) {
+                alloc_uninitialized_fill_n(m_allocator, gap, extra, value);
+            });
         }
     }
 
     // Exchanges the contents and capacity of the container with those of other
+    // Allocators are swapped only if they propagate on swap; otherwise they must be equal
     constexpr void swap(DynamicArray& other) noexcept {
-        std::swap(m_data, other.m_data);
+        T* data = m_data.release();
+        m_data.reset(other.m_data.release());
+        other.m_data.reset(data);
         std::swap(m_size, other.m_size);
         std::swap(m_capacity, other.m_capacity);
         std::swap(m_original_capacity, other.m_original_capacity);
-        std::swap(m_allocator, other.m_allocator);
+        propagation_detail::swap_on_swap(m_allocator, other.m_allocator);
     }
 
     // Add an element to the end of the array
     constexpr void push_back(const T& value) {
-        if (m_size == m_capacity) {
-            reserve(m_capacity == 0 ? 1 : m_capacity * 2);
-        }
-
-        std::allocator_traits<Alloc>::construct(m_allocator, m_data.get() + m_size, value);
-        ++m_size;
+        emplace_back(value);
     }
 
     constexpr void push_back(T&& value) {
-        if (m_size == m_capacity) {
-            reserve(m_capacity == 0 ? 1 : m_capacity * 2);
-        }
-
-        std::allocator_traits<Alloc>::construct(m_allocator, m_data.get() + m_size, std::move(value));
-        ++m_size;
+        emplace_back(std::move(value));
     }
 
     // Add an element to the front of the array
     constexpr void push_front(const T& value) {
-        if (m_size + 1 > m_capacity) {
-            m_original_capacity = m_capacity; // update m_original_capacity
-            std::size_t new_capacity = std::max(1u, static_cast<unsigned int>(m_capacity * 2));
-            auto new_data = std::allocator_traits<Alloc>::allocate(m_allocator, new_capacity);
-
-            // Move all elements one position to the right
-            std::uninitialized_move(m_data.get(), m_data.get() + m_size, std::addressof(*(new_data + 1)));
-
-            // Construct the new value at the beginning of the new data
-            std::allocator_traits<Alloc>::construct(m_allocator, new_data, value);
-
-            // Destroy the old elements
-            for (size_t index = 0; index < m_size; ++index) {
-                std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get() + index);
-            }
-
-            // Deallocate the old memory
-            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_original_capacity);
-
-            m_data.reset(new_data);
-            m_capacity = new_capacity;
-        }
-        else {
-            // Move all elements one position to the right
-            std::uninitialized_move(m_data.get(), m_data.get() + m_size, m_data.get() + 1);
-
-            // Construct the new value at the beginning of the data
-            std::allocator_traits<Alloc>::construct(m_allocator, m_data.get(), value);
-        }
-
-        ++m_size;
+        emplace(cbegin(), value);
     }
 
     // remove the last element from the array
@@ -650,16 +736,176 @@ public:
             throw std::logic_error("Array is empty");
         }
 
-        // Destroy the first element in the array
-        std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get());
-        std::move(m_data.get() + 1, m_data.get() + m_size, m_data.get());
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get());
+            shift_relocate(m_data.get() + 1, m_data.get() + m_size, -1);
+        }
+        else {
+            // Shift the remaining elements over the first one and destroy the now unused last slot
+            std::move(m_data.get() + 1, m_data.get() + m_size, m_data.get());
+            std::allocator_traits<Alloc>::destroy(m_allocator, m_data.get() + m_size - 1);
+        }
         --m_size;
     }
 
 private:
+    constexpr std::size_t find_index(const T& value) const {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return simd_find(data(), value);
+            }
+        }
+        return static_cast<std::size_t>(std::find(begin(), end(), value) - begin());
+    }
+
+    // Capacity to grow to when `required` elements must fit
+    constexpr std::size_t grown_capacity(std::size_t required) const {
+        if (required > max_size()) {
+            throw std::length_error("DynamicArray exceeds max_size");
+        }
+
+        std::size_t next = Growth::next_capacity(m_capacity, required);
+        return std::clamp(next, required, std::max(required, max_size()));
+    }
+
+    // Moves the elements into a buffer of new_capacity, leaving `gap` uninitialized slots at offset.
+    // construct_gap fills the gap before the old elements move, so its arguments may refer to them.
+    template <class ConstructGap>
+    constexpr void reallocate_with_gap(std::size_t new_capacity, std::size_t offset, std::size_t gap, ConstructGap construct_gap) {
+        if (new_capacity == 0) {
+            // Only reachable when shrinking an empty array
+            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
+            container_stats_detail::record_resize<DynamicArray>(m_capacity, 0, 0, false);
+            m_capacity = 0;
+            return;
+        }
+
+        if constexpr (is_trivially_relocatable_v<T> && ReallocatingAllocator<Alloc, T>) {
+            if (m_data && gap <= 1) {
+                reallocate_in_place(new_capacity, offset, gap, construct_gap);
+                return;
+            }
+        }
+
+        move_to_new_buffer(new_capacity, offset, gap, construct_gap);
+    }
+
+    // Resizes the buffer through the allocator's reallocate(), which may extend it without moving.
+    // A single new element is staged outside the buffer, it may be built from an element being moved.
+    template <class ConstructGap>
+    void reallocate_in_place(std::size_t new_capacity, std::size_t offset, std::size_t gap, ConstructGap construct_gap) {
+        alignas(T) std::byte staged[sizeof(T)];
+        if (gap == 1) {
+            construct_gap(reinterpret_cast<T*>(staged));
+        }
+
+        // The staged element is destroyed again if either reallocate() or the fallback throws
+        T* resized = nullptr;
+        try {
+            resized = m_allocator.reallocate(m_data.get(), m_capacity, new_capacity);
+            if (!resized) {
+                move_to_new_buffer(new_capacity, offset, gap, [&](T* slot) {
+                    std::memcpy(static_cast<void*>(slot), staged, gap * sizeof(T));
+                });
+                return;
+            }
+        } catch (...) {
+            if (gap == 1) {
+                std::destroy_at(std::launder(reinterpret_cast<T*>(staged)));
+            }
+            throw;
+        }
+
+        m_data.release();
+        m_data.reset(resized);
+        shift_relocate(resized + offset, resized + m_size, static_cast<std::ptrdiff_t>(gap));
+        if (gap == 1) {
+            std::memcpy(static_cast<void*>(resized + offset), staged, sizeof(T));
+        }
+        container_stats_detail::record_resize<DynamicArray>(m_capacity, new_capacity, 0, true);
+        m_capacity = new_capacity;
+        m_size += gap;
+    }
+
+    template <class ConstructGap>
+    constexpr void move_to_new_buffer(std::size_t new_capacity, std::size_t offset, std::size_t gap, ConstructGap construct_gap) {
+        T* new_data = std::allocator_traits<Alloc>::allocate(m_allocator, new_capacity);
+        if (!new_data) {
+            throw std::bad_alloc();
+        }
+
+        try {
+            construct_gap(new_data + offset);
+        } catch (...) {
+            std::allocator_traits<Alloc>::deallocate(m_allocator, new_data, new_capacity);
+            throw;
+        }
+
+        // The old buffer stays owned until every element has left it, so a throwing copy leaves the
+        // array as it was
+        T* old_data = m_data.get();
+        if (old_data) {
+            try {
+                relocate_with_gap(m_allocator, old_data, old_data + m_size, offset, gap, new_data);
+            } catch (...) {
+                for (std::size_t i = 0; i < gap; ++i) {
+                    std::allocator_traits<Alloc>::destroy(m_allocator, new_data + offset + i);
+                }
+                std::allocator_traits<Alloc>::deallocate(m_allocator, new_data, new_capacity);
+                throw;
+            }
+            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data.release(), m_capacity);
+        }
+        container_stats_detail::record_resize<DynamicArray>(m_capacity, new_capacity, old_data ? m_size : 0, false);
+
+        m_data.reset(new_data);
+        m_capacity = new_capacity;
+        m_size += gap;
+    }
+
+    // Gives capacity back as the shrink policy decides; erase iterators are invalidated if it does
+    constexpr void shrink_after_erase() {
+        std::size_t kept = std::max<std::size_t>(Shrink::shrink_capacity(m_size, m_capacity), m_size);
+        if (kept < m_capacity) {
+            reallocate(kept);
+        }
+    }
+
+    constexpr void reallocate(std::size_t new_capacity) {
+        reallocate_with_gap(new_capacity, m_size, 0, [](T*) {});
+    }
+
+    // Takes over the storage of other, whose allocator must equal this array's, into this empty array
+    constexpr void take_storage(DynamicArray& other) noexcept {
+        m_data.reset(other.m_data.release());
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+    }
+
+    // Constructs `count` elements from first onwards at the end, through the allocator so elements
+    // taking an allocator are built with this array's
+    template <typename InputIt>
+    constexpr void append_elements(InputIt first, std::size_t count) {
+        if (m_size + count > m_capacity) {
+            reallocate(m_size + count);
+        }
+
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_pointer_v<InputIt>) {
+            if (count != 0 && !std::is_constant_evaluated()) {
+                std::memcpy(static_cast<void*>(m_data.get() + m_size), first, count * sizeof(T));
+                m_size += count;
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i, ++first) {
+            std::allocator_traits<Alloc>::construct(m_allocator, m_data.get() + m_size, *first);
+            ++m_size;
+        }
+    }
+
     template <typename T1, typename Alloc1>
     class ArrayDeleter {
-        template<typename, typename>
+        template <typename, typename, GrowthPolicy, ShrinkPolicy>
         friend class DynamicArray;
     public:
         ArrayDeleter()
@@ -1,95 +1,377 @@
 #pragma once
 #include <algorithm>
+#include <compare>
+#include <concepts>
+#include <functional>
 #include <memory>
 #include <ranges>
 #include <stdexcept>
 #include <cstddef>
 #include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include "../allocators/simpleAllocator.h"
+#include "allocatorPropagation.h"
+#include "relocation.h"
+#include "simdKernels.h"
 
-// Fixed-size array with memory safety
-template <typename T, std::size_t S, typename Alloc = SimpleAllocator<T>>
+// Storage tag selecting a FixedArray that holds its elements inside the object itself
+struct InlineStorage {};
+
+namespace fixed_array_detail {
+    // Arrays up to this many elements run their element-wise arithmetic and reductions as straight
+    // line code, longer ones as loops with a trip count the compiler knows
+    inline constexpr std::size_t unroll_limit = 16;
+
+    // Independent accumulators of the reductions over longer arrays; one SIMD register of floats or
+    // two of doubles, which lets the compiler vectorize them without reassociating anything itself
+    inline constexpr std::size_t reduce_lanes = 8;
+
+    // Calls f(i) for every index below S
+    template <std::size_t S, class F>
+    constexpr void for_each_index(F&& f) {
+        if constexpr (S <= unroll_limit) {
+            [&]<std::size_t... I>(std::index_sequence<I...>) { (f(I), ...); }(std::make_index_sequence<S>());
+        } else {
+            for (std::size_t i = 0; i < S; ++i) {
+                f(i);
+            }
+        }
+    }
+
+    // Element-wise operations on longer arrays of arithmetic values run blocks of this many elements
+    inline constexpr std::size_t apply_block = 16;
+
+    // Calls op(element, i) on every element of dest, which op updates in place. Longer arithmetic
+    // arrays go in blocks that are read completely before any element is written back; that tells the
+    // compiler the block's loads do not depend on its stores, so it vectorizes without alias checks.
+    template <std::size_t S, class T, class Op>
+    constexpr void apply(T* dest, Op op) {
+        if constexpr (S <= unroll_limit || !std::is_arithmetic_v<T>) {
+            for_each_index<S>([&](std::size_t i) { op(dest[i], i); });
+        } else {
+            constexpr std::size_t blocked = S / apply_block * apply_block;
+            for (std::size_t i = 0; i < blocked; i += apply_block) {
+                T block[apply_block];
+                for (std::size_t j = 0; j < apply_block; ++j) {
+                    block[j] = dest[i + j];
+                    op(block[j], i + j);
+                }
+                for (std::size_t j = 0; j < apply_block; ++j) {
+                    dest[i + j] = block[j];
+                }
+            }
+            for (std::size_t i = blocked; i < S; ++i) {
+                op(dest[i], i);
+            }
+        }
+    }
+
+    // Folds term(0), ..., term(S - 1) into init with op. Short arrays fold left to right; longer ones
+    // keep reduce_lanes partial results, so op must be associative and commutative, as for std::reduce.
+    // The order is fixed by S alone, so a reduction gives the same result at compile time and at run
+    // time, floating point rounding included.
+    template <std::size_t S, class T, class Term, class Op>
+    constexpr T reduce(T init, Term term, Op op) {
+        if constexpr (S <= unroll_limit) {
+            for_each_index<S>([&](std::size_t i) { init = op(init, term(i)); });
+            return init;
+        } else {
+            constexpr std::size_t blocked = S / reduce_lanes * reduce_lanes;
+            T lanes[reduce_lanes] = {};
+            for (std::size_t j = 0; j < reduce_lanes; ++j) {
+                lanes[j] = term(j);
+            }
+            for (std::size_t i = reduce_lanes; i < blocked; i += reduce_lanes) {
+                for (std::size_t j = 0; j < reduce_lanes; ++j) {
+                    lanes[j] = op(lanes[j], term(i + j));
+                }
+            }
+            for (std::size_t width = reduce_lanes / 2; width > 0; width /= 2) {
+                for (std::size_t j = 0; j < width; ++j) {
+                    lanes[j] = op(lanes[j], lanes[j + width]);
+                }
+            }
+            for (std::size_t i = blocked; i < S; ++i) {
+                lanes[0] = op(lanes[0], term(i));
+            }
+            return op(init, lanes[0]);
+        }
+    }
+}
+
+// Fixed-size array with memory safety.
+// With the default InlineStorage the elements live inside the array object: no allocation, no pointer
+// chase, fully usable in constant expressions and trivially copyable for trivially copyable T, like a
+// built-in array. Very large arrays may not fit on the stack; give those an allocator instead
+// (see HeapFixedArray), which keeps the elements in one allocation owned by the array. Moving a heap
+// array hands over that allocation; the moved-from array owns none until it is assigned to, and may
+// only be assigned to or destroyed.
+// Supports structured bindings through std::tuple_size, std::tuple_element and get<I>.
+// Comparisons and find/count/contains on arithmetic element types run the SIMD kernels of
+// simdKernels.h.
+template <typename T, std::size_t S, typename Alloc = InlineStorage>
 class FixedArray {
+    static constexpr bool is_inline = std::is_same_v<Alloc, InlineStorage>;
+
+    struct HeapStorage {
+        T* data = nullptr;
+        [[no_unique_address]] Alloc allocator{};
+    };
+
+    // A zero-sized array still needs one slot to be a complete type
+    using InlineBuffer = T[S == 0 ? 1 : S];
+
 public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
     using iterator = T*;
     using const_iterator = const T*;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-    using span = std::span<T>;
-    using const_span = std::span<const T>;
+    using span = std::span<T, S>;
+    using const_span = std::span<const T, S>;
 
     constexpr FixedArray() {
-        allocate_memory();
-        std::fill(m_data.begin(), m_data.end(), T{});
+        if constexpr (!is_inline) {
+            allocate_elements([this] { alloc_uninitialized_fill_n(m_storage.allocator, m_storage.data, S, T{}); });
+        }
+    }
+
+    // Value-initializes the elements in storage obtained from the given allocator
+    explicit FixedArray(const Alloc& allocator) requires (!is_inline) : m_storage{nullptr, allocator} {
+        allocate_elements([this] { alloc_uninitialized_fill_n(m_storage.allocator, m_storage.data, S, T{}); });
     }
 
-    constexpr FixedArray(std::initializer_list<T> values) : m_data(nullptr) {
+    // Copies values into the first elements and value-initializes the rest
+    constexpr FixedArray(std::initializer_list<T> values) : FixedArray() {
         if (values.size() > S) {
             throw std::invalid_argument("Initializer list size is greater than array size");
         }
-        
-        std::copy(values.begin(), values.end(), m_data.begin());
+
+        std::copy(values.begin(), values.end(), begin());
     }
 
-    constexpr FixedArray(const FixedArray& other) : m_data(nullptr) {
-        allocate_memory();
-        std::copy(other.cbegin(), other.cend(), m_data.begin());
+    constexpr FixedArray(const FixedArray& other) requires is_inline = default;
+
+    // Copies use the allocator chosen by select_on_container_copy_construction
+    constexpr FixedArray(const FixedArray& other) requires (!is_inline)
+        : FixedArray(other, propagation_detail::select_on_copy(other.m_storage.allocator)) {}
+
+    FixedArray(const FixedArray& other, const Alloc& allocator) requires (!is_inline)
+        : m_storage{nullptr, allocator} {
+        allocate_elements([&] { alloc_uninitialized_copy(m_storage.allocator, other.cbegin(), other.cend(), m_storage.data); });
     }
 
-    ~FixedArray() {
+    constexpr FixedArray(FixedArray&& other) requires is_inline = default;
+
+    // Takes over the source's buffer
+    FixedArray(FixedArray&& other) noexcept requires (!is_inline)
+        : m_storage{std::exchange(other.m_storage.data, nullptr), other.m_storage.allocator} {}
+
+    constexpr ~FixedArray() requires is_inline = default;
+
+    ~FixedArray() requires (!is_inline) {
         deallocate_memory();
     }
 
-    constexpr FixedArray& operator=(const FixedArray& other) noexcept {
+    constexpr FixedArray& operator=(const FixedArray& other) requires is_inline = default;
+
+    constexpr FixedArray& operator=(const FixedArray& other) requires (!is_inline) {
+        if (this == &other) { return *this; }
+
+        // Both arrays hold exactly S elements, so the existing storage is always reused; only a
+        // moved-from array needs a new buffer
+        if (!m_storage.data) {
+            allocate_elements([&] { alloc_uninitialized_copy(m_storage.allocator, other.cbegin(), other.cend(), m_storage.data); });
+        } else {
+            std::copy(other.cbegin(), other.cend(), begin());
+        }
+
+        return *this;
+    }
+
+    constexpr FixedArray& operator=(FixedArray&& other) requires is_inline = default;
+
+    // Exchanges buffers with the source when the allocators allow it, which then frees the old
+    // buffer; otherwise moves the elements into this array's own buffer
+    FixedArray& operator=(FixedArray&& other) noexcept(propagation_detail::move_steals_storage_v<Alloc>)
+        requires (!is_inline) {
         if (this == &other) { return *this; }
-        
-        if (other.size() > S) {
-            // Allocate a new array of the appropriate size
-            FixedArray<T, other.size()> new_data;
-            
-            // Copy elements from the old and new arrays to the new array
-            std::copy(other.cbegin(), other.cend(), new_data.begin());
-            std::fill(new_data.begin() + S, new_data.end(), T{});
-            
-            // Deallocate the old array
-            deallocate_memory();
-            
-            // Update the data pointer and size
-            m_data = new_data;
+
+        if (propagation_detail::move_steals_storage_v<Alloc>
+            || propagation_detail::equal(m_storage.allocator, other.m_storage.allocator)) {
+            std::swap(m_storage.data, other.m_storage.data);
+            if constexpr (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value) {
+                using std::swap;
+                swap(m_storage.allocator, other.m_storage.allocator);
+            }
+        } else if (!m_storage.data) {
+            allocate_elements([&] { alloc_uninitialized_move(m_storage.allocator, other.begin(), other.end(), m_storage.data); });
         } else {
-            // Copy elements from the old and new arrays to the current array
-            std::copy(other.cbegin(), other.cend(), m_data.begin());
-            std::fill(m_data.begin() + other.size(), m_data.end(), T{});
+            std::move(other.begin(), other.end(), begin());
         }
-        
+
         return *this;
     }
 
     // Returns a reference to the element stored at the specified index in the array.
-    constexpr T& operator[](std::size_t index) noexcept { return m_data[index]; }
+    constexpr T& operator[](std::size_t index) noexcept { return begin()[index]; }
 
     // Returns a constant reference to the element stored at the specified index in the array.
-    constexpr const T& operator[](std::size_t index) const noexcept { 
-        if (index >= S) {
-            throw std::out_of_range("Index out of range");
+    constexpr const T& operator[](std::size_t index) const noexcept { return begin()[index]; }
+
+    friend constexpr bool operator==(const FixedArray& lhs, const FixedArray& rhs) noexcept {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return simd_equal(std::span<const T>(lhs.data()), std::span<const T>(rhs.data()));
+            }
         }
+        return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    }
 
-        return m_data[index]; 
+    friend constexpr bool operator!=(const FixedArray& lhs, const FixedArray& rhs) noexcept {
+        return !(lhs == rhs);
     }
 
-    constexpr bool operator==(const FixedArray& lhs, const FixedArray& rhs) noexcept { 
-        return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    // Lexicographic comparison of the elements
+    friend constexpr auto operator<=>(const FixedArray& lhs, const FixedArray& rhs) requires std::three_way_comparable<T> {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return simd_compare(std::span<const T>(lhs.data()), std::span<const T>(rhs.data()));
+            }
+        }
+        return std::lexicographical_compare_three_way(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
     }
 
-    constexpr bool operator!=(const FixedArray& lhs, const FixedArray& rhs) noexcept { 
-        return !(lhs == rhs); 
+    // Element-wise arithmetic, with another array or with one value for every element
+    constexpr FixedArray& operator+=(const FixedArray& rhs) requires requires(T& a, const T& b) { a += b; } {
+        fixed_array_detail::apply<S>(begin(), [&](T& element, std::size_t i) { element += rhs[i]; });
+        return *this;
+    }
+
+    constexpr FixedArray& operator-=(const FixedArray& rhs) requires requires(T& a, const T& b) { a -= b; } {
+        fixed_array_detail::apply<S>(begin(), [&](T& element, std::size_t i) { element -= rhs[i]; });
+        return *this;
+    }
+
+    constexpr FixedArray& operator*=(const FixedArray& rhs) requires requires(T& a, const T& b) { a *= b; } {
+        fixed_array_detail::apply<S>(begin(), [&](T& element, std::size_t i) { element *= rhs[i]; });
+        return *this;
+    }
+
+    constexpr FixedArray& operator/=(const FixedArray& rhs) requires requires(T& a, const T& b) { a /= b; } {
+        fixed_array_detail::apply<S>(begin(), [&](T& element, std::size_t i) { element /= rhs[i]; });
+        return *this;
+    }
+
+    constexpr FixedArray& operator+=(const T& value) requires requires(T& a, const T& b) { a += b; } {
+        fixed_array_detail::apply<S>(begin(), [&](T& element, std::size_t) { element += value; });
+        return *this;
+    }
+
+    constexpr FixedArray& operator-=(const T& value) requires requires(T& a, const T& b) { a -= b; } {
+        fixed_array_detail::apply<S>(begin(), [&](T& element, std::size_t) { element -= value; });
+        return *this;
+    }
+
+    constexpr FixedArray& operator*=(const T& value) requires requires(T& a, const T& b) { a *= b; } {
+        fixed_array_detail::apply<S>(begin(), [&](T& element, std::size_t) { element *= value; });
+        return *this;
+    }
+
+    constexpr FixedArray& operator/=(const T& value) requires requires(T& a, const T& b) { a /= b; } {
+        fixed_array_detail::apply<S>(begin(), [&](T& element, std::size_t) { element /= value; });
+        return *this;
     }
 
-    constexpr iterator begin() noexcept { return m_data.get(); }
-    constexpr const_iterator begin() const noexcept { return m_data.get(); }
+    friend constexpr FixedArray operator+(const FixedArray& lhs, const FixedArray& rhs) requires requires(FixedArray& result) { result += rhs; } {
+        FixedArray result(lhs);
+        result += rhs;
+        return result;
+    }
+
+    friend constexpr FixedArray operator-(const FixedArray& lhs, const FixedArray& rhs) requires requires(FixedArray& result) { result -= rhs; } {
+        FixedArray result(lhs);
+        result -= rhs;
+        return result;
+    }
+
+    friend constexpr FixedArray operator*(const FixedArray& lhs, const FixedArray& rhs) requires requires(FixedArray& result) { result *= rhs; } {
+        FixedArray result(lhs);
+        result *= rhs;
+        return result;
+    }
+
+    friend constexpr FixedArray operator/(const FixedArray& lhs, const FixedArray& rhs) requires requires(FixedArray& result) { result /= rhs; } {
+        FixedArray result(lhs);
+        result /= rhs;
+        return result;
+    }
+
+    friend constexpr FixedArray operator+(const FixedArray& lhs, const T& value) requires requires(FixedArray& result) { result += value; } {
+        FixedArray result(lhs);
+        result += value;
+        return result;
+    }
+
+    friend constexpr FixedArray operator-(const FixedArray& lhs, const T& value) requires requires(FixedArray& result) { result -= value; } {
+        FixedArray result(lhs);
+        result -= value;
+        return result;
+    }
+
+    friend constexpr FixedArray operator*(const FixedArray& lhs, const T& value) requires requires(FixedArray& result) { result *= value; } {
+        FixedArray result(lhs);
+        result *= value;
+        return result;
+    }
+
+    friend constexpr FixedArray operator/(const FixedArray& lhs, const T& value) requires requires(FixedArray& result) { result /= value; } {
+        FixedArray result(lhs);
+        result /= value;
+        return result;
+    }
+
+    // A value on the left applies to every element as the left operand
+    friend constexpr FixedArray operator+(const T& value, const FixedArray& rhs) requires requires(const T& a) { { a + a } -> std::convertible_to<T>; } {
+        FixedArray result(rhs);
+        fixed_array_detail::apply<S>(result.begin(), [&](T& element, std::size_t) { element = value + element; });
+        return result;
+    }
+
+    friend constexpr FixedArray operator-(const T& value, const FixedArray& rhs) requires requires(const T& a) { { a - a } -> std::convertible_to<T>; } {
+        FixedArray result(rhs);
+        fixed_array_detail::apply<S>(result.begin(), [&](T& element, std::size_t) { element = value - element; });
+        return result;
+    }
+
+    friend constexpr FixedArray operator*(const T& value, const FixedArray& rhs) requires requires(const T& a) { { a * a } -> std::convertible_to<T>; } {
+        FixedArray result(rhs);
+        fixed_array_detail::apply<S>(result.begin(), [&](T& element, std::size_t) { element = value * element; });
+        return result;
+    }
+
+    friend constexpr FixedArray operator/(const T& value, const FixedArray& rhs) requires requires(const T& a) { { a / a } -> std::convertible_to<T>; } {
+        FixedArray result(rhs);
+        fixed_array_detail::apply<S>(result.begin(), [&](T& element, std::size_t) { element = value / element; });
+        return result;
+    }
+
+    constexpr FixedArray operator-() const requires requires(const T& a) { { -a } -> std::convertible_to<T>; } {
+        FixedArray result(*this);
+        fixed_array_detail::apply<S>(result.begin(), [](T& element, std::size_t) { element = -element; });
+        return result;
+    }
+
+    constexpr iterator begin() noexcept { return storage(); }
+    constexpr const_iterator begin() const noexcept { return storage(); }
     constexpr const_iterator cbegin() const noexcept { return begin(); }
-    constexpr iterator end() noexcept { return m_data.get() + S; }
-    constexpr const_iterator end() const noexcept { return m_data.get() + S; }
+    constexpr iterator end() noexcept { return begin() + S; }
+    constexpr const_iterator end() const noexcept { return begin() + S; }
     constexpr const_iterator cend() const noexcept { return end(); }
     constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
     constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
@@ -99,10 +381,27 @@ public:
     constexpr const_reverse_iterator crend() const noexcept { return rend(); }
 
     // Returns a non-const span object that provides pointer access to the underlying stored data.
-    constexpr span data() noexcept { return { m_data.get(), S }; }
+    constexpr span data() noexcept { return span(begin(), S); }
 
     // Returns a const span object that provides read-only pointer access to the underlying stored data.
-    constexpr const_span data() const noexcept { return { m_data.get(), S }; }
+    constexpr const_span data() const noexcept { return const_span(begin(), S); }
+
+    // Returns an iterator to the first element equal to value, or end() if there is none
+    constexpr iterator find(const T& value) { return begin() + find_index(value); }
+    constexpr const_iterator find(const T& value) const { return begin() + find_index(value); }
+
+    // Checks whether an element equal to value is stored in the array
+    constexpr bool contains(const T& value) const { return find_index(value) != S; }
+
+    // Returns the number of elements equal to value
+    constexpr std::size_t count(const T& value) const {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return simd_count(std::span<const T>(data()), value);
+            }
+        }
+        return static_cast<std::size_t>(std::count(begin(), end(), value));
+    }
 
     // Returns size of array
     constexpr std::size_t size() const noexcept { return S; }
@@ -116,16 +415,16 @@ public:
             throw std::logic_error("Array is empty");
         }
 
-        return m_data[0];
+        return begin()[0];
     }
 
     // Returns a constant reference to first element in array
-    constexpr T& front() const {
+    constexpr const T& front() const {
         if (empty()) {
             throw std::logic_error("Array is empty");
         }
 
-        return m_data[0];
+        return begin()[0];
     }
 
     // Returns a reference to last element in array
@@ -134,46 +433,188 @@ public:
             throw std::logic_error("Array is empty");
         }
 
-        return m_data[S-1];
+        return begin()[S - 1];
     }
 
     // Returns a constant reference to last element in array
-    constexpr T& back() const {
+    constexpr const T& back() const {
         if (empty()) {
             throw std::logic_error("Array is empty");
         }
 
-        return m_data[S-1];
+        return begin()[S - 1];
     }
 
     // Access element by index, throws if not within the bounds of the array.
-    constexpr T& at(std::size_t index) const {
+    constexpr T& at(std::size_t index) {
         if (index >= S) {
             throw std::out_of_range("Index out of range");
         }
 
-        return m_data[index];
+        return begin()[index];
     }
 
-    // Fills array with a specified value
-    void fill(const T& value) noexcept {
+    // Access const element by index, throws if not within the bounds of the array.
+    constexpr const T& at(std::size_t index) const {
+        if (index >= S) {
+            throw std::out_of_range("Index out of range");
+        }
+
+        return begin()[index];
+    }
+
+    // Fills array with a specified value. A plain loop over contiguous storage, which compilers
+    // turn into vector stores for trivial T.
+    constexpr void fill(const T& value) noexcept(std::is_nothrow_copy_assignable_v<T>) {
         std::fill(begin(), end(), value);
     }
 
-    // Swaps data with target array
-    void swap(FixedArray& other) noexcept {
-        std::swap(m_data, other.m_data);
+    // Swaps data with target array. Inline arrays swap element-wise, heap arrays swap their buffers;
+    // their allocators are swapped only if they propagate on swap, otherwise they must be equal.
+    constexpr void swap(FixedArray& other) noexcept(!is_inline || std::is_nothrow_swappable_v<T>) {
+        if constexpr (is_inline) {
+            std::swap_ranges(begin(), end(), other.begin());
+        } else {
+            std::swap(m_storage.data, other.m_storage.data);
+            propagation_detail::swap_on_swap(m_storage.allocator, other.m_storage.allocator);
+        }
+    }
+
+    friend constexpr void swap(FixedArray& lhs, FixedArray& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
     }
 
 private:
-    std::unique_ptr<T[S]> m_data;
+    std::conditional_t<is_inline, InlineBuffer, HeapStorage> m_storage{};
+
+    constexpr std::size_t find_index(const T& value) const {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return simd_find(std::span<const T>(data()), value);
+            }
+        }
+        return static_cast<std::size_t>(std::find(begin(), end(), value) - begin());
+    }
+
+    constexpr T* storage() noexcept {
+        if constexpr (is_inline) {
+            return m_storage;
+        } else {
+            return m_storage.data;
+        }
+    }
+
+    constexpr const T* storage() const noexcept {
+        if constexpr (is_inline) {
+            return m_storage;
+        } else {
+            return m_storage.data;
+        }
+    }
 
-    void allocate_memory() {
-        std::uninitialized_fill_n(m_data.get(), S, T{});
-        m_data = m_allocator.allocate(S);
+    // Allocates the buffer and lets construct fill it, freeing the buffer again if that throws
+    template <class Construct>
+    void allocate_elements(Construct construct) {
+        m_storage.data = std::allocator_traits<Alloc>::allocate(m_storage.allocator, S);
+        try {
+            construct();
+        } catch (...) {
+            std::allocator_traits<Alloc>::deallocate(m_storage.allocator, m_storage.data, S);
+            m_storage.data = nullptr;
+            throw;
+        }
     }
 
     void deallocate_memory() {
-        m_allocator.deallocate(m_data, S);
+        if (m_storage.data) {
+            for (std::size_t i = 0; i < S; ++i) {
+                std::allocator_traits<Alloc>::destroy(m_storage.allocator, m_storage.data + i);
+            }
+            std::allocator_traits<Alloc>::deallocate(m_storage.allocator, m_storage.data, S);
+        }
     }
-};
\ No newline at end of file
+};
+
+// Fixed-size array keeping its elements in a single heap allocation, for sizes too large for the stack
+template <typename T, std::size_t S, typename Alloc = SimpleAllocator<T>>
+using HeapFixedArray = FixedArray<T, S, Alloc>;
+
+// Tuple-like access: get<I>(array) is checked at compile time
+template <std::size_t I, typename T, std::size_t S, typename Alloc>
+constexpr T& get(FixedArray<T, S, Alloc>& array) noexcept {
+    static_assert(I < S, "FixedArray index out of range");
+    return array[I];
+}
+
+template <std::size_t I, typename T, std::size_t S, typename Alloc>
+constexpr const T& get(const FixedArray<T, S, Alloc>& array) noexcept {
+    static_assert(I < S, "FixedArray index out of range");
+    return array[I];
+}
+
+template <std::size_t I, typename T, std::size_t S, typename Alloc>
+constexpr T&& get(FixedArray<T, S, Alloc>&& array) noexcept {
+    static_assert(I < S, "FixedArray index out of range");
+    return std::move(array[I]);
+}
+
+// Folds every element into init with op, which must be associative and commutative for arrays
+// longer than fixed_array_detail::unroll_limit; see fixed_array_detail::reduce for the order
+template <typename T, std::size_t S, typename Alloc, typename U, typename Op>
+constexpr U reduce(const FixedArray<T, S, Alloc>& array, U init, Op op) {
+    return fixed_array_detail::reduce<S>(std::move(init), [&](std::size_t i) -> const T& { return array[i]; }, op);
+}
+
+// Sum of the elements, T{} for an empty array
+template <typename T, std::size_t S, typename Alloc>
+constexpr T sum(const FixedArray<T, S, Alloc>& array) {
+    return reduce(array, T{}, std::plus<>());
+}
+
+// Sum of the element-wise products of two arrays. Floating point results match between compile time
+// and run time unless the compiler fuses the multiply-adds (FMA with -ffp-contract=fast).
+template <typename T, std::size_t S, typename LhsAlloc, typename RhsAlloc>
+constexpr T dot(const FixedArray<T, S, LhsAlloc>& lhs, const FixedArray<T, S, RhsAlloc>& rhs) {
+    return fixed_array_detail::reduce<S>(T{}, [&](std::size_t i) { return lhs[i] * rhs[i]; }, std::plus<>());
+}
+
+// Smallest and largest element; throws on an empty array. Arithmetic types run the SIMD kernel of
+// simdKernels.h outside constant evaluation.
+template <typename T, std::size_t S, typename Alloc>
+constexpr std::pair<T, T> min_max(const FixedArray<T, S, Alloc>& array) {
+    if constexpr (S == 0) {
+        throw std::logic_error("Array is empty");
+    } else {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return simd_min_max(std::span<const T>(array.data()));
+            }
+        }
+        return fixed_array_detail::reduce<S>(std::pair<T, T>(array[0], array[0]),
+            [&](std::size_t i) { return std::pair<T, T>(array[i], array[i]); },
+            [](const std::pair<T, T>& lhs, const std::pair<T, T>& rhs) {
+                return std::pair<T, T>(rhs.first < lhs.first ? rhs.first : lhs.first, lhs.second < rhs.second ? rhs.second : lhs.second);
+            });
+    }
+}
+
+// Builds the array whose element i is generator(i), meant for tables computed at compile time:
+//     constexpr auto squares = make_table<256>([](std::size_t i) { return i * i; });
+template <std::size_t S, typename Generator>
+constexpr auto make_table(Generator generator) {
+    using T = std::remove_cvref_t<std::invoke_result_t<Generator&, std::size_t>>;
+    FixedArray<T, S> table;
+    for (std::size_t i = 0; i < S; ++i) {
+        table[i] = generator(i);
+    }
+    return table;
+}
+
+template <typename T, std::size_t S, typename Alloc>
+struct std::tuple_size<FixedArray<T, S, Alloc>> : std::integral_constant<std::size_t, S> {};
+
+template <std::size_t I, typename T, std::size_t S, typename Alloc>
+struct std::tuple_element<I, FixedArray<T, S, Alloc>> {
+    static_assert(I < S, "FixedArray index out of range");
+    using type = T;
+};
@@ -0,0 +1,713 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../algorithms/threadPool.h"
+#include "dynamicArray.h"
+#include "map.h"
+#include "priority_queue.h"
+
+// Graphs over dense vertex ids 0 ... vertex_count() - 1.
+// Graph is the immutable compressed sparse row form the algorithms below run on: the targets of all
+// arcs sit in one array grouped by source vertex, with an offset array marking where each vertex's
+// arcs begin, so a traversal streams through two flat arrays instead of chasing one allocation per
+// edge. AdjacencyGraph is the mutable form to assemble a graph edge by edge before freezing it.
+// Weight = void makes a graph unweighted and stores no weights at all.
+
+// Edge of an edge list
+template <typename Weight = void, typename Vertex = std::uint32_t>
+struct Edge {
+    Vertex source;
+    Vertex target;
+    Weight weight;
+};
+
+template <typename Vertex>
+struct Edge<void, Vertex> {
+    Vertex source;
+    Vertex target;
+};
+
+// How a Graph stores the edges it is built from
+enum class GraphKind {
+    // Each edge is an arc from source to target
+    Directed,
+    // Each edge is traversable both ways, stored as two arcs
+    Undirected,
+    // Directed, with an additional index of the arcs into each vertex
+    Bidirectional,
+};
+
+namespace graph_detail {
+    struct NoWeight {};
+
+    template <typename Weight>
+    using weight_value = std::conditional_t<std::is_void_v<Weight>, NoWeight, Weight>;
+
+    template <typename Weight>
+    using weight_array = std::conditional_t<std::is_void_v<Weight>, NoWeight, DynamicArray<weight_value<Weight>>>;
+
+    template <typename Weight, typename Vertex>
+    struct Csr {
+        // Arcs of vertex v are targets[offsets[v]] ... targets[offsets[v + 1] - 1]
+        DynamicArray<std::size_t> offsets;
+        DynamicArray<Vertex> targets;
+        [[no_unique_address]] weight_array<Weight> weights;
+
+        // Counting sort of the arcs emit_all reports by source, O(V + E). Arcs keep their relative
+        // order within a source.
+        template <class EmitAll>
+        static Csr build(std::size_t vertex_count, EmitAll emit_all) {
+            Csr csr;
+            csr.offsets.assign(vertex_count + 1, 0);
+            emit_all([&](Vertex source, Vertex, const weight_value<Weight>&) { ++csr.offsets[source + 1]; });
+            for (std::size_t v = 0; v < vertex_count; ++v) {
+                csr.offsets[v + 1] += csr.offsets[v];
+            }
+
+            const std::size_t arcs = csr.offsets[vertex_count];
+            csr.targets.resize(arcs);
+            if constexpr (!std::is_void_v<Weight>) {
+                csr.weights.resize(arcs);
+            }
+            DynamicArray<std::size_t> cursor;
+            cursor.assign(csr.offsets.begin(), csr.offsets.end() - 1);
+            emit_all([&](Vertex source, Vertex target, const weight_value<Weight>& weight) {
+                const std::size_t at = cursor[source]++;
+                csr.targets[at] = target;
+                if constexpr (!std::is_void_v<Weight>) {
+                    csr.weights[at] = weight;
+                }
+            });
+            return csr;
+        }
+
+        std::span<const Vertex> targets_of(std::size_t v) const noexcept {
+            return std::span<const Vertex>(targets.begin() + offsets[v], targets.begin() + offsets[v + 1]);
+        }
+
+        std::span<const weight_value<Weight>> weights_of(std::size_t v) const noexcept
+            requires(!std::is_void_v<Weight>) {
+            return std::span<const Weight>(weights.begin() + offsets[v], weights.begin() + offsets[v + 1]);
+        }
+    };
+
+    // Runs fn(begin, end, worker) over [0, count) on pool, or as a single chunk without one
+    template <class Fn>
+    void for_each_chunk(ThreadPool* pool, std::size_t count, std::size_t grain, Fn&& fn) {
+        if (pool != nullptr) {
+            pool->parallel_for(count, grain, fn);
+        } else if (count > 0) {
+            fn(std::size_t{0}, count, std::size_t{0});
+        }
+    }
+
+    inline std::size_t worker_count(const ThreadPool* pool) noexcept {
+        return pool != nullptr ? pool->concurrency() : 1;
+    }
+
+    template <typename T>
+    std::atomic_ref<T> shared(T& value) noexcept {
+        static_assert(std::atomic_ref<T>::required_alignment == alignof(T));
+        return std::atomic_ref<T>(value);
+    }
+}
+
+template <typename Weight = void, typename Vertex = std::uint32_t>
+class AdjacencyGraph;
+
+// Immutable graph in compressed sparse row form
+template <typename Weight = void, typename Vertex = std::uint32_t>
+class Graph {
+    static_assert(std::unsigned_integral<Vertex>, "Vertex ids must be an unsigned integer type");
+
+public:
+    using vertex_type = Vertex;
+    using weight_type = Weight;
+    using edge_type = Edge<Weight, Vertex>;
+    using size_type = std::size_t;
+
+    static constexpr bool weighted = !std::is_void_v<Weight>;
+
+    // Marks missing vertices, e.g. the parent of an unreachable vertex after a bfs()
+    static constexpr Vertex no_vertex = std::numeric_limits<Vertex>::max();
+
+    Graph() = default;
+
+    // Builds the graph on vertex_count vertices from an edge list in O(V + E)
+    Graph(size_type vertex_count, const DynamicArray<edge_type>& edges, GraphKind kind = GraphKind::Directed)
+        : m_kind(kind), m_edge_count(edges.size()) {
+        check_vertex_count(vertex_count);
+        for (const edge_type& edge : edges) {
+            if (edge.source >= vertex_count || edge.target >= vertex_count) {
+                throw std::out_of_range("Vertex out of range");
+            }
+        }
+        build(vertex_count, [&](auto&& emit) {
+            for (const edge_type& edge : edges) {
+                if constexpr (weighted) {
+                    emit(edge.source, edge.target, edge.weight);
+                } else {
+                    emit(edge.source, edge.target, graph_detail::NoWeight{});
+                }
+            }
+        });
+    }
+
+    // Freezes the arcs of a mutable graph
+    explicit Graph(const AdjacencyGraph<Weight, Vertex>& graph, GraphKind kind = GraphKind::Directed)
+        : m_kind(kind), m_edge_count(graph.edge_count()) {
+        build(graph.vertex_count(), [&](auto&& emit) { graph.for_each_edge(emit); });
+    }
+
+    size_type vertex_count() const noexcept { return m_out.offsets.size() == 0 ? 0 : m_out.offsets.size() - 1; }
+
+    // Number of edges the graph was built from; an undirected graph stores up to twice as many arcs
+    size_type edge_count() const noexcept { return m_edge_count; }
+
+    size_type arc_count() const noexcept { return m_out.targets.size(); }
+
+    GraphKind kind() const noexcept { return m_kind; }
+
+    // Targets of the arcs out of v
+    std::span<const Vertex> neighbors(Vertex v) const noexcept { return m_out.targets_of(v); }
+
+    // Weights of the arcs out of v, in the order of neighbors(v)
+    std::span<const graph_detail::weight_value<Weight>> weights(Vertex v) const noexcept requires weighted {
+        return m_out.weights_of(v);
+    }
+
+    size_type out_degree(Vertex v) const noexcept { return m_out.offsets[v + 1] - m_out.offsets[v]; }
+
+    // Whether in_neighbors() is available: undirected and bidirectional graphs
+    bool has_in_edges() const noexcept { return m_kind != GraphKind::Directed; }
+
+    // Sources of the arcs into v
+    std::span<const Vertex> in_neighbors(Vertex v) const { return in_csr().targets_of(v); }
+
+    std::span<const graph_detail::weight_value<Weight>> in_weights(Vertex v) const requires weighted {
+        return in_csr().weights_of(v);
+    }
+
+    size_type in_degree(Vertex v) const {
+        const auto& csr = in_csr();
+        return csr.offsets[v + 1] - csr.offsets[v];
+    }
+
+    // The raw CSR arrays: arcs of v are targets()[offsets()[v]] ... targets()[offsets()[v + 1] - 1]
+    std::span<const size_type> offsets() const noexcept { return m_out.offsets.data(); }
+    std::span<const Vertex> targets() const noexcept { return m_out.targets.data(); }
+
+private:
+    using Csr = graph_detail::Csr<Weight, Vertex>;
+
+    Csr m_out;
+    Csr m_in;
+    GraphKind m_kind = GraphKind::Directed;
+    size_type m_edge_count = 0;
+
+    static void check_vertex_count(size_type vertex_count) {
+        if (vertex_count >= no_vertex) {
+            throw std::length_error("Too many vertices for the vertex type");
+        }
+    }
+
+    const Csr& in_csr() const {
+        if (m_kind == GraphKind::Directed) {
+            throw std::logic_error("Graph has no in-edges");
+        }
+        return m_kind == GraphKind::Undirected ? m_out : m_in;
+    }
+
+    template <class ForEachEdge>
+    void build(size_type vertex_count, ForEachEdge for_each_edge) {
+        const bool undirected = m_kind == GraphKind::Undirected;
+        m_out = Csr::build(vertex_count, [&](auto&& emit) {
+            for_each_edge([&](Vertex source, Vertex target, const graph_detail::weight_value<Weight>& weight) {
+                emit(source, target, weight);
+                // A self-loop is one arc either way
+                if (undirected && source != target) {
+                    emit(target, source, weight);
+                }
+            });
+        });
+        if (m_kind == GraphKind::Bidirectional) {
+            m_in = Csr::build(vertex_count, [&](auto&& emit) {
+                for_each_edge([&](Vertex source, Vertex target, const graph_detail::weight_value<Weight>& weight) {
+                    emit(target, source, weight);
+                });
+            });
+        }
+    }
+};
+
+// Mutable directed graph with one arc array per vertex
+template <typename Weight, typename Vertex>
+class AdjacencyGraph {
+    static_assert(std::unsigned_integral<Vertex>, "Vertex ids must be an unsigned integer type");
+
+public:
+    using vertex_type = Vertex;
+    using weight_type = Weight;
+    using size_type = std::size_t;
+
+    static constexpr bool weighted = !std::is_void_v<Weight>;
+
+    AdjacencyGraph() = default;
+
+    explicit AdjacencyGraph(size_type vertex_count) : m_vertices(vertex_count) {}
+
+    size_type vertex_count() const noexcept { return m_vertices.size(); }
+    size_type edge_count() const noexcept { return m_edge_count; }
+
+    // Adds a vertex without arcs and returns its id
+    Vertex add_vertex() {
+        if (m_vertices.size() >= Graph<Weight, Vertex>::no_vertex - 1) {
+            throw std::length_error("Too many vertices for the vertex type");
+        }
+        m_vertices.emplace_back();
+        return static_cast<Vertex>(m_vertices.size() - 1);
+    }
+
+    void add_edge(Vertex source, Vertex target) requires(!weighted) {
+        check(target);
+        at(source).targets.push_back(target);
+        ++m_edge_count;
+    }
+
+    void add_edge(Vertex source, Vertex target, graph_detail::weight_value<Weight> weight) requires weighted {
+        check(target);
+        Arcs& arcs = at(source);
+        arcs.targets.push_back(target);
+        try {
+            arcs.weights.push_back(std::move(weight));
+        } catch (...) {
+            arcs.targets.pop_back();
+            throw;
+        }
+        ++m_edge_count;
+    }
+
+    // Removes one arc from source to target. The last arc of source takes its place, so the order
+    // of neighbors(source) changes.
+    bool remove_edge(Vertex source, Vertex target) {
+        check(target);
+        Arcs& arcs = at(source);
+        for (size_type i = 0; i < arcs.targets.size(); ++i) {
+            if (arcs.targets[i] == target) {
+                arcs.targets[i] = arcs.targets.back();
+                arcs.targets.pop_back();
+                if constexpr (weighted) {
+                    arcs.weights[i] = std::move(arcs.weights.back());
+                    arcs.weights.pop_back();
+                }
+                --m_edge_count;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool contains_edge(Vertex source, Vertex target) const {
+        for (Vertex v : at(source).targets) {
+            if (v == target) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::span<const Vertex> neighbors(Vertex v) const { return at(v).targets.data(); }
+
+    std::span<const graph_detail::weight_value<Weight>> weights(Vertex v) const requires weighted {
+        return at(v).weights.data();
+    }
+
+    size_type out_degree(Vertex v) const { return at(v).targets.size(); }
+
+    // Calls fn(source, target, weight) for every arc; weight is an empty tag in unweighted graphs
+    template <class Fn>
+    void for_each_edge(Fn&& fn) const {
+        for (size_type v = 0; v < m_vertices.size(); ++v) {
+            const Arcs& arcs = m_vertices[v];
+            for (size_type i = 0; i < arcs.targets.size(); ++i) {
+                if constexpr (weighted) {
+                    fn(static_cast<Vertex>(v), arcs.targets[i], arcs.weights[i]);
+                } else {
+                    fn(static_cast<Vertex>(v), arcs.targets[i], graph_detail::NoWeight{});
+                }
+            }
+        }
+    }
+
+    void clear() noexcept {
+        m_vertices.clear();
+        m_edge_count = 0;
+    }
+
+private:
+    struct Arcs {
+        DynamicArray<Vertex> targets;
+        [[no_unique_address]] graph_detail::weight_array<Weight> weights;
+    };
+
+    DynamicArray<Arcs> m_vertices;
+    size_type m_edge_count = 0;
+
+    void check(Vertex v) const {
+        if (v >= m_vertices.size()) {
+            throw std::out_of_range("Vertex out of range");
+        }
+    }
+
+    Arcs& at(Vertex v) {
+        check(v);
+        return m_vertices[v];
+    }
+
+    const Arcs& at(Vertex v) const {
+        check(v);
+        return m_vertices[v];
+    }
+};
+
+namespace graph_detail {
+    // Direction-optimizing switch points (Beamer et al.): go bottom-up once the frontier's arcs
+    // exceed 1 / alpha of the arcs still unexplored, and back once it shrinks below 1 / beta of
+    // the vertices
+    inline constexpr std::size_t bfs_alpha = 15;
+    inline constexpr std::size_t bfs_beta = 18;
+
+    // Vertices per bottom-up chunk, a multiple of 64 so every chunk owns whole bitmap words
+    inline constexpr std::size_t bottom_up_grain = 64 * 64;
+    inline constexpr std::size_t top_down_grain = 256;
+
+    // Expands the frontier along out-arcs, claiming each unvisited vertex with a CAS on its parent.
+    // Returns the number of arcs out of the new frontier.
+    template <typename Weight, typename Vertex>
+    std::size_t top_down_step(const Graph<Weight, Vertex>& graph, DynamicArray<Vertex>& parent,
+        DynamicArray<Vertex>& frontier, DynamicArray<DynamicArray<Vertex>>& found, ThreadPool* pool) {
+        constexpr Vertex none = Graph<Weight, Vertex>::no_vertex;
+        std::atomic<std::size_t> scout{0};
+        for_each_chunk(pool, frontier.size(), top_down_grain, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+            DynamicArray<Vertex>& next = found[worker];
+            std::size_t arcs = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                const Vertex u = frontier[i];
+                for (Vertex v : graph.neighbors(u)) {
+                    auto claim = shared(parent[v]);
+                    Vertex expected = none;
+                    if (claim.load(std::memory_order_relaxed) == none &&
+                        claim.compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+                        next.push_back(v);
+                        arcs += graph.out_degree(v);
+                    }
+                }
+            }
+            scout.fetch_add(arcs, std::memory_order_relaxed);
+        });
+
+        frontier.clear();
+        for (DynamicArray<Vertex>& next : found) {
+            frontier.insert(frontier.end(), next.begin(), next.end());
+            next.clear();
+        }
+        return scout.load(std::memory_order_relaxed);
+    }
+
+    // Lets every unvisited vertex look for a parent among its in-neighbours in the frontier bitmap.
+    // Returns the size of the new frontier.
+    template <typename Weight, typename Vertex>
+    std::size_t bottom_up_step(const Graph<Weight, Vertex>& graph, DynamicArray<Vertex>& parent,
+        const DynamicArray<std::uint64_t>& frontier, DynamicArray<std::uint64_t>& next, ThreadPool* pool) {
+        constexpr Vertex none = Graph<Weight, Vertex>::no_vertex;
+        std::atomic<std::size_t> awake{0};
+        for_each_chunk(pool, graph.vertex_count(), bottom_up_grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+            std::size_t found = 0;
+            for (std::size_t word = begin / 64; word < (end + 63) / 64; ++word) {
+                next[word] = 0;
+            }
+            for (std::size_t v = begin; v < end; ++v) {
+                if (parent[v] != none) {
+                    continue;
+                }
+                for (Vertex u : graph.in_neighbors(static_cast<Vertex>(v))) {
+                    if (frontier[u / 64] >> (u % 64) & 1) {
+                        parent[v] = u;
+                        next[v / 64] |= std::uint64_t{1} << (v % 64);
+                        ++found;
+                        break;
+                    }
+                }
+            }
+            awake.fetch_add(found, std::memory_order_relaxed);
+        });
+        return awake.load(std::memory_order_relaxed);
+    }
+}
+
+// Breadth-first search from source. Returns the BFS tree as parent array: parent[source] is source,
+// unreachable vertices have Graph::no_vertex.
+// On graphs with in-edges the search switches to bottom-up steps while the frontier is large, where
+// unvisited vertices look for a visited in-neighbour instead of the frontier scanning all its arcs.
+// With a pool the steps run in parallel; the parent chosen for a vertex then depends on timing,
+// its depth does not.
+template <typename Weight, typename Vertex>
+DynamicArray<Vertex> bfs(const Graph<Weight, Vertex>& graph, Vertex source, ThreadPool* pool = nullptr) {
+    using namespace graph_detail;
+    constexpr Vertex none = Graph<Weight, Vertex>::no_vertex;
+    const std::size_t vertex_count = graph.vertex_count();
+    if (source >= vertex_count) {
+        throw std::out_of_range("Vertex out of range");
+    }
+
+    DynamicArray<Vertex> parent;
+    parent.assign(vertex_count, none);
+    parent[source] = source;
+
+    DynamicArray<Vertex> frontier{source};
+    DynamicArray<DynamicArray<Vertex>> found(worker_count(pool));
+    DynamicArray<std::uint64_t> front_bits;
+    DynamicArray<std::uint64_t> next_bits;
+
+    std::size_t unexplored = graph.arc_count();
+    std::size_t scout = graph.out_degree(source);
+    while (!frontier.empty()) {
+        if (graph.has_in_edges() && scout > unexplored / bfs_alpha) {
+            if (front_bits.empty()) {
+                front_bits.assign((vertex_count + 63) / 64, 0);
+                next_bits.assign((vertex_count + 63) / 64, 0);
+            } else {
+                std::fill(front_bits.begin(), front_bits.end(), 0);
+            }
+            for (Vertex v : frontier) {
+                front_bits[v / 64] |= std::uint64_t{1} << (v % 64);
+            }
+
+            std::size_t awake = frontier.size();
+            std::size_t previous = 0;
+            do {
+                previous = awake;
+                awake = bottom_up_step(graph, parent, front_bits, next_bits, pool);
+                front_bits.swap(next_bits);
+            } while (awake >= previous || awake > vertex_count / bfs_beta);
+
+            frontier.clear();
+            for (std::size_t word = 0; word < front_bits.size(); ++word) {
+                for (std::uint64_t bits = front_bits[word]; bits != 0; bits &= bits - 1) {
+                    frontier.push_back(static_cast<Vertex>(word * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+                }
+            }
+            scout = 1;
+        } else {
+            unexplored -= std::min(scout, unexplored);
+            scout = top_down_step(graph, parent, frontier, found, pool);
+        }
+    }
+    return parent;
+}
+
+// Marks unreachable vertices in the results of dijkstra() and delta_stepping()
+template <typename Weight>
+inline constexpr Weight unreachable = std::numeric_limits<Weight>::has_infinity
+    ? std::numeric_limits<Weight>::infinity() : std::numeric_limits<Weight>::max();
+
+namespace graph_detail {
+    template <typename Weight>
+    void check_weight(const Weight& weight) {
+        if constexpr (std::is_signed_v<Weight>) {
+            if (weight < Weight{}) {
+                throw std::invalid_argument("Negative edge weight");
+            }
+        }
+    }
+}
+
+// Single source shortest path distances from source, unreachable<Weight> for vertices without a
+// path. Runs Dijkstra's algorithm on a 4-ary PriorityQueue with lazy deletion: an improved vertex is
+// pushed again and its stale entries are skipped when popped, cheaper than decrease_key bookkeeping.
+// Throws std::invalid_argument on a negative weight.
+template <typename Weight, typename Vertex>
+    requires std::is_arithmetic_v<Weight>
+DynamicArray<Weight> dijkstra(const Graph<Weight, Vertex>& graph, Vertex source) {
+    const std::size_t vertex_count = graph.vertex_count();
+    if (source >= vertex_count) {
+        throw std::out_of_range("Vertex out of range");
+    }
+
+    DynamicArray<Weight> distance;
+    distance.assign(vertex_count, unreachable<Weight>);
+    distance[source] = Weight{};
+
+    using Entry = std::pair<Weight, Vertex>;
+    PriorityQueue<Entry, std::greater<Entry>> queue;
+    queue.push(Entry{Weight{}, source});
+    while (!queue.empty()) {
+        const auto [d, u] = queue.top();
+        queue.pop();
+        if (d > distance[u]) {
+            continue;
+        }
+        const auto targets = graph.neighbors(u);
+        const auto weights = graph.weights(u);
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            graph_detail::check_weight(weights[i]);
+            const Weight candidate = d + weights[i];
+            if (candidate < distance[targets[i]]) {
+                distance[targets[i]] = candidate;
+                queue.push(Entry{candidate, targets[i]});
+            }
+        }
+    }
+    return distance;
+}
+
+// Single source shortest path distances like dijkstra(), computed by delta-stepping so the
+// relaxations can run in parallel on pool. Vertices are kept in buckets of distance width delta;
+// the lowest bucket is relaxed in parallel, with an atomic minimum on each distance, until it stays
+// empty. A small delta approaches Dijkstra's order, a large one Bellman-Ford's parallelism.
+template <typename Weight, typename Vertex>
+    requires std::is_arithmetic_v<Weight>
+DynamicArray<Weight> delta_stepping(const Graph<Weight, Vertex>& graph, Vertex source, Weight delta,
+    ThreadPool* pool = nullptr) {
+    using namespace graph_detail;
+    const std::size_t vertex_count = graph.vertex_count();
+    if (source >= vertex_count) {
+        throw std::out_of_range("Vertex out of range");
+    }
+    if (!(delta > Weight{})) {
+        throw std::invalid_argument("Delta must be positive");
+    }
+
+    DynamicArray<Weight> distance;
+    distance.assign(vertex_count, unreachable<Weight>);
+    distance[source] = Weight{};
+    auto bucket_of = [delta](Weight d) { return static_cast<std::size_t>(d / delta); };
+
+    Map<std::size_t, DynamicArray<Vertex>> buckets;
+    buckets[0].push_back(source);
+    DynamicArray<DynamicArray<Vertex>> improved(worker_count(pool));
+    std::atomic<bool> negative{false};
+
+    while (!buckets.empty()) {
+        const std::size_t current = buckets.begin()->first;
+        DynamicArray<Vertex> frontier = std::move(buckets.begin()->second);
+        buckets.erase(buckets.begin());
+
+        while (!frontier.empty()) {
+            for_each_chunk(pool, frontier.size(), top_down_grain, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                DynamicArray<Vertex>& out = improved[worker];
+                for (std::size_t i = begin; i < end; ++i) {
+                    const Vertex u = frontier[i];
+                    const Weight d = shared(distance[u]).load(std::memory_order_relaxed);
+                    // Entries left behind by a later improvement within the bucket are relaxed
+                    // again, entries of a vertex that moved to a lower bucket were settled there
+                    if (bucket_of(d) != current) {
+                        continue;
+                    }
+                    const auto targets = graph.neighbors(u);
+                    const auto weights = graph.weights(u);
+                    for (std::size_t a = 0; a < targets.size(); ++a) {
+                        if constexpr (std::is_signed_v<Weight>) {
+                            if (weights[a] < Weight{}) {
+                                negative.store(true, std::memory_order_relaxed);
+                                return;
+                            }
+                        }
+                        const Weight candidate = d + weights[a];
+                        auto target = shared(distance[targets[a]]);
+                        Weight known = target.load(std::memory_order_relaxed);
+                        while (candidate < known) {
+                            if (target.compare_exchange_weak(known, candidate, std::memory_order_relaxed)) {
+                                out.push_back(targets[a]);
+                                break;
+                            }
+                        }
+                    }
+                }
+            });
+            if (negative.load(std::memory_order_relaxed)) {
+                throw std::invalid_argument("Negative edge weight");
+            }
+
+            frontier.clear();
+            for (DynamicArray<Vertex>& out : improved) {
+                for (Vertex v : out) {
+                    const std::size_t bucket = bucket_of(distance[v]);
+                    if (bucket == current) {
+                        frontier.push_back(v);
+                    } else {
+                        buckets[bucket].push_back(v);
+                    }
+                }
+                out.clear();
+            }
+        }
+    }
+    return distance;
+}
+
+// Labels the (weakly) connected components: label[v] is the smallest vertex of v's component.
+// Builds a union-find forest over the arcs, hooking the larger root under the smaller with a CAS so
+// chunks of vertices can be linked in parallel on pool, then flattens every vertex onto its root.
+template <typename Weight, typename Vertex>
+DynamicArray<Vertex> connected_components(const Graph<Weight, Vertex>& graph, ThreadPool* pool = nullptr) {
+    using namespace graph_detail;
+    const std::size_t vertex_count = graph.vertex_count();
+    DynamicArray<Vertex> label(vertex_count);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+        label[v] = static_cast<Vertex>(v);
+    }
+
+    // Root of v, halving the path on the way: pointing v at its grandparent keeps it below the
+    // same root, so this is safe concurrently with other finds and hooks
+    auto find = [&](Vertex v) {
+        while (true) {
+            const Vertex up = shared(label[v]).load(std::memory_order_relaxed);
+            if (up == v) {
+                return v;
+            }
+            const Vertex grand = shared(label[up]).load(std::memory_order_relaxed);
+            if (grand != up) {
+                shared(label[v]).store(grand, std::memory_order_relaxed);
+            }
+            v = grand;
+        }
+    };
+
+    for_each_chunk(pool, vertex_count, top_down_grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t u = begin; u < end; ++u) {
+            for (Vertex v : graph.neighbors(static_cast<Vertex>(u))) {
+                Vertex a = find(static_cast<Vertex>(u));
+                Vertex b = find(v);
+                while (a != b) {
+                    if (a < b) {
+                        std::swap(a, b);
+                    }
+                    Vertex expected = a;
+                    if (shared(label[a]).compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+                        break;
+                    }
+                    a = find(a);
+                    b = find(b);
+                }
+            }
+        }
+    });
+
+    for_each_chunk(pool, vertex_count, bottom_up_grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t v = begin; v < end; ++v) {
+            shared(label[v]).store(find(static_cast<Vertex>(v)), std::memory_order_relaxed);
+        }
+    });
+    return label;
+}
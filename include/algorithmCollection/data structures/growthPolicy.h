@@ -0,0 +1,98 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+
+// Capacity policies for contiguous containers such as DynamicArray.
+
+// Growth policies decide the capacity a contiguous container moves to when an insertion needs more
+// room than it has. A policy is any type with a static
+//     std::size_t next_capacity(std::size_t capacity, std::size_t required)
+// returning the new capacity for a container currently holding `capacity` slots that needs at least
+// `required`. Containers never allocate less than `required`, whatever the policy returns.
+
+template <typename Policy>
+concept GrowthPolicy = requires(std::size_t capacity, std::size_t required) {
+    { Policy::next_capacity(capacity, required) } -> std::convertible_to<std::size_t>;
+};
+
+// Multiplies the capacity by Numerator / Denominator, so n appends cost amortized O(1) reallocations.
+// Smaller factors waste less memory, larger ones reallocate less often.
+template <std::size_t Numerator, std::size_t Denominator = 1>
+struct GrowthFactor {
+    static_assert(Denominator > 0 && Numerator > Denominator, "Growth factor must be greater than one");
+
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required) noexcept {
+        std::size_t grown = capacity / Denominator * Numerator + capacity % Denominator * Numerator / Denominator;
+        if (grown <= capacity) {
+            grown = capacity + 1;
+        }
+        return grown < required ? required : grown;
+    }
+};
+
+// Doubles the capacity; the default policy of DynamicArray
+using DoublingGrowth = GrowthFactor<2>;
+
+// Grows by half of the capacity, which lets freed blocks be reused by later growth steps
+using HalfGrowth = GrowthFactor<3, 2>;
+
+// Grows by a fixed number of elements. Memory overhead is bounded by Step, but n appends cost O(n / Step)
+// reallocations, so it suits containers whose final size is roughly known.
+template <std::size_t Step>
+struct FixedStepGrowth {
+    static_assert(Step > 0, "Growth step must be positive");
+
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required) noexcept {
+        std::size_t grown = capacity + Step;
+        return grown < required ? required : grown;
+    }
+};
+
+// Shrink policies decide when a contiguous container gives capacity back. A policy is any type with
+//     static std::size_t shrink_capacity(std::size_t size, std::size_t capacity)
+// returning the capacity to keep after an erase leaves `size` elements in `capacity` slots (returning
+// `capacity` keeps the buffer), and
+//     static constexpr bool explicit_shrink
+// telling whether shrink_to_fit and shrink_to may release memory at all.
+
+template <typename Policy>
+concept ShrinkPolicy = requires(std::size_t size, std::size_t capacity) {
+    { Policy::shrink_capacity(size, capacity) } -> std::convertible_to<std::size_t>;
+    { Policy::explicit_shrink } -> std::convertible_to<bool>;
+};
+
+// Shrinks once the size falls to a quarter of the capacity, and then only to twice the size. After a
+// shrink the container can grow back by the same amount or lose half of its elements again before
+// the next reallocation, so a size oscillating around any value does not reallocate on every
+// insert/erase pair. Capacities of at most MinCapacity are never shrunk.
+template <std::size_t MinCapacity = 16>
+struct HysteresisShrink {
+    static constexpr bool explicit_shrink = true;
+
+    static constexpr std::size_t shrink_capacity(std::size_t size, std::size_t capacity) noexcept {
+        if (capacity <= MinCapacity || size > capacity / 4) {
+            return capacity;
+        }
+        std::size_t kept = size * 2;
+        return kept < MinCapacity ? MinCapacity : kept;
+    }
+};
+
+// Erasing never releases memory; only shrink_to_fit and shrink_to do
+struct ExplicitShrink {
+    static constexpr bool explicit_shrink = true;
+
+    static constexpr std::size_t shrink_capacity(std::size_t, std::size_t capacity) noexcept {
+        return capacity;
+    }
+};
+
+// Capacity is never released before the container is cleared or destroyed, shrink_to_fit and
+// shrink_to included. For latency critical containers that must not reallocate once warmed up.
+struct NeverShrink {
+    static constexpr bool explicit_shrink = false;
+
+    static constexpr std::size_t shrink_capacity(std::size_t, std::size_t capacity) noexcept {
+        return capacity;
+    }
+};
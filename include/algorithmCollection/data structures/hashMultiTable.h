@@ -0,0 +1,387 @@
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "hashTable.h"
+#include "smallDynamicArray.h"
+
+// Policy of the table inside a multi container: one slot per distinct key, holding every element with
+// that key in insertion order. The first element of a group lives in the slot itself, larger groups
+// spill into one contiguous buffer.
+template <typename Policy, typename Alloc>
+struct KeyGroupPolicy {
+    using key_type = typename Policy::key_type;
+    using element_type = typename Policy::value_type;
+    using element_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<element_type>;
+    using value_type = SmallDynamicArray<element_type, 1, element_allocator>;
+
+    static constexpr bool constant_iterators = false;
+
+    static const key_type& key(const value_type& group) noexcept { return Policy::key(group[0]); }
+
+    static value_type&& transfer(value_type& group) noexcept { return std::move(group); }
+};
+
+// Hash table engine of the multi containers. Elements with equal keys are stored next to each other,
+// so equal_range and count are a single scan over contiguous memory and iteration visits equal
+// elements in the order they were inserted.
+// Inserting may move elements of any group and erasing may move elements of the same group, which
+// invalidates iterators, pointers and references to them.
+template <typename Policy, typename Hash, typename Eq, typename Alloc>
+class HashMultiTable {
+    using GroupPolicy = KeyGroupPolicy<Policy, Alloc>;
+    using GroupTable = HashTable<GroupPolicy, Hash, Eq, Alloc>;
+    using group_type = typename GroupPolicy::value_type;
+    using element_allocator = typename GroupPolicy::element_allocator;
+
+    static constexpr bool is_transparent = requires {
+        typename Hash::is_transparent;
+        typename Eq::is_transparent;
+    };
+
+public:
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = Eq;
+    using allocator_type = element_allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+protected:
+    template <class K>
+    using key_arg = typename hash_detail::KeyArg<is_transparent>::template type<K, key_type>;
+
+private:
+    template <bool Const>
+    class Iterator {
+        static constexpr bool is_constant = Const || Policy::constant_iterators;
+        using group_iterator = std::conditional_t<Const, typename GroupTable::const_iterator, typename GroupTable::iterator>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<is_constant, const value_type*, value_type*>;
+        using reference = std::conditional_t<is_constant, const value_type&, value_type&>;
+
+        Iterator() = default;
+
+        // Non-const to const conversion
+        template <bool OtherConst> requires (Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other) noexcept : m_group(other.m_group), m_index(other.m_index) {}
+
+        reference operator*() const noexcept { return (*m_group)[m_index]; }
+        pointer operator->() const noexcept { return &(*m_group)[m_index]; }
+
+        Iterator& operator++() noexcept {
+            if (++m_index == m_group->size()) {
+                ++m_group;
+                m_index = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.m_group == rhs.m_group && lhs.m_index == rhs.m_index;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class HashMultiTable;
+        friend class Iterator<true>;
+
+        Iterator(group_iterator group, size_type index) noexcept : m_group(group), m_index(index) {}
+
+        group_iterator m_group{};
+        size_type m_index = 0;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    HashMultiTable() = default;
+
+    explicit HashMultiTable(size_type bucket_count, const Hash& hash = Hash(), const Eq& eq = Eq(),
+        const allocator_type& alloc = allocator_type())
+        : m_groups(bucket_count, hash, eq, alloc) {}
+
+    explicit HashMultiTable(const allocator_type& alloc) : m_groups(alloc) {}
+
+    template <class InputIt>
+    HashMultiTable(InputIt first, InputIt last, size_type bucket_count = 0, const Hash& hash = Hash(),
+        const Eq& eq = Eq(), const allocator_type& alloc = allocator_type())
+        : HashMultiTable(bucket_count, hash, eq, alloc) {
+        insert(first, last);
+    }
+
+    HashMultiTable(std::initializer_list<value_type> values, size_type bucket_count = 0, const Hash& hash = Hash(),
+        const Eq& eq = Eq(), const allocator_type& alloc = allocator_type())
+        : HashMultiTable(values.begin(), values.end(), bucket_count, hash, eq, alloc) {}
+
+    HashMultiTable(const HashMultiTable& other) = default;
+
+    HashMultiTable(HashMultiTable&& other) noexcept
+        : m_groups(std::move(other.m_groups)), m_size(std::exchange(other.m_size, 0)) {}
+
+    HashMultiTable& operator=(const HashMultiTable& other) = default;
+
+    // With unequal allocators that do not propagate, the groups are moved one by one and other is
+    // cleared of what is left of them
+    HashMultiTable& operator=(HashMultiTable&& other) noexcept(std::is_nothrow_move_assignable_v<GroupTable>) {
+        if (this != &other) {
+            m_groups = std::move(other.m_groups);
+            m_size = std::exchange(other.m_size, 0);
+            other.m_groups.clear();
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(m_groups.begin(), 0); }
+    const_iterator begin() const noexcept { return const_iterator(m_groups.begin(), 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(m_groups.end(), 0); }
+    const_iterator end() const noexcept { return const_iterator(m_groups.end(), 0); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Returns the number of elements
+    size_type size() const noexcept { return m_size; }
+
+    // Checks whether the table holds no elements
+    bool empty() const noexcept { return m_size == 0; }
+
+    size_type max_size() const noexcept { return m_groups.max_size(); }
+
+    // Slots of the table; each holds the elements of one distinct key
+    size_type bucket_count() const noexcept { return m_groups.bucket_count(); }
+
+    // Fraction of slots holding a key
+    float load_factor() const noexcept { return m_groups.load_factor(); }
+    float max_load_factor() const noexcept { return m_groups.max_load_factor(); }
+    void max_load_factor(float factor) { m_groups.max_load_factor(factor); }
+
+    // Makes room for count distinct keys without rehashing
+    void reserve(size_type count) { m_groups.reserve(count); }
+    void rehash(size_type count) { m_groups.rehash(count); }
+
+    hasher hash_function() const { return m_groups.hash_function(); }
+    key_equal key_eq() const { return m_groups.key_eq(); }
+    allocator_type get_allocator() const noexcept { return allocator_type(m_groups.get_allocator()); }
+
+    // Destroys every element, keeping the slots for reuse
+    void clear() noexcept {
+        m_groups.clear();
+        m_size = 0;
+    }
+
+    // Inserts value behind the elements with an equal key
+    iterator insert(const value_type& value) {
+        return emplace_with_key(Policy::key(value), value);
+    }
+
+    iterator insert(value_type&& value) {
+        return emplace_with_key(Policy::key(value), std::move(value));
+    }
+
+    // Inserts every element of [first, last). A forward range is measured first and the table grows
+    // at most once, to room for every element having a distinct key.
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {
+        if constexpr (std::derived_from<typename std::iterator_traits<InputIt>::iterator_category,
+                          std::forward_iterator_tag>) {
+            m_groups.reserve(m_groups.size() + static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> values) {
+        insert(values.begin(), values.end());
+    }
+
+    // Constructs an element from args and inserts it behind the elements with an equal key
+    template <class... Args>
+    iterator emplace(Args&&... args) {
+        if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, value_type> && ...)) {
+            return emplace_with_key(Policy::key(args...), std::forward<Args>(args)...);
+        } else {
+            // The key is only known once the element exists, so it is built outside the table first
+            element_allocator alloc(get_allocator());
+            alignas(value_type) std::byte buffer[sizeof(value_type)];
+            auto* staged = reinterpret_cast<value_type*>(buffer);
+            std::allocator_traits<element_allocator>::construct(alloc, staged, std::forward<Args>(args)...);
+            struct Guard {
+                element_allocator& alloc;
+                value_type* value;
+                ~Guard() { std::allocator_traits<element_allocator>::destroy(alloc, value); }
+            } guard{alloc, staged};
+
+            return emplace_with_key(Policy::key(*staged), Policy::transfer(*staged));
+        }
+    }
+
+    // Returns an iterator to the first element with an equal key, or end()
+    template <class K = key_type>
+    iterator find(const key_arg<K>& key) {
+        return iterator(m_groups.template find<K>(key), 0);
+    }
+
+    template <class K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        return const_iterator(m_groups.template find<K>(key), 0);
+    }
+
+    template <class K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return m_groups.template contains<K>(key);
+    }
+
+    template <class K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        auto group = m_groups.template find<K>(key);
+        return group == m_groups.end() ? 0 : group->size();
+    }
+
+    // Returns the elements with an equal key, which are adjacent in memory
+    template <class K = key_type>
+    std::pair<iterator, iterator> equal_range(const key_arg<K>& key) {
+        auto group = m_groups.template find<K>(key);
+        if (group == m_groups.end()) {
+            return {end(), end()};
+        }
+        auto next = group;
+        return {iterator(group, 0), iterator(++next, 0)};
+    }
+
+    template <class K = key_type>
+    std::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const {
+        auto group = m_groups.template find<K>(key);
+        if (group == m_groups.end()) {
+            return {end(), end()};
+        }
+        auto next = group;
+        return {const_iterator(group, 0), const_iterator(++next, 0)};
+    }
+
+    // Removes the element at pos and returns an iterator to the element after it
+    iterator erase(const_iterator pos) {
+        auto group = m_groups.mutable_iterator(pos.m_group);
+        --m_size;
+        if (group->size() == 1) {
+            return iterator(m_groups.erase(group), 0);
+        }
+
+        group->erase(group->begin() + static_cast<difference_type>(pos.m_index));
+        if (pos.m_index == group->size()) {
+            return iterator(++group, 0);
+        }
+        return iterator(group, pos.m_index);
+    }
+
+    iterator erase(iterator pos) {
+        return erase(const_iterator(pos));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        // Erasing shifts the rest of a group down, so the end of the range is tracked by distance
+        size_type remaining = static_cast<size_type>(std::distance(first, last));
+        iterator it(m_groups.mutable_iterator(first.m_group), first.m_index);
+        for (; remaining > 0; --remaining) {
+            it = erase(it);
+        }
+        return it;
+    }
+
+    // Removes every element with an equal key, returns the number of removed elements
+    template <class K = key_type>
+    size_type erase(const key_arg<K>& key) {
+        auto group = m_groups.template find<K>(key);
+        if (group == m_groups.end()) {
+            return 0;
+        }
+        const size_type removed = group->size();
+        m_groups.erase(group);
+        m_size -= removed;
+        return removed;
+    }
+
+    void swap(HashMultiTable& other) noexcept {
+        m_groups.swap(other.m_groups);
+        std::swap(m_size, other.m_size);
+    }
+
+    friend void swap(HashMultiTable& lhs, HashMultiTable& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    // Tables are equal when every key has the same elements, in any order
+    friend bool operator==(const HashMultiTable& lhs, const HashMultiTable& rhs) {
+        if (lhs.m_size != rhs.m_size || lhs.m_groups.size() != rhs.m_groups.size()) {
+            return false;
+        }
+        for (const auto& group : lhs.m_groups) {
+            auto other = rhs.m_groups.find(GroupPolicy::key(group));
+            if (other == rhs.m_groups.end() || other->size() != group.size() ||
+                !std::is_permutation(group.begin(), group.end(), other->begin())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const HashMultiTable& lhs, const HashMultiTable& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    GroupTable m_groups;
+    size_type m_size = 0;
+
+    // Finds or creates the group of key. Allocators with a construct of their own (PolymorphicAllocator)
+    // hand themselves to a new group by uses-allocator construction, the others are passed explicitly.
+    template <class K>
+    auto emplace_group(const K& key) {
+        using group_allocator = typename GroupTable::allocator_type;
+        if constexpr (requires(group_allocator& alloc, group_type* group) { alloc.construct(group); }) {
+            return m_groups.emplace_with_key(key);
+        } else {
+            return m_groups.emplace_with_key(key, element_allocator(get_allocator()));
+        }
+    }
+
+    // Appends an element constructed from args to the group of key, creating the group if needed
+    template <class K, class... Args>
+    iterator emplace_with_key(const K& key, Args&&... args) {
+        auto [group, inserted] = emplace_group(key);
+        if (inserted) {
+            try {
+                group->emplace_back(std::forward<Args>(args)...);
+            } catch (...) {
+                m_groups.erase(group);
+                throw;
+            }
+        } else {
+            group->emplace_back(std::forward<Args>(args)...);
+        }
+        ++m_size;
+        return iterator(group, group->size() - 1);
+    }
+};
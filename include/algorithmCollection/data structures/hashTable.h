@@ -0,0 +1,997 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "relocation.h"
+#include "allocatorPropagation.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ALGORITHM_COLLECTION_HASH_SSE2 1
+#endif
+
+// Open-addressing hash table engine shared by the hash containers ("Swiss table" layout).
+//
+// Elements live in one flat slot array. A parallel array holds one control byte per slot: the slot is
+// empty, deleted (a tombstone), or full, in which case the byte stores 7 bits of the element's hash.
+// Lookups probe groups of 16 control bytes (8 without SSE2) at a time: a single SIMD compare finds
+// every slot in the group whose stored hash bits match, so keys are only compared for likely hits
+// and an empty byte in the group ends the search. No per-element allocation and no pointers are
+// stored, so an entry costs its value plus one byte at a load factor of up to max_load_factor().
+//
+// A Policy describes the element type:
+//     using key_type; using value_type;
+//     static const key_type& key(const value_type&)    the key of an element
+//     static auto transfer(value_type&)                constructor argument moving an element out of
+//                                                      a slot that is destroyed right after
+//     static constexpr bool constant_iterators         whether iterators only give const access
+// Every table holds unique keys; the multi containers (hashMultiTable.h) store one group of equal
+// elements per key.
+namespace hash_detail {
+    using ctrl_t = std::int8_t;
+
+    inline constexpr ctrl_t ctrl_empty = -128;
+    inline constexpr ctrl_t ctrl_deleted = -2;
+    inline constexpr ctrl_t ctrl_sentinel = -1;
+
+    constexpr bool is_full(ctrl_t ctrl) noexcept { return ctrl >= 0; }
+    constexpr bool is_empty_or_deleted(ctrl_t ctrl) noexcept { return ctrl < ctrl_sentinel; }
+
+    // Set of slots of a group, iterated from the lowest slot. Each slot is represented by
+    // 1 << Shift bits of Bits, of which only the lowest (SSE2) or highest (portable) may be set.
+    template <typename Bits, int Width, int Shift>
+    class BitMask {
+    public:
+        explicit constexpr BitMask(Bits bits) noexcept : m_bits(bits) {}
+
+        explicit constexpr operator bool() const noexcept { return m_bits != 0; }
+
+        // Index of the lowest slot in the set
+        constexpr int lowest() const noexcept { return std::countr_zero(m_bits) >> Shift; }
+
+        // Number of slots below the lowest slot in the set
+        constexpr int trailing_zeros() const noexcept { return std::countr_zero(m_bits) >> Shift; }
+
+        // Number of slots above the highest slot in the set
+        constexpr int leading_zeros() const noexcept {
+            constexpr int unused = static_cast<int>(sizeof(Bits) * 8) - (Width << Shift);
+            return (std::countl_zero(m_bits) - unused) >> Shift;
+        }
+
+        constexpr BitMask begin() const noexcept { return *this; }
+        constexpr BitMask end() const noexcept { return BitMask(0); }
+        constexpr int operator*() const noexcept { return lowest(); }
+
+        constexpr BitMask& operator++() noexcept {
+            m_bits &= m_bits - 1;
+            return *this;
+        }
+
+        friend constexpr bool operator!=(const BitMask& lhs, const BitMask& rhs) noexcept {
+            return lhs.m_bits != rhs.m_bits;
+        }
+
+    private:
+        Bits m_bits;
+    };
+
+#ifdef ALGORITHM_COLLECTION_HASH_SSE2
+    // 16 control bytes examined with one SSE2 compare each
+    class Group {
+    public:
+        static constexpr std::size_t width = 16;
+        using Mask = BitMask<std::uint32_t, 16, 0>;
+
+        explicit Group(const ctrl_t* pos) noexcept
+            : m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+        // Slots whose control byte equals h2
+        Mask match(ctrl_t h2) const noexcept {
+            return Mask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl))));
+        }
+
+        Mask match_empty() const noexcept { return match(ctrl_empty); }
+
+        Mask match_empty_or_deleted() const noexcept {
+            const __m128i sentinel = _mm_set1_epi8(ctrl_sentinel);
+            return Mask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(sentinel, m_ctrl))));
+        }
+
+        // Number of empty or deleted slots at the start of the group
+        std::size_t count_leading_empty_or_deleted() const noexcept {
+            const __m128i sentinel = _mm_set1_epi8(ctrl_sentinel);
+            const auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(sentinel, m_ctrl)));
+            return static_cast<std::size_t>(std::countr_zero(bits + 1));
+        }
+
+    private:
+        __m128i m_ctrl;
+    };
+#else
+    // 8 control bytes examined with 64-bit integer arithmetic
+    class Group {
+    public:
+        static constexpr std::size_t width = 8;
+        using Mask = BitMask<std::uint64_t, 8, 3>;
+
+        explicit Group(const ctrl_t* pos) noexcept : m_ctrl(0) {
+            for (std::size_t i = 0; i < width; ++i) {
+                m_ctrl |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(pos[i])) << (i * 8);
+            }
+        }
+
+        // Slots whose control byte equals h2. May report a full slot next to a match as matching
+        // too; callers compare keys anyway.
+        Mask match(ctrl_t h2) const noexcept {
+            const std::uint64_t x = m_ctrl ^ (lsbs * static_cast<std::uint8_t>(h2));
+            return Mask((x - lsbs) & ~x & msbs);
+        }
+
+        Mask match_empty() const noexcept { return Mask(m_ctrl & ~(m_ctrl << 6) & msbs); }
+
+        Mask match_empty_or_deleted() const noexcept { return Mask(m_ctrl & ~(m_ctrl << 7) & msbs); }
+
+        // Number of empty or deleted slots at the start of the group
+        std::size_t count_leading_empty_or_deleted() const noexcept {
+            constexpr std::uint64_t gaps = 0x00FEFEFEFEFEFEFEULL;
+            const std::uint64_t bits = ((~m_ctrl & (m_ctrl >> 7)) | gaps) + 1;
+            return static_cast<std::size_t>((std::countr_zero(bits) + 7) >> 3);
+        }
+
+    private:
+        static constexpr std::uint64_t lsbs = 0x0101010101010101ULL;
+        static constexpr std::uint64_t msbs = 0x8080808080808080ULL;
+
+        std::uint64_t m_ctrl;
+    };
+#endif
+
+    inline void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        static_cast<void>(address);
+#endif
+    }
+
+    // Control bytes of a table without slots: the sentinel followed by empty bytes, so lookups in
+    // an empty table need no special case
+    inline ctrl_t* empty_group() noexcept {
+        alignas(16) static ctrl_t group[16] = {ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty,
+            ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+            ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty};
+        return group;
+    }
+
+    // Spreads the bits of a hash. std::hash is the identity for integers, which would put 128
+    // consecutive keys into the same group without this step.
+    constexpr std::size_t mix(std::size_t hash) noexcept {
+        auto x = static_cast<std::uint64_t>(hash);
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+    }
+
+    // Start of the probe sequence and 7-bit control byte tag of a hash
+    constexpr std::size_t h1(std::size_t hash) noexcept { return hash >> 7; }
+    constexpr ctrl_t h2(std::size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7F); }
+
+    // Triangular probing over groups, which visits every group of a power of two sized table once
+    class ProbeSeq {
+    public:
+        constexpr ProbeSeq(std::size_t hash, std::size_t mask) noexcept : m_mask(mask), m_offset(h1(hash) & mask) {}
+
+        constexpr std::size_t offset() const noexcept { return m_offset; }
+        constexpr std::size_t offset(std::size_t i) const noexcept { return (m_offset + i) & m_mask; }
+
+        constexpr void next() noexcept {
+            m_index += Group::width;
+            m_offset = (m_offset + m_index) & m_mask;
+        }
+
+    private:
+        std::size_t m_mask;
+        std::size_t m_offset;
+        std::size_t m_index = 0;
+    };
+
+    // Selects the argument type of lookups: any type with transparent Hash and Eq, else the key type
+    template <bool Transparent>
+    struct KeyArg {
+        template <class K, class Key>
+        using type = Key;
+    };
+
+    template <>
+    struct KeyArg<true> {
+        template <class K, class Key>
+        using type = K;
+    };
+}
+
+template <typename Policy, typename Hash, typename Eq, typename Alloc>
+class HashTable {
+    using ctrl_t = hash_detail::ctrl_t;
+    using Group = hash_detail::Group;
+
+    static constexpr bool is_transparent = requires {
+        typename Hash::is_transparent;
+        typename Eq::is_transparent;
+    };
+
+public:
+    using key_type = typename Policy::key_type;
+    using value_type = typename Policy::value_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = Eq;
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<value_type>;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    static constexpr float default_max_load_factor = 0.875f;
+
+private:
+    using ctrl_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<ctrl_t>;
+
+protected:
+    template <class K>
+    using key_arg = typename hash_detail::KeyArg<is_transparent>::template type<K, key_type>;
+
+private:
+    template <bool Const>
+    class Iterator {
+        // Elements of sets are their own keys and never handed out mutably
+        static constexpr bool is_constant = Const || Policy::constant_iterators;
+        using slot_pointer = std::conditional_t<is_constant, const typename Policy::value_type*, typename Policy::value_type*>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Policy::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = slot_pointer;
+        using reference = std::conditional_t<is_constant, const value_type&, value_type&>;
+
+        Iterator() = default;
+
+        // Non-const to const conversion
+        template <bool OtherConst> requires (Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other) noexcept : m_ctrl(other.m_ctrl), m_slot(other.m_slot) {}
+
+        reference operator*() const noexcept { return *m_slot; }
+        pointer operator->() const noexcept { return m_slot; }
+
+        Iterator& operator++() noexcept {
+            ++m_ctrl;
+            ++m_slot;
+            skip_empty_or_deleted();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.m_ctrl == rhs.m_ctrl; }
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.m_ctrl != rhs.m_ctrl; }
+
+    private:
+        friend class HashTable;
+        friend class Iterator<true>;
+
+        Iterator(const ctrl_t* ctrl, slot_pointer slot) noexcept : m_ctrl(ctrl), m_slot(slot) {}
+
+        // Moves to the next full slot, or to the sentinel behind the last slot
+        void skip_empty_or_deleted() noexcept {
+            while (hash_detail::is_empty_or_deleted(*m_ctrl)) {
+                const std::size_t shift = Group(m_ctrl).count_leading_empty_or_deleted();
+                m_ctrl += shift;
+                m_slot += shift;
+            }
+        }
+
+        const ctrl_t* m_ctrl = nullptr;
+        slot_pointer m_slot = nullptr;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    HashTable() = default;
+
+    explicit HashTable(size_type bucket_count, const Hash& hash = Hash(), const Eq& eq = Eq(),
+        const allocator_type& alloc = allocator_type())
+        : m_hash(hash), m_eq(eq), m_allocator(alloc) {
+        if (bucket_count > 0) {
+            resize(normalize_capacity(bucket_count));
+        }
+    }
+
+    explicit HashTable(const allocator_type& alloc) : m_allocator(alloc) {}
+
+    template <class InputIt>
+    HashTable(InputIt first, InputIt last, size_type bucket_count = 0, const Hash& hash = Hash(),
+        const Eq& eq = Eq(), const allocator_type& alloc = allocator_type())
+        : HashTable(bucket_count, hash, eq, alloc) {
+        insert(first, last);
+    }
+
+    HashTable(std::initializer_list<value_type> values, size_type bucket_count = 0, const Hash& hash = Hash(),
+        const Eq& eq = Eq(), const allocator_type& alloc = allocator_type())
+        : HashTable(values.begin(), values.end(), bucket_count, hash, eq, alloc) {}
+
+    // Copies the table layout as is, so no element is rehashed
+    HashTable(const HashTable& other)
+        : HashTable(other, propagation_detail::select_on_copy(other.m_allocator)) {}
+
+    HashTable(const HashTable& other, const allocator_type& alloc)
+        : m_max_load_factor(other.m_max_load_factor), m_hash(other.m_hash), m_eq(other.m_eq), m_allocator(alloc) {
+        copy_from(other);
+    }
+
+    HashTable(HashTable&& other) noexcept
+        : m_ctrl(std::exchange(other.m_ctrl, hash_detail::empty_group())),
+          m_slots(std::exchange(other.m_slots, nullptr)),
+          m_capacity(std::exchange(other.m_capacity, 0)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_growth_left(std::exchange(other.m_growth_left, 0)),
+          m_max_load_factor(other.m_max_load_factor),
+          m_hash(std::move(other.m_hash)), m_eq(std::move(other.m_eq)), m_allocator(std::move(other.m_allocator)) {}
+
+    // Takes over the storage of other if `alloc` equals its allocator, otherwise moves the elements
+    // into the same layout in storage obtained from `alloc`
+    HashTable(HashTable&& other, const allocator_type& alloc)
+        : m_max_load_factor(other.m_max_load_factor), m_hash(other.m_hash), m_eq(other.m_eq), m_allocator(alloc) {
+        if (propagation_detail::equal(m_allocator, other.m_allocator)) {
+            swap_storage(other);
+        } else {
+            move_from(other);
+        }
+    }
+
+    ~HashTable() {
+        destroy_and_deallocate();
+    }
+
+    // Keeps this table's allocator unless it propagates on copy assignment
+    HashTable& operator=(const HashTable& other) {
+        if (this != &other) {
+            HashTable copy(other, propagation_detail::copy_assignment_allocator(m_allocator, other.m_allocator));
+            swap_storage(copy);
+            propagation_detail::swap_on_copy_assignment(m_allocator, copy.m_allocator);
+        }
+        return *this;
+    }
+
+    // Takes over the storage of other when the allocator propagates on move assignment or both
+    // allocators are equal; otherwise other's elements are moved into this table's own storage
+    HashTable& operator=(HashTable&& other) noexcept(propagation_detail::move_steals_storage_v<allocator_type>) {
+        if (this != &other) {
+            if constexpr (!propagation_detail::move_steals_storage_v<allocator_type>) {
+                if (!propagation_detail::equal(m_allocator, other.m_allocator)) {
+                    HashTable moved(std::move(other), m_allocator);
+                    swap_storage(moved);
+                    return *this;
+                }
+            }
+
+            // Release the current elements with the allocator that created them
+            destroy_and_deallocate();
+            m_ctrl = std::exchange(other.m_ctrl, hash_detail::empty_group());
+            m_slots = std::exchange(other.m_slots, nullptr);
+            m_capacity = std::exchange(other.m_capacity, 0);
+            m_size = std::exchange(other.m_size, 0);
+            m_growth_left = std::exchange(other.m_growth_left, 0);
+            m_max_load_factor = other.m_max_load_factor;
+            m_hash = std::move(other.m_hash);
+            m_eq = std::move(other.m_eq);
+            propagation_detail::move_assign(m_allocator, other.m_allocator);
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept {
+        iterator it(m_ctrl, m_slots);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+
+    const_iterator begin() const noexcept {
+        const_iterator it(m_ctrl, m_slots);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(m_ctrl + m_capacity, m_slots + m_capacity); }
+    const_iterator end() const noexcept { return const_iterator(m_ctrl + m_capacity, m_slots + m_capacity); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Returns the number of elements
+    size_type size() const noexcept { return m_size; }
+
+    // Checks whether the table holds no elements
+    bool empty() const noexcept { return m_size == 0; }
+
+    // Returns the number of slots
+    size_type capacity() const noexcept { return m_capacity; }
+    size_type bucket_count() const noexcept { return m_capacity; }
+
+    size_type max_size() const noexcept {
+        return std::allocator_traits<allocator_type>::max_size(m_allocator);
+    }
+
+    float load_factor() const noexcept {
+        return m_capacity == 0 ? 0.0f : static_cast<float>(m_size) / static_cast<float>(m_capacity);
+    }
+
+    float max_load_factor() const noexcept { return m_max_load_factor; }
+
+    // Sets the fraction of slots that may be full before the table grows, in (0, 1]. Higher values
+    // save memory, lower values shorten probe sequences. Rehashes when the current elements need it.
+    void max_load_factor(float factor) {
+        if (!(factor > 0.0f && factor <= 1.0f)) {
+            throw std::invalid_argument("Max load factor must be in (0, 1]");
+        }
+
+        m_max_load_factor = factor;
+        if (m_capacity > 0) {
+            resize(capacity_for(m_size));
+        }
+    }
+
+    // Makes room for count elements without rehashing
+    void reserve(size_type count) {
+        if (count > m_size + m_growth_left) {
+            resize(capacity_for(count));
+        }
+    }
+
+    // Rebuilds the table with at least count slots and room for its elements, dropping tombstones
+    void rehash(size_type count) {
+        if (count == 0 && m_size == 0) {
+            destroy_and_deallocate();
+            reset_empty();
+            return;
+        }
+
+        resize(std::max(normalize_capacity(count), capacity_for(m_size)));
+    }
+
+    hasher hash_function() const { return m_hash; }
+    key_equal key_eq() const { return m_eq; }
+    allocator_type get_allocator() const noexcept { return m_allocator; }
+
+    // Destroys every element, keeping the slots for reuse
+    void clear() noexcept {
+        if (m_capacity == 0) {
+            return;
+        }
+
+        destroy_elements();
+        reset_ctrl();
+        m_size = 0;
+        m_growth_left = capacity_to_growth(m_capacity);
+    }
+
+    // Inserts value if no element with an equal key exists
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return emplace_with_key(Policy::key(value), value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return emplace_with_key(Policy::key(value), std::move(value));
+    }
+
+    // Inserts every element of [first, last) whose key is not present yet. A forward range is measured
+    // first and the table grows at most once, to room for all of it.
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {
+        if constexpr (std::derived_from<typename std::iterator_traits<InputIt>::iterator_category,
+                          std::forward_iterator_tag>) {
+            reserve(m_size + static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> values) {
+        insert(values.begin(), values.end());
+    }
+
+    // Constructs an element from args and inserts it if no element with an equal key exists
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, value_type> && ...)) {
+            return emplace_with_key(Policy::key(args...), std::forward<Args>(args)...);
+        } else {
+            // The key is only known once the element exists, so it is built outside the table first
+            alignas(value_type) std::byte buffer[sizeof(value_type)];
+            auto* staged = reinterpret_cast<value_type*>(buffer);
+            std::allocator_traits<allocator_type>::construct(m_allocator, staged, std::forward<Args>(args)...);
+            struct Guard {
+                HashTable* table;
+                value_type* value;
+                ~Guard() { std::allocator_traits<allocator_type>::destroy(table->m_allocator, value); }
+            } guard{this, staged};
+
+            return emplace_with_key(Policy::key(*staged), Policy::transfer(*staged));
+        }
+    }
+
+    template <class K = key_type>
+    iterator find(const key_arg<K>& key) {
+        return iterator_at(find_index(key));
+    }
+
+    template <class K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        return const_iterator_at(find_index(key));
+    }
+
+    template <class K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return find_index(key) != m_capacity;
+    }
+
+    template <class K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <class K = key_type>
+    std::pair<iterator, iterator> equal_range(const key_arg<K>& key) {
+        iterator it = find(key);
+        if (it == end()) {
+            return {it, it};
+        }
+        iterator next = it;
+        return {it, ++next};
+    }
+
+    template <class K = key_type>
+    std::pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const {
+        const_iterator it = find(key);
+        if (it == end()) {
+            return {it, it};
+        }
+        const_iterator next = it;
+        return {it, ++next};
+    }
+
+    // Removes the element at pos and returns an iterator to the element after it
+    iterator erase(const_iterator pos) {
+        const auto index = static_cast<size_type>(pos.m_ctrl - m_ctrl);
+        erase_at(index);
+        iterator next(m_ctrl + index, m_slots + index);
+        next.skip_empty_or_deleted();
+        return next;
+    }
+
+    iterator erase(iterator pos) {
+        return erase(const_iterator(pos));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        const auto index = static_cast<size_type>(last.m_ctrl - m_ctrl);
+        return iterator(m_ctrl + index, m_slots + index);
+    }
+
+    // Removes the element with an equal key, returns the number of removed elements
+    template <class K = key_type>
+    size_type erase(const key_arg<K>& key) {
+        const size_type index = find_index(key);
+        if (index == m_capacity) {
+            return 0;
+        }
+        erase_at(index);
+        return 1;
+    }
+
+    // Allocators are swapped only if they propagate on swap; otherwise they must be equal
+    void swap(HashTable& other) noexcept {
+        swap_storage(other);
+        propagation_detail::swap_on_swap(m_allocator, other.m_allocator);
+    }
+
+    friend void swap(HashTable& lhs, HashTable& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    // Tables are equal when they hold the same elements, in any order
+    friend bool operator==(const HashTable& lhs, const HashTable& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (const auto& value : lhs) {
+            auto it = rhs.find(Policy::key(value));
+            if (it == rhs.end() || !(*it == value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const HashTable& lhs, const HashTable& rhs) {
+        return !(lhs == rhs);
+    }
+
+protected:
+    // Index of the element with an equal key, or capacity() if there is none
+    template <class K>
+    size_type find_index(const K& key) const {
+        return find_index_hashed(key, hash_of(key));
+    }
+
+    // Finds the element with an equal key, or constructs one from args if there is none
+    template <class K, class... Args>
+    std::pair<iterator, bool> emplace_with_key(const K& key, Args&&... args) {
+        const size_type hash = hash_of(key);
+        const size_type found = find_index_hashed(key, hash);
+        if (found != m_capacity) {
+            return {iterator_at(found), false};
+        }
+
+        const size_type index = prepare_insert(hash);
+        std::allocator_traits<allocator_type>::construct(m_allocator, m_slots + index, std::forward<Args>(args)...);
+        commit_insert(index, hash);
+        return {iterator_at(index), true};
+    }
+
+    template <class K>
+    size_type hash_of(const K& key) const {
+        return hash_detail::mix(static_cast<size_type>(m_hash(key)));
+    }
+
+    template <class K>
+    size_type find_index_hashed(const K& key, size_type hash) const {
+        const ctrl_t tag = hash_detail::h2(hash);
+        hash_detail::ProbeSeq seq(hash, m_capacity);
+        // Most keys sit in the first slots of their group; fetching them overlaps with the control
+        // byte load instead of waiting for it
+        hash_detail::prefetch(m_slots + seq.offset());
+        while (true) {
+            Group group(m_ctrl + seq.offset());
+            for (int i : group.match(tag)) {
+                const size_type index = seq.offset(static_cast<size_type>(i));
+                if (m_eq(Policy::key(m_slots[index]), key)) {
+                    return index;
+                }
+            }
+            if (group.match_empty()) {
+                return m_capacity;
+            }
+            seq.next();
+        }
+    }
+
+    // Returns the slot a new element with the given hash goes to, growing the table if needed.
+    // The slot is only marked full by commit_insert, once its element has been constructed.
+    size_type prepare_insert(size_type hash) {
+        size_type index = find_first_non_full(hash);
+        if (m_growth_left == 0 && m_ctrl[index] != hash_detail::ctrl_deleted) {
+            grow_for_insert();
+            index = find_first_non_full(hash);
+        }
+        return index;
+    }
+
+    void commit_insert(size_type index, size_type hash) noexcept {
+        if (m_ctrl[index] == hash_detail::ctrl_empty) {
+            --m_growth_left;
+        }
+        set_ctrl(index, hash_detail::h2(hash));
+        ++m_size;
+    }
+
+    iterator iterator_at(size_type index) noexcept { return iterator(m_ctrl + index, m_slots + index); }
+    const_iterator const_iterator_at(size_type index) const noexcept { return const_iterator(m_ctrl + index, m_slots + index); }
+
+private:
+    // The multi containers keep one group of equal elements per slot and edit groups in place
+    template <typename, typename, typename, typename>
+    friend class HashMultiTable;
+
+    ctrl_t* m_ctrl = hash_detail::empty_group();
+    value_type* m_slots = nullptr;
+    size_type m_capacity = 0;
+    size_type m_size = 0;
+    size_type m_growth_left = 0;
+    float m_max_load_factor = default_max_load_factor;
+    [[no_unique_address]] Hash m_hash{};
+    [[no_unique_address]] Eq m_eq{};
+    [[no_unique_address]] allocator_type m_allocator{};
+
+    iterator mutable_iterator(const_iterator it) noexcept {
+        return iterator_at(static_cast<size_type>(it.m_ctrl - m_ctrl));
+    }
+
+    // Control bytes: one per slot, the sentinel, and a copy of the first group's bytes so a group
+    // loaded near the end of the table wraps around without a bounds check
+    static constexpr size_type cloned_bytes = Group::width - 1;
+    static constexpr size_type min_capacity = 15;
+
+    static constexpr size_type ctrl_bytes(size_type capacity) noexcept { return capacity + 1 + cloned_bytes; }
+
+    // Smallest valid capacity (2^k - 1) of at least count slots
+    static size_type normalize_capacity(size_type count) noexcept {
+        return count <= min_capacity ? min_capacity : (std::bit_ceil(count + 1) - 1);
+    }
+
+    // Elements a table of the given capacity holds before it grows; at least one slot stays empty
+    // so every probe sequence ends
+    size_type capacity_to_growth(size_type capacity) const noexcept {
+        if (capacity == 0) {
+            return 0;
+        }
+        const auto growth = static_cast<size_type>(static_cast<double>(capacity) * m_max_load_factor);
+        return std::clamp<size_type>(growth, 1, capacity - 1);
+    }
+
+    // Smallest capacity that holds count elements
+    size_type capacity_for(size_type count) const noexcept {
+        size_type capacity = normalize_capacity(count);
+        while (capacity_to_growth(capacity) < count) {
+            capacity = capacity * 2 + 1;
+        }
+        return capacity;
+    }
+
+    // Writes a control byte and its clone behind the sentinel
+    void set_ctrl(size_type index, ctrl_t ctrl) noexcept {
+        m_ctrl[index] = ctrl;
+        m_ctrl[((index - cloned_bytes) & m_capacity) + (cloned_bytes & m_capacity)] = ctrl;
+    }
+
+    void reset_ctrl() noexcept {
+        std::memset(m_ctrl, static_cast<unsigned char>(hash_detail::ctrl_empty), ctrl_bytes(m_capacity));
+        m_ctrl[m_capacity] = hash_detail::ctrl_sentinel;
+    }
+
+    void reset_empty() noexcept {
+        m_ctrl = hash_detail::empty_group();
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_growth_left = 0;
+    }
+
+    // First empty or deleted slot on the probe sequence of hash
+    size_type find_first_non_full(size_type hash) const noexcept {
+        hash_detail::ProbeSeq seq(hash, m_capacity);
+        while (true) {
+            const auto mask = Group(m_ctrl + seq.offset()).match_empty_or_deleted();
+            if (mask) {
+                return seq.offset(static_cast<size_type>(mask.lowest()));
+            }
+            seq.next();
+        }
+    }
+
+    // Makes room for one more element. A table whose growth is used up mostly by tombstones is
+    // rebuilt at its capacity, anything else doubles.
+    void grow_for_insert() {
+        if (m_capacity > 0 && m_size + 1 <= capacity_to_growth(m_capacity) / 2) {
+            resize(m_capacity);
+        } else {
+            resize(std::max(m_capacity * 2 + 1, capacity_for(m_size + 1)));
+        }
+    }
+
+    void erase_at(size_type index) noexcept {
+        std::allocator_traits<allocator_type>::destroy(m_allocator, m_slots + index);
+        --m_size;
+
+        // A slot may become empty again instead of a tombstone when no group containing it was ever
+        // full, because then no probe sequence continued past it
+        const size_type index_before = (index - Group::width) & m_capacity;
+        const auto empty_after = Group(m_ctrl + index).match_empty();
+        const auto empty_before = Group(m_ctrl + index_before).match_empty();
+        const bool was_never_full = empty_before && empty_after &&
+            static_cast<size_type>(empty_after.trailing_zeros() + empty_before.leading_zeros()) < Group::width;
+
+        set_ctrl(index, was_never_full ? hash_detail::ctrl_empty : hash_detail::ctrl_deleted);
+        if (was_never_full) {
+            ++m_growth_left;
+        }
+    }
+
+    // Elements whose transfer may throw are copied on rehash, as by std::move_if_noexcept
+    static constexpr bool transfer_may_throw = !is_trivially_relocatable_v<value_type>
+        && !std::is_nothrow_constructible_v<value_type, decltype(Policy::transfer(std::declval<value_type&>()))>
+        && std::is_copy_constructible_v<value_type>;
+
+    // Moves every element into a table of new_capacity slots. Elements whose move may throw are
+    // copied and the old slots are only released once every copy exists, so a throwing copy or hash
+    // leaves the table as it was. Other elements are relocated one by one; if the hash throws in
+    // between, the elements are destroyed and the table is left empty.
+    void resize(size_type new_capacity) {
+        ctrl_allocator ctrl_alloc(m_allocator);
+        ctrl_t* old_ctrl = m_ctrl;
+        value_type* old_slots = m_slots;
+        const size_type old_capacity = m_capacity;
+
+        ctrl_t* new_ctrl = std::allocator_traits<ctrl_allocator>::allocate(ctrl_alloc, ctrl_bytes(new_capacity));
+        value_type* new_slots;
+        try {
+            new_slots = std::allocator_traits<allocator_type>::allocate(m_allocator, new_capacity);
+        } catch (...) {
+            std::allocator_traits<ctrl_allocator>::deallocate(ctrl_alloc, new_ctrl, ctrl_bytes(new_capacity));
+            throw;
+        }
+
+        // Probing for free slots works on the members, so they point at the new arrays while they fill
+        m_ctrl = new_ctrl;
+        m_slots = new_slots;
+        m_capacity = new_capacity;
+        reset_ctrl();
+
+        size_type i = 0;
+        try {
+            for (; i < old_capacity; ++i) {
+                if (!hash_detail::is_full(old_ctrl[i])) {
+                    continue;
+                }
+
+                const size_type hash = hash_of(Policy::key(old_slots[i]));
+                const size_type index = find_first_non_full(hash);
+                if constexpr (transfer_may_throw) {
+                    std::allocator_traits<allocator_type>::construct(m_allocator, m_slots + index, std::as_const(old_slots[i]));
+                } else {
+                    relocate_slot(old_slots + i, m_slots + index);
+                }
+                set_ctrl(index, hash_detail::h2(hash));
+            }
+        } catch (...) {
+            destroy_and_deallocate();
+            if constexpr (transfer_may_throw) {
+                m_ctrl = old_ctrl;
+                m_slots = old_slots;
+                m_capacity = old_capacity;
+            } else {
+                // The hash or the move of an element that cannot be copied threw, with the elements
+                // split between both tables
+                for (; i < old_capacity; ++i) {
+                    if (hash_detail::is_full(old_ctrl[i])) {
+                        std::allocator_traits<allocator_type>::destroy(m_allocator, old_slots + i);
+                    }
+                }
+                if (old_capacity > 0) {
+                    std::allocator_traits<ctrl_allocator>::deallocate(ctrl_alloc, old_ctrl, ctrl_bytes(old_capacity));
+                    std::allocator_traits<allocator_type>::deallocate(m_allocator, old_slots, old_capacity);
+                }
+                reset_empty();
+            }
+            throw;
+        }
+
+        if constexpr (transfer_may_throw) {
+            for (size_type j = 0; j < old_capacity; ++j) {
+                if (hash_detail::is_full(old_ctrl[j])) {
+                    std::allocator_traits<allocator_type>::destroy(m_allocator, old_slots + j);
+                }
+            }
+        }
+        m_growth_left = capacity_to_growth(new_capacity) - m_size;
+
+        if (old_capacity > 0) {
+            std::allocator_traits<ctrl_allocator>::deallocate(ctrl_alloc, old_ctrl, ctrl_bytes(old_capacity));
+            std::allocator_traits<allocator_type>::deallocate(m_allocator, old_slots, old_capacity);
+        }
+    }
+
+    void relocate_slot(value_type* from, value_type* to) {
+        if constexpr (is_trivially_relocatable_v<value_type>) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(value_type));
+        } else {
+            std::allocator_traits<allocator_type>::construct(m_allocator, to, Policy::transfer(*from));
+            std::allocator_traits<allocator_type>::destroy(m_allocator, from);
+        }
+    }
+
+    // Exchanges everything but the allocators
+    void swap_storage(HashTable& other) noexcept {
+        using std::swap;
+        swap(m_ctrl, other.m_ctrl);
+        swap(m_slots, other.m_slots);
+        swap(m_capacity, other.m_capacity);
+        swap(m_size, other.m_size);
+        swap(m_growth_left, other.m_growth_left);
+        swap(m_max_load_factor, other.m_max_load_factor);
+        swap(m_hash, other.m_hash);
+        swap(m_eq, other.m_eq);
+    }
+
+    void copy_from(const HashTable& other) {
+        clone_layout(other);
+    }
+
+    // Moves the elements of other, which keeps its storage, into a copy of its layout
+    void move_from(HashTable& other) {
+        clone_layout(other);
+    }
+
+    // Copies the layout of other into this empty table, constructing each element from other's, or
+    // from the element moved out of other when Source is not const
+    template <class Source>
+    void clone_layout(Source& other) {
+        if (other.m_size == 0) {
+            return;
+        }
+
+        ctrl_allocator ctrl_alloc(m_allocator);
+        m_ctrl = std::allocator_traits<ctrl_allocator>::allocate(ctrl_alloc, ctrl_bytes(other.m_capacity));
+        try {
+            m_slots = std::allocator_traits<allocator_type>::allocate(m_allocator, other.m_capacity);
+        } catch (...) {
+            std::allocator_traits<ctrl_allocator>::deallocate(ctrl_alloc, m_ctrl, ctrl_bytes(other.m_capacity));
+            m_ctrl = hash_detail::empty_group();
+            throw;
+        }
+        m_capacity = other.m_capacity;
+        std::memcpy(m_ctrl, other.m_ctrl, ctrl_bytes(m_capacity));
+
+        size_type i = 0;
+        try {
+            for (; i < m_capacity; ++i) {
+                if (hash_detail::is_full(m_ctrl[i])) {
+                    if constexpr (std::is_const_v<Source>) {
+                        std::allocator_traits<allocator_type>::construct(m_allocator, m_slots + i, other.m_slots[i]);
+                    } else {
+                        std::allocator_traits<allocator_type>::construct(m_allocator, m_slots + i, Policy::transfer(other.m_slots[i]));
+                    }
+                }
+            }
+        } catch (...) {
+            // Forget the elements that were not copied, then release the ones that were
+            for (size_type j = i; j < m_capacity; ++j) {
+                m_ctrl[j] = hash_detail::ctrl_empty;
+            }
+            destroy_and_deallocate();
+            reset_empty();
+            throw;
+        }
+
+        m_size = other.m_size;
+        m_growth_left = other.m_growth_left;
+    }
+
+    void destroy_elements() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_type i = 0; i < m_capacity; ++i) {
+                if (hash_detail::is_full(m_ctrl[i])) {
+                    std::allocator_traits<allocator_type>::destroy(m_allocator, m_slots + i);
+                }
+            }
+        }
+    }
+
+    void destroy_and_deallocate() noexcept {
+        if (m_capacity == 0) {
+            return;
+        }
+
+        destroy_elements();
+        ctrl_allocator ctrl_alloc(m_allocator);
+        std::allocator_traits<ctrl_allocator>::deallocate(ctrl_alloc, m_ctrl, ctrl_bytes(m_capacity));
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, m_slots, m_capacity);
+    }
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "hashTable.h"
+
+// Element policy of HashMap: key-value pairs keyed by their first member
+template <typename K, typename V>
+struct HashMapPolicy {
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+
+    static constexpr bool constant_iterators = false;
+
+    static const K& key(const value_type& value) noexcept { return value.first; }
+
+    // Moves a pair out of a slot that is destroyed right after, the key included, the same way
+    // extracting a node from a std::map hands out a mutable key
+    static std::pair<K&&, V&&> transfer(value_type& value) noexcept {
+        return {std::move(const_cast<K&>(value.first)), std::move(value.second)};
+    }
+};
+
+// Hash map with open addressing, see hashTable.h for the table layout.
+// Elements are stored in place, so inserting may move them: a rehash invalidates iterators, pointers
+// and references. Erasing never moves other elements.
+// Lookups accept any key type when both Hash and Eq declare is_transparent.
+template <typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>,
+    typename Alloc = SimpleAllocator<std::pair<const K, V>>>
+class HashMap : public HashTable<HashMapPolicy<K, V>, Hash, Eq, Alloc> {
+    using Base = HashTable<HashMapPolicy<K, V>, Hash, Eq, Alloc>;
+
+    template <class Key>
+    using key_arg = typename Base::template key_arg<Key>;
+
+public:
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using mapped_type = V;
+
+    using Base::Base;
+
+    HashMap() = default;
+
+    HashMap(std::initializer_list<value_type> values) : Base(values) {}
+
+    // Inserts a value constructed from args under key if the key is not present yet. Nothing is
+    // constructed or moved from when it is.
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return this->emplace_with_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return this->emplace_with_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    // Assigns value to the element with key, inserting it if the key is not present yet
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value) {
+        auto result = try_emplace(key, std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& value) {
+        auto result = try_emplace(std::move(key), std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    // Returns the value stored under key, inserting a value-initialized one if there is none
+    V& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    V& operator[](key_type&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    // Returns the value stored under key, throws if there is none
+    template <class Key = key_type>
+    V& at(const key_arg<Key>& key) {
+        auto it = this->find(key);
+        if (it == this->end()) {
+            throw std::out_of_range("Key not found");
+        }
+        return it->second;
+    }
+
+    template <class Key = key_type>
+    const V& at(const key_arg<Key>& key) const {
+        auto it = this->find(key);
+        if (it == this->end()) {
+            throw std::out_of_range("Key not found");
+        }
+        return it->second;
+    }
+};
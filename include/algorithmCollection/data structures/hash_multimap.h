@@ -0,0 +1,29 @@
+#pragma once
+#include <functional>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "hash_map.h"
+#include "hashMultiTable.h"
+
+// Hash multimap on the shared hash table engine, see hashMultiTable.h. Values with equal keys are
+// stored contiguously in insertion order, so equal_range is one scan over adjacent memory.
+// Lookups accept any key type when both Hash and Eq declare is_transparent.
+template <typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>,
+    typename Alloc = SimpleAllocator<std::pair<const K, V>>>
+class HashMultiMap : public HashMultiTable<HashMapPolicy<K, V>, Hash, Eq, Alloc> {
+    using Base = HashMultiTable<HashMapPolicy<K, V>, Hash, Eq, Alloc>;
+
+public:
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using mapped_type = V;
+
+    using Base::Base;
+
+    HashMultiMap() = default;
+
+    HashMultiMap(std::initializer_list<value_type> values) : Base(values) {}
+};
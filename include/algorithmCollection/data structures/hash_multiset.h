@@ -0,0 +1,26 @@
+#pragma once
+#include <functional>
+#include "../allocators/simpleAllocator.h"
+#include "hash_set.h"
+#include "hashMultiTable.h"
+
+// Hash multiset on the shared hash table engine, see hashMultiTable.h. Equal elements are stored
+// contiguously in insertion order, so count and equal_range are one scan over adjacent memory.
+// Lookups accept any key type when both Hash and Eq declare is_transparent.
+template <typename K, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>, typename Alloc = SimpleAllocator<K>>
+class HashMultiSet : public HashMultiTable<HashSetPolicy<K>, Hash, Eq, Alloc> {
+    using Base = HashMultiTable<HashSetPolicy<K>, Hash, Eq, Alloc>;
+
+public:
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    using Base::Base;
+
+    HashMultiSet() = default;
+
+    HashMultiSet(std::initializer_list<value_type> values) : Base(values) {}
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <functional>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "hashTable.h"
+
+// Element policy of HashSet: every element is its own key
+template <typename K>
+struct HashSetPolicy {
+    using key_type = K;
+    using value_type = K;
+
+    static constexpr bool constant_iterators = true;
+
+    static const K& key(const value_type& value) noexcept { return value; }
+
+    static K&& transfer(value_type& value) noexcept { return std::move(value); }
+};
+
+// Hash set with open addressing, see hashTable.h for the table layout.
+// Elements are stored in place, so inserting may move them: a rehash invalidates iterators, pointers
+// and references. Erasing never moves other elements.
+// Lookups accept any key type when both Hash and Eq declare is_transparent.
+template <typename K, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>, typename Alloc = SimpleAllocator<K>>
+class HashSet : public HashTable<HashSetPolicy<K>, Hash, Eq, Alloc> {
+    using Base = HashTable<HashSetPolicy<K>, Hash, Eq, Alloc>;
+
+public:
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    using Base::Base;
+
+    HashSet() = default;
+
+    HashSet(std::initializer_list<value_type> values) : Base(values) {}
+};
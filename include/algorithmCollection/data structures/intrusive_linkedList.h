@@ -0,0 +1,280 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+// Links embedded in a user object so it can be a member of an IntrusiveList. An object derives
+// publicly from one hook per list it can be in at the same time, each with its own Tag. A hook that
+// is not linked has null links.
+template <typename Tag = void>
+struct IntrusiveListHook {
+    IntrusiveListHook* next = nullptr;
+    IntrusiveListHook* prev = nullptr;
+
+    IntrusiveListHook() = default;
+
+    // Copying an object never copies its list membership
+    IntrusiveListHook(const IntrusiveListHook&) noexcept {}
+    IntrusiveListHook& operator=(const IntrusiveListHook&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return next != nullptr; }
+};
+
+// Non-owning double linked list threaded through the IntrusiveListHook<Tag> base of T.
+// The list never allocates: linking, unlinking and removing an element known by reference are O(1),
+// which suits LRU lists and timer queues where elements move between lists or are dropped from the
+// middle. Elements must outlive their membership and are never destroyed by the list.
+template <typename T, typename Tag = void>
+class IntrusiveList {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using hook_type = IntrusiveListHook<Tag>;
+
+private:
+    template <bool Const>
+    class basic_iterator {
+        using hook_pointer = std::conditional_t<Const, const hook_type*, hook_type*>;
+        hook_pointer node;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        basic_iterator() : node(nullptr) {}
+        explicit basic_iterator(hook_pointer n) : node(n) {}
+
+        // iterator converts to const_iterator
+        template <bool OtherConst, std::enable_if_t<Const && !OtherConst, int> = 0>
+        basic_iterator(const basic_iterator<OtherConst>& other) : node(other.get_node()) {}
+
+        reference operator*() const { return *owner_of(node); }
+        pointer operator->() const { return owner_of(node); }
+
+        basic_iterator& operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator temp(*this);
+            node = node->next;
+            return temp;
+        }
+
+        basic_iterator& operator--() {
+            node = node->prev;
+            return *this;
+        }
+
+        basic_iterator operator--(int) {
+            basic_iterator temp(*this);
+            node = node->prev;
+            return temp;
+        }
+
+        hook_pointer get_node() const {
+            return node;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.node == rhs.node; }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.node != rhs.node; }
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    IntrusiveList() noexcept : m_root(), m_size(0) {
+        m_root.next = &m_root;
+        m_root.prev = &m_root;
+    }
+
+    // Elements can only be members of one list through the same hook, so lists are move-only
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    IntrusiveList(IntrusiveList&& other) noexcept : IntrusiveList() {
+        take_nodes(other);
+    }
+
+    IntrusiveList& operator=(IntrusiveList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            take_nodes(other);
+        }
+        return *this;
+    }
+
+    // Unlinks all elements so they can join another list
+    ~IntrusiveList() { clear(); }
+
+    iterator begin() noexcept { return iterator(m_root.next); }
+    const_iterator begin() const noexcept { return const_iterator(m_root.next); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(&m_root); }
+    const_iterator end() const noexcept { return const_iterator(&m_root); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    size_type size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    T& front() {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return *owner_of(m_root.next);
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return *owner_of(m_root.next);
+    }
+
+    T& back() {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return *owner_of(m_root.prev);
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return *owner_of(m_root.prev);
+    }
+
+    void push_front(T& value) {
+        insert(cbegin(), value);
+    }
+
+    void push_back(T& value) {
+        insert(cend(), value);
+    }
+
+    // Links value in front of pos. value must not already be linked through Hook.
+    iterator insert(const_iterator pos, T& value) {
+        hook_type& hook = static_cast<hook_type&>(value);
+        if (hook.is_linked()) {
+            throw std::logic_error("Element is already linked");
+        }
+
+        hook_type* next = const_cast<hook_type*>(pos.get_node());
+        hook.next = next;
+        hook.prev = next->prev;
+        next->prev->next = &hook;
+        next->prev = &hook;
+        ++m_size;
+
+        return iterator(&hook);
+    }
+
+    // Unlinks the element at pos and returns an iterator to the element after it
+    iterator erase(const_iterator pos) {
+        if (pos == cend()) {
+            throw std::out_of_range("Invalid index");
+        }
+
+        hook_type* hook = const_cast<hook_type*>(pos.get_node());
+        hook_type* next = hook->next;
+        unlink(hook);
+        return iterator(next);
+    }
+
+    // Unlinks value, which must be a member of this list, in O(1)
+    void remove(T& value) noexcept {
+        unlink(&static_cast<hook_type&>(value));
+    }
+
+    void pop_front() {
+        if (empty()) {
+            throw std::logic_error("List is empty");
+        }
+        unlink(m_root.next);
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::logic_error("List is empty");
+        }
+        unlink(m_root.prev);
+    }
+
+    // Returns an iterator to value, which must be a member of this list
+    iterator iterator_to(T& value) noexcept {
+        return iterator(&static_cast<hook_type&>(value));
+    }
+
+    const_iterator iterator_to(const T& value) const noexcept {
+        return const_iterator(&static_cast<const hook_type&>(value));
+    }
+
+    // Unlinks all elements without destroying them
+    void clear() noexcept {
+        hook_type* hook = m_root.next;
+        while (hook != &m_root) {
+            hook_type* next = hook->next;
+            hook->next = nullptr;
+            hook->prev = nullptr;
+            hook = next;
+        }
+
+        m_root.next = &m_root;
+        m_root.prev = &m_root;
+        m_size = 0;
+    }
+
+private:
+    // Only element hooks are dereferenced, never the root, and each is the base of a T
+    static T* owner_of(hook_type* hook) noexcept {
+        return static_cast<T*>(hook);
+    }
+
+    static const T* owner_of(const hook_type* hook) noexcept {
+        return static_cast<const T*>(hook);
+    }
+
+    void unlink(hook_type* hook) noexcept {
+        hook->prev->next = hook->next;
+        hook->next->prev = hook->prev;
+        hook->next = nullptr;
+        hook->prev = nullptr;
+        --m_size;
+    }
+
+    void take_nodes(IntrusiveList& other) noexcept {
+        if (other.empty()) {
+            return;
+        }
+
+        m_root.next = other.m_root.next;
+        m_root.prev = other.m_root.prev;
+        m_root.next->prev = &m_root;
+        m_root.prev->next = &m_root;
+        m_size = other.m_size;
+
+        other.m_root.next = &other.m_root;
+        other.m_root.prev = &other.m_root;
+        other.m_size = 0;
+    }
+
+    hook_type m_root;
+    size_type m_size;
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "bTree.h"
+
+// Element policy of Map and MultiMap: key-value pairs ordered by their first member
+template <typename K, typename V>
+struct BTreeMapPolicy {
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+
+    static constexpr bool constant_iterators = false;
+
+    static const K& key(const value_type& value) noexcept { return value.first; }
+
+    // Moves a pair out of a slot that is destroyed right after, the key included
+    static std::pair<K&&, V&&> transfer(value_type& value) noexcept {
+        return {std::move(const_cast<K&>(value.first)), std::move(value.second)};
+    }
+};
+
+// Ordered map stored in a B-tree, see bTree.h for the node layout.
+// Inserting and erasing move elements between nodes, so they invalidate iterators, pointers and
+// references. bulk_load builds the map from a sorted DynamicArray in O(n).
+// Lookups accept any key type when Compare declares is_transparent.
+template <typename K, typename V, typename Compare = std::less<K>,
+    typename Alloc = SimpleAllocator<std::pair<const K, V>>>
+class Map : public BTree<BTreeMapPolicy<K, V>, Compare, Alloc, false> {
+    using Base = BTree<BTreeMapPolicy<K, V>, Compare, Alloc, false>;
+
+    template <class Key>
+    using key_arg = typename Base::template key_arg<Key>;
+
+public:
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using mapped_type = V;
+
+    using Base::Base;
+
+    Map() = default;
+
+    Map(std::initializer_list<value_type> values) : Base(values) {}
+
+    // Inserts a value constructed from args under key if the key is not present yet. Nothing is
+    // constructed or moved from when it is.
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return this->insert_with_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return this->insert_with_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    // Assigns value to the element with key, inserting it if the key is not present yet
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value) {
+        auto result = try_emplace(key, std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& value) {
+        auto result = try_emplace(std::move(key), std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    // Returns the value stored under key, inserting a value-initialized one if there is none
+    V& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    V& operator[](key_type&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    // Returns the value stored under key, throws if there is none
+    template <class Key = key_type>
+    V& at(const key_arg<Key>& key) {
+        auto it = this->find(key);
+        if (it == this->end()) {
+            throw std::out_of_range("Key not found");
+        }
+        return it->second;
+    }
+
+    template <class Key = key_type>
+    const V& at(const key_arg<Key>& key) const {
+        auto it = this->find(key);
+        if (it == this->end()) {
+            throw std::out_of_range("Key not found");
+        }
+        return it->second;
+    }
+};
@@ -0,0 +1,563 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "tabular.h"
+
+// Files are mapped with mmap where POSIX is available. Elsewhere, or with
+// ALGORITHM_COLLECTION_NO_MMAP defined, they are read into memory at open instead.
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(ALGORITHM_COLLECTION_NO_MMAP)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ALGORITHM_COLLECTION_MMAP 1
+#endif
+
+// Binary files of trivially copyable values, and read-only views that map them into memory.
+//
+// write_mapped_array() saves one array, write_mapped_table() every column of a Tabular. MappedArray
+// and MappedTable open such a file and use its bytes in place: opening costs a check of the header
+// whatever the file size, and pages are read from disk when first touched. The views expose spans,
+// so the column_ kernels of tabular.h and the simd_ kernels run on them directly.
+//
+// Layout, all integers in the byte order of the machine that wrote the file (readers reject the other):
+//   64 byte file header   magic "ACMAPPED", version, byte order mark, column count, row count
+//   32 bytes per column   element size, alignment, type code, data offset, checksum
+//   column data           each column at a 64 byte aligned offset, or its element alignment if larger
+// The checksum covers a column's data bytes. Verifying reads the whole column, so it is left to
+// verify_checksums() or MappedCheck::Checksum rather than done on every open.
+
+// Work done when opening a mapped file
+enum class MappedCheck {
+    Header,  // Format, element types and sizes; constant time
+    Checksum // Header, then every column's checksum; reads the whole file
+};
+
+// Expected access pattern, passed to the kernel so it can schedule reads ahead
+enum class MappedAccess { Normal, Sequential, Random, WillNeed };
+
+namespace mapped_detail {
+    inline constexpr char magic[8] = {'A', 'C', 'M', 'A', 'P', 'P', 'E', 'D'};
+    inline constexpr std::uint32_t version = 1;
+    inline constexpr std::uint32_t byte_order_mark = 0x01020304;
+    inline constexpr std::size_t section_alignment = 64;
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t column_count;
+        std::uint32_t reserved;
+        std::uint64_t row_count;
+        std::uint64_t padding[4];
+    };
+
+    struct ColumnHeader {
+        std::uint32_t element_size;
+        std::uint32_t element_align;
+        std::uint32_t type_code;
+        std::uint32_t reserved;
+        std::uint64_t offset;
+        std::uint64_t checksum;
+    };
+
+    static_assert(sizeof(FileHeader) == 64 && sizeof(ColumnHeader) == 32);
+
+    // Element type as stored in a column header. Arithmetic types record their kind as well as
+    // their size, so a float column does not open as int32_t; other types only check size and
+    // alignment.
+    struct ElementInfo {
+        std::uint32_t size;
+        std::uint32_t align;
+        std::uint32_t type_code;
+    };
+
+    template <typename T>
+    constexpr ElementInfo element_info() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "Mapped arrays hold trivially copyable types only");
+        static_assert(alignof(T) <= 4096, "Mapped array elements cannot be aligned beyond a page");
+        std::uint32_t kind = 0;
+        if constexpr (std::is_floating_point_v<T>) {
+            kind = 3;
+        } else if constexpr (std::is_integral_v<T>) {
+            kind = std::is_signed_v<T> ? 2 : 1;
+        }
+        return {static_cast<std::uint32_t>(sizeof(T)), static_cast<std::uint32_t>(alignof(T)),
+            (kind << 16) | static_cast<std::uint32_t>(sizeof(T))};
+    }
+
+    // 64 bit checksum over four independent lanes of 8 byte words, so it runs at memory speed
+    // rather than one multiply latency per word. Not a cryptographic hash.
+    inline std::uint64_t checksum(const std::byte* data, std::size_t size) noexcept {
+        constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+        constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+        const auto round = [](std::uint64_t acc, std::uint64_t word) {
+            return std::rotl(acc + word * prime2, 31) * prime1;
+        };
+        const auto load = [](const std::byte* p) {
+            std::uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            return word;
+        };
+
+        std::uint64_t lanes[4] = {prime1 + prime2, prime2, 0, 0 - prime1};
+        std::size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            for (std::size_t lane = 0; lane < 4; ++lane) {
+                lanes[lane] = round(lanes[lane], load(data + i + lane * 8));
+            }
+        }
+        std::uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12)
+            + std::rotl(lanes[3], 18) + static_cast<std::uint64_t>(size);
+        for (; i + 8 <= size; i += 8) {
+            hash = std::rotl(hash ^ round(0, load(data + i)), 27) * prime1 + prime3;
+        }
+        for (; i < size; ++i) {
+            hash = std::rotl(hash ^ (static_cast<std::uint64_t>(data[i]) * prime3), 11) * prime1;
+        }
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        return hash ^ (hash >> 32);
+    }
+
+    constexpr std::uint64_t align_up(std::uint64_t value, std::uint64_t alignment) noexcept {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    struct Section {
+        const std::byte* data;
+        std::size_t bytes;
+        ElementInfo info;
+    };
+
+    // Writes the header, the column headers and the sections to a temporary file next to path and
+    // renames it over path once complete, so a failed write leaves any previous file intact
+    template <std::size_t N>
+    void write_file(const std::filesystem::path& path, std::uint64_t row_count, const std::array<Section, N>& sections) {
+        FileHeader header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.byte_order = byte_order_mark;
+        header.column_count = static_cast<std::uint32_t>(N);
+        header.row_count = row_count;
+
+        std::array<ColumnHeader, N> columns{};
+        std::uint64_t position = sizeof(FileHeader) + N * sizeof(ColumnHeader);
+        for (std::size_t i = 0; i < N; ++i) {
+            const ElementInfo& info = sections[i].info;
+            position = align_up(position, std::max<std::uint64_t>(section_alignment, info.align));
+            columns[i] = {info.size, info.align, info.type_code, 0, position,
+                checksum(sections[i].data, sections[i].bytes)};
+            position += sections[i].bytes;
+        }
+
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Cannot create " + temporary.string());
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(columns.data()), static_cast<std::streamsize>(N * sizeof(ColumnHeader)));
+            std::uint64_t written = sizeof(FileHeader) + N * sizeof(ColumnHeader);
+            const char zeros[section_alignment * 64] = {};
+            for (std::size_t i = 0; i < N; ++i) {
+                out.write(zeros, static_cast<std::streamsize>(columns[i].offset - written));
+                if (sections[i].bytes > 0) {
+                    out.write(reinterpret_cast<const char*>(sections[i].data), static_cast<std::streamsize>(sections[i].bytes));
+                }
+                written = columns[i].offset + sections[i].bytes;
+            }
+            out.close();
+            if (!out) {
+                std::filesystem::remove(temporary);
+                throw std::runtime_error("Cannot write " + temporary.string());
+            }
+        }
+        std::filesystem::rename(temporary, path);
+    }
+
+    // Read-only memory holding a whole file: a shared mapping, or a page-aligned copy without mmap
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        explicit MappedFile(const std::filesystem::path& path) {
+#ifdef ALGORITHM_COLLECTION_MMAP
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot open " + path.string());
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Cannot stat " + path.string());
+            }
+            m_size = static_cast<std::size_t>(info.st_size);
+            if (m_size > 0) {
+                void* address = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+                const int error = errno;
+                // The mapping keeps the file open by itself
+                ::close(fd);
+                if (address == MAP_FAILED) {
+                    throw std::system_error(error, std::generic_category(), "Cannot map " + path.string());
+                }
+                m_data = static_cast<std::byte*>(address);
+            } else {
+                ::close(fd);
+            }
+#else
+            // Throws std::filesystem::filesystem_error, a std::system_error, if the file is missing
+            m_size = static_cast<std::size_t>(std::filesystem::file_size(path));
+            std::ifstream in(path, std::ios::binary);
+            if (m_size > 0) {
+                m_data = static_cast<std::byte*>(::operator new(m_size, std::align_val_t{4096}));
+                if (!in.read(reinterpret_cast<char*>(m_data), static_cast<std::streamsize>(m_size))) {
+                    release();
+                    throw std::system_error(std::make_error_code(std::errc::io_error), "Cannot read " + path.string());
+                }
+            }
+#endif
+        }
+
+        MappedFile(MappedFile&& other) noexcept
+            : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                release();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+            }
+            return *this;
+        }
+
+        ~MappedFile() { release(); }
+
+        const std::byte* data() const noexcept { return m_data; }
+        std::size_t size() const noexcept { return m_size; }
+
+        void advise(const std::byte* address, std::size_t bytes, MappedAccess access) const noexcept {
+#ifdef ALGORITHM_COLLECTION_MMAP
+            if (bytes == 0) {
+                return;
+            }
+            // madvise needs a page-aligned start
+            const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const std::size_t start = static_cast<std::size_t>(address - m_data) / page * page;
+            const std::size_t length = static_cast<std::size_t>(address - m_data) + bytes - start;
+            int advice = MADV_NORMAL;
+            switch (access) {
+                case MappedAccess::Normal: advice = MADV_NORMAL; break;
+                case MappedAccess::Sequential: advice = MADV_SEQUENTIAL; break;
+                case MappedAccess::Random: advice = MADV_RANDOM; break;
+                case MappedAccess::WillNeed: advice = MADV_WILLNEED; break;
+            }
+            ::madvise(const_cast<std::byte*>(m_data) + start, length, advice);
+#else
+            static_cast<void>(address);
+            static_cast<void>(bytes);
+            static_cast<void>(access);
+#endif
+        }
+
+    private:
+        std::byte* m_data = nullptr;
+        std::size_t m_size = 0;
+
+        void release() noexcept {
+            if (m_data == nullptr) {
+                return;
+            }
+#ifdef ALGORITHM_COLLECTION_MMAP
+            ::munmap(m_data, m_size);
+#else
+            ::operator delete(m_data, std::align_val_t{4096});
+#endif
+            m_data = nullptr;
+        }
+    };
+
+    // Checks the file against the expected element types and returns its row count
+    template <std::size_t N>
+    std::uint64_t check_layout(const MappedFile& file, const std::array<ElementInfo, N>& expected,
+        std::array<ColumnHeader, N>& columns) {
+        FileHeader header;
+        if (file.size() < sizeof(header)) {
+            throw std::runtime_error("Not a mapped array file");
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+            throw std::runtime_error("Not a mapped array file");
+        }
+        if (header.byte_order != byte_order_mark) {
+            throw std::runtime_error("Mapped array file has the wrong byte order");
+        }
+        if (header.version != version) {
+            throw std::runtime_error("Unsupported mapped array file version");
+        }
+        if (header.column_count != N) {
+            throw std::runtime_error("Mapped array file has a different number of columns");
+        }
+        if (file.size() < sizeof(FileHeader) + N * sizeof(ColumnHeader)) {
+            throw std::runtime_error("Mapped array file is truncated");
+        }
+        std::memcpy(columns.data(), file.data() + sizeof(FileHeader), N * sizeof(ColumnHeader));
+        for (std::size_t i = 0; i < N; ++i) {
+            const ColumnHeader& column = columns[i];
+            if (column.element_size != expected[i].size || column.element_align != expected[i].align
+                || column.type_code != expected[i].type_code) {
+                throw std::runtime_error("Mapped array element type does not match");
+            }
+            if (column.offset % column.element_align != 0 || column.offset > file.size()
+                || header.row_count > (file.size() - column.offset) / column.element_size) {
+                throw std::runtime_error("Mapped array file is truncated");
+            }
+        }
+        return header.row_count;
+    }
+
+    template <std::size_t N>
+    bool checksums_match(const MappedFile& file, const std::array<ColumnHeader, N>& columns, std::uint64_t rows) noexcept {
+        return std::all_of(columns.begin(), columns.end(), [&](const ColumnHeader& column) {
+            return checksum(file.data() + column.offset, static_cast<std::size_t>(rows * column.element_size))
+                == column.checksum;
+        });
+    }
+}
+
+// Writes values to path in the mapped array format, replacing the file if it exists
+template <typename T>
+void write_mapped_array(const std::filesystem::path& path, std::span<T> values) {
+    using V = std::remove_const_t<T>;
+    const std::array<mapped_detail::Section, 1> sections = {
+        mapped_detail::Section{reinterpret_cast<const std::byte*>(values.data()), values.size_bytes(),
+            mapped_detail::element_info<V>()}};
+    mapped_detail::write_file(path, values.size(), sections);
+}
+
+// Writes every column of table to path, one section per column
+template <typename... Columns>
+void write_mapped_table(const std::filesystem::path& path, const Tabular<Columns...>& table) {
+    const auto sections = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<mapped_detail::Section, sizeof...(Columns)>{
+            mapped_detail::Section{reinterpret_cast<const std::byte*>(table.template column<I>().data()),
+                table.template column<I>().size_bytes(), mapped_detail::element_info<Columns>()}...};
+    }(std::index_sequence_for<Columns...>{});
+    mapped_detail::write_file(path, table.size(), sections);
+}
+
+// Read-only array over a file written by write_mapped_array(). The elements are the file's bytes,
+// mapped into memory with no copy; the view stays valid while the MappedArray lives, and the file
+// must not be modified in that time.
+template <typename T>
+class MappedArray {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = const T&;
+    using const_reference = const T&;
+    using iterator = const T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using span = std::span<const T>;
+
+    MappedArray() = default;
+
+    // Maps the file at path. Throws std::system_error if it cannot be opened or mapped and
+    // std::runtime_error if it is not a mapped array of T, or if its checksum does not match
+    // under MappedCheck::Checksum.
+    explicit MappedArray(const std::filesystem::path& path, MappedCheck check = MappedCheck::Header)
+        : m_file(path) {
+        std::array<mapped_detail::ColumnHeader, 1> columns;
+        m_size = static_cast<std::size_t>(mapped_detail::check_layout(m_file, std::array{mapped_detail::element_info<T>()}, columns));
+        m_column = columns[0];
+        m_data = reinterpret_cast<const T*>(m_file.data() + m_column.offset);
+        if (check == MappedCheck::Checksum && !verify_checksums()) {
+            throw std::runtime_error("Mapped array checksum does not match");
+        }
+    }
+
+    // The mapping moves with the array, so the elements keep their addresses
+    MappedArray(MappedArray&& other) noexcept
+        : m_file(std::move(other.m_file)),
+        m_column(other.m_column),
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)) {}
+
+    MappedArray& operator=(MappedArray&& other) noexcept {
+        if (this != &other) {
+            m_file = std::move(other.m_file);
+            m_column = other.m_column;
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    const_iterator begin() const noexcept { return m_data; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator end() const noexcept { return m_data + m_size; }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // Returns a constant reference to the element stored at the specified index in the array.
+    const T& operator[](std::size_t index) const noexcept { return m_data[index]; }
+
+    // Access element by index, throws if not within the bounds of the array.
+    const T& at(std::size_t index) const {
+        if (index >= m_size) {
+            throw std::out_of_range("Index out of range");
+        }
+        return m_data[index];
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::logic_error("Array is empty");
+        }
+        return m_data[0];
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::logic_error("Array is empty");
+        }
+        return m_data[m_size - 1];
+    }
+
+    // Returns a span over the mapped elements
+    span data() const noexcept { return {m_data, m_size}; }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    // Recomputes the checksum of the elements, reading all of them
+    bool verify_checksums() const noexcept {
+        return mapped_detail::checksums_match(m_file, std::array{m_column}, m_size);
+    }
+
+    // Tells the kernel how the elements will be read, e.g. WillNeed to start reading them in
+    void advise(MappedAccess access) const noexcept {
+        m_file.advise(reinterpret_cast<const std::byte*>(m_data), m_size * sizeof(T), access);
+    }
+
+private:
+    mapped_detail::MappedFile m_file;
+    mapped_detail::ColumnHeader m_column{};
+    const T* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+// Read-only table over a file written by write_mapped_table() for a Tabular<Columns...>, with the
+// columns in place in the mapped file like MappedArray
+template <typename... Columns>
+class MappedTable {
+    static_assert(sizeof...(Columns) > 0, "A table needs at least one column");
+
+public:
+    using size_type = std::size_t;
+
+    template <std::size_t I>
+    using column_type = std::tuple_element_t<I, std::tuple<Columns...>>;
+
+    static constexpr std::size_t column_count = sizeof...(Columns);
+
+    MappedTable() = default;
+
+    // Maps the file at path, with the checks and exceptions of MappedArray's constructor
+    explicit MappedTable(const std::filesystem::path& path, MappedCheck check = MappedCheck::Header)
+        : m_file(path) {
+        m_size = static_cast<std::size_t>(
+            mapped_detail::check_layout(m_file, std::array{mapped_detail::element_info<Columns>()...}, m_columns));
+        [this]<std::size_t... I>(std::index_sequence<I...>) {
+            ((std::get<I>(m_data) = reinterpret_cast<const Columns*>(m_file.data() + m_columns[I].offset)), ...);
+        }(std::index_sequence_for<Columns...>{});
+        if (check == MappedCheck::Checksum && !verify_checksums()) {
+            throw std::runtime_error("Mapped array checksum does not match");
+        }
+    }
+
+    MappedTable(MappedTable&& other) noexcept
+        : m_file(std::move(other.m_file)),
+        m_columns(other.m_columns),
+        m_data(std::exchange(other.m_data, {})),
+        m_size(std::exchange(other.m_size, 0)) {}
+
+    MappedTable& operator=(MappedTable&& other) noexcept {
+        if (this != &other) {
+            m_file = std::move(other.m_file);
+            m_columns = other.m_columns;
+            m_data = std::exchange(other.m_data, {});
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    // Number of rows
+    size_type size() const noexcept { return m_size; }
+
+    bool empty() const noexcept { return m_size == 0; }
+
+    // Column I as a contiguous span
+    template <std::size_t I>
+    std::span<const column_type<I>> column() const noexcept {
+        return {std::get<I>(m_data), m_size};
+    }
+
+    // The fields of one row, gathered from the columns
+    std::tuple<const Columns&...> row(size_type index) const noexcept {
+        return std::apply([index](const Columns*... columns) { return std::tuple<const Columns&...>(columns[index]...); },
+            m_data);
+    }
+
+    std::tuple<const Columns&...> at(size_type index) const {
+        if (index >= m_size) {
+            throw std::out_of_range("Index out of range");
+        }
+        return row(index);
+    }
+
+    // Recomputes the checksum of every column, reading the whole file
+    bool verify_checksums() const noexcept {
+        return mapped_detail::checksums_match(m_file, m_columns, m_size);
+    }
+
+    // Tells the kernel how column I will be read
+    template <std::size_t I>
+    void advise(MappedAccess access) const noexcept {
+        m_file.advise(reinterpret_cast<const std::byte*>(std::get<I>(m_data)), m_size * sizeof(column_type<I>), access);
+    }
+
+private:
+    mapped_detail::MappedFile m_file;
+    std::array<mapped_detail::ColumnHeader, sizeof...(Columns)> m_columns{};
+    std::tuple<const Columns*...> m_data{};
+    std::size_t m_size = 0;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <functional>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "bTree.h"
+#include "map.h"
+
+// Ordered map allowing equal keys, stored in a B-tree, see bTree.h for the node layout.
+// Elements with equal keys are kept in insertion order.
+// Inserting and erasing move elements between nodes, so they invalidate iterators, pointers and
+// references. bulk_load builds the map from a sorted DynamicArray in O(n).
+// Lookups accept any key type when Compare declares is_transparent.
+template <typename K, typename V, typename Compare = std::less<K>,
+    typename Alloc = SimpleAllocator<std::pair<const K, V>>>
+class MultiMap : public BTree<BTreeMapPolicy<K, V>, Compare, Alloc, true> {
+    using Base = BTree<BTreeMapPolicy<K, V>, Compare, Alloc, true>;
+
+public:
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using mapped_type = V;
+
+    using Base::Base;
+
+    MultiMap() = default;
+
+    MultiMap(std::initializer_list<value_type> values) : Base(values) {}
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <functional>
+#include "../allocators/simpleAllocator.h"
+#include "bTree.h"
+#include "set.h"
+
+// Ordered set allowing equal elements, stored in a B-tree, see bTree.h for the node layout.
+// Equal elements are kept in insertion order.
+// Inserting and erasing move elements between nodes, so they invalidate iterators, pointers and
+// references. bulk_load builds the set from a sorted DynamicArray in O(n).
+// Lookups accept any key type when Compare declares is_transparent.
+template <typename K, typename Compare = std::less<K>, typename Alloc = SimpleAllocator<K>>
+class MultiSet : public BTree<BTreeSetPolicy<K>, Compare, Alloc, true> {
+    using Base = BTree<BTreeSetPolicy<K>, Compare, Alloc, true>;
+
+public:
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    using Base::Base;
+
+    MultiSet() = default;
+
+    MultiSet(std::initializer_list<value_type> values) : Base(values) {}
+};
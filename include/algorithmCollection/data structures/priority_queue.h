@@ -0,0 +1,546 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include "dynamicArray.h"
+
+// Implicit d-ary heaps. Children of node i sit at Arity * i + 1 ... Arity * i + Arity, so a sift
+// down reads Arity neighbouring elements per level from one or two cache lines and the heap is only
+// log_Arity(n) levels deep; 4 is a good default, 2 gives the classic binary heap.
+// As with std::priority_queue, top() is the greatest element under Compare; use std::greater for
+// a min-heap.
+namespace heap_detail {
+    // Moves the element at index toward the root while it has priority over its parent. Each
+    // element moved, including value itself, is reported to moved(index) at its new index.
+    template <std::size_t Arity, class Container, class Compare, class Moved>
+    std::size_t sift_up(Container& heap, std::size_t index, Compare& comp, Moved moved) {
+        auto value = std::move(heap[index]);
+        while (index > 0) {
+            const std::size_t parent = (index - 1) / Arity;
+            if (!comp(heap[parent], value)) {
+                break;
+            }
+            heap[index] = std::move(heap[parent]);
+            moved(index);
+            index = parent;
+        }
+        heap[index] = std::move(value);
+        moved(index);
+        return index;
+    }
+
+    // Index of the highest priority child in the group starting at first_child. A full group has a
+    // fixed trip count the compiler unrolls; for four children two independent pairs are compared
+    // first so the selections do not form one dependency chain.
+    template <std::size_t Arity, class Container, class Compare>
+    std::size_t best_child(const Container& heap, std::size_t first_child, std::size_t size, Compare& comp) {
+        if (first_child + Arity <= size) {
+            if constexpr (Arity == 4) {
+                const std::size_t left = comp(heap[first_child], heap[first_child + 1]) ? first_child + 1 : first_child;
+                const std::size_t right = comp(heap[first_child + 2], heap[first_child + 3]) ? first_child + 3 : first_child + 2;
+                return comp(heap[left], heap[right]) ? right : left;
+            } else {
+                std::size_t best = first_child;
+                for (std::size_t child = first_child + 1; child < first_child + Arity; ++child) {
+                    best = comp(heap[best], heap[child]) ? child : best;
+                }
+                return best;
+            }
+        }
+        std::size_t best = first_child;
+        for (std::size_t child = first_child + 1; child < size; ++child) {
+            best = comp(heap[best], heap[child]) ? child : best;
+        }
+        return best;
+    }
+
+    // Moves the element at index away from the root while a child has priority over it
+    template <std::size_t Arity, class Container, class Compare, class Moved>
+    std::size_t sift_down(Container& heap, std::size_t index, Compare& comp, Moved moved) {
+        const std::size_t size = heap.size();
+        auto value = std::move(heap[index]);
+        while (true) {
+            const std::size_t first_child = Arity * index + 1;
+            if (first_child >= size) {
+                break;
+            }
+
+            const std::size_t best = best_child<Arity>(heap, first_child, size, comp);
+            if (!comp(value, heap[best])) {
+                break;
+            }
+            heap[index] = std::move(heap[best]);
+            moved(index);
+            index = best;
+        }
+        heap[index] = std::move(value);
+        moved(index);
+        return index;
+    }
+
+    // Bottom-up sift down for a value that likely belongs near the leaves, like the last element
+    // moved to the root by a pop: the hole walks down to a leaf along the highest priority children,
+    // one comparison per child, and value is then sifted up from there. That saves the comparison
+    // against value on every level which the top-down sift pays.
+    template <std::size_t Arity, class Container, class Compare, class Moved>
+    std::size_t sift_down_to_leaf(Container& heap, std::size_t index, Compare& comp, Moved moved) {
+        const std::size_t size = heap.size();
+        const std::size_t start = index;
+        auto value = std::move(heap[index]);
+        while (true) {
+            const std::size_t first_child = Arity * index + 1;
+            if (first_child >= size) {
+                break;
+            }
+
+            const std::size_t best = best_child<Arity>(heap, first_child, size, comp);
+            heap[index] = std::move(heap[best]);
+            moved(index);
+            index = best;
+        }
+        while (index > start) {
+            const std::size_t parent = (index - 1) / Arity;
+            if (!comp(heap[parent], value)) {
+                break;
+            }
+            heap[index] = std::move(heap[parent]);
+            moved(index);
+            index = parent;
+        }
+        heap[index] = std::move(value);
+        moved(index);
+        return index;
+    }
+
+    // Floyd's bottom-up heap construction: sifts down every internal node, O(n). Elements that
+    // stay where they are are not reported to moved.
+    template <std::size_t Arity, class Container, class Compare, class Moved>
+    void make_heap(Container& heap, Compare& comp, Moved moved) {
+        const std::size_t size = heap.size();
+        if (size < 2) {
+            return;
+        }
+        for (std::size_t i = (size - 2) / Arity + 1; i-- > 0;) {
+            sift_down_to_leaf<Arity>(heap, i, comp, moved);
+        }
+    }
+
+    struct NoMoves {
+        void operator()(std::size_t) const noexcept {}
+    };
+}
+
+// Storage a PriorityQueue can keep its heap in
+template <typename C>
+concept HeapStorage = std::ranges::random_access_range<C> && requires(C c, typename C::value_type v) {
+    c.push_back(std::move(v));
+    c.pop_back();
+    c[std::size_t{}];
+    { c.size() } -> std::convertible_to<std::size_t>;
+};
+
+// Priority queue on an implicit Arity-ary heap stored in Container
+template <typename T, typename Compare = std::less<T>, std::size_t Arity = 4, HeapStorage Container = DynamicArray<T>>
+class PriorityQueue {
+    static_assert(Arity >= 2, "A heap needs at least two children per node");
+
+public:
+    using container_type = Container;
+    using value_type = T;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr std::size_t arity = Arity;
+
+    PriorityQueue() = default;
+
+    explicit PriorityQueue(const Compare& comp) : m_comp(comp) {}
+
+    // Takes over the elements of container and orders them in O(n)
+    explicit PriorityQueue(const Container& container, const Compare& comp = Compare())
+        : m_heap(container), m_comp(comp) {
+        heap_detail::make_heap<Arity>(m_heap, m_comp, heap_detail::NoMoves{});
+    }
+
+    explicit PriorityQueue(Container&& container, const Compare& comp = Compare())
+        : m_heap(std::move(container)), m_comp(comp) {
+        heap_detail::make_heap<Arity>(m_heap, m_comp, heap_detail::NoMoves{});
+    }
+
+    template <std::input_iterator InputIt>
+    PriorityQueue(InputIt first, InputIt last, const Compare& comp = Compare()) : m_comp(comp) {
+        assign(first, last);
+    }
+
+    PriorityQueue(std::initializer_list<T> values, const Compare& comp = Compare())
+        : PriorityQueue(values.begin(), values.end(), comp) {}
+
+    // Returns the element with the highest priority
+    const T& top() const {
+        if (empty()) {
+            throw std::out_of_range("PriorityQueue is empty");
+        }
+        return m_heap[0];
+    }
+
+    // Returns number of elements in the queue
+    size_type size() const noexcept { return m_heap.size(); }
+
+    // Checks whether the queue is empty or not
+    bool empty() const noexcept { return m_heap.size() == 0; }
+
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+
+    template <class... Args>
+    void emplace(Args&&... args) {
+        m_heap.push_back(T(std::forward<Args>(args)...));
+        heap_detail::sift_up<Arity>(m_heap, m_heap.size() - 1, m_comp, heap_detail::NoMoves{});
+    }
+
+    // Appends the elements of [first, last). Small batches are sifted up one by one; a batch
+    // comparable to the heap itself is cheaper to order by rebuilding the heap in O(n).
+    template <std::input_iterator InputIt>
+    void push_range(InputIt first, InputIt last) {
+        const size_type before = size();
+        for (; first != last; ++first) {
+            m_heap.push_back(*first);
+        }
+        const size_type added = size() - before;
+        if (added > before / 2) {
+            heap_detail::make_heap<Arity>(m_heap, m_comp, heap_detail::NoMoves{});
+        } else {
+            for (size_type i = before; i < size(); ++i) {
+                heap_detail::sift_up<Arity>(m_heap, i, m_comp, heap_detail::NoMoves{});
+            }
+        }
+    }
+
+    // Replaces the contents with [first, last), ordered in O(n)
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        for (; first != last; ++first) {
+            m_heap.push_back(*first);
+        }
+        heap_detail::make_heap<Arity>(m_heap, m_comp, heap_detail::NoMoves{});
+    }
+
+    // Removes the element with the highest priority
+    void pop() {
+        if (empty()) {
+            throw std::logic_error("PriorityQueue is empty");
+        }
+        if (m_heap.size() > 1) {
+            m_heap[0] = std::move(m_heap[m_heap.size() - 1]);
+        }
+        m_heap.pop_back();
+        if (!empty()) {
+            heap_detail::sift_down_to_leaf<Arity>(m_heap, 0, m_comp, heap_detail::NoMoves{});
+        }
+    }
+
+    // Removes the element with the highest priority and inserts value, with one sift down instead
+    // of the two sifts pop() followed by push() costs. Rescheduling a timer is a typical use.
+    void replace_top(T value) {
+        if (empty()) {
+            throw std::logic_error("PriorityQueue is empty");
+        }
+        m_heap[0] = std::move(value);
+        heap_detail::sift_down_to_leaf<Arity>(m_heap, 0, m_comp, heap_detail::NoMoves{});
+    }
+
+    // Removes and returns the element with the highest priority
+    T take_top() {
+        if (empty()) {
+            throw std::logic_error("PriorityQueue is empty");
+        }
+        T value = std::move(m_heap[0]);
+        pop();
+        return value;
+    }
+
+    void clear() noexcept { m_heap.clear(); }
+
+    void reserve(size_type capacity) requires requires(Container c) { c.reserve(size_type{}); } {
+        m_heap.reserve(capacity);
+    }
+
+    // The elements in heap order
+    const Container& container() const noexcept { return m_heap; }
+
+    value_compare value_comp() const { return m_comp; }
+
+    void swap(PriorityQueue& other) noexcept {
+        using std::swap;
+        m_heap.swap(other.m_heap);
+        swap(m_comp, other.m_comp);
+    }
+
+    friend void swap(PriorityQueue& lhs, PriorityQueue& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+private:
+    Container m_heap;
+    [[no_unique_address]] Compare m_comp{};
+};
+
+// Priority queue whose elements can be found again through the handle push() returns, to change
+// their priority or remove them in O(log n) without searching the heap.
+// Each heap entry records its handle and each handle its heap position, updated as sifts move
+// entries. Handles of removed elements are recycled with a new generation, so a stale handle is
+// detected rather than aliasing a newer element.
+template <typename T, typename Compare = std::less<T>, std::size_t Arity = 4>
+class IndexedPriorityQueue {
+    static_assert(Arity >= 2, "A heap needs at least two children per node");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+
+    static constexpr std::size_t arity = Arity;
+
+    class Handle {
+    public:
+        Handle() = default;
+
+        friend bool operator==(const Handle&, const Handle&) = default;
+
+    private:
+        friend class IndexedPriorityQueue;
+
+        Handle(std::uint32_t id, std::uint32_t generation) noexcept : m_id(id), m_generation(generation) {}
+
+        std::uint32_t m_id = static_cast<std::uint32_t>(-1);
+        std::uint32_t m_generation = 0;
+    };
+
+    IndexedPriorityQueue() = default;
+
+    explicit IndexedPriorityQueue(const Compare& comp) : m_comp(EntryCompare{comp}) {}
+
+    IndexedPriorityQueue(const IndexedPriorityQueue&) = default;
+    IndexedPriorityQueue& operator=(const IndexedPriorityQueue&) = default;
+
+    // The moved-from queue is left empty, with no free slots
+    IndexedPriorityQueue(IndexedPriorityQueue&& other) noexcept
+        : m_heap(std::move(other.m_heap)), m_slots(std::move(other.m_slots)),
+          m_free(std::exchange(other.m_free, no_id)), m_comp(std::move(other.m_comp)) {}
+
+    IndexedPriorityQueue& operator=(IndexedPriorityQueue&& other) noexcept {
+        if (this != &other) {
+            m_heap = std::move(other.m_heap);
+            m_slots = std::move(other.m_slots);
+            m_free = std::exchange(other.m_free, no_id);
+            m_comp = std::move(other.m_comp);
+        }
+        return *this;
+    }
+
+    // Returns the element with the highest priority
+    const T& top() const {
+        if (empty()) {
+            throw std::out_of_range("PriorityQueue is empty");
+        }
+        return m_heap[0].value;
+    }
+
+    // Returns the handle of the element with the highest priority
+    Handle top_handle() const {
+        if (empty()) {
+            throw std::out_of_range("PriorityQueue is empty");
+        }
+        return handle_of(m_heap[0].id);
+    }
+
+    size_type size() const noexcept { return m_heap.size(); }
+    bool empty() const noexcept { return m_heap.size() == 0; }
+
+    // Inserts value and returns its handle
+    Handle push(T value) {
+        const std::uint32_t id = acquire_id();
+        try {
+            m_heap.push_back(Entry{std::move(value), id});
+        } catch (...) {
+            release_id(id);
+            throw;
+        }
+        sift_up(m_heap.size() - 1);
+        return handle_of(id);
+    }
+
+    // Replaces the contents with [first, last), ordered in O(n). Returns the handles in input order.
+    template <std::input_iterator InputIt>
+    DynamicArray<Handle> assign(InputIt first, InputIt last) {
+        clear();
+        DynamicArray<Handle> handles;
+        for (; first != last; ++first) {
+            const std::uint32_t id = acquire_id();
+            m_heap.push_back(Entry{*first, id});
+            m_slots[id].position = m_heap.size() - 1;
+            handles.push_back(handle_of(id));
+        }
+        heap_detail::make_heap<Arity>(m_heap, m_comp, PositionUpdate{this});
+        return handles;
+    }
+
+    // Removes the element with the highest priority
+    void pop() {
+        if (empty()) {
+            throw std::logic_error("PriorityQueue is empty");
+        }
+        remove_at(0);
+    }
+
+    // Checks whether handle refers to an element still in the queue
+    bool contains(Handle handle) const noexcept {
+        return handle.m_id < m_slots.size() && m_slots[handle.m_id].generation == handle.m_generation &&
+            m_slots[handle.m_id].position != npos;
+    }
+
+    // Returns the element of handle
+    const T& value(Handle handle) const {
+        return m_heap[position_of(handle)].value;
+    }
+
+    // Gives the element of handle a new value and restores the heap order around it
+    void update(Handle handle, T value) {
+        const size_type position = position_of(handle);
+        const bool raises = m_comp.comp(m_heap[position].value, value);
+        m_heap[position].value = std::move(value);
+        if (raises) {
+            sift_up(position);
+        } else {
+            sift_down(position);
+        }
+    }
+
+    // Moves the element of handle toward the top: value must not have a lower priority than the
+    // current one (a smaller deadline in a min-heap of timers). Throws std::invalid_argument if it
+    // does.
+    void decrease_key(Handle handle, T value) {
+        const size_type position = position_of(handle);
+        if (m_comp.comp(value, m_heap[position].value)) {
+            throw std::invalid_argument("New key has a lower priority");
+        }
+        m_heap[position].value = std::move(value);
+        sift_up(position);
+    }
+
+    // Removes the element of handle
+    void erase(Handle handle) {
+        remove_at(position_of(handle));
+    }
+
+    void clear() noexcept {
+        for (const Entry& entry : m_heap) {
+            release_id(entry.id);
+        }
+        m_heap.clear();
+    }
+
+    void reserve(size_type capacity) {
+        m_heap.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+private:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+    static constexpr std::uint32_t no_id = static_cast<std::uint32_t>(-1);
+
+    struct Entry {
+        T value;
+        std::uint32_t id;
+    };
+
+    struct EntryCompare {
+        [[no_unique_address]] Compare comp;
+
+        bool operator()(const Entry& lhs, const Entry& rhs) const { return comp(lhs.value, rhs.value); }
+    };
+
+    // Where a handle's element sits in the heap, npos once it was removed
+    // Free slots are linked through next_free, so releasing an id never allocates
+    struct Slot {
+        size_type position;
+        std::uint32_t generation;
+        std::uint32_t next_free;
+    };
+
+    struct PositionUpdate {
+        IndexedPriorityQueue* queue;
+
+        void operator()(size_type index) const noexcept {
+            queue->m_slots[queue->m_heap[index].id].position = index;
+        }
+    };
+
+    DynamicArray<Entry> m_heap;
+    DynamicArray<Slot> m_slots;
+    std::uint32_t m_free = no_id; // First free slot
+    EntryCompare m_comp{};
+
+    Handle handle_of(std::uint32_t id) const noexcept { return Handle(id, m_slots[id].generation); }
+
+    size_type position_of(Handle handle) const {
+        if (!contains(handle)) {
+            throw std::invalid_argument("Invalid handle");
+        }
+        return m_slots[handle.m_id].position;
+    }
+
+    std::uint32_t acquire_id() {
+        if (m_free != no_id) {
+            const std::uint32_t id = m_free;
+            m_free = m_slots[id].next_free;
+            return id;
+        }
+        m_slots.push_back(Slot{npos, 0, no_id});
+        return static_cast<std::uint32_t>(m_slots.size() - 1);
+    }
+
+    void release_id(std::uint32_t id) noexcept {
+        m_slots[id].position = npos;
+        ++m_slots[id].generation;
+        m_slots[id].next_free = m_free;
+        m_free = id;
+    }
+
+    void sift_up(size_type position) {
+        heap_detail::sift_up<Arity>(m_heap, position, m_comp, PositionUpdate{this});
+    }
+
+    void sift_down(size_type position) {
+        heap_detail::sift_down<Arity>(m_heap, position, m_comp, PositionUpdate{this});
+    }
+
+    // Fills the hole at position with the last entry and sifts that in whichever direction it needs.
+    // The entry came from a leaf, so the way down is the bottom-up sift.
+    void remove_at(size_type position) {
+        const std::uint32_t id = m_heap[position].id;
+        const size_type last = m_heap.size() - 1;
+        if (position != last) {
+            m_heap[position] = std::move(m_heap[last]);
+        }
+        m_heap.pop_back();
+        release_id(id);
+
+        if (position < m_heap.size()) {
+            if (position > 0 && m_comp(m_heap[(position - 1) / Arity], m_heap[position])) {
+                sift_up(position);
+            } else {
+                heap_detail::sift_down_to_leaf<Arity>(m_heap, position, m_comp, PositionUpdate{this});
+            }
+        }
+    }
+};
@@ -0,0 +1,455 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "deque.h"
+
+// Storage a Queue can sit on: appends at the back and removes from the front. Deque does both in
+// O(1); DynamicArray also qualifies, but its pop_front shifts every element.
+template <typename C>
+concept QueueStorage = requires(C c, const C cc, typename C::value_type v) {
+    typename C::value_type;
+    c.push_back(v);
+    c.pop_front();
+    c.front();
+    c.back();
+    { cc.size() } -> std::convertible_to<std::size_t>;
+    { cc.empty() } -> std::convertible_to<bool>;
+};
+
+// First-in first-out adapter over Container.
+// front(), back() and pop() on an empty queue throw like the underlying container does.
+template <typename T, QueueStorage Container = Deque<T>>
+class Queue {
+public:
+    using container_type = Container;
+    using value_type = typename Container::value_type;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    Queue() = default;
+
+    explicit Queue(const Container& container) : m_container(container) {}
+
+    explicit Queue(Container&& container) : m_container(std::move(container)) {}
+
+    // Returns the oldest element
+    reference front() { return m_container.front(); }
+    const_reference front() const { return m_container.front(); }
+
+    // Returns the newest element
+    reference back() { return m_container.back(); }
+    const_reference back() const { return m_container.back(); }
+
+    // Returns number of elements in the queue
+    size_type size() const noexcept { return m_container.size(); }
+
+    // Checks whether the queue is empty or not
+    bool empty() const noexcept { return m_container.empty(); }
+
+    // Adds an element behind the newest one
+    void push(const value_type& value) { m_container.push_back(value); }
+    void push(value_type&& value) { m_container.push_back(std::move(value)); }
+
+    template <class... Args>
+    decltype(auto) emplace(Args&&... args) {
+        return m_container.emplace_back(std::forward<Args>(args)...);
+    }
+
+    // Removes the oldest element
+    void pop() { m_container.pop_front(); }
+
+    // Gives access to the underlying storage
+    const Container& container() const noexcept { return m_container; }
+
+    void swap(Queue& other) noexcept {
+        m_container.swap(other.m_container);
+    }
+
+    friend void swap(Queue& lhs, Queue& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    bool operator==(const Queue& rhs) const { return m_container == rhs.m_container; }
+
+private:
+    Container m_container;
+};
+
+// Bounded queues for passing elements between threads. Each allocates its ring once, in the
+// constructor, through Alloc; pushing and popping never allocate and never block: try_* return
+// false (or a count) when the queue is full or empty. The producer and the consumer indices are
+// padded to separate cache lines, so the two sides do not invalidate each other's lines on every
+// operation.
+
+// Alignment that keeps data written by different threads out of one cache line
+inline constexpr std::size_t queue_cache_line = 64;
+
+// Single-producer single-consumer ring. Every operation finishes in a bounded number of steps
+// (wait-free). Exactly one thread may push and one thread may pop at a time.
+// Each side caches the other side's index and only reloads it when the ring looks full or empty,
+// so in steady state a push or pop touches no cache line the other side writes.
+template <typename T, typename Alloc = SimpleAllocator<T>>
+class SpscQueue {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+    // Allocates room for at least capacity elements, rounded up to a power of two
+    explicit SpscQueue(size_type capacity, const allocator_type& alloc = allocator_type())
+        : m_allocator(alloc), m_capacity(std::bit_ceil(std::max<size_type>(capacity, 1))) {
+        m_slots = std::allocator_traits<allocator_type>::allocate(m_allocator, m_capacity);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue() {
+        const size_type tail = m_tail.load(std::memory_order_acquire);
+        for (size_type head = m_head.load(std::memory_order_relaxed); head != tail; ++head) {
+            std::allocator_traits<allocator_type>::destroy(m_allocator, slot(head));
+        }
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, m_slots, m_capacity);
+    }
+
+    // Producer side: constructs an element from args at the back, returns false if the queue is full
+    template <class... Args>
+    bool try_emplace(Args&&... args) {
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cached_head == m_capacity) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail - m_cached_head == m_capacity) {
+                return false;
+            }
+        }
+        std::allocator_traits<allocator_type>::construct(m_allocator, slot(tail), std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    // Producer side: pushes up to count elements read from first with a single index update.
+    // Returns the number pushed.
+    template <std::input_iterator InputIt>
+    size_type try_push_n(InputIt first, size_type count) {
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        if (m_capacity - (tail - m_cached_head) < count) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+        }
+        const size_type pushed = std::min(count, m_capacity - (tail - m_cached_head));
+
+        size_type i = 0;
+        try {
+            for (; i < pushed; ++i, ++first) {
+                std::allocator_traits<allocator_type>::construct(m_allocator, slot(tail + i), *first);
+            }
+        } catch (...) {
+            // Publish the elements constructed before the failure
+            m_tail.store(tail + i, std::memory_order_release);
+            throw;
+        }
+        m_tail.store(tail + pushed, std::memory_order_release);
+        return pushed;
+    }
+
+    // Consumer side: moves the front element into out, returns false if the queue is empty
+    bool try_pop(T& out) {
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cached_tail) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cached_tail) {
+                return false;
+            }
+        }
+        out = std::move(*slot(head));
+        std::allocator_traits<allocator_type>::destroy(m_allocator, slot(head));
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: moves up to count front elements to out with a single index update. Returns
+    // the number popped.
+    template <class OutputIt>
+    size_type try_pop_n(OutputIt out, size_type count) {
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        if (m_cached_tail - head < count) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+        }
+        const size_type popped = std::min(count, m_cached_tail - head);
+
+        size_type i = 0;
+        try {
+            for (; i < popped; ++i, ++out) {
+                *out = std::move(*slot(head + i));
+                std::allocator_traits<allocator_type>::destroy(m_allocator, slot(head + i));
+            }
+        } catch (...) {
+            // The element that failed to move stays at the front
+            m_head.store(head + i, std::memory_order_release);
+            throw;
+        }
+        m_head.store(head + popped, std::memory_order_release);
+        return popped;
+    }
+
+    // Number of elements, exact only while neither side is active
+    size_type size() const noexcept {
+        const size_type head = m_head.load(std::memory_order_acquire);
+        const size_type tail = m_tail.load(std::memory_order_acquire);
+        return std::min(tail - head, m_capacity);
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    size_type capacity() const noexcept { return m_capacity; }
+
+    allocator_type get_allocator() const noexcept { return m_allocator; }
+
+private:
+    T* slot(size_type index) const noexcept { return m_slots + (index & (m_capacity - 1)); }
+
+    // Read-only after construction, shared by both sides
+    [[no_unique_address]] allocator_type m_allocator;
+    size_type m_capacity;
+    T* m_slots = nullptr;
+
+    // Consumer: the next element to pop, and the last tail it saw
+    alignas(queue_cache_line) std::atomic<size_type> m_head{0};
+    size_type m_cached_tail = 0;
+
+    // Producer: the next slot to fill, and the last head it saw
+    alignas(queue_cache_line) std::atomic<size_type> m_tail{0};
+    size_type m_cached_head = 0;
+};
+
+// Multi-producer multi-consumer bounded queue (D. Vyukov's design). Every slot carries a sequence
+// number telling which lap of the ring it is ready for: producers and consumers claim a position
+// with one compare-and-swap on the shared index and then only wait on their own slot, which is
+// aligned to a cache line so neighbouring slots do not false-share.
+// A claimed slot has to be filled or emptied, so the operations after a claim must not throw: T
+// must be nothrow move constructible, and try_emplace builds a temporary first when the
+// constructor can throw. The batch operations claim several consecutive positions at once.
+template <typename T, typename Alloc = SimpleAllocator<T>>
+class MpmcQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>,
+        "MpmcQueue elements must be nothrow move constructible and destructible");
+
+    struct alignas(queue_cache_line) Slot {
+        std::atomic<std::size_t> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* value() noexcept { return reinterpret_cast<T*>(storage); }
+    };
+
+    using slot_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+    // Allocates room for at least capacity elements, rounded up to a power of two
+    explicit MpmcQueue(size_type capacity, const allocator_type& alloc = allocator_type())
+        : m_allocator(alloc), m_capacity(std::bit_ceil(std::max<size_type>(capacity, 1))) {
+        slot_allocator slots(m_allocator);
+        m_slots = std::allocator_traits<slot_allocator>::allocate(slots, m_capacity);
+        for (size_type i = 0; i < m_capacity; ++i) {
+            ::new (static_cast<void*>(m_slots + i)) Slot;
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    ~MpmcQueue() {
+        const size_type tail = m_tail.load(std::memory_order_acquire);
+        for (size_type head = m_head.load(std::memory_order_relaxed); head != tail; ++head) {
+            std::allocator_traits<allocator_type>::destroy(m_allocator, slot(head).value());
+        }
+        for (size_type i = 0; i < m_capacity; ++i) {
+            m_slots[i].~Slot();
+        }
+        slot_allocator slots(m_allocator);
+        std::allocator_traits<slot_allocator>::deallocate(slots, m_slots, m_capacity);
+    }
+
+    // Constructs an element from args at the back, returns false if the queue is full
+    template <class... Args>
+    bool try_emplace(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+            const size_type position = claim(m_tail, 0);
+            if (position == no_position) {
+                return false;
+            }
+            fill(position, std::forward<Args>(args)...);
+            return true;
+        } else {
+            // Build the element before claiming a slot, so a throwing constructor cannot strand one
+            T value(std::forward<Args>(args)...);
+            return try_emplace(std::move(value));
+        }
+    }
+
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    // Pushes up to count elements read from first, claiming their positions with a single
+    // compare-and-swap. Returns the number pushed. Constructing T from the elements must not throw;
+    // pass a std::move_iterator to move elements that are only nothrow movable.
+    template <std::input_iterator InputIt>
+        requires std::is_nothrow_constructible_v<T, std::iter_reference_t<InputIt>>
+    size_type try_push_n(InputIt first, size_type count) {
+        size_type claimed = 0;
+        const size_type position = claim_n(m_tail, 0, count, claimed);
+        for (size_type i = 0; i < claimed; ++i, ++first) {
+            fill(position + i, *first);
+        }
+        return claimed;
+    }
+
+    // Moves the front element into out, returns false if the queue is empty. Move assigning T must
+    // not throw.
+    bool try_pop(T& out) noexcept {
+        static_assert(std::is_nothrow_move_assignable_v<T>, "try_pop requires a nothrow move assignment");
+        const size_type position = claim(m_head, 1);
+        if (position == no_position) {
+            return false;
+        }
+        empty_into(position, out);
+        return true;
+    }
+
+    // Moves up to count front elements to out, claiming their positions with a single
+    // compare-and-swap. Returns the number popped. If writing to out throws, the remaining claimed
+    // elements are dropped before the exception propagates.
+    template <class OutputIt>
+    size_type try_pop_n(OutputIt out, size_type count) {
+        size_type claimed = 0;
+        const size_type position = claim_n(m_head, 1, count, claimed);
+        size_type i = 0;
+        try {
+            for (; i < claimed; ++i, ++out) {
+                Slot& target = slot(position + i);
+                *out = std::move(*target.value());
+                release(position + i);
+            }
+        } catch (...) {
+            for (; i < claimed; ++i) {
+                release(position + i);
+            }
+            throw;
+        }
+        return claimed;
+    }
+
+    // Number of elements, approximate while threads are pushing or popping
+    size_type size() const noexcept {
+        const size_type head = m_head.load(std::memory_order_acquire);
+        const size_type tail = m_tail.load(std::memory_order_acquire);
+        return tail > head ? std::min(tail - head, m_capacity) : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    size_type capacity() const noexcept { return m_capacity; }
+
+    allocator_type get_allocator() const noexcept { return m_allocator; }
+
+private:
+    static constexpr size_type no_position = static_cast<size_type>(-1);
+
+    Slot& slot(size_type position) const noexcept { return m_slots[position & (m_capacity - 1)]; }
+
+    // Lap offset of the sequence a slot holds when it is ready for the side owning index: a slot is
+    // ready to be filled at position p when its sequence is p, and to be emptied when it is p + 1
+    static std::ptrdiff_t readiness(const Slot& target, size_type position, size_type lag) noexcept {
+        return static_cast<std::ptrdiff_t>(target.sequence.load(std::memory_order_acquire) - (position + lag));
+    }
+
+    // Claims the next position of index if its slot is ready, or returns no_position if the queue
+    // is full (for producers) or empty (for consumers)
+    size_type claim(std::atomic<size_type>& index, size_type lag) noexcept {
+        size_type position = index.load(std::memory_order_relaxed);
+        while (true) {
+            const std::ptrdiff_t ready = readiness(slot(position), position, lag);
+            if (ready == 0) {
+                if (index.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    return position;
+                }
+            } else if (ready < 0) {
+                return no_position;
+            } else {
+                // Another thread claimed the position first
+                position = index.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Claims up to count consecutive positions whose slots are ready. Slots ready for this side
+    // cannot change until their positions are claimed, so checking them before the CAS is enough.
+    size_type claim_n(std::atomic<size_type>& index, size_type lag, size_type count, size_type& claimed) noexcept {
+        size_type position = index.load(std::memory_order_relaxed);
+        count = std::min(count, m_capacity);
+        while (count > 0) {
+            size_type ready = 0;
+            while (ready < count && readiness(slot(position + ready), position + ready, lag) == 0) {
+                ++ready;
+            }
+            if (ready == 0) {
+                if (readiness(slot(position), position, lag) < 0) {
+                    break;
+                }
+                position = index.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (index.compare_exchange_weak(position, position + ready, std::memory_order_relaxed)) {
+                claimed = ready;
+                return position;
+            }
+        }
+        claimed = 0;
+        return position;
+    }
+
+    // Constructs the element of a claimed producer position and hands the slot to consumers
+    template <class... Args>
+    void fill(size_type position, Args&&... args) noexcept {
+        Slot& target = slot(position);
+        std::allocator_traits<allocator_type>::construct(m_allocator, target.value(), std::forward<Args>(args)...);
+        target.sequence.store(position + 1, std::memory_order_release);
+    }
+
+    void empty_into(size_type position, T& out) noexcept {
+        out = std::move(*slot(position).value());
+        release(position);
+    }
+
+    // Destroys the element of a claimed consumer position and hands the slot to the producers of
+    // the next lap
+    void release(size_type position) noexcept {
+        Slot& target = slot(position);
+        std::allocator_traits<allocator_type>::destroy(m_allocator, target.value());
+        target.sequence.store(position + m_capacity, std::memory_order_release);
+    }
+
+    // Read-only after construction, shared by all threads
+    [[no_unique_address]] allocator_type m_allocator;
+    size_type m_capacity;
+    Slot* m_slots = nullptr;
+
+    alignas(queue_cache_line) std::atomic<size_type> m_tail{0}; // Next position to fill
+    alignas(queue_cache_line) std::atomic<size_type> m_head{0}; // Next position to empty
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Trivial relocation: moving an object to new storage and ending the lifetime of the original is
+// equivalent to copying its bytes. Containers use it to grow and shift elements with memcpy/memmove
+// instead of a move construction and destruction per element.
+//
+// Trivially copyable types qualify automatically. Other types opt in by specializing the trait, which
+// is correct for types that do not store pointers into themselves and do not register their address
+// anywhere (handles, most smart pointers, vectors; not libstdc++'s std::string):
+//
+//     template <>
+//     struct is_trivially_relocatable<MyHandle> : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// A unique_ptr is one pointer plus an empty deleter; its address matters to nobody
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+// A pair is relocatable member-wise; its user-provided assignment does not matter for relocation
+template <typename First, typename Second>
+struct is_trivially_relocatable<std::pair<First, Second>>
+    : std::bool_constant<is_trivially_relocatable_v<First> && is_trivially_relocatable_v<Second>> {};
+
+// Allocators may provide
+//     T* reallocate(T* p, std::size_t old_n, std::size_t new_n)
+// resizing the block of old_n objects at p to new_n objects, in place where possible. The contents
+// move bitwise with the block. On failure it returns nullptr and leaves the old block untouched; it
+// may also throw, leaving the old block untouched as well.
+// Containers only call it for trivially relocatable element types.
+template <typename Alloc, typename T>
+concept ReallocatingAllocator = requires(Alloc& alloc, T* p, std::size_t n) {
+    { alloc.reallocate(p, n, n) } -> std::same_as<T*>;
+};
+
+// Relocates [first, last) into the uninitialized, non-overlapping storage at dest. Afterwards the
+// source range holds no objects. Elements move one at a time, so a move that throws leaves both
+// ranges partly filled; buffer growth goes through relocate_with_gap instead.
+template <typename T, typename Alloc>
+constexpr void relocate(Alloc& alloc, T* first, T* last, T* dest) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (first != last) {
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                static_cast<std::size_t>(last - first) * sizeof(T));
+        }
+    } else {
+        for (; first != last; ++first, ++dest) {
+            std::allocator_traits<Alloc>::construct(alloc, dest, std::move(*first));
+            std::allocator_traits<Alloc>::destroy(alloc, first);
+        }
+    }
+}
+
+// Counterparts of std::uninitialized_copy, _move, _fill and _fill_n constructing through the
+// allocator, so elements that take an allocator are built with the container's (see
+// PolymorphicAllocator). Trivially copyable elements are copied as by the std versions. If a
+// construction throws, the objects constructed so far are destroyed.
+template <typename Alloc, typename InputIt, typename T>
+constexpr T* alloc_uninitialized_copy(Alloc& alloc, InputIt first, InputIt last, T* dest) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        return std::uninitialized_copy(first, last, dest);
+    } else {
+        T* current = dest;
+        try {
+            for (; first != last; ++first, ++current) {
+                std::allocator_traits<Alloc>::construct(alloc, current, *first);
+            }
+        } catch (...) {
+            for (; dest != current; ++dest) {
+                std::allocator_traits<Alloc>::destroy(alloc, dest);
+            }
+            throw;
+        }
+        return current;
+    }
+}
+
+template <typename Alloc, typename InputIt, typename T>
+constexpr T* alloc_uninitialized_move(Alloc& alloc, InputIt first, InputIt last, T* dest) {
+    return alloc_uninitialized_copy(alloc, std::make_move_iterator(first), std::make_move_iterator(last), dest);
+}
+
+// Relocates [first, last) into the uninitialized, non-overlapping storage at dest, leaving `gap`
+// slots free after the first `offset` elements. Elements whose move may throw are copied instead,
+// as by std::move_if_noexcept, and the source is destroyed only once every copy exists; if a copy
+// throws, the copies made so far are destroyed and the source is left as it was.
+template <typename T, typename Alloc>
+constexpr void relocate_with_gap(Alloc& alloc, T* first, T* last, std::size_t offset, std::size_t gap, T* dest) {
+    T* split = first + offset;
+    if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>
+        || !std::is_copy_constructible_v<T>) {
+        relocate(alloc, first, split, dest);
+        relocate(alloc, split, last, dest + offset + gap);
+    } else {
+        const T* source = first;
+        alloc_uninitialized_copy(alloc, source, source + offset, dest);
+        try {
+            alloc_uninitialized_copy(alloc, source + offset, static_cast<const T*>(last), dest + offset + gap);
+        } catch (...) {
+            for (std::size_t i = 0; i < offset; ++i) {
+                std::allocator_traits<Alloc>::destroy(alloc, dest + i);
+            }
+            throw;
+        }
+        for (; first != last; ++first) {
+            std::allocator_traits<Alloc>::destroy(alloc, first);
+        }
+    }
+}
+
+template <typename Alloc, typename T>
+constexpr T* alloc_uninitialized_fill_n(Alloc& alloc, T* dest, std::size_t count, const T& value) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        return std::uninitialized_fill_n(dest, count, value);
+    } else {
+        T* current = dest;
+        try {
+            for (; count > 0; --count, ++current) {
+                std::allocator_traits<Alloc>::construct(alloc, current, value);
+            }
+        } catch (...) {
+            for (; dest != current; ++dest) {
+                std::allocator_traits<Alloc>::destroy(alloc, dest);
+            }
+            throw;
+        }
+        return current;
+    }
+}
+
+template <typename Alloc, typename T>
+constexpr void alloc_uninitialized_fill(Alloc& alloc, T* first, T* last, const T& value) {
+    alloc_uninitialized_fill_n(alloc, first, static_cast<std::size_t>(last - first), value);
+}
+
+// Shifts the objects [first, last) of a trivially relocatable type by `distance` slots, which may
+// overlap their current storage. Slots left behind hold no objects.
+template <typename T>
+void shift_relocate(T* first, T* last, std::ptrdiff_t distance) noexcept {
+    static_assert(is_trivially_relocatable_v<T>, "shift_relocate requires a trivially relocatable type");
+    if (first != last && distance != 0) {
+        std::memmove(static_cast<void*>(first + distance), static_cast<const void*>(first),
+            static_cast<std::size_t>(last - first) * sizeof(T));
+    }
+}
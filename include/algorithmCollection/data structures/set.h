@@ -0,0 +1,40 @@
+#pragma once
+#include <functional>
+#include <utility>
+#include "../allocators/simpleAllocator.h"
+#include "bTree.h"
+
+// Element policy of Set and MultiSet: every element is its own key
+template <typename K>
+struct BTreeSetPolicy {
+    using key_type = K;
+    using value_type = K;
+
+    static constexpr bool constant_iterators = true;
+
+    static const K& key(const value_type& value) noexcept { return value; }
+
+    static K&& transfer(value_type& value) noexcept { return std::move(value); }
+};
+
+// Ordered set stored in a B-tree, see bTree.h for the node layout.
+// Inserting and erasing move elements between nodes, so they invalidate iterators, pointers and
+// references. bulk_load builds the set from a sorted DynamicArray in O(n).
+// Lookups accept any key type when Compare declares is_transparent.
+template <typename K, typename Compare = std::less<K>, typename Alloc = SimpleAllocator<K>>
+class Set : public BTree<BTreeSetPolicy<K>, Compare, Alloc, false> {
+    using Base = BTree<BTreeSetPolicy<K>, Compare, Alloc, false>;
+
+public:
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    using Base::Base;
+
+    Set() = default;
+
+    Set(std::initializer_list<value_type> values) : Base(values) {}
+};
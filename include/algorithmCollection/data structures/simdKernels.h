@@ -0,0 +1,512 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ALGORITHM_COLLECTION_SIMD_SSE2 1
+#endif
+
+// AVX2 and AVX-512 code is compiled per function with target attributes and only run when the CPU
+// reports support, so the library needs no -mavx2 and the same binary runs on any x86-64 machine
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define ALGORITHM_COLLECTION_SIMD_AVX 1
+#define ALGORITHM_COLLECTION_AVX2 __attribute__((target("avx2")))
+#define ALGORITHM_COLLECTION_AVX512 __attribute__((target("avx512f,avx512bw")))
+#endif
+
+// Search and compare kernels over contiguous arrays of arithmetic values: find, count, mismatch,
+// equality, lexicographic comparison and min/max. DynamicArray and FixedArray route their
+// comparisons and lookups through these for arithmetic element types.
+//
+// Elements are compared with == and <, exactly like the scalar std algorithms: 0.0 equals -0.0 and
+// NaN equals nothing. Integers 1 to 8 bytes wide, float and double use SIMD compares, 16, 32 or 64
+// bytes at a time depending on simd_level(); other arithmetic types (long double) run scalar loops.
+
+// Widest instruction set the kernels use on this machine, ordered from narrowest to widest
+enum class SimdLevel { Portable, Sse2, Avx2, Avx512 };
+
+namespace simd_detail {
+    inline SimdLevel detect_level() noexcept {
+#ifdef ALGORITHM_COLLECTION_SIMD_AVX
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+            return SimdLevel::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::Avx2;
+        }
+#endif
+#ifdef ALGORITHM_COLLECTION_SIMD_SSE2
+        return SimdLevel::Sse2;
+#else
+        return SimdLevel::Portable;
+#endif
+    }
+}
+
+// Detected once per process
+inline SimdLevel simd_level() noexcept {
+    static const SimdLevel level = simd_detail::detect_level();
+    return level;
+}
+
+namespace simd_detail {
+    // Element types with a vector compare: the lanes of one element compare as one unit
+    template <typename T>
+    inline constexpr bool vector_element = std::is_same_v<T, float> || std::is_same_v<T, double>
+        || (std::is_integral_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8));
+
+    template <typename T>
+    std::size_t find_scalar(const T* data, std::size_t n, T value) noexcept {
+        return static_cast<std::size_t>(std::find(data, data + n, value) - data);
+    }
+
+    template <typename T>
+    std::size_t count_scalar(const T* data, std::size_t n, T value) noexcept {
+        return static_cast<std::size_t>(std::count(data, data + n, value));
+    }
+
+    template <typename T>
+    std::size_t mismatch_scalar(const T* lhs, const T* rhs, std::size_t n) noexcept {
+        return static_cast<std::size_t>(std::mismatch(lhs, lhs + n, rhs).first - lhs);
+    }
+
+    // Lanes of one 512 bit register, each tracking the smallest and greatest value of every
+    // lanes-th element, so the loop carries no dependency and compiles to vector min/max
+    template <typename T>
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((always_inline))
+#endif
+    inline std::pair<T, T> min_max_lanes(const T* data, std::size_t n) noexcept {
+        constexpr std::size_t lanes = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+        T low[lanes];
+        T high[lanes];
+        std::fill(std::begin(low), std::end(low), data[0]);
+        std::fill(std::begin(high), std::end(high), data[0]);
+        const std::size_t full = n - n % lanes;
+        for (std::size_t i = 0; i < full; i += lanes) {
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                const T value = data[i + lane];
+                low[lane] = value < low[lane] ? value : low[lane];
+                high[lane] = high[lane] < value ? value : high[lane];
+            }
+        }
+        std::pair<T, T> result{data[0], data[0]};
+        for (std::size_t i = full; i < n; ++i) {
+            result.first = data[i] < result.first ? data[i] : result.first;
+            result.second = result.second < data[i] ? data[i] : result.second;
+        }
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            result.first = low[lane] < result.first ? low[lane] : result.first;
+            result.second = result.second < high[lane] ? high[lane] : result.second;
+        }
+        return result;
+    }
+
+    template <typename T>
+    std::pair<T, T> min_max_portable(const T* data, std::size_t n) noexcept {
+        return min_max_lanes(data, n);
+    }
+
+#ifdef ALGORITHM_COLLECTION_SIMD_SSE2
+    // SSE2 compares set every byte of an equal lane, so the byte mask of _mm_movemask_epi8 gives
+    // each element sizeof(T) consecutive bits
+    template <typename T>
+    inline __m128i sse2_load(const T* data) noexcept {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    }
+
+    template <typename T>
+    inline __m128i sse2_splat(T value) noexcept {
+        T lanes[16 / sizeof(T)];
+        std::fill(std::begin(lanes), std::end(lanes), value);
+        return sse2_load(lanes);
+    }
+
+    template <typename T>
+    inline std::uint32_t sse2_equal(__m128i a, __m128i b) noexcept {
+        __m128i equal;
+        if constexpr (std::is_same_v<T, float>) {
+            equal = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        } else if constexpr (std::is_same_v<T, double>) {
+            equal = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        } else if constexpr (sizeof(T) == 1) {
+            equal = _mm_cmpeq_epi8(a, b);
+        } else if constexpr (sizeof(T) == 2) {
+            equal = _mm_cmpeq_epi16(a, b);
+        } else if constexpr (sizeof(T) == 4) {
+            equal = _mm_cmpeq_epi32(a, b);
+        } else {
+            // No 64 bit compare before SSE4.1: both 32 bit halves have to match
+            const __m128i halves = _mm_cmpeq_epi32(a, b);
+            equal = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(equal));
+    }
+
+    template <typename T>
+    std::size_t find_sse2(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t width = 16 / sizeof(T);
+        const __m128i needle = sse2_splat(value);
+        std::size_t i = 0;
+        for (; i + width <= n; i += width) {
+            if (const std::uint32_t mask = sse2_equal<T>(sse2_load(data + i), needle)) {
+                return i + static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(T);
+            }
+        }
+        return i + find_scalar(data + i, n - i, value);
+    }
+
+    template <typename T>
+    std::size_t count_sse2(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t width = 16 / sizeof(T);
+        const __m128i needle = sse2_splat(value);
+        std::size_t bits = 0;
+        std::size_t i = 0;
+        for (; i + width <= n; i += width) {
+            bits += static_cast<std::size_t>(std::popcount(sse2_equal<T>(sse2_load(data + i), needle)));
+        }
+        return bits / sizeof(T) + count_scalar(data + i, n - i, value);
+    }
+
+    template <typename T>
+    std::size_t mismatch_sse2(const T* lhs, const T* rhs, std::size_t n) noexcept {
+        constexpr std::size_t width = 16 / sizeof(T);
+        std::size_t i = 0;
+        for (; i + width <= n; i += width) {
+            const std::uint32_t mask = sse2_equal<T>(sse2_load(lhs + i), sse2_load(rhs + i));
+            if (mask != 0xFFFFu) {
+                return i + static_cast<std::size_t>(std::countr_one(mask)) / sizeof(T);
+            }
+        }
+        return i + mismatch_scalar(lhs + i, rhs + i, n - i);
+    }
+#endif
+
+#ifdef ALGORITHM_COLLECTION_SIMD_AVX
+    // AVX2: the SSE2 scheme with 32 byte registers and a native 64 bit compare
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX2 inline __m256i avx2_load(const T* data) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX2 inline __m256i avx2_splat(T value) noexcept {
+        T lanes[32 / sizeof(T)];
+        std::fill(std::begin(lanes), std::end(lanes), value);
+        return avx2_load(lanes);
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX2 inline std::uint32_t avx2_equal(__m256i a, __m256i b) noexcept {
+        __m256i equal;
+        if constexpr (std::is_same_v<T, float>) {
+            equal = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+        } else if constexpr (std::is_same_v<T, double>) {
+            equal = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+        } else if constexpr (sizeof(T) == 1) {
+            equal = _mm256_cmpeq_epi8(a, b);
+        } else if constexpr (sizeof(T) == 2) {
+            equal = _mm256_cmpeq_epi16(a, b);
+        } else if constexpr (sizeof(T) == 4) {
+            equal = _mm256_cmpeq_epi32(a, b);
+        } else {
+            equal = _mm256_cmpeq_epi64(a, b);
+        }
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(equal));
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX2 std::size_t find_avx2(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t width = 32 / sizeof(T);
+        const __m256i needle = avx2_splat(value);
+        std::size_t i = 0;
+        for (; i + width <= n; i += width) {
+            if (const std::uint32_t mask = avx2_equal<T>(avx2_load(data + i), needle)) {
+                return i + static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(T);
+            }
+        }
+        return i + find_scalar(data + i, n - i, value);
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX2 std::size_t count_avx2(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t width = 32 / sizeof(T);
+        const __m256i needle = avx2_splat(value);
+        std::size_t bits = 0;
+        std::size_t i = 0;
+        for (; i + width <= n; i += width) {
+            bits += static_cast<std::size_t>(std::popcount(avx2_equal<T>(avx2_load(data + i), needle)));
+        }
+        return bits / sizeof(T) + count_scalar(data + i, n - i, value);
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX2 std::size_t mismatch_avx2(const T* lhs, const T* rhs, std::size_t n) noexcept {
+        constexpr std::size_t width = 32 / sizeof(T);
+        std::size_t i = 0;
+        for (; i + width <= n; i += width) {
+            const std::uint32_t mask = avx2_equal<T>(avx2_load(lhs + i), avx2_load(rhs + i));
+            if (mask != 0xFFFFFFFFu) {
+                return i + static_cast<std::size_t>(std::countr_one(mask)) / sizeof(T);
+            }
+        }
+        return i + mismatch_scalar(lhs + i, rhs + i, n - i);
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX2 std::pair<T, T> min_max_avx2(const T* data, std::size_t n) noexcept {
+        return min_max_lanes(data, n);
+    }
+
+    // AVX-512 compares write a mask register with one bit per element
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX512 inline __m512i avx512_load(const T* data) noexcept {
+        return _mm512_loadu_si512(data);
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX512 inline __m512i avx512_splat(T value) noexcept {
+        T lanes[64 / sizeof(T)];
+        std::fill(std::begin(lanes), std::end(lanes), value);
+        return avx512_load(lanes);
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX512 inline std::uint64_t avx512_equal(__m512i a, __m512i b) noexcept {
+        if constexpr (std::is_same_v<T, float>) {
+            return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b), _CMP_EQ_OQ);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b), _CMP_EQ_OQ);
+        } else if constexpr (sizeof(T) == 1) {
+            return _mm512_cmpeq_epi8_mask(a, b);
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm512_cmpeq_epi16_mask(a, b);
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm512_cmpeq_epi32_mask(a, b);
+        } else {
+            return _mm512_cmpeq_epi64_mask(a, b);
+        }
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX512 std::size_t find_avx512(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t width = 64 / sizeof(T);
+        const __m512i needle = avx512_splat(value);
+        std::size_t i = 0;
+        for (; i + width <= n; i += width) {
+            if (const std::uint64_t mask = avx512_equal<T>(avx512_load(data + i), needle)) {
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+        return i + find_scalar(data + i, n - i, value);
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX512 std::size_t count_avx512(const T* data, std::size_t n, T value) noexcept {
+        constexpr std::size_t width = 64 / sizeof(T);
+        const __m512i needle = avx512_splat(value);
+        std::size_t count = 0;
+        std::size_t i = 0;
+        for (; i + width <= n; i += width) {
+            count += static_cast<std::size_t>(std::popcount(avx512_equal<T>(avx512_load(data + i), needle)));
+        }
+        return count + count_scalar(data + i, n - i, value);
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX512 std::size_t mismatch_avx512(const T* lhs, const T* rhs, std::size_t n) noexcept {
+        constexpr std::size_t width = 64 / sizeof(T);
+        constexpr std::uint64_t all = width == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << width) - 1;
+        std::size_t i = 0;
+        for (; i + width <= n; i += width) {
+            const std::uint64_t mask = avx512_equal<T>(avx512_load(lhs + i), avx512_load(rhs + i));
+            if (mask != all) {
+                return i + static_cast<std::size_t>(std::countr_one(mask));
+            }
+        }
+        return i + mismatch_scalar(lhs + i, rhs + i, n - i);
+    }
+
+    template <typename T>
+    ALGORITHM_COLLECTION_AVX512 std::pair<T, T> min_max_avx512(const T* data, std::size_t n) noexcept {
+        return min_max_lanes(data, n);
+    }
+#endif
+
+    // Kernels at an explicit level, which must not exceed simd_level(). The public functions below
+    // pass simd_level(); tests use these to cover every level the machine supports.
+    template <typename T>
+    std::size_t find(SimdLevel level, const T* data, std::size_t n, T value) noexcept {
+        static_cast<void>(level);
+        if constexpr (vector_element<T>) {
+#ifdef ALGORITHM_COLLECTION_SIMD_AVX
+            if (level >= SimdLevel::Avx512) {
+                return find_avx512(data, n, value);
+            }
+            if (level >= SimdLevel::Avx2) {
+                return find_avx2(data, n, value);
+            }
+#endif
+#ifdef ALGORITHM_COLLECTION_SIMD_SSE2
+            if (level >= SimdLevel::Sse2) {
+                return find_sse2(data, n, value);
+            }
+#endif
+        }
+        return find_scalar(data, n, value);
+    }
+
+    template <typename T>
+    std::size_t count(SimdLevel level, const T* data, std::size_t n, T value) noexcept {
+        static_cast<void>(level);
+        if constexpr (vector_element<T>) {
+#ifdef ALGORITHM_COLLECTION_SIMD_AVX
+            if (level >= SimdLevel::Avx512) {
+                return count_avx512(data, n, value);
+            }
+            if (level >= SimdLevel::Avx2) {
+                return count_avx2(data, n, value);
+            }
+#endif
+#ifdef ALGORITHM_COLLECTION_SIMD_SSE2
+            if (level >= SimdLevel::Sse2) {
+                return count_sse2(data, n, value);
+            }
+#endif
+        }
+        return count_scalar(data, n, value);
+    }
+
+    template <typename T>
+    std::size_t mismatch(SimdLevel level, const T* lhs, const T* rhs, std::size_t n) noexcept {
+        static_cast<void>(level);
+        if constexpr (vector_element<T>) {
+#ifdef ALGORITHM_COLLECTION_SIMD_AVX
+            if (level >= SimdLevel::Avx512) {
+                return mismatch_avx512(lhs, rhs, n);
+            }
+            if (level >= SimdLevel::Avx2) {
+                return mismatch_avx2(lhs, rhs, n);
+            }
+#endif
+#ifdef ALGORITHM_COLLECTION_SIMD_SSE2
+            if (level >= SimdLevel::Sse2) {
+                return mismatch_sse2(lhs, rhs, n);
+            }
+#endif
+        }
+        return mismatch_scalar(lhs, rhs, n);
+    }
+
+    // Needs n > 0. Below AVX2 there is no vector min/max for every element width, and compilers
+    // already vectorize the lane loop with the SSE2 they assume by default.
+    template <typename T>
+    std::pair<T, T> min_max(SimdLevel level, const T* data, std::size_t n) noexcept {
+        static_cast<void>(level);
+#ifdef ALGORITHM_COLLECTION_SIMD_AVX
+        if (level >= SimdLevel::Avx512) {
+            return min_max_avx512(data, n);
+        }
+        if (level >= SimdLevel::Avx2) {
+            return min_max_avx2(data, n);
+        }
+#endif
+        return min_max_portable(data, n);
+    }
+
+    template <typename T, typename U>
+    concept same_element = std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>>;
+}
+
+// Index of the first element equal to value, or values.size() if there is none. Takes spans of
+// const and mutable elements alike, as do the kernels below.
+template <typename T>
+    requires std::is_arithmetic_v<std::remove_const_t<T>>
+std::size_t simd_find(std::span<T> values, std::remove_const_t<T> value) noexcept {
+    return simd_detail::find<std::remove_const_t<T>>(simd_level(), values.data(), values.size(), value);
+}
+
+// Number of elements equal to value
+template <typename T>
+    requires std::is_arithmetic_v<std::remove_const_t<T>>
+std::size_t simd_count(std::span<T> values, std::remove_const_t<T> value) noexcept {
+    return simd_detail::count<std::remove_const_t<T>>(simd_level(), values.data(), values.size(), value);
+}
+
+template <typename T>
+    requires std::is_arithmetic_v<std::remove_const_t<T>>
+bool simd_contains(std::span<T> values, std::remove_const_t<T> value) noexcept {
+    return simd_find(values, value) != values.size();
+}
+
+// Index of the first position at which lhs and rhs differ, or the size of the shorter one if that
+// is a prefix of the other
+template <typename T, typename U>
+    requires std::is_arithmetic_v<std::remove_const_t<T>> && simd_detail::same_element<T, U>
+std::size_t simd_mismatch(std::span<T> lhs, std::span<U> rhs) noexcept {
+    return simd_detail::mismatch<std::remove_const_t<T>>(simd_level(), lhs.data(), rhs.data(), std::min(lhs.size(), rhs.size()));
+}
+
+// Same size and equal elements. Integers are equal exactly when their bytes are, so those go to
+// memcmp, which the C library already vectorizes.
+template <typename T, typename U>
+    requires std::is_arithmetic_v<std::remove_const_t<T>> && simd_detail::same_element<T, U>
+bool simd_equal(std::span<T> lhs, std::span<U> rhs) noexcept {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    if (lhs.empty()) {
+        return true;
+    }
+    if constexpr (std::is_integral_v<std::remove_const_t<T>>) {
+        return std::memcmp(lhs.data(), rhs.data(), lhs.size_bytes()) == 0;
+    } else {
+        return simd_mismatch(lhs, rhs) == lhs.size();
+    }
+}
+
+// Lexicographic three-way comparison, the result of std::lexicographical_compare_three_way.
+// Unsigned bytes order like memcmp, which answers directly; other types find the first mismatch
+// and compare that pair.
+template <typename T, typename U>
+    requires std::is_arithmetic_v<std::remove_const_t<T>> && simd_detail::same_element<T, U>
+std::compare_three_way_result_t<std::remove_const_t<T>> simd_compare(std::span<T> lhs, std::span<U> rhs) noexcept {
+    using V = std::remove_const_t<T>;
+    const std::size_t common = std::min(lhs.size(), rhs.size());
+    if constexpr (std::is_unsigned_v<V> && sizeof(V) == 1) {
+        const int order = common == 0 ? 0 : std::memcmp(lhs.data(), rhs.data(), common);
+        if (order != 0) {
+            return order <=> 0;
+        }
+    } else {
+        const std::size_t index = simd_mismatch(lhs, rhs);
+        if (index != common) {
+            return lhs[index] <=> rhs[index];
+        }
+    }
+    return lhs.size() <=> rhs.size();
+}
+
+// Smallest and greatest value as (min, max). Throws std::logic_error on an empty range. With NaNs
+// among floating point values the result is unspecified.
+template <typename T>
+    requires std::is_arithmetic_v<std::remove_const_t<T>>
+std::pair<std::remove_const_t<T>, std::remove_const_t<T>> simd_min_max(std::span<T> values) {
+    if (values.empty()) {
+        throw std::logic_error("Range is empty");
+    }
+    return simd_detail::min_max<std::remove_const_t<T>>(simd_level(), values.data(), values.size());
+}
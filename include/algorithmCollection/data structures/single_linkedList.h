@@ -0,0 +1,840 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../allocators/poolAllocator.h"
+#include "../allocators/simpleAllocator.h"
+#include "allocatorPropagation.h"
+
+// Singly linked list with custom memory allocation: one link per node instead of DoubleLinkedList's
+// two. Without backward links, positions are named by the node before them, so insertion, removal
+// and splicing take the iterator in front of the affected elements (insert_after, erase_after,
+// splice_after) and before_begin() names the position in front of the first element.
+template <typename T, typename Alloc = SimpleAllocator<T>>
+class SingleLinkedList {
+private:
+    struct Node;
+
+public:
+    using value_type = T;
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+private:
+    // Link shared by element nodes and the head in front of the first one; the last node links to null
+    struct NodeBase {
+        NodeBase* next;
+    };
+
+    struct Node : NodeBase {
+        T data;
+
+        // Allocators doing uses-allocator construction (PolymorphicAllocator) pass themselves on to
+        // the element through the allocator_arg_t constructor
+        using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+
+        template <class... Args>
+        explicit Node(std::in_place_t, Args&&... args) : NodeBase{nullptr}, data(std::forward<Args>(args)...) {}
+
+        template <class... Args>
+        Node(std::allocator_arg_t, const allocator_type& alloc, std::in_place_t, Args&&... args)
+            : NodeBase{nullptr}, data(std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...)) {}
+    };
+
+    template <bool Const>
+    class Iterator {
+        using node_pointer = std::conditional_t<Const, const NodeBase*, NodeBase*>;
+        using element_pointer = std::conditional_t<Const, const Node*, Node*>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        Iterator() = default;
+
+        // Non-const to const conversion
+        template <bool OtherConst> requires (Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other) noexcept : m_node(other.m_node) {}
+
+        reference operator*() const noexcept { return static_cast<element_pointer>(m_node)->data; }
+        pointer operator->() const noexcept { return &static_cast<element_pointer>(m_node)->data; }
+
+        Iterator& operator++() noexcept {
+            m_node = m_node->next;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator temp(*this);
+            m_node = m_node->next;
+            return temp;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.m_node == rhs.m_node; }
+
+    private:
+        friend class SingleLinkedList;
+        friend class Iterator<true>;
+
+        explicit Iterator(node_pointer node) noexcept : m_node(node) {}
+
+        node_pointer m_node = nullptr;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    explicit SingleLinkedList(const allocator_type& alloc = allocator_type()) : m_allocator(alloc) {}
+
+    SingleLinkedList(size_type size, const T& value, const allocator_type& alloc = allocator_type())
+        : m_allocator(alloc) {
+        insert_after(before_begin(), size, value);
+    }
+
+    explicit SingleLinkedList(size_type size, const allocator_type& alloc = allocator_type()) : m_allocator(alloc) {
+        resize(size);
+    }
+
+    template <std::input_iterator InputIt>
+    SingleLinkedList(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+        : m_allocator(alloc) {
+        insert_after(before_begin(), first, last);
+    }
+
+    SingleLinkedList(std::initializer_list<T> init, const allocator_type& alloc = allocator_type())
+        : SingleLinkedList(init.begin(), init.end(), alloc) {}
+
+    SingleLinkedList(const SingleLinkedList& other)
+        : SingleLinkedList(other, propagation_detail::select_on_copy(other.m_allocator)) {}
+
+    SingleLinkedList(const SingleLinkedList& other, const allocator_type& alloc)
+        : SingleLinkedList(other.begin(), other.end(), alloc) {}
+
+    SingleLinkedList(SingleLinkedList&& other) noexcept : m_allocator(other.m_allocator) {
+        take_nodes(other);
+    }
+
+    // Takes over the nodes of other if `alloc` equals its allocator, otherwise moves the elements
+    SingleLinkedList(SingleLinkedList&& other, const allocator_type& alloc) : m_allocator(alloc) {
+        if (allocators_equal(m_allocator, other.m_allocator)) {
+            take_nodes(other);
+        } else {
+            insert_after(before_begin(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+    }
+
+    ~SingleLinkedList() { clear(); }
+
+    // Keeps this list's allocator unless it propagates on copy assignment
+    SingleLinkedList& operator=(const SingleLinkedList& other) {
+        if (this != &other) {
+            if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value) {
+                clear();
+                m_allocator = other.m_allocator;
+            }
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    // Takes over the nodes of other when the allocator propagates on move assignment or both
+    // allocators are equal; otherwise other's elements are moved into new nodes
+    SingleLinkedList& operator=(SingleLinkedList&& other) noexcept(propagation_detail::move_steals_storage_v<allocator_type>) {
+        if (this != &other) {
+            clear();
+            if constexpr (!propagation_detail::move_steals_storage_v<allocator_type>) {
+                if (!allocators_equal(m_allocator, other.m_allocator)) {
+                    insert_after(before_begin(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                    return *this;
+                }
+            }
+            propagation_detail::move_assign(m_allocator, other.m_allocator);
+            take_nodes(other);
+        }
+        return *this;
+    }
+
+    SingleLinkedList& operator=(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    bool operator==(const SingleLinkedList& other) const {
+        return m_size == other.m_size && std::equal(begin(), end(), other.begin());
+    }
+
+    auto operator<=>(const SingleLinkedList& other) const {
+        return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+    }
+
+    iterator before_begin() noexcept { return iterator(&m_head); }
+    const_iterator before_begin() const noexcept { return const_iterator(&m_head); }
+    const_iterator cbefore_begin() const noexcept { return before_begin(); }
+
+    iterator begin() noexcept { return iterator(m_head.next); }
+    const_iterator begin() const noexcept { return const_iterator(m_head.next); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(nullptr); }
+    const_iterator end() const noexcept { return const_iterator(nullptr); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    allocator_type get_allocator() const noexcept { return m_allocator; }
+
+    // Get first element in linked list
+    reference front() {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return value_of(m_head.next);
+    }
+
+    const_reference front() const {
+        if (empty()) {
+            throw std::out_of_range("List is empty");
+        }
+        return value_of(m_head.next);
+    }
+
+    // Replace elements with copies in the range [first, last). Existing nodes are reused, so only a
+    // size difference allocates or frees nodes.
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last) {
+        NodeBase* prev = &m_head;
+        for (; prev->next != nullptr && first != last; prev = prev->next, ++first) {
+            value_of(prev->next) = *first;
+        }
+        if (first != last) {
+            insert_after(iterator(prev), first, last);
+        } else {
+            erase_after(const_iterator(prev), end());
+        }
+    }
+
+    void assign(size_type size, const T& value) {
+        NodeBase* prev = &m_head;
+        for (; prev->next != nullptr && size > 0; prev = prev->next, --size) {
+            value_of(prev->next) = value;
+        }
+        if (size > 0) {
+            insert_after(iterator(prev), size, value);
+        } else {
+            erase_after(const_iterator(prev), end());
+        }
+    }
+
+    void assign(std::initializer_list<T> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    template <class... Args>
+    reference emplace_front(Args&&... args) {
+        return *emplace_after(before_begin(), std::forward<Args>(args)...);
+    }
+
+    // Removes first element in the linked list
+    void pop_front() {
+        if (empty()) {
+            throw std::logic_error("List is empty");
+        }
+        erase_after(before_begin());
+    }
+
+    // Constructs an element in place after pos and returns an iterator to it
+    template <class... Args>
+    iterator emplace_after(const_iterator pos, Args&&... args) {
+        NodeBase* prev = node_of(pos);
+        Node* node = create_node(std::forward<Args>(args)...);
+        node->next = prev->next;
+        prev->next = node;
+        ++m_size;
+        return iterator(node);
+    }
+
+    iterator insert_after(const_iterator pos, const T& value) { return emplace_after(pos, value); }
+    iterator insert_after(const_iterator pos, T&& value) { return emplace_after(pos, std::move(value)); }
+
+    // Inserts count copies of value after pos, returns an iterator to the last inserted element or
+    // pos if count is 0
+    iterator insert_after(const_iterator pos, size_type count, const T& value) {
+        iterator last = to_iterator(pos);
+        for (size_type i = 0; i < count; ++i) {
+            last = emplace_after(last, value);
+        }
+        return last;
+    }
+
+    // Inserts copies of [first, last) after pos in order, returns an iterator to the last inserted
+    // element or pos if the range is empty
+    template <std::input_iterator InputIt>
+    iterator insert_after(const_iterator pos, InputIt first, InputIt last) {
+        iterator inserted = to_iterator(pos);
+        for (; first != last; ++first) {
+            inserted = emplace_after(inserted, *first);
+        }
+        return inserted;
+    }
+
+    iterator insert_after(const_iterator pos, std::initializer_list<T> ilist) {
+        return insert_after(pos, ilist.begin(), ilist.end());
+    }
+
+    // Removes the element after pos and returns an iterator to the element after the removed one
+    iterator erase_after(const_iterator pos) {
+        NodeBase* prev = node_of(pos);
+        if (prev == nullptr || prev->next == nullptr) {
+            throw std::out_of_range("Invalid index");
+        }
+        NodeBase* node = prev->next;
+        prev->next = node->next;
+        destroy_node(node);
+        --m_size;
+        return iterator(prev->next);
+    }
+
+    // Removes the elements in (first, last)
+    iterator erase_after(const_iterator first, const_iterator last) {
+        NodeBase* prev = node_of(first);
+        NodeBase* stop = node_of(last);
+        NodeBase* node = prev->next;
+        while (node != stop) {
+            NodeBase* next = node->next;
+            destroy_node(node);
+            --m_size;
+            node = next;
+        }
+        prev->next = stop;
+        return to_iterator(last);
+    }
+
+    // Removes all elements from the linked list
+    void clear() noexcept {
+        NodeBase* node = m_head.next;
+        while (node != nullptr) {
+            NodeBase* next = node->next;
+            destroy_node(node);
+            node = next;
+        }
+        m_head.next = nullptr;
+        m_size = 0;
+    }
+
+    // Resizes the list to size elements, appending value-initialized elements if it grows
+    void resize(size_type size) {
+        NodeBase* prev = advance_to(size);
+        if (size > m_size) {
+            for (size_type i = m_size; i < size; ++i) {
+                prev = node_of(emplace_after(const_iterator(prev)));
+            }
+        } else {
+            erase_after(const_iterator(prev), end());
+        }
+    }
+
+    // Resizes the list to size elements, appending copies of value if it grows
+    void resize(size_type size, const T& value) {
+        NodeBase* prev = advance_to(size);
+        if (size > m_size) {
+            insert_after(const_iterator(prev), size - m_size, value);
+        } else {
+            erase_after(const_iterator(prev), end());
+        }
+    }
+
+    // Swaps the node chains, sizes and, if the allocator propagates on swap, allocators with other
+    void swap(SingleLinkedList& other) noexcept {
+        if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(m_allocator, other.m_allocator);
+        }
+        std::swap(m_head.next, other.m_head.next);
+        std::swap(m_size, other.m_size);
+    }
+
+    friend void swap(SingleLinkedList& lhs, SingleLinkedList& rhs) noexcept { lhs.swap(rhs); }
+
+    // Move all the elements of other to this list after pos. Both lists must use equal allocators.
+    // Walks other once to find its last node.
+    void splice_after(const_iterator pos, SingleLinkedList& other) {
+        if (this == &other || other.empty()) {
+            return;
+        }
+        check_splice_allocator(other);
+        NodeBase* last = &other.m_head;
+        while (last->next != nullptr) {
+            last = last->next;
+        }
+        link_after(node_of(pos), &other.m_head, last);
+        m_size += other.m_size;
+        other.m_size = 0;
+    }
+
+    void splice_after(const_iterator pos, SingleLinkedList&& other) { splice_after(pos, other); }
+
+    // Move the element after it in other to this list after pos. O(1).
+    void splice_after(const_iterator pos, SingleLinkedList& other, const_iterator it) {
+        NodeBase* before = node_of(it);
+        NodeBase* prev = node_of(pos);
+        if (before == nullptr || before->next == nullptr) {
+            throw std::out_of_range("Invalid index");
+        }
+        if (prev == before || prev == before->next) {
+            return;
+        }
+        check_splice_allocator(other);
+        link_after(prev, before, before->next);
+        if (this != &other) {
+            ++m_size;
+            --other.m_size;
+        }
+    }
+
+    void splice_after(const_iterator pos, SingleLinkedList&& other, const_iterator it) { splice_after(pos, other, it); }
+
+    // Move the elements in (first, last) of other to this list after pos, which must not lie inside
+    // the range. The range is walked once to find its last node and count it.
+    void splice_after(const_iterator pos, SingleLinkedList& other, const_iterator first, const_iterator last) {
+        NodeBase* before = node_of(first);
+        NodeBase* stop = node_of(last);
+        if (before == stop || before->next == stop) {
+            return;
+        }
+        check_splice_allocator(other);
+        NodeBase* last_moved = before->next;
+        size_type count = 1;
+        while (last_moved->next != stop) {
+            last_moved = last_moved->next;
+            ++count;
+        }
+        link_after(node_of(pos), before, last_moved);
+        if (this != &other) {
+            m_size += count;
+            other.m_size -= count;
+        }
+    }
+
+    void splice_after(const_iterator pos, SingleLinkedList&& other, const_iterator first, const_iterator last) {
+        splice_after(pos, other, first, last);
+    }
+
+    // Removes all elements equal to value and returns how many were removed
+    size_type remove(const T& value) {
+        return remove_if([&value](const T& element) { return element == value; });
+    }
+
+    // Removes all elements satisfying p and returns how many were removed
+    template <class UnaryPredicate>
+    size_type remove_if(UnaryPredicate p) {
+        // Matches are moved into a local list first, so value may refer to an element of this list
+        SingleLinkedList removed(m_allocator);
+        NodeBase* removed_tail = &removed.m_head;
+        NodeBase* prev = &m_head;
+        while (prev->next != nullptr) {
+            NodeBase* node = prev->next;
+            if (p(value_of(node))) {
+                prev->next = node->next;
+                node->next = nullptr;
+                removed_tail->next = node;
+                removed_tail = node;
+                ++removed.m_size;
+                --m_size;
+            } else {
+                prev = node;
+            }
+        }
+        return removed.size();
+    }
+
+    // Removes consecutive duplicate elements and returns how many were removed
+    size_type unique() { return unique(std::equal_to<>()); }
+
+    // Removes consecutive elements for which p(previous, element) holds and returns how many were removed
+    template <class BinaryPredicate>
+    size_type unique(BinaryPredicate p) {
+        size_type removed = 0;
+        NodeBase* kept = m_head.next;
+        while (kept != nullptr && kept->next != nullptr) {
+            NodeBase* node = kept->next;
+            if (p(value_of(kept), value_of(node))) {
+                kept->next = node->next;
+                destroy_node(node);
+                ++removed;
+            } else {
+                kept = node;
+            }
+        }
+        m_size -= removed;
+        return removed;
+    }
+
+    // Reverses the order of elements by turning every link around
+    void reverse() noexcept {
+        NodeBase* reversed = nullptr;
+        NodeBase* node = m_head.next;
+        while (node != nullptr) {
+            NodeBase* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        m_head.next = reversed;
+    }
+
+    // Sorts elements in ascending order. Stable bottom-up merge sort that only relinks nodes: no
+    // element is copied, moved or reallocated, and no memory is allocated. O(n log n).
+    void sort() { sort(std::less<>()); }
+
+    template <class Compare>
+    void sort(Compare comp) {
+        if (m_size < 2) {
+            return;
+        }
+
+        // bins[i] holds a sorted, null terminated run of 2^i nodes, or null
+        constexpr std::size_t bin_count = 64;
+        NodeBase* bins[bin_count] = {};
+
+        NodeBase* node = m_head.next;
+        while (node != nullptr) {
+            NodeBase* next = node->next;
+            node->next = nullptr;
+
+            NodeBase* carry = node;
+            std::size_t i = 0;
+            for (; i < bin_count - 1 && bins[i]; ++i) {
+                carry = merge_runs(bins[i], carry, comp);
+                bins[i] = nullptr;
+            }
+            bins[i] = bins[i] ? merge_runs(bins[i], carry, comp) : carry;
+
+            node = next;
+        }
+
+        // Higher bins hold earlier elements, so they are merged in as the left run to keep stability
+        NodeBase* sorted = nullptr;
+        for (NodeBase* run : bins) {
+            if (run) {
+                sorted = sorted ? merge_runs(run, sorted, comp) : run;
+            }
+        }
+        m_head.next = sorted;
+    }
+
+    // Merges the sorted list other into this sorted list by relinking nodes; other is left empty.
+    // Stable: for equivalent elements, those of this list come first.
+    void merge(SingleLinkedList& other) { merge(other, std::less<>()); }
+    void merge(SingleLinkedList&& other) { merge(other); }
+
+    template <class Compare>
+    void merge(SingleLinkedList& other, Compare comp) {
+        if (this == &other || other.empty()) {
+            return;
+        }
+        check_splice_allocator(other);
+        m_head.next = merge_runs(m_head.next, other.m_head.next, comp);
+        m_size += other.m_size;
+        other.m_head.next = nullptr;
+        other.m_size = 0;
+    }
+
+    template <class Compare>
+    void merge(SingleLinkedList&& other, Compare comp) { merge(other, comp); }
+
+private:
+    template <class... Args>
+    Node* create_node(Args&&... args) {
+        Node* node = std::allocator_traits<allocator_type>::allocate(m_allocator, 1);
+        try {
+            std::allocator_traits<allocator_type>::construct(m_allocator, node, std::in_place, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator_traits<allocator_type>::deallocate(m_allocator, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroy_node(NodeBase* node) noexcept {
+        Node* element = static_cast<Node*>(node);
+        std::allocator_traits<allocator_type>::destroy(m_allocator, element);
+        std::allocator_traits<allocator_type>::deallocate(m_allocator, element, 1);
+    }
+
+    static T& value_of(NodeBase* node) noexcept { return static_cast<Node*>(node)->data; }
+    static const T& value_of(const NodeBase* node) noexcept { return static_cast<const Node*>(node)->data; }
+
+    static NodeBase* node_of(const_iterator pos) noexcept { return const_cast<NodeBase*>(pos.m_node); }
+
+    static iterator to_iterator(const_iterator pos) noexcept { return iterator(node_of(pos)); }
+
+    // Moves the nodes after before up to and including last behind pos
+    static void link_after(NodeBase* pos, NodeBase* before, NodeBase* last) noexcept {
+        NodeBase* first = before->next;
+        before->next = last->next;
+        last->next = pos->next;
+        pos->next = first;
+    }
+
+    // Node in front of position count, or the last node if the list is shorter
+    NodeBase* advance_to(size_type count) noexcept {
+        NodeBase* prev = &m_head;
+        for (; count > 0 && prev->next != nullptr; --count) {
+            prev = prev->next;
+        }
+        return prev;
+    }
+
+    // Merges the null terminated sorted runs left and right, preferring left on ties
+    template <class Compare>
+    static NodeBase* merge_runs(NodeBase* left, NodeBase* right, Compare& comp) {
+        NodeBase head{nullptr};
+        NodeBase* tail = &head;
+        while (left && right) {
+            if (comp(value_of(right), value_of(left))) {
+                tail->next = right;
+                right = right->next;
+            } else {
+                tail->next = left;
+                left = left->next;
+            }
+            tail = tail->next;
+        }
+        tail->next = left ? left : right;
+        return head.next;
+    }
+
+    void check_splice_allocator(const SingleLinkedList& other) const {
+        if (!allocators_equal(m_allocator, other.m_allocator)) {
+            throw std::invalid_argument("Lists use different allocators");
+        }
+    }
+
+    static bool allocators_equal(const allocator_type& lhs, const allocator_type& rhs) noexcept {
+        return propagation_detail::equal(lhs, rhs);
+    }
+
+    // Moves the whole chain of other, which must share this list's allocator, into this empty list
+    void take_nodes(SingleLinkedList& other) noexcept {
+        m_head.next = other.m_head.next;
+        m_size = other.m_size;
+        other.m_head.next = nullptr;
+        other.m_size = 0;
+    }
+
+    [[no_unique_address]] allocator_type m_allocator;
+    NodeBase m_head{nullptr};
+    size_type m_size = 0;
+};
+
+// Single linked list drawing its nodes from a PoolAllocator, see PooledDoubleLinkedList
+template <typename T, std::size_t BlockSize = 1024>
+using PooledSingleLinkedList = SingleLinkedList<T, PoolAllocator<T, BlockSize>>;
+
+// Link a node needs to sit on a TreiberStack. The link is atomic because a pop may read it from a
+// node another thread is popping and pushing at the same moment.
+struct TreiberLink {
+    std::atomic<TreiberLink*> next{nullptr};
+};
+
+// Lock-free intrusive stack of TreiberLink nodes (R. K. Treiber's design): push and pop swing the
+// head with one compare-and-swap. The head word packs a modification count next to the pointer, so
+// a pop that read head X and X->next cannot succeed after other threads popped X, changed the stack
+// and pushed X back (the ABA problem).
+// A pop dereferences the head it read even when another thread pops and reuses that node in the
+// meantime, so nodes must stay readable while the stack is shared: keep them in memory that is only
+// released after the last concurrent pop, like pool blocks or ConcurrentStack's node cache.
+// On 64 bit targets the pointer takes the low 48 address bits, less the 3 its 8 byte alignment leaves
+// zero, and the counter the remaining 19; 32 bit targets keep a 34 bit counter in a 64 bit word.
+class TreiberStack {
+public:
+    TreiberStack() = default;
+
+    TreiberStack(const TreiberStack&) = delete;
+    TreiberStack& operator=(const TreiberStack&) = delete;
+
+    void push(TreiberLink* node) noexcept { push_chain(node, node); }
+
+    // Pushes the nodes first ... last, already linked through next, as one batch
+    void push_chain(TreiberLink* first, TreiberLink* last) noexcept {
+        word head = m_head.load(std::memory_order_relaxed);
+        do {
+            last->next.store(pointer_of(head), std::memory_order_relaxed);
+        } while (!m_head.compare_exchange_weak(head, pack(first, head), std::memory_order_release,
+            std::memory_order_relaxed));
+    }
+
+    // Removes and returns the top node, or null if the stack is empty
+    TreiberLink* pop() noexcept {
+        word head = m_head.load(std::memory_order_acquire);
+        while (TreiberLink* top = pointer_of(head)) {
+            TreiberLink* next = top->next.load(std::memory_order_relaxed);
+            if (m_head.compare_exchange_weak(head, pack(next, head), std::memory_order_acquire,
+                std::memory_order_acquire)) {
+                return top;
+            }
+        }
+        return nullptr;
+    }
+
+    // Detaches every node at once, returns the former top; the nodes stay linked through next
+    TreiberLink* pop_all() noexcept {
+        word head = m_head.load(std::memory_order_relaxed);
+        while (!m_head.compare_exchange_weak(head, pack(nullptr, head), std::memory_order_acquire,
+            std::memory_order_relaxed)) {}
+        return pointer_of(head);
+    }
+
+    // Snapshot that may be stale by the time it returns
+    bool empty() const noexcept { return pointer_of(m_head.load(std::memory_order_relaxed)) == nullptr; }
+
+private:
+    using word = std::uint64_t;
+
+    static_assert(std::atomic<word>::is_always_lock_free, "TreiberStack needs a lock-free 64 bit atomic");
+
+    static constexpr unsigned align_bits = static_cast<unsigned>(std::countr_zero(alignof(TreiberLink)));
+    static constexpr unsigned address_bits = sizeof(void*) == 8 ? 48 : 32;
+    static constexpr unsigned pointer_bits = address_bits - align_bits;
+    static constexpr word pointer_mask = (word{1} << pointer_bits) - 1;
+
+    std::atomic<word> m_head{0};
+
+    static TreiberLink* pointer_of(word head) noexcept {
+        return reinterpret_cast<TreiberLink*>(static_cast<std::uintptr_t>((head & pointer_mask) << align_bits));
+    }
+
+    // node with the counter of previous advanced by one
+    static word pack(TreiberLink* node, word previous) noexcept {
+        const word count = (previous >> pointer_bits) + 1;
+        return (count << pointer_bits) | (static_cast<word>(reinterpret_cast<std::uintptr_t>(node)) >> align_bits);
+    }
+};
+
+// Unbounded lock-free stack of T for any number of pushing and popping threads, built from two
+// TreiberStacks: the elements, and the nodes popped elements leave behind. Nodes are recycled
+// through the second and only freed when the stack is destroyed, which keeps a concurrent pop's
+// read of a node it lost the race for valid; the node count is the stack's peak size.
+// push() allocates only when no recycled node is left, reserve() allocates nodes up front. The
+// allocator may be called from several threads at once, so it must be thread safe.
+template <typename T, typename Alloc = SimpleAllocator<T>>
+class ConcurrentStack {
+    static_assert(std::is_nothrow_destructible_v<T>, "ConcurrentStack elements must be nothrow destructible");
+
+    struct Node : TreiberLink {
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+
+public:
+    using value_type = T;
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+    explicit ConcurrentStack(const allocator_type& alloc = allocator_type()) : m_allocator(alloc) {}
+
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    // Not safe to run concurrently with any other operation
+    ~ConcurrentStack() {
+        while (TreiberLink* link = m_items.pop()) {
+            Node* node = static_cast<Node*>(link);
+            std::allocator_traits<allocator_type>::destroy(m_allocator, node->value());
+            free_node(node);
+        }
+        while (TreiberLink* link = m_free.pop()) {
+            free_node(static_cast<Node*>(link));
+        }
+    }
+
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+
+    // Constructs an element from args on top of the stack
+    template <class... Args>
+    void emplace(Args&&... args) {
+        Node* node = acquire_node();
+        try {
+            std::allocator_traits<allocator_type>::construct(m_allocator, node->value(), std::forward<Args>(args)...);
+        } catch (...) {
+            m_free.push(node);
+            throw;
+        }
+        m_items.push(node);
+    }
+
+    // Moves the top element into out and removes it, returns false if the stack is empty
+    bool try_pop(T& out) noexcept {
+        static_assert(std::is_nothrow_move_assignable_v<T>, "try_pop requires a nothrow move assignment");
+        TreiberLink* link = m_items.pop();
+        if (link == nullptr) {
+            return false;
+        }
+        Node* node = static_cast<Node*>(link);
+        out = std::move(*node->value());
+        std::allocator_traits<allocator_type>::destroy(m_allocator, node->value());
+        m_free.push(node);
+        return true;
+    }
+
+    // Makes sure at least count nodes are cached, so that many pushes do not allocate
+    void reserve(std::size_t count) {
+        for (std::size_t i = m_node_count.load(std::memory_order_relaxed); i < count; ++i) {
+            m_free.push(allocate_node());
+        }
+    }
+
+    // Snapshot that may be stale by the time it returns
+    bool empty() const noexcept { return m_items.empty(); }
+
+    allocator_type get_allocator() const noexcept { return m_allocator; }
+
+private:
+    alignas(64) TreiberStack m_items;
+    alignas(64) TreiberStack m_free;
+    std::atomic<std::size_t> m_node_count{0};
+    [[no_unique_address]] allocator_type m_allocator;
+
+    Node* acquire_node() {
+        if (TreiberLink* link = m_free.pop()) {
+            return static_cast<Node*>(link);
+        }
+        return allocate_node();
+    }
+
+    Node* allocate_node() {
+        node_allocator nodes(m_allocator);
+        Node* node = std::allocator_traits<node_allocator>::allocate(nodes, 1);
+        ::new (static_cast<void*>(node)) Node;
+        m_node_count.fetch_add(1, std::memory_order_relaxed);
+        return node;
+    }
+
+    void free_node(Node* node) noexcept {
+        node->~Node();
+        node_allocator nodes(m_allocator);
+        std::allocator_traits<node_allocator>::deallocate(nodes, node, 1);
+    }
+};
@@ -0,0 +1,651 @@
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <span>
+#include <cstddef>
+#include <cstring>
+#include <compare>
+#include <iterator>
+#include <type_traits>
+#include "../allocators/simpleAllocator.h"
+#include "growthPolicy.h"
+#include "relocation.h"
+#include "allocatorPropagation.h"
+#include "containerStats.h"
+
+// Dynamic-sized array storing up to N elements inline, inside the object itself, and spilling to
+// storage from Alloc once it grows past N. Small arrays therefore cost no allocation and no pointer
+// chase. The interface matches DynamicArray, so either can be swapped for the other.
+// Erasing never gives capacity back; shrink_to_fit and shrink_to do, and return to the inline buffer
+// once the elements fit into it. Moving an inline array moves its elements one by one.
+// Buffer reallocations are counted like DynamicArray's, see containerStats.h.
+template <typename T, std::size_t N, typename Alloc = SimpleAllocator<T>, GrowthPolicy Growth = DoublingGrowth>
+class SmallDynamicArray {
+    static_assert(N > 0, "SmallDynamicArray needs room for at least one inline element");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using span = std::span<T>;
+    using const_span = std::span<const T>;
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using allocator_type = Alloc;
+    using growth_policy = Growth;
+
+    static constexpr std::size_t inline_capacity = N;
+
+    iterator begin() noexcept { return m_data; }
+    const_iterator begin() const noexcept { return m_data; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return m_data + m_size; }
+    const_iterator end() const noexcept { return m_data + m_size; }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    SmallDynamicArray() noexcept
+        : m_data(inline_data()), m_size(0), m_capacity(N), m_allocator() {}
+
+    // Creates an empty array that spills into storage from `alloc`
+    explicit SmallDynamicArray(const Alloc& alloc) noexcept
+        : m_data(inline_data()), m_size(0), m_capacity(N), m_allocator(alloc) {}
+
+    explicit SmallDynamicArray(std::size_t size, const Alloc& alloc = Alloc())
+        : SmallDynamicArray(alloc) {
+        reserve(size);
+        for (; m_size < size; ++m_size) {
+            std::allocator_traits<Alloc>::construct(m_allocator, m_data + m_size);
+        }
+    }
+
+    explicit SmallDynamicArray(std::span<const T> values, const Alloc& alloc = Alloc())
+        : SmallDynamicArray(alloc) {
+        insert(cend(), values.begin(), values.end());
+    }
+
+    SmallDynamicArray(std::initializer_list<T> values, const Alloc& alloc = Alloc())
+        : SmallDynamicArray(alloc) {
+        insert(cend(), values.begin(), values.end());
+    }
+
+    // Copies use the allocator chosen by select_on_container_copy_construction
+    SmallDynamicArray(const SmallDynamicArray& other)
+        : SmallDynamicArray(other, propagation_detail::select_on_copy(other.m_allocator)) {}
+
+    SmallDynamicArray(const SmallDynamicArray& other, const Alloc& alloc)
+        : SmallDynamicArray(alloc) {
+        construct_from(other.begin(), other.end(), other.size());
+    }
+
+    SmallDynamicArray(SmallDynamicArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : SmallDynamicArray(other.m_allocator) {
+        take_elements(other);
+    }
+
+    // Takes over the heap buffer of other if `alloc` equals its allocator, otherwise moves the elements
+    SmallDynamicArray(SmallDynamicArray&& other, const Alloc& alloc)
+        : SmallDynamicArray(alloc) {
+        if (other.is_inline() || propagation_detail::equal(m_allocator, other.m_allocator)) {
+            take_elements(other);
+        } else {
+            construct_from(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), other.size());
+        }
+    }
+
+    ~SmallDynamicArray() {
+        std::destroy_n(m_data, m_size);
+        release_heap();
+    }
+
+    SmallDynamicArray& operator=(const SmallDynamicArray& other) {
+        if (this != &other) {
+            if constexpr (std::allocator_traits<Alloc>::propagate_on_container_copy_assignment::value) {
+                if (!propagation_detail::equal(m_allocator, other.m_allocator)) {
+                    // The heap buffer has to go back to the allocator that created it
+                    clear();
+                    release_heap();
+                }
+                m_allocator = other.m_allocator;
+            }
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    // Takes over the heap buffer of other when the allocator propagates on move assignment or both
+    // allocators are equal; otherwise other's elements are moved one by one
+    SmallDynamicArray& operator=(SmallDynamicArray&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T> && propagation_detail::move_steals_storage_v<Alloc>) {
+        if (this != &other) {
+            std::destroy_n(m_data, m_size);
+            m_size = 0;
+            if constexpr (!propagation_detail::move_steals_storage_v<Alloc>) {
+                if (!other.is_inline() && !propagation_detail::equal(m_allocator, other.m_allocator)) {
+                    insert(cend(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                    return *this;
+                }
+            }
+            release_heap();
+            propagation_detail::move_assign(m_allocator, other.m_allocator);
+            take_elements(other);
+        }
+        return *this;
+    }
+
+    SmallDynamicArray& operator=(std::initializer_list<T> ilist) {
+        assign(ilist);
+        return *this;
+    }
+
+    bool operator==(const SmallDynamicArray& rhs) const {
+        return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
+    }
+
+    // Shorter arrays order first; arrays of one size compare their elements lexicographically
+    auto operator<=>(const SmallDynamicArray& rhs) const requires std::three_way_comparable<T> {
+        using Ordering = std::compare_three_way_result_t<T>;
+        if (size() != rhs.size()) {
+            return Ordering(size() <=> rhs.size());
+        }
+        return Ordering(std::lexicographical_compare_three_way(begin(), end(), rhs.begin(), rhs.end()));
+    }
+
+    // Returns a reference to the element stored at the specified index in the array.
+    T& operator[](std::size_t index) noexcept {
+        return m_data[index];
+    }
+
+    // Returns a constant reference to the element stored at the specified index in the array.
+    const T& operator[](std::size_t index) const noexcept {
+        return m_data[index];
+    }
+
+    // Returns a non-const span object that provides pointer access to the underlying stored data.
+    span data() noexcept {
+        return { m_data, m_size };
+    }
+
+    // Returns a const span object that provides read-only pointer access to the underlying stored data.
+    const_span data() const noexcept {
+        return { m_data, m_size };
+    }
+
+    // Return number of elements in the array
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    // Returns maximum number of elements allowed due to system restrictions
+    std::size_t max_size() const noexcept {
+        return std::allocator_traits<Alloc>::max_size(m_allocator);
+    }
+
+    // Returns capacity of array, at least N
+    std::size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    // Checks whether array is empty or not
+    [[nodiscard]] bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    // Checks whether the elements are stored in the inline buffer
+    bool is_inline() const noexcept {
+        return m_data == inline_data();
+    }
+
+    // Returns m_allocator associated with the array
+    Alloc get_allocator() const noexcept {
+        return m_allocator;
+    }
+
+    void assign(std::size_t count, const T& value) {
+        T copy(value);
+        clear();
+        insert(cend(), count, copy);
+    }
+
+    void assign(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    template <class InputIt, std::enable_if_t<!std::is_integral_v<InputIt>, int> = 0>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        insert(cend(), first, last);
+    }
+
+    // Access element by index, throws if not within the bounds of the array.
+    T& at(std::size_t index) {
+        if (index >= m_size) {
+            throw std::out_of_range("Index out of range");
+        }
+        return m_data[index];
+    }
+
+    const T& at(std::size_t index) const {
+        if (index >= m_size) {
+            throw std::out_of_range("Index out of range");
+        }
+        return m_data[index];
+    }
+
+    T& front() {
+        if (empty()) {
+            throw std::out_of_range("Array is empty");
+        }
+        return m_data[0];
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::out_of_range("Array is empty");
+        }
+        return m_data[0];
+    }
+
+    T& back() {
+        if (empty()) {
+            throw std::out_of_range("Array is empty");
+        }
+        return m_data[m_size - 1];
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::out_of_range("Array is empty");
+        }
+        return m_data[m_size - 1];
+    }
+
+    // Reserves storage space to store at least `new_capacity` elements in the array.
+    void reserve(std::size_t new_capacity) {
+        if (new_capacity > m_capacity) {
+            reallocate(new_capacity);
+        }
+    }
+
+    // Frees unused heap storage, moving the elements back inline if they fit
+    void shrink_to_fit() {
+        shrink_to(m_size);
+    }
+
+    // Reduces the capacity to max(new_capacity, size(), N) if that is smaller than the current capacity
+    void shrink_to(std::size_t new_capacity) {
+        new_capacity = std::max(new_capacity, m_size);
+        if (new_capacity < m_capacity && !is_inline()) {
+            reallocate(new_capacity);
+        }
+    }
+
+    // Erase all elements and return to the inline buffer
+    void clear() noexcept {
+        std::destroy_n(m_data, m_size);
+        m_size = 0;
+        release_heap();
+    }
+
+    iterator insert(const_iterator index, const T& value) {
+        return emplace(index, value);
+    }
+
+    iterator insert(const_iterator index, T&& value) {
+        return emplace(index, std::move(value));
+    }
+
+    iterator insert(const_iterator index, std::size_t count, const T& value) {
+        std::size_t offset = checked_offset(index);
+        if (count == 0) {
+            return begin() + offset;
+        }
+
+        if (m_size + count > m_capacity) {
+            reallocate_with_gap(grown_capacity(m_size + count), offset, count, [&](T* gap) {
+                alloc_uninitialized_fill_n(m_allocator, gap, count, value);
+            });
+            return begin() + offset;
+        }
+
+        // value may refer to an element that is about to be shifted
+        T copy(value);
+        open_gap(offset, count, [&](T* gap) { alloc_uninitialized_fill_n(m_allocator, gap, count, copy); });
+        return begin() + offset;
+    }
+
+    iterator insert(const_iterator index, std::initializer_list<T> ilist) {
+        return insert(index, ilist.begin(), ilist.end());
+    }
+
+    template <class InputIt, std::enable_if_t<!std::is_integral_v<InputIt>, int> = 0>
+    iterator insert(const_iterator index, InputIt first, InputIt last) {
+        std::size_t offset = checked_offset(index);
+        auto count = static_cast<std::size_t>(std::distance(first, last));
+        if (count == 0) {
+            return begin() + offset;
+        }
+
+        if (m_size + count > m_capacity) {
+            reallocate_with_gap(grown_capacity(m_size + count), offset, count, [&](T* gap) {
+                alloc_uninitialized_copy(m_allocator, first, last, gap);
+            });
+            return begin() + offset;
+        }
+
+        open_gap(offset, count, [&](T* gap) { alloc_uninitialized_copy(m_allocator, first, last, gap); });
+        return begin() + offset;
+    }
+
+    // Constructs a new element before index
+    template <class... Args>
+    iterator emplace(const_iterator index, Args&&... args) {
+        std::size_t offset = checked_offset(index);
+
+        if (m_size == m_capacity) {
+            reallocate_with_gap(grown_capacity(m_size + 1), offset, 1, [&](T* gap) {
+                std::allocator_traits<Alloc>::construct(m_allocator, gap, std::forward<Args>(args)...);
+            });
+        }
+        else if (offset == m_size) {
+            std::allocator_traits<Alloc>::construct(m_allocator, end(), std::forward<Args>(args)...);
+            ++m_size;
+        }
+        else {
+            // Build the element first, args may refer to elements that are about to be shifted
+            T value(std::forward<Args>(args)...);
+            open_gap(offset, 1, [&](T* gap) {
+                std::allocator_traits<Alloc>::construct(m_allocator, gap, std::move(value));
+            });
+        }
+
+        return begin() + offset;
+    }
+
+    // Appends a new element to the end of the array.
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        if (m_size == m_capacity) {
+            reallocate_with_gap(grown_capacity(m_size + 1), m_size, 1, [&](T* gap) {
+                std::allocator_traits<Alloc>::construct(m_allocator, gap, std::forward<Args>(args)...);
+            });
+        }
+        else {
+            std::allocator_traits<Alloc>::construct(m_allocator, end(), std::forward<Args>(args)...);
+            ++m_size;
+        }
+
+        return back();
+    }
+
+    // Remove element at index
+    iterator erase(const_iterator index) {
+        if (index < cbegin() || index >= cend()) {
+            throw std::out_of_range("Invalid index");
+        }
+        return erase(index, index + 1);
+    }
+
+    // Remove elements in range [first, last)
+    iterator erase(const_iterator first, const_iterator last) {
+        if (first < cbegin() || last > cend() || first > last) {
+            throw std::out_of_range("Invalid range");
+        }
+
+        T* first_index = begin() + (first - cbegin());
+        T* last_index = begin() + (last - cbegin());
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::destroy(first_index, last_index);
+            shift_relocate(last_index, end(), -(last_index - first_index));
+        }
+        else if constexpr (std::is_move_assignable_v<T>) {
+            // Shift the tail down over the erased range, then destroy the now unused trailing slots
+            T* new_end = std::move(last_index, end(), first_index);
+            std::destroy(new_end, end());
+        }
+        else {
+            // Elements that cannot be assigned, such as pairs with a const key, are relocated one by
+            // one. If that throws, the elements not relocated yet are dropped.
+            std::destroy(first_index, last_index);
+            T* dest = first_index;
+            T* source = last_index;
+            try {
+                for (; source != end(); ++source, ++dest) {
+                    std::allocator_traits<Alloc>::construct(m_allocator, dest, std::move(*source));
+                    std::destroy_at(source);
+                }
+            } catch (...) {
+                std::destroy(source, end());
+                m_size = static_cast<std::size_t>(dest - begin());
+                throw;
+            }
+        }
+        m_size -= static_cast<std::size_t>(last_index - first_index);
+
+        return first_index;
+    }
+
+    // Resizes array to contain 'count' of elements of type 'value'
+    void resize(std::size_t count, const T& value = T()) {
+        if (count < m_size) {
+            std::destroy(begin() + count, end());
+            m_size = count;
+        }
+        else if (count > m_size) {
+            insert(cend(), count - m_size, value);
+        }
+    }
+
+    // Exchanges the contents of the container with those of other. Allocators are swapped only if
+    // they propagate on swap; otherwise they must be equal.
+    void swap(SmallDynamicArray& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this == &other) {
+            return;
+        }
+
+        if (!is_inline() && !other.is_inline()) {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_capacity, other.m_capacity);
+            propagation_detail::swap_on_swap(m_allocator, other.m_allocator);
+            return;
+        }
+
+        SmallDynamicArray temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    // Add an element to the end of the array
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    // Add an element to the front of the array
+    void push_front(const T& value) {
+        emplace(cbegin(), value);
+    }
+
+    // remove the last element from the array
+    void pop_back() {
+        if (empty()) {
+            throw std::logic_error("Array is empty");
+        }
+
+        std::allocator_traits<Alloc>::destroy(m_allocator, m_data + m_size - 1);
+        --m_size;
+    }
+
+    // remove the first element from the array
+    void pop_front() {
+        if (empty()) {
+            throw std::logic_error("Array is empty");
+        }
+
+        erase(cbegin());
+    }
+
+private:
+    T* inline_data() noexcept {
+        return reinterpret_cast<T*>(m_inline);
+    }
+
+    const T* inline_data() const noexcept {
+        return reinterpret_cast<const T*>(m_inline);
+    }
+
+    std::size_t checked_offset(const_iterator index) const {
+        if (index < cbegin() || index > cend()) {
+            throw std::out_of_range("Invalid index");
+        }
+        return static_cast<std::size_t>(index - cbegin());
+    }
+
+    // Capacity to grow to when `required` elements must fit
+    std::size_t grown_capacity(std::size_t required) const {
+        if (required > max_size()) {
+            throw std::length_error("SmallDynamicArray exceeds max_size");
+        }
+        return std::max(static_cast<std::size_t>(Growth::next_capacity(m_capacity, required)), required);
+    }
+
+    // Opens `count` slots at offset within the current capacity and fills them with construct_gap
+    template <class ConstructGap>
+    void open_gap(std::size_t offset, std::size_t count, ConstructGap construct_gap) {
+        T* pos = begin() + offset;
+        T* old_end = end();
+        std::size_t after = m_size - offset;
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            shift_relocate(pos, old_end, static_cast<std::ptrdiff_t>(count));
+            try {
+                construct_gap(pos);
+            } catch (...) {
+                shift_relocate(pos + count, old_end + count, -static_cast<std::ptrdiff_t>(count));
+                throw;
+            }
+        }
+        else {
+            // Move the tail up into raw storage first, then the shifted-over slots hold no live
+            // objects and the new elements are constructed in place
+            std::size_t moved_to_raw = std::min(after, count);
+            alloc_uninitialized_move(m_allocator, old_end - moved_to_raw, old_end, old_end + count - moved_to_raw);
+            std::move_backward(pos, old_end - moved_to_raw, old_end + count - moved_to_raw);
+            std::destroy(pos, pos + std::min(after, count));
+            try {
+                construct_gap(pos);
+            } catch (...) {
+                // Relocating front to back is safe for this overlapping move down
+                relocate(m_allocator, pos + count, old_end + count, pos);
+                throw;
+            }
+        }
+        m_size += count;
+    }
+
+    // Moves the elements into a buffer of at least new_capacity, leaving `gap` uninitialized slots at
+    // offset. A capacity of at most N selects the inline buffer. construct_gap fills the gap before the
+    // old elements move, so its arguments may refer to them.
+    template <class ConstructGap>
+    void reallocate_with_gap(std::size_t new_capacity, std::size_t offset, std::size_t gap, ConstructGap construct_gap) {
+        T* new_data;
+        if (new_capacity <= N) {
+            new_data = inline_data();
+            new_capacity = N;
+        }
+        else {
+            new_data = std::allocator_traits<Alloc>::allocate(m_allocator, new_capacity);
+            if (!new_data) {
+                throw std::bad_alloc();
+            }
+        }
+
+        std::size_t constructed = 0;
+        try {
+            construct_gap(new_data + offset);
+            constructed = gap;
+            relocate_with_gap(m_allocator, m_data, m_data + m_size, offset, gap, new_data);
+        } catch (...) {
+            // The elements are still in the old buffer if their relocation threw
+            for (std::size_t i = 0; i < constructed; ++i) {
+                std::allocator_traits<Alloc>::destroy(m_allocator, new_data + offset + i);
+            }
+            if (new_data != inline_data()) {
+                std::allocator_traits<Alloc>::deallocate(m_allocator, new_data, new_capacity);
+            }
+            throw;
+        }
+
+        container_stats_detail::record_resize<SmallDynamicArray>(m_capacity, new_capacity, m_size, false);
+        release_heap();
+
+        m_data = new_data;
+        m_capacity = new_capacity;
+        m_size += gap;
+    }
+
+    void reallocate(std::size_t new_capacity) {
+        reallocate_with_gap(new_capacity, m_size, 0, [](T*) {});
+    }
+
+    // Frees the heap buffer, if any, and points back at the inline buffer. Holds no elements afterwards.
+    // Fills this empty array with the count elements of [first, last). Elements are only constructed,
+    // never assigned, so copies work for element types such as pairs with a const key.
+    template <typename InputIt>
+    void construct_from(InputIt first, InputIt last, std::size_t count) {
+        reserve(count);
+        try {
+            alloc_uninitialized_copy(m_allocator, first, last, m_data);
+        } catch (...) {
+            release_heap();
+            throw;
+        }
+        m_size = count;
+    }
+
+    void release_heap() noexcept {
+        if (!is_inline()) {
+            std::allocator_traits<Alloc>::deallocate(m_allocator, m_data, m_capacity);
+            m_data = inline_data();
+            m_capacity = N;
+        }
+    }
+
+    // Takes the elements of other into this empty, inline array. Heap buffers change owner, inline
+    // elements are relocated one by one.
+    void take_elements(SmallDynamicArray& other) {
+        if (other.is_inline()) {
+            relocate(m_allocator, other.m_data, other.m_data + other.m_size, inline_data());
+            m_size = other.m_size;
+        }
+        else {
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_capacity = other.m_capacity;
+            other.m_data = other.inline_data();
+            other.m_capacity = N;
+        }
+        other.m_size = 0;
+    }
+
+    T* m_data;
+    std::size_t m_size;
+    std::size_t m_capacity;
+    [[no_unique_address]] Alloc m_allocator;
+    alignas(T) std::byte m_inline[N * sizeof(T)];
+};
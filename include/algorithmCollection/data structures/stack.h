@@ -0,0 +1,73 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include "deque.h"
+
+// Storage a Stack can sit on: appends and removes at the back, which Deque and DynamicArray both do
+// in O(1)
+template <typename C>
+concept StackStorage = requires(C c, const C cc, typename C::value_type v) {
+    typename C::value_type;
+    c.push_back(v);
+    c.pop_back();
+    c.back();
+    { cc.size() } -> std::convertible_to<std::size_t>;
+    { cc.empty() } -> std::convertible_to<bool>;
+};
+
+// Last-in first-out adapter over Container.
+// top() and pop() on an empty stack throw like the underlying container does.
+template <typename T, StackStorage Container = Deque<T>>
+class Stack {
+public:
+    using container_type = Container;
+    using value_type = typename Container::value_type;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    Stack() = default;
+
+    explicit Stack(const Container& container) : m_container(container) {}
+
+    explicit Stack(Container&& container) : m_container(std::move(container)) {}
+
+    // Returns the newest element
+    reference top() { return m_container.back(); }
+    const_reference top() const { return m_container.back(); }
+
+    // Returns number of elements in the stack
+    size_type size() const noexcept { return m_container.size(); }
+
+    // Checks whether the stack is empty or not
+    bool empty() const noexcept { return m_container.empty(); }
+
+    // Puts an element on top
+    void push(const value_type& value) { m_container.push_back(value); }
+    void push(value_type&& value) { m_container.push_back(std::move(value)); }
+
+    template <class... Args>
+    decltype(auto) emplace(Args&&... args) {
+        return m_container.emplace_back(std::forward<Args>(args)...);
+    }
+
+    // Removes the newest element
+    void pop() { m_container.pop_back(); }
+
+    // Gives access to the underlying storage
+    const Container& container() const noexcept { return m_container; }
+
+    void swap(Stack& other) noexcept {
+        m_container.swap(other.m_container);
+    }
+
+    friend void swap(Stack& lhs, Stack& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    bool operator==(const Stack& rhs) const { return m_container == rhs.m_container; }
+
+private:
+    Container m_container;
+};
@@ -0,0 +1,348 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "dynamicArray.h"
+
+// Column scan kernels over contiguous spans, e.g. the columns of a Tabular or DynamicArray::data().
+// Each kernel keeps scan_lanes independent accumulators, consecutive elements going to consecutive
+// lanes, so the loop carries no dependency from one element to the next and compilers turn it
+// into SIMD code without -ffast-math. Floating point sums therefore add in a different order than a
+// sequential loop.
+
+// Accumulators per kernel, one 512 bit register of 64 bit values
+inline constexpr std::size_t scan_lanes = 8;
+
+// One byte per row, 1 for selected rows and 0 otherwise. Bytes rather than bits keep mask building
+// and masked scans as vectorizable as the unmasked ones.
+using RowMask = DynamicArray<std::uint8_t>;
+
+// Accumulator of column_sum(): 64 bit for integers, the element type itself for floating point
+template <typename T>
+using column_sum_t = std::conditional_t<std::is_floating_point_v<T>, T,
+    std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+template <typename T>
+struct ColumnMinMax {
+    T min;
+    T max;
+};
+
+// Sum of all values. Takes spans of const and mutable elements alike, as do the kernels below.
+template <typename T>
+    requires std::is_arithmetic_v<std::remove_const_t<T>>
+column_sum_t<std::remove_const_t<T>> column_sum(std::span<T> values) noexcept {
+    using Sum = column_sum_t<std::remove_const_t<T>>;
+    Sum lanes[scan_lanes] = {};
+    const std::size_t full = values.size() - values.size() % scan_lanes;
+    for (std::size_t i = 0; i < full; i += scan_lanes) {
+        for (std::size_t lane = 0; lane < scan_lanes; ++lane) {
+            lanes[lane] += static_cast<Sum>(values[i + lane]);
+        }
+    }
+    for (std::size_t i = full; i < values.size(); ++i) {
+        lanes[i - full] += static_cast<Sum>(values[i]);
+    }
+    Sum sum{};
+    for (Sum lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+namespace tabular_detail {
+    // value if selected is non-zero, else zero, by masking its bits: a branch would mispredict on
+    // every unpredictable mask and keep the loop scalar, a multiplication would let an unselected
+    // infinity or NaN through
+    template <typename Sum>
+    Sum select_or_zero(std::uint8_t selected, Sum value) noexcept {
+        if constexpr (std::is_floating_point_v<Sum>) {
+            using Bits = std::conditional_t<sizeof(Sum) == 8, std::uint64_t, std::uint32_t>;
+            const Bits keep = Bits{0} - static_cast<Bits>(selected != 0);
+            return std::bit_cast<Sum>(static_cast<Bits>(std::bit_cast<Bits>(value) & keep));
+        } else {
+            return value & static_cast<Sum>(Sum{0} - static_cast<Sum>(selected != 0));
+        }
+    }
+}
+
+// Sum over the rows mask selects
+template <typename T>
+    requires std::is_arithmetic_v<std::remove_const_t<T>>
+column_sum_t<std::remove_const_t<T>> column_sum(std::span<T> values, std::span<const std::uint8_t> mask) {
+    if (mask.size() != values.size()) {
+        throw std::invalid_argument("Mask size does not match the column");
+    }
+    using Sum = column_sum_t<std::remove_const_t<T>>;
+    Sum lanes[scan_lanes] = {};
+    const std::size_t full = values.size() - values.size() % scan_lanes;
+    for (std::size_t i = 0; i < full; i += scan_lanes) {
+        for (std::size_t lane = 0; lane < scan_lanes; ++lane) {
+            lanes[lane] += tabular_detail::select_or_zero(mask[i + lane], static_cast<Sum>(values[i + lane]));
+        }
+    }
+    for (std::size_t i = full; i < values.size(); ++i) {
+        lanes[i - full] += tabular_detail::select_or_zero(mask[i], static_cast<Sum>(values[i]));
+    }
+    Sum sum{};
+    for (Sum lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+// Smallest and greatest value. Throws std::logic_error on an empty column.
+template <typename T>
+    requires std::is_arithmetic_v<std::remove_const_t<T>>
+ColumnMinMax<std::remove_const_t<T>> column_min_max(std::span<T> values) {
+    using V = std::remove_const_t<T>;
+    if (values.empty()) {
+        throw std::logic_error("Column is empty");
+    }
+    V low[scan_lanes];
+    V high[scan_lanes];
+    std::fill(std::begin(low), std::end(low), values[0]);
+    std::fill(std::begin(high), std::end(high), values[0]);
+    const std::size_t full = values.size() - values.size() % scan_lanes;
+    for (std::size_t i = 0; i < full; i += scan_lanes) {
+        for (std::size_t lane = 0; lane < scan_lanes; ++lane) {
+            const V value = values[i + lane];
+            low[lane] = value < low[lane] ? value : low[lane];
+            high[lane] = high[lane] < value ? value : high[lane];
+        }
+    }
+    ColumnMinMax<V> result{values[0], values[0]};
+    for (std::size_t i = full; i < values.size(); ++i) {
+        result.min = values[i] < result.min ? values[i] : result.min;
+        result.max = result.max < values[i] ? values[i] : result.max;
+    }
+    for (std::size_t lane = 0; lane < scan_lanes; ++lane) {
+        result.min = low[lane] < result.min ? low[lane] : result.min;
+        result.max = result.max < high[lane] ? high[lane] : result.max;
+    }
+    return result;
+}
+
+// Writes pred(value) of every row to mask, reusing its storage
+template <typename T, class Pred>
+void column_mask(std::span<T> values, Pred pred, RowMask& mask) {
+    mask.resize(values.size());
+    std::uint8_t* out = mask.begin();
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        out[i] = static_cast<std::uint8_t>(pred(values[i]) ? 1 : 0);
+    }
+}
+
+template <typename T, class Pred>
+RowMask column_mask(std::span<T> values, Pred pred) {
+    RowMask mask;
+    column_mask(values, pred, mask);
+    return mask;
+}
+
+// Number of selected rows
+inline std::size_t mask_count(std::span<const std::uint8_t> mask) noexcept {
+    return static_cast<std::size_t>(column_sum(mask));
+}
+
+// Keeps the rows both masks select
+inline void mask_and(RowMask& mask, std::span<const std::uint8_t> other) {
+    if (mask.size() != other.size()) {
+        throw std::invalid_argument("Mask size does not match the column");
+    }
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        mask[i] &= other[i];
+    }
+}
+
+// Keeps the rows either mask selects
+inline void mask_or(RowMask& mask, std::span<const std::uint8_t> other) {
+    if (mask.size() != other.size()) {
+        throw std::invalid_argument("Mask size does not match the column");
+    }
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        mask[i] |= other[i];
+    }
+}
+
+inline void mask_not(RowMask& mask) noexcept {
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        mask[i] ^= 1;
+    }
+}
+
+// Indices of the selected rows in ascending order
+inline DynamicArray<std::size_t> mask_indices(std::span<const std::uint8_t> mask) {
+    DynamicArray<std::size_t> indices;
+    indices.reserve(mask_count(mask));
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+        if (mask[i]) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+// Table stored as struct of arrays: one DynamicArray per column, so a scan over one column reads
+// only that column's bytes. Columns are addressed by index, column<I>() yields a span to hand to
+// the column_ kernels above.
+// Appending a row appends to every column; if one of them throws, the others are rolled back.
+template <typename... Columns>
+class Tabular {
+    static_assert(sizeof...(Columns) > 0, "A table needs at least one column");
+
+public:
+    using size_type = std::size_t;
+    using row_type = std::tuple<Columns...>;
+
+    template <std::size_t I>
+    using column_type = std::tuple_element_t<I, std::tuple<Columns...>>;
+
+    static constexpr std::size_t column_count = sizeof...(Columns);
+
+    Tabular() = default;
+
+    Tabular(std::initializer_list<row_type> rows) {
+        reserve(rows.size());
+        for (const row_type& row : rows) {
+            std::apply([this](const Columns&... values) { push_back(values...); }, row);
+        }
+    }
+
+    // Number of rows
+    size_type size() const noexcept { return std::get<0>(m_columns).size(); }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    void reserve(size_type rows) {
+        std::apply([rows](auto&... columns) { (columns.reserve(rows), ...); }, m_columns);
+    }
+
+    void clear() noexcept {
+        std::apply([](auto&... columns) { (columns.clear(), ...); }, m_columns);
+    }
+
+    // Appends a row
+    template <typename... Values>
+        requires(sizeof...(Values) == sizeof...(Columns) && (std::constructible_from<Columns, Values&&> && ...))
+    void push_back(Values&&... values) {
+        append(std::index_sequence_for<Columns...>{}, std::forward<Values>(values)...);
+    }
+
+    void push_back(const row_type& row) {
+        std::apply([this](const Columns&... values) { push_back(values...); }, row);
+    }
+
+    // Removes the last row
+    void pop_back() {
+        if (empty()) {
+            throw std::logic_error("Table is empty");
+        }
+        std::apply([](auto&... columns) { (columns.pop_back(), ...); }, m_columns);
+    }
+
+    // Column I as a contiguous span
+    template <std::size_t I>
+    std::span<column_type<I>> column() noexcept {
+        return std::get<I>(m_columns).data();
+    }
+
+    template <std::size_t I>
+    std::span<const column_type<I>> column() const noexcept {
+        return std::get<I>(m_columns).data();
+    }
+
+    // The fields of one row, gathered from the columns
+    std::tuple<Columns&...> row(size_type index) noexcept {
+        return std::apply([index](auto&... columns) { return std::tuple<Columns&...>(columns[index]...); }, m_columns);
+    }
+
+    std::tuple<const Columns&...> row(size_type index) const noexcept {
+        return std::apply([index](const auto&... columns) { return std::tuple<const Columns&...>(columns[index]...); },
+            m_columns);
+    }
+
+    std::tuple<Columns&...> at(size_type index) {
+        check(index);
+        return row(index);
+    }
+
+    std::tuple<const Columns&...> at(size_type index) const {
+        check(index);
+        return row(index);
+    }
+
+    template <std::size_t I>
+    column_sum_t<column_type<I>> sum() const noexcept {
+        return column_sum(column<I>());
+    }
+
+    template <std::size_t I>
+    column_sum_t<column_type<I>> sum(const RowMask& mask) const {
+        return column_sum(column<I>(), mask.data());
+    }
+
+    template <std::size_t I>
+    ColumnMinMax<column_type<I>> min_max() const {
+        return column_min_max(column<I>());
+    }
+
+    // Mask of the rows whose column I satisfies pred
+    template <std::size_t I, class Pred>
+    RowMask where(Pred pred) const {
+        return column_mask(column<I>(), pred);
+    }
+
+    // Copy of the rows mask selects
+    Tabular filter(const RowMask& mask) const {
+        if (mask.size() != size()) {
+            throw std::invalid_argument("Mask size does not match the column");
+        }
+        Tabular result;
+        result.reserve(mask_count(mask.data()));
+        copy_selected(mask, result, std::index_sequence_for<Columns...>{});
+        return result;
+    }
+
+private:
+    std::tuple<DynamicArray<Columns>...> m_columns;
+
+    void check(size_type index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of range");
+        }
+    }
+
+    template <std::size_t... I, typename... Values>
+    void append(std::index_sequence<I...>, Values&&... values) {
+        std::size_t appended = 0;
+        try {
+            ((std::get<I>(m_columns).push_back(column_type<I>(std::forward<Values>(values))), ++appended), ...);
+        } catch (...) {
+            ((I < appended ? std::get<I>(m_columns).pop_back() : void()), ...);
+            throw;
+        }
+    }
+
+    template <std::size_t... I>
+    void copy_selected(const RowMask& mask, Tabular& result, std::index_sequence<I...>) const {
+        (copy_selected(std::get<I>(m_columns), std::get<I>(result.m_columns), mask), ...);
+    }
+
+    template <typename T>
+    static void copy_selected(const DynamicArray<T>& in, DynamicArray<T>& out, const RowMask& mask) {
+        for (size_type i = 0; i < in.size(); ++i) {
+            if (mask[i]) {
+                out.push_back(in[i]);
+            }
+        }
+    }
+};
@@ -0,0 +1,124 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/allocators/arenaAllocator.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <array>
+#include <cstdint>
+#include <string>
+
+TEST_CASE("Test arena allocations are aligned and disjoint") {
+    ArenaResource arena(64);
+
+    auto* a = static_cast<char*>(arena.allocate(3, 1));
+    auto* b = arena.allocate(sizeof(double), alignof(double));
+    auto* c = arena.allocate(32, 32);
+
+    CHECK(reinterpret_cast<std::uintptr_t>(b) % alignof(double) == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(c) % 32 == 0);
+    CHECK(static_cast<void*>(a + 3) <= b);
+    CHECK(arena.bytes_allocated() == 3 + sizeof(double) + 32);
+}
+
+TEST_CASE("Test arena grows when a chunk is exhausted") {
+    ArenaResource arena(128);
+
+    for (int i = 0; i < 100; ++i) {
+        arena.allocate(64);
+    }
+
+    CHECK(arena.chunk_count() > 1);
+    CHECK(arena.bytes_allocated() == 100 * 64);
+
+    SUBCASE("Allocation larger than the chunk size") {
+        void* p = arena.allocate(100000);
+        CHECK(p != nullptr);
+    }
+}
+
+TEST_CASE("Test arena reset keeps one chunk for reuse") {
+    ArenaResource arena(256);
+
+    for (int i = 0; i < 64; ++i) {
+        arena.allocate(64);
+    }
+    arena.reset();
+
+    CHECK(arena.bytes_allocated() == 0);
+    CHECK(arena.chunk_count() == 1);
+
+    // The retained chunk is the largest one, so a smaller workload does not grow the arena again
+    arena.allocate(64);
+    CHECK(arena.chunk_count() == 1);
+
+    arena.release();
+    CHECK(arena.chunk_count() == 0);
+}
+
+TEST_CASE("Test arena serves caller-supplied buffer first") {
+    alignas(std::max_align_t) std::array<std::byte, 256> buffer{};
+    ArenaResource arena(buffer);
+
+    auto* p = static_cast<std::byte*>(arena.allocate(128));
+    CHECK(p >= buffer.data());
+    CHECK(p < buffer.data() + buffer.size());
+    CHECK(arena.chunk_count() == 0);
+
+    arena.allocate(512);
+    CHECK(arena.chunk_count() == 1);
+
+    arena.reset();
+    CHECK(static_cast<std::byte*>(arena.allocate(16)) == buffer.data());
+}
+
+TEST_CASE("Test arena allocator rebinding shares the arena") {
+    ArenaResource arena;
+    MonotonicArenaAllocator<int> ints(arena);
+    MonotonicArenaAllocator<double> doubles(ints);
+
+    CHECK(doubles.resource() == &arena);
+    CHECK(ints == doubles);
+
+    ArenaResource other;
+    CHECK(ints != MonotonicArenaAllocator<int>(other));
+}
+
+TEST_CASE("Test DynamicArray with arena allocator") {
+    ArenaResource arena;
+    MonotonicArenaAllocator<std::string> alloc(arena);
+
+    DynamicArray<std::string, MonotonicArenaAllocator<std::string>> arr(alloc);
+    for (int i = 0; i < 100; ++i) {
+        arr.push_back(std::to_string(i));
+    }
+
+    CHECK(arr.size() == 100);
+    CHECK(arr[99] == "99");
+    CHECK(arr.get_allocator().resource() == &arena);
+    CHECK(arena.bytes_allocated() >= 100 * sizeof(std::string));
+
+    DynamicArray<std::string, MonotonicArenaAllocator<std::string>> copy(arr);
+    CHECK(copy == arr);
+    CHECK(copy.get_allocator() == alloc);
+}
+
+TEST_CASE("Test several containers sharing one arena") {
+    ArenaResource arena;
+    MonotonicArenaAllocator<int> alloc(arena);
+
+    DynamicArray<int, MonotonicArenaAllocator<int>> arr(alloc);
+    DoubleLinkedList<int, MonotonicArenaAllocator<int>> list(alloc);
+
+    for (int i = 0; i < 10; ++i) {
+        arr.push_back(i);
+        list.push_back(i);
+    }
+
+    CHECK(arr.size() == 10);
+    CHECK(list.size() == 10);
+    CHECK(list.front().data == 0);
+    CHECK(list.back().data == 9);
+    CHECK(list.get_allocator().resource() == &arena);
+
+    // Nodes are allocated through the rebound allocator from the same arena
+    CHECK(arena.bytes_allocated() >= 10 * (sizeof(int) + 2 * sizeof(void*)) + 10 * sizeof(int));
+}
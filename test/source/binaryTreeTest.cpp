@@ -0,0 +1,180 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/binaryTree.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    // Checks every lookup of a tree over sorted against std::lower_bound / std::upper_bound
+    template <TreeLayout Layout>
+    void check_against_sorted(const std::vector<int>& sorted) {
+        const StaticSearchTree<int, Layout> tree(sorted.begin(), sorted.end());
+        REQUIRE(tree.size() == sorted.size());
+        for (std::size_t rank = 0; rank < sorted.size(); ++rank) {
+            REQUIRE(tree[rank] == sorted[rank]);
+        }
+        const int low = sorted.empty() ? 0 : sorted.front() - 2;
+        const int high = sorted.empty() ? 0 : sorted.back() + 2;
+        for (int key = low; key <= high; ++key) {
+            const auto expected_lower = static_cast<std::size_t>(std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin());
+            const auto expected_upper = static_cast<std::size_t>(std::upper_bound(sorted.begin(), sorted.end(), key) - sorted.begin());
+            REQUIRE(tree.lower_bound(key) == expected_lower);
+            REQUIRE(tree.upper_bound(key) == expected_upper);
+            REQUIRE(tree.contains(key) == std::binary_search(sorted.begin(), sorted.end(), key));
+        }
+    }
+
+    // In-order traversal yields strictly increasing keys
+    template <typename Tree>
+    bool is_sorted_tree(const Tree& tree) {
+        return std::is_sorted(tree.begin(), tree.end()) &&
+            std::adjacent_find(tree.begin(), tree.end()) == tree.end();
+    }
+}
+
+TEST_CASE("Test static search tree lookups") {
+    const StaticSearchTree<int> tree = {1, 3, 3, 5, 9};
+    CHECK(tree.size() == 5);
+    CHECK(tree.height() == 3);
+    CHECK(tree.layout().size() == 7);
+    CHECK(tree.lower_bound(3) == 1);
+    CHECK(tree.upper_bound(3) == 3);
+    CHECK(tree.lower_bound(0) == 0);
+    CHECK(tree.lower_bound(10) == tree.size());
+    CHECK(tree.find(5) == 3);
+    CHECK(tree.find(4) == tree.size());
+    CHECK(tree.contains(9));
+    CHECK_FALSE(tree.contains(2));
+    CHECK(tree.at(4) == 9);
+    CHECK_THROWS_AS(tree.at(5), std::out_of_range);
+
+    const StaticSearchTree<int> empty;
+    CHECK(empty.empty());
+    CHECK(empty.lower_bound(1) == 0);
+    CHECK_FALSE(empty.contains(1));
+
+    const std::vector<int> unsorted = {2, 1};
+    CHECK_THROWS_AS((StaticSearchTree<int>(unsorted.begin(), unsorted.end())), std::invalid_argument);
+}
+
+TEST_CASE("Test static search tree layouts match binary search") {
+    std::mt19937 rng(11);
+    for (std::size_t n = 0; n <= 130; ++n) {
+        std::vector<int> sorted(n);
+        for (int& value : sorted) {
+            value = static_cast<int>(rng() % 200);
+        }
+        std::sort(sorted.begin(), sorted.end());
+        check_against_sorted<TreeLayout::Eytzinger>(sorted);
+        check_against_sorted<TreeLayout::VanEmdeBoas>(sorted);
+    }
+}
+
+TEST_CASE("Test van Emde Boas layout keeps subtrees contiguous") {
+    std::vector<int> sorted(15);
+    for (int i = 0; i < 15; ++i) {
+        sorted[static_cast<std::size_t>(i)] = i;
+    }
+    const VanEmdeBoasTree<int> tree(sorted.begin(), sorted.end());
+    // Height 4 splits into a top tree of 2 levels and four bottom trees of 2 levels
+    const std::vector<int> expected = {7, 3, 11, 1, 0, 2, 5, 4, 6, 9, 8, 10, 13, 12, 14};
+    CHECK(std::equal(tree.layout().begin(), tree.layout().end(), expected.begin(), expected.end()));
+
+    const EytzingerTree<int> bfs(sorted.begin(), sorted.end());
+    const std::vector<int> breadth_first = {7, 3, 11, 1, 5, 9, 13, 0, 2, 4, 6, 8, 10, 12, 14};
+    CHECK(std::equal(bfs.layout().begin(), bfs.layout().end(), breadth_first.begin(), breadth_first.end()));
+}
+
+TEST_CASE("Test static search tree with a custom comparator and heterogeneous keys") {
+    const std::vector<std::string> sorted = {"pear", "kiwi", "apple"};
+    const StaticSearchTree<std::string, TreeLayout::VanEmdeBoas, std::greater<>> tree(sorted.begin(), sorted.end());
+    CHECK(tree.lower_bound("lemon") == 1);
+    CHECK(tree.find(std::string_view("apple")) == 2);
+    CHECK(tree[0] == "pear");
+}
+
+TEST_CASE("Test binary tree insert, find and erase") {
+    BinaryTree<int> tree = {5, 3, 8, 1, 3};
+    CHECK(tree.size() == 4);
+    CHECK(tree.contains(3));
+    CHECK_FALSE(tree.contains(4));
+    CHECK_FALSE(tree.insert(5).second);
+    CHECK(*tree.insert(4).first == 4);
+    CHECK(*tree.begin() == 1);
+    CHECK(*tree.rbegin() == 8);
+    CHECK(*--tree.end() == 8);
+    CHECK(*tree.lower_bound(6) == 8);
+    CHECK(*tree.upper_bound(4) == 5);
+    CHECK(tree.upper_bound(8) == tree.end());
+    CHECK(tree.erase(3) == 1);
+    CHECK(tree.erase(3) == 0);
+    CHECK(*tree.erase(tree.find(4)) == 5);
+    CHECK(tree.erase(tree.find(8)) == tree.end());
+    CHECK(tree.size() == 2);
+    tree.clear();
+    CHECK(tree.empty());
+    CHECK(tree.begin() == tree.end());
+    CHECK(tree.height() == 0);
+}
+
+TEST_CASE("Test binary tree stays balanced") {
+    BinaryTree<int> tree;
+    for (int i = 0; i < 1000; ++i) {
+        tree.insert(i);
+    }
+    CHECK(tree.height() <= static_cast<std::size_t>(1.44 * std::log2(1002.0)));
+    for (int i = 0; i < 1000; i += 2) {
+        tree.erase(i);
+    }
+    CHECK(tree.size() == 500);
+    CHECK(tree.height() <= static_cast<std::size_t>(1.44 * std::log2(502.0)));
+    CHECK(*tree.begin() == 1);
+}
+
+TEST_CASE("Test binary tree matches std::set under random operations") {
+    BinaryTree<std::string> tree;
+    std::set<std::string> reference;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 10000; ++step) {
+        const std::string key = std::to_string(rng() % 500);
+        if (rng() % 3 == 0) {
+            CHECK(tree.erase(key) == reference.erase(key));
+        } else {
+            CHECK(tree.insert(key).second == reference.insert(key).second);
+        }
+        REQUIRE(tree.size() == reference.size());
+    }
+    CHECK(std::equal(tree.begin(), tree.end(), reference.begin(), reference.end()));
+    CHECK(std::equal(tree.rbegin(), tree.rend(), reference.rbegin(), reference.rend()));
+    CHECK(is_sorted_tree(tree));
+}
+
+TEST_CASE("Test binary tree copy and move") {
+    BinaryTree<int> tree = {4, 2, 6, 1, 3};
+    BinaryTree<int> copy(tree);
+    CHECK(copy == tree);
+    copy.insert(7);
+    CHECK(tree.size() == 5);
+    CHECK(*copy.rbegin() == 7);
+
+    BinaryTree<int> moved(std::move(copy));
+    CHECK(moved.size() == 6);
+    CHECK(*--moved.end() == 7);
+    moved.erase(7);
+    CHECK(moved == tree);
+
+    BinaryTree<int> assigned;
+    assigned = tree;
+    CHECK(assigned == tree);
+    assigned = BinaryTree<int>{9};
+    CHECK(assigned.size() == 1);
+    swap(assigned, tree);
+    CHECK(tree.size() == 1);
+    CHECK(assigned.size() == 5);
+    CHECK(*assigned.begin() == 1);
+}
@@ -0,0 +1,167 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/concurrentHashMap.h>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view value) const noexcept { return std::hash<std::string_view>()(value); }
+};
+
+struct StringEq {
+    using is_transparent = void;
+
+    bool operator()(std::string_view lhs, std::string_view rhs) const noexcept { return lhs == rhs; }
+};
+}
+
+TEST_CASE("Test concurrent hash map single-threaded operations") {
+    ConcurrentHashMap<int, std::string> map;
+    CHECK(map.empty());
+    CHECK_FALSE(map.find(1).has_value());
+
+    CHECK(map.try_emplace(1, "one"));
+    CHECK_FALSE(map.try_emplace(1, "uno"));
+    CHECK(map.find(1) == "one");
+
+    CHECK_FALSE(map.insert_or_assign(1, "uno"));
+    CHECK(map.insert_or_assign(2, "two"));
+    CHECK(map.find(1) == "uno");
+    CHECK(map.contains(2));
+    CHECK(map.size() == 2);
+
+    std::size_t length = 0;
+    CHECK(map.visit(2, [&](const std::string& value) { length = value.size(); }));
+    CHECK(length == 3);
+    CHECK_FALSE(map.visit(3, [&](const std::string&) { length = 0; }));
+    CHECK(map.update(2, [](std::string& value) { value += "!"; }));
+    CHECK(map.find(2) == "two!");
+
+    CHECK(map.erase(1) == 1);
+    CHECK(map.erase(1) == 0);
+    CHECK(map.size() == 1);
+
+    for (int i = 0; i < 1000; ++i) {
+        map.insert_or_assign(i, std::to_string(i));
+    }
+    CHECK(map.size() == 1000);
+    CHECK(map.erase_if([](const auto& value) { return value.first % 2 == 0; }) == 500);
+    CHECK(map.size() == 500);
+
+    std::size_t visited = 0;
+    map.for_each([&](const auto& value) { visited += value.first % 2; });
+    CHECK(visited == 500);
+
+    map.clear();
+    CHECK(map.empty());
+}
+
+TEST_CASE("Test concurrent hash map spreads keys over its shards") {
+    ConcurrentHashMap<int, int, std::hash<int>, std::equal_to<int>, SimpleAllocator<std::pair<const int, int>>, 16> map;
+    std::vector<int> per_shard(map.shard_count);
+    for (int i = 0; i < 16000; ++i) {
+        const std::size_t shard = map.shard_index(i);
+        CHECK(shard < map.shard_count);
+        ++per_shard[shard];
+    }
+    for (int count : per_shard) {
+        CHECK(count > 800);
+        CHECK(count < 1200);
+    }
+
+    ConcurrentHashMap<int, int, std::hash<int>, std::equal_to<int>, SimpleAllocator<std::pair<const int, int>>, 1> single;
+    single.try_emplace(5, 6);
+    CHECK(single.shard_index(5) == 0);
+    CHECK(single.find(5) == 6);
+}
+
+TEST_CASE("Test concurrent hash map transparent lookups") {
+    ConcurrentHashMap<std::string, int, StringHash, StringEq> map;
+    map.try_emplace(std::string("key"), 1);
+    std::string_view view = "key";
+    CHECK(map.contains(view));
+    CHECK(map.find(view) == 1);
+    CHECK(map.erase(view) == 1);
+    CHECK_FALSE(map.contains(view));
+}
+
+TEST_CASE("Test concurrent hash map compute_if_absent computes once per key") {
+    ConcurrentHashMap<int, int> map;
+    std::atomic<int> computed{0};
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int key = 0; key < 200; ++key) {
+                const int value = map.compute_if_absent(key, [&] {
+                    computed.fetch_add(1);
+                    return key * 3;
+                });
+                if (value != key * 3) {
+                    wrong.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(computed.load() == 200);
+    CHECK(wrong.load() == 0);
+    CHECK(map.size() == 200);
+}
+
+TEST_CASE("Test concurrent hash map under concurrent readers and writers") {
+    ConcurrentHashMap<int, std::string> map;
+    constexpr int keys = 2000;
+    for (int i = 0; i < keys; ++i) {
+        map.insert_or_assign(i, std::to_string(i));
+    }
+
+    // Writers flip odd keys between present and absent while readers check that whatever they see
+    // under a key is that key's value
+    std::atomic<bool> stop{false};
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([&, t] {
+            for (int round = 0; round < 20; ++round) {
+                for (int i = 1 + 2 * t; i < keys; i += 4) {
+                    if (round % 2 == 0) {
+                        map.erase(i);
+                    } else {
+                        map.try_emplace(i, std::to_string(i));
+                    }
+                }
+            }
+        });
+    }
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            int i = t;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const int key = i++ % keys;
+                if (auto value = map.find(key); value && *value != std::to_string(key)) {
+                    mismatches.fetch_add(1);
+                }
+                if (key % 2 == 0 && !map.contains(key)) {
+                    mismatches.fetch_add(1);
+                }
+            }
+        });
+    }
+    threads[0].join();
+    threads[1].join();
+    stop.store(true);
+    for (std::size_t t = 2; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+
+    CHECK(mismatches.load() == 0);
+    CHECK(map.size() == keys);
+}
@@ -0,0 +1,190 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/queue.h>
+#include <algorithmCollection/allocators/arenaAllocator.h>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Test spsc queue push and pop") {
+    SpscQueue<std::string> queue(5);
+    CHECK(queue.capacity() == 8);
+    CHECK(queue.empty());
+
+    std::string value;
+    CHECK_FALSE(queue.try_pop(value));
+    for (int i = 0; i < 8; ++i) {
+        CHECK(queue.try_push(std::to_string(i)));
+    }
+    CHECK_FALSE(queue.try_push("full"));
+    CHECK(queue.size() == 8);
+
+    CHECK(queue.try_pop(value));
+    CHECK(value == "0");
+    CHECK(queue.try_emplace(3, 'x'));
+    for (int i = 1; i < 8; ++i) {
+        REQUIRE(queue.try_pop(value));
+        CHECK(value == std::to_string(i));
+    }
+    CHECK(queue.try_pop(value));
+    CHECK(value == "xxx");
+    CHECK(queue.empty());
+
+    // Leftover elements are destroyed with the queue
+    queue.try_push(std::string(100, 'y'));
+}
+
+TEST_CASE("Test spsc queue batches") {
+    SpscQueue<int> queue(16);
+    std::vector<int> input(40);
+    for (int i = 0; i < 40; ++i) {
+        input[i] = i;
+    }
+
+    CHECK(queue.try_push_n(input.begin(), 10) == 10);
+    CHECK(queue.try_push_n(input.begin() + 10, 30) == 6);
+    CHECK(queue.try_push_n(input.begin(), 1) == 0);
+
+    std::vector<int> output;
+    CHECK(queue.try_pop_n(std::back_inserter(output), 4) == 4);
+    CHECK(queue.try_pop_n(std::back_inserter(output), 100) == 12);
+    CHECK(queue.try_pop_n(std::back_inserter(output), 100) == 0);
+    CHECK(output == std::vector<int>(input.begin(), input.begin() + 16));
+}
+
+TEST_CASE("Test spsc queue between two threads") {
+    constexpr int count = 200000;
+    SpscQueue<int> queue(64);
+
+    std::thread producer([&] {
+        int buffer[7];
+        for (int i = 0; i < count;) {
+            if (i % 3 == 0) {
+                for (int j = 0; j < 7; ++j) {
+                    buffer[j] = i + j;
+                }
+                i += static_cast<int>(queue.try_push_n(buffer, std::min(7, count - i)));
+            } else if (queue.try_push(i)) {
+                ++i;
+            }
+        }
+    });
+
+    bool in_order = true;
+    int expected = 0;
+    std::vector<int> batch;
+    while (expected < count) {
+        batch.clear();
+        if (queue.try_pop_n(std::back_inserter(batch), 5) == 0) {
+            int value;
+            if (queue.try_pop(value)) {
+                batch.push_back(value);
+            }
+        }
+        for (int value : batch) {
+            in_order = in_order && value == expected;
+            ++expected;
+        }
+    }
+    producer.join();
+    CHECK(in_order);
+    CHECK(queue.empty());
+}
+
+TEST_CASE("Test mpmc queue push and pop") {
+    ArenaResource arena;
+    MpmcQueue<std::unique_ptr<int>, MonotonicArenaAllocator<std::unique_ptr<int>>> queue(
+        3, MonotonicArenaAllocator<std::unique_ptr<int>>(arena));
+    CHECK(queue.capacity() == 4);
+    const std::size_t allocated = arena.bytes_allocated();
+
+    std::unique_ptr<int> value;
+    CHECK_FALSE(queue.try_pop(value));
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(queue.try_push(std::make_unique<int>(i)));
+        }
+        CHECK_FALSE(queue.try_push(std::make_unique<int>(9)));
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(queue.try_pop(value));
+            CHECK(*value == i);
+        }
+        CHECK(queue.empty());
+    }
+    CHECK(arena.bytes_allocated() == allocated);
+
+    queue.try_push(std::make_unique<int>(1));
+}
+
+TEST_CASE("Test mpmc queue batches") {
+    MpmcQueue<std::string> queue(8);
+    std::vector<std::string> input = {"a", "b", "c", "d", "e", "f"};
+
+    CHECK(queue.try_push_n(std::make_move_iterator(input.begin()), 6) == 6);
+    CHECK(queue.try_push(std::string("g")));
+    CHECK(queue.try_push_n(std::make_move_iterator(input.begin()), 6) == 1);
+
+    std::vector<std::string> output;
+    CHECK(queue.try_pop_n(std::back_inserter(output), 3) == 3);
+    CHECK(queue.try_pop_n(std::back_inserter(output), 10) == 5);
+    CHECK(queue.try_pop_n(std::back_inserter(output), 10) == 0);
+    CHECK(output.size() == 8);
+    CHECK(output[0] == "a");
+    CHECK(output[6] == "g");
+}
+
+TEST_CASE("Test mpmc queue with several producers and consumers") {
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int per_producer = 50000;
+    MpmcQueue<int> queue(128);
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    std::atomic<int> received{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            const int first = p * per_producer;
+            for (int i = 0; i < per_producer;) {
+                if (p % 2 == 0) {
+                    int batch[4] = {first + i, first + i + 1, first + i + 2, first + i + 3};
+                    i += static_cast<int>(queue.try_push_n(batch, std::min(4, per_producer - i)));
+                } else if (queue.try_push(first + i)) {
+                    ++i;
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            std::vector<int> batch;
+            while (received.load() < producers * per_producer) {
+                batch.clear();
+                if (c % 2 == 0) {
+                    queue.try_pop_n(std::back_inserter(batch), 3);
+                } else {
+                    int value;
+                    if (queue.try_pop(value)) {
+                        batch.push_back(value);
+                    }
+                }
+                for (int value : batch) {
+                    seen[value].fetch_add(1);
+                }
+                received.fetch_add(static_cast<int>(batch.size()));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    bool exactly_once = true;
+    for (auto& count : seen) {
+        exactly_once = exactly_once && count.load() == 1;
+    }
+    CHECK(exactly_once);
+    CHECK(queue.empty());
+}
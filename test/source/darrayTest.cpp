@@ -1,6 +1,9 @@
 #include <doctest/doctest.h>
 #include <algorithmCollection/data structures/dynamicArray.h>
+#include <cmath>
+#include <compare>
 #include <iostream>
+#include <string>
 
 TEST_CASE("Test default constructor") {
     DynamicArray<int> arr;
@@ -383,4 +386,209 @@ TEST_CASE("Test iterator functions") {
             expected--;
         }
     }
-}
\ No newline at end of file
+}
+namespace {
+    // Grows to exactly the required capacity, so every reallocation is visible to the test
+    struct ExactGrowth {
+        static std::size_t next_capacity(std::size_t, std::size_t required) {
+            return required;
+        }
+    };
+}
+
+TEST_CASE("Test growth policies") {
+    CHECK(DoublingGrowth::next_capacity(0, 1) == 1);
+    CHECK(DoublingGrowth::next_capacity(8, 9) == 16);
+    CHECK(HalfGrowth::next_capacity(1, 2) == 2);
+    CHECK(HalfGrowth::next_capacity(8, 9) == 12);
+    CHECK(FixedStepGrowth<16>::next_capacity(16, 17) == 32);
+    CHECK(DoublingGrowth::next_capacity(4, 100) == 100);
+
+    SUBCASE("Selected policy drives push_back growth") {
+        DynamicArray<int, SimpleAllocator<int>, HalfGrowth> half;
+        DynamicArray<int, SimpleAllocator<int>, FixedStepGrowth<10>> stepped;
+        DynamicArray<int, SimpleAllocator<int>, ExactGrowth> exact;
+        for (int i = 0; i < 9; ++i) {
+            half.push_back(i);
+            stepped.push_back(i);
+            exact.push_back(i);
+        }
+
+        CHECK(half.capacity() == 9);
+        CHECK(stepped.capacity() == 10);
+        CHECK(exact.capacity() == 9);
+        CHECK(half[8] == 8);
+    }
+}
+
+TEST_CASE("Test emplace in the middle works in place with spare capacity") {
+    DynamicArray<std::string> arr = {"a", "b", "d"};
+    arr.reserve(8);
+    const std::string* storage = arr.data().data();
+
+    auto it = arr.emplace(arr.cbegin() + 2, 1, 'c');
+    CHECK(*it == "c");
+    CHECK(arr.data().data() == storage);
+    CHECK(arr.capacity() == 8);
+    CHECK(arr == DynamicArray<std::string>{"a", "b", "c", "d"});
+
+    arr.emplace(arr.cbegin(), "start");
+    arr.emplace(arr.cend(), "end");
+    CHECK(arr.data().data() == storage);
+    CHECK(arr.front() == "start");
+    CHECK(arr.back() == "end");
+    CHECK(arr.size() == 6);
+}
+
+TEST_CASE("Test repeated mid-array emplace reallocates geometrically") {
+    DynamicArray<int> arr;
+    std::size_t reallocations = 0;
+    const int* storage = nullptr;
+
+    for (int i = 0; i < 1000; ++i) {
+        arr.emplace(arr.cbegin() + arr.size() / 2, i);
+        if (arr.data().data() != storage) {
+            storage = arr.data().data();
+            ++reallocations;
+        }
+    }
+
+    CHECK(arr.size() == 1000);
+    CHECK(reallocations <= 11);
+}
+
+TEST_CASE("Test insertions may refer to the array's own elements") {
+    DynamicArray<std::string> arr = {"first", "second"};
+    arr.shrink_to_fit();
+
+    arr.push_back(arr[0]);
+    CHECK(arr.back() == "first");
+
+    arr.emplace(arr.cbegin(), arr.back());
+    CHECK(arr.front() == "first");
+
+    arr.insert(arr.cbegin() + 1, 2, arr[2]);
+    CHECK(arr == DynamicArray<std::string>{"first", "second", "second", "first", "second", "first"});
+
+    arr.push_front(arr.back());
+    CHECK(arr.front() == "first");
+    CHECK(arr.size() == 7);
+}
+
+TEST_CASE("Test multi-element inserts with spare capacity") {
+    DynamicArray<std::string> arr = {"a", "b", "c", "d"};
+    arr.reserve(16);
+
+    arr.insert(arr.cbegin() + 1, 2, "x");
+    CHECK(arr == DynamicArray<std::string>{"a", "x", "x", "b", "c", "d"});
+
+    arr.insert(arr.cbegin() + 5, 3, "y");
+    CHECK(arr == DynamicArray<std::string>{"a", "x", "x", "b", "c", "y", "y", "y", "d"});
+
+    DynamicArray<std::string> more = {"p", "q"};
+    arr.insert(arr.cend() - 1, more.cbegin(), more.cend());
+    arr.insert(arr.cbegin(), {"0"});
+    CHECK(arr == DynamicArray<std::string>{"0", "a", "x", "x", "b", "c", "y", "y", "y", "p", "q", "d"});
+    CHECK(arr.capacity() == 16);
+
+    arr.assign(2, "z");
+    CHECK(arr == DynamicArray<std::string>{"z", "z"});
+    arr.assign({"1", "2", "3"});
+    CHECK(arr == DynamicArray<std::string>{"1", "2", "3"});
+}
+
+TEST_CASE("Test erase does not reallocate while the size oscillates") {
+    DynamicArray<int> arr;
+    for (int i = 0; i < 64; ++i) {
+        arr.push_back(i);
+    }
+    CHECK(arr.capacity() == 64);
+
+    // Around half of the capacity, the old shrink-at-half rule reallocated on every erase
+    const int* storage = arr.data().data();
+    for (int round = 0; round < 100; ++round) {
+        arr.erase(arr.cbegin());
+        arr.erase(arr.cend() - 1);
+        arr.push_back(round);
+        arr.push_back(round);
+    }
+    arr.erase(arr.cbegin() + 31, arr.cend());
+    arr.push_back(1);
+    arr.erase(arr.cbegin());
+    CHECK(arr.data().data() == storage);
+    CHECK(arr.capacity() == 64);
+}
+
+TEST_CASE("Test hysteresis shrink policy") {
+    CHECK(HysteresisShrink<16>::shrink_capacity(17, 64) == 64);
+    CHECK(HysteresisShrink<16>::shrink_capacity(16, 64) == 32);
+    CHECK(HysteresisShrink<16>::shrink_capacity(2, 64) == 16);
+    CHECK(HysteresisShrink<16>::shrink_capacity(0, 16) == 16);
+
+    DynamicArray<int> arr;
+    arr.resize(128, 7);
+    auto it = arr.erase(arr.cbegin() + 10, arr.cend() - 22);
+    CHECK(arr.size() == 32);
+    CHECK(arr.capacity() == 64);
+    CHECK(*it == 7);
+    CHECK(it == arr.begin() + 10);
+}
+
+TEST_CASE("Test explicit and never shrink policies") {
+    DynamicArray<int, SimpleAllocator<int>, DoublingGrowth, ExplicitShrink> explicit_arr;
+    DynamicArray<int, SimpleAllocator<int>, DoublingGrowth, NeverShrink> never_arr;
+    explicit_arr.resize(100);
+    never_arr.resize(100);
+
+    explicit_arr.erase(explicit_arr.cbegin() + 1, explicit_arr.cend());
+    never_arr.erase(never_arr.cbegin() + 1, never_arr.cend());
+    CHECK(explicit_arr.capacity() == 100);
+    CHECK(never_arr.capacity() == 100);
+
+    explicit_arr.shrink_to(10);
+    never_arr.shrink_to(10);
+    CHECK(explicit_arr.capacity() == 10);
+    CHECK(never_arr.capacity() == 100);
+
+    explicit_arr.shrink_to_fit();
+    never_arr.shrink_to_fit();
+    CHECK(explicit_arr.capacity() == 1);
+    CHECK(never_arr.capacity() == 100);
+}
+
+TEST_CASE("Test shrink_to never drops below the size") {
+    DynamicArray<std::string> arr = {"a", "b", "c"};
+    arr.reserve(50);
+
+    arr.shrink_to(60);
+    CHECK(arr.capacity() == 50);
+    arr.shrink_to(1);
+    CHECK(arr.capacity() == 3);
+    CHECK(arr == DynamicArray<std::string>{"a", "b", "c"});
+
+    arr.clear();
+    arr.reserve(4);
+    arr.shrink_to_fit();
+    CHECK(arr.capacity() == 0);
+    arr.push_back("again");
+    CHECK(arr.front() == "again");
+}
+
+TEST_CASE("Test three-way comparison") {
+    CHECK((DynamicArray<int>{1, 2, 3} <=> DynamicArray<int>{1, 2, 4}) == std::strong_ordering::less);
+    CHECK((DynamicArray<int>{1, 2} <=> DynamicArray<int>{1, 2, 0}) == std::strong_ordering::less);
+    CHECK((DynamicArray<std::string>{"b"} <=> DynamicArray<std::string>{"a"}) == std::strong_ordering::greater);
+
+    // Floating point orders partially, NaN included
+    static_assert(std::is_same_v<decltype(DynamicArray<double>() <=> DynamicArray<double>()), std::partial_ordering>);
+    CHECK((DynamicArray<double>{1.0} <=> DynamicArray<double>{2.0}) == std::partial_ordering::less);
+    CHECK((DynamicArray<float>{1.0f, 2.5f} <=> DynamicArray<float>{1.0f, 2.5f}) == std::partial_ordering::equivalent);
+    CHECK((DynamicArray<double>{0.0, std::nan("")} <=> DynamicArray<double>{0.0, 1.0}) == std::partial_ordering::unordered);
+    CHECK(DynamicArray<double>{3.0} > DynamicArray<double>{-1.0});
+
+    DynamicArray<float> long_values;
+    long_values.resize(100, 1.0f);
+    DynamicArray<float> other = long_values;
+    other[97] = 2.0f;
+    CHECK((long_values <=> other) == std::partial_ordering::less);
+}
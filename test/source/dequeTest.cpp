@@ -0,0 +1,224 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/deque.h>
+#include <algorithmCollection/allocators/arenaAllocator.h>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE("Test deque push and pop at both ends") {
+    Deque<int> deque;
+    CHECK(deque.empty());
+    CHECK(deque.begin() == deque.end());
+    CHECK_THROWS_AS(deque.front(), std::out_of_range);
+    CHECK_THROWS_AS(deque.pop_back(), std::logic_error);
+    CHECK_THROWS_AS(deque.pop_front(), std::logic_error);
+
+    for (int i = 0; i < 5000; ++i) {
+        deque.push_back(i);
+        deque.push_front(-i - 1);
+    }
+    CHECK(deque.size() == 10000);
+    CHECK(deque.front() == -5000);
+    CHECK(deque.back() == 4999);
+    for (int i = 0; i < 10000; ++i) {
+        REQUIRE(deque[i] == i - 5000);
+    }
+    CHECK(deque.at(5000) == 0);
+    CHECK_THROWS_AS(deque.at(10000), std::out_of_range);
+
+    for (int i = 0; i < 4000; ++i) {
+        deque.pop_front();
+        deque.pop_back();
+    }
+    CHECK(deque.size() == 2000);
+    CHECK(deque.front() == -1000);
+    CHECK(deque.back() == 999);
+
+    deque.clear();
+    CHECK(deque.empty());
+    deque.push_front(3);
+    CHECK(deque.front() == 3);
+    CHECK(deque.back() == 3);
+}
+
+TEST_CASE("Test deque keeps references on end insertion") {
+    Deque<std::string> deque = {"a", "b", "c"};
+    std::string& first = deque.front();
+    std::string& last = deque.back();
+    for (int i = 0; i < 10000; ++i) {
+        deque.push_back(std::to_string(i));
+        deque.emplace_front(i, 'x');
+    }
+    CHECK(first == "a");
+    CHECK(last == "c");
+    CHECK(&deque[10000] == &first);
+}
+
+TEST_CASE("Test deque iterators stay valid when popping releases a block") {
+    Deque<int> deque;
+    const int count = static_cast<int>(Deque<int>::block_size) * 3;
+    for (int i = 0; i < count; ++i) {
+        deque.push_back(i);
+    }
+    auto middle = deque.begin() + count / 2;
+    auto last = deque.end() - 1;
+    auto end = deque.end();
+
+    // Empties the first block, which shifts the index of every other block
+    for (std::size_t i = 0; i < Deque<int>::block_size; ++i) {
+        deque.pop_front();
+    }
+    CHECK(*middle == count / 2);
+    CHECK(*last == count - 1);
+    CHECK(end == deque.end());
+    CHECK(middle - deque.begin() == count / 2 - static_cast<int>(Deque<int>::block_size));
+    CHECK(*(middle + 1) == count / 2 + 1);
+    CHECK(*--middle == count / 2 - 1);
+    CHECK(std::distance(middle, deque.end()) == count - count / 2 + 1);
+    CHECK(middle < last);
+
+    int next = static_cast<int>(Deque<int>::block_size);
+    for (auto it = deque.begin(); it != end; ++it) {
+        REQUIRE(*it == next++);
+    }
+    CHECK(next == count);
+}
+
+TEST_CASE("Test deque iterators") {
+    Deque<int> deque;
+    for (int i = 0; i < 3000; ++i) {
+        deque.push_back(i);
+    }
+    deque.pop_front();
+
+    CHECK(std::distance(deque.begin(), deque.end()) == 2999);
+    CHECK(deque.end() - deque.begin() == 2999);
+    CHECK(*(deque.begin() + 1500) == 1501);
+    CHECK(deque.begin()[2000] == 2001);
+    CHECK(*(deque.end() - 1) == 2999);
+    CHECK(*(deque.end() - 2999) == 1);
+    CHECK(deque.begin() < deque.end());
+    CHECK(std::is_sorted(deque.begin(), deque.end()));
+    CHECK(*std::lower_bound(deque.begin(), deque.end(), 1024) == 1024);
+
+    int expected = 2999;
+    for (auto it = deque.rbegin(); it != deque.rend(); ++it) {
+        REQUIRE(*it == expected--);
+    }
+    CHECK(expected == 0);
+
+    // A deque ending exactly on a block boundary
+    Deque<int> full;
+    for (std::size_t i = 0; i < 2 * Deque<int>::block_size; ++i) {
+        full.push_back(static_cast<int>(i));
+    }
+    auto it = full.begin();
+    for (std::size_t i = 0; i < full.size(); ++i) {
+        ++it;
+    }
+    CHECK(it == full.end());
+    CHECK(*--it == static_cast<int>(full.size() - 1));
+    CHECK(full.begin() + static_cast<std::ptrdiff_t>(full.size()) == full.end());
+
+    std::sort(deque.begin(), deque.end(), std::greater<>());
+    CHECK(deque.front() == 2999);
+    Deque<int>::const_iterator constant = deque.begin();
+    CHECK(*constant == 2999);
+}
+
+TEST_CASE("Test deque matches std::deque under random operations") {
+    Deque<std::unique_ptr<int>, SimpleAllocator<std::unique_ptr<int>>, 64> deque;
+    std::deque<int> reference;
+    std::mt19937 rng(5);
+
+    for (int step = 0; step < 50000; ++step) {
+        switch (rng() % 6) {
+        case 0:
+        case 1:
+            deque.push_back(std::make_unique<int>(step));
+            reference.push_back(step);
+            break;
+        case 2:
+        case 3:
+            deque.emplace_front(std::make_unique<int>(step));
+            reference.push_front(step);
+            break;
+        case 4:
+            if (!reference.empty()) {
+                CHECK(*deque.back() == reference.back());
+                deque.pop_back();
+                reference.pop_back();
+            }
+            break;
+        default:
+            if (!reference.empty()) {
+                CHECK(*deque.front() == reference.front());
+                deque.pop_front();
+                reference.pop_front();
+            }
+        }
+        REQUIRE(deque.size() == reference.size());
+    }
+    for (std::size_t i = 0; i < reference.size(); ++i) {
+        REQUIRE(*deque[i] == reference[i]);
+    }
+}
+
+TEST_CASE("Test deque used as a queue stops allocating") {
+    ArenaResource arena;
+    Deque<int, MonotonicArenaAllocator<int>> deque{MonotonicArenaAllocator<int>(arena)};
+    for (int i = 0; i < 100; ++i) {
+        deque.push_back(i);
+    }
+
+    // Warm up so the map and the spare block exist, then cycle many blocks through the queue
+    for (std::size_t i = 0; i < 4 * Deque<int>::block_size; ++i) {
+        deque.push_back(static_cast<int>(i));
+        deque.pop_front();
+    }
+    const std::size_t allocated = arena.bytes_allocated();
+    for (std::size_t i = 0; i < 100 * Deque<int>::block_size; ++i) {
+        deque.push_back(static_cast<int>(i));
+        deque.pop_front();
+    }
+    CHECK(arena.bytes_allocated() == allocated);
+    CHECK(deque.size() == 100);
+}
+
+TEST_CASE("Test deque copy, move, resize and compare") {
+    Deque<std::string> deque(3, "x");
+    CHECK(deque.size() == 3);
+    deque.resize(5);
+    CHECK(deque[4].empty());
+    deque.resize(2);
+    CHECK(deque.size() == 2);
+
+    Deque<std::string> copy(deque);
+    CHECK(copy == deque);
+    copy.push_front("a");
+    CHECK(copy != deque);
+    CHECK(copy < deque);
+
+    Deque<std::string> moved(std::move(copy));
+    CHECK(copy.empty());
+    CHECK(moved.size() == 3);
+    copy = moved;
+    CHECK(copy == moved);
+    moved = std::move(deque);
+    CHECK(moved.size() == 2);
+    swap(moved, copy);
+    CHECK(moved.size() == 3);
+    moved.shrink_to_fit();
+    CHECK(moved.front() == "a");
+    moved.clear();
+    moved.shrink_to_fit();
+    moved.push_back("again");
+    CHECK(moved.back() == "again");
+
+    copy = {"p", "q"};
+    CHECK(copy.size() == 2);
+    CHECK(copy.back() == "q");
+}
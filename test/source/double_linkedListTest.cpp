@@ -240,3 +240,263 @@ TEST_CASE("Test inserting elements from a range of iterators at the specified in
         ++idx;
     }
 }
+
+TEST_CASE("Test node layout holds only the links and the element") {
+    struct Links {
+        void* next;
+        void* prev;
+    };
+    struct Expected : Links {
+        double data;
+    };
+
+    CHECK(sizeof(DoubleLinkedList<double>::node_type) == sizeof(Expected));
+    CHECK(sizeof(DoubleLinkedList<int>::node_type) <= 3 * sizeof(void*));
+}
+
+TEST_CASE("Test emplace constructs elements in place") {
+    DoubleLinkedList<std::pair<int, int>> list;
+
+    list.emplace_back(1, 2);
+    list.emplace_front(0, 1);
+    auto it = list.emplace(list.cend(), 2, 3);
+
+    CHECK(list.size() == 3);
+    CHECK(it->first == 2);
+    CHECK(list.front().data == std::pair<int, int>(0, 1));
+    CHECK(list.back().data == std::pair<int, int>(2, 3));
+}
+
+TEST_CASE("Test erase and pop keep the list linked") {
+    DoubleLinkedList<int> list = {1, 2, 3, 4, 5};
+
+    auto it = list.cbegin();
+    ++it;
+    auto next = list.erase(it);
+    CHECK(*next == 3);
+    CHECK(list.size() == 4);
+
+    list.pop_front();
+    list.pop_back();
+    CHECK(list.front().data == 3);
+    CHECK(list.back().data == 4);
+
+    list.erase(list.cbegin(), list.cend());
+    CHECK(list.empty());
+    CHECK(list.begin() == list.end());
+    CHECK_THROWS_AS(list.erase(list.cend()), std::out_of_range);
+    CHECK_THROWS_AS(list.front(), std::out_of_range);
+}
+
+TEST_CASE("Test reverse iteration and decrementing end") {
+    DoubleLinkedList<int> list = {1, 2, 3};
+
+    DynamicArray<int> reversed;
+    for (auto it = list.rbegin(); it != list.rend(); ++it) {
+        reversed.push_back(*it);
+    }
+    CHECK(reversed == DynamicArray<int>{3, 2, 1});
+
+    auto last = list.end();
+    --last;
+    CHECK(*last == 3);
+}
+
+TEST_CASE("Test moving a list relinks its sentinel") {
+    DoubleLinkedList<int> list = {1, 2, 3};
+    DoubleLinkedList<int> moved(std::move(list));
+
+    CHECK(list.empty());
+    CHECK(moved.size() == 3);
+    CHECK(moved.back().data == 3);
+
+    list = std::move(moved);
+    CHECK(list.size() == 3);
+    CHECK(moved.empty());
+    list.push_back(4);
+    CHECK(list.back().data == 4);
+    CHECK(*(--list.end()) == 4);
+}
+
+namespace {
+    template <typename T, typename Alloc>
+    DynamicArray<T> to_array(const DoubleLinkedList<T, Alloc>& list) {
+        DynamicArray<T> result;
+        for (const auto& value : list) {
+            result.push_back(value);
+        }
+        return result;
+    }
+
+    // Records each node's element address so tests can check operations relink instead of copying
+    template <typename T, typename Alloc>
+    DynamicArray<const T*> addresses(const DoubleLinkedList<T, Alloc>& list) {
+        DynamicArray<const T*> result;
+        for (const auto& value : list) {
+            result.push_back(&value);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("Test sort relinks nodes in ascending order") {
+    DoubleLinkedList<int> list = {5, 3, 9, 1, 7, 2, 8, 6, 4, 0};
+    const int* nine = &*std::next(list.begin(), 2);
+
+    list.sort();
+    CHECK(to_array(list) == DynamicArray<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    CHECK(&*std::next(list.begin(), 9) == nine);
+    CHECK(*(--list.end()) == 9);
+    CHECK(list.size() == 10);
+
+    list.sort(std::greater<>());
+    CHECK(to_array(list) == DynamicArray<int>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+
+    SUBCASE("Large input matches std::sort") {
+        DoubleLinkedList<int> big;
+        DynamicArray<int> expected;
+        unsigned seed = 12345;
+        for (int i = 0; i < 5000; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            int value = static_cast<int>(seed >> 16) % 1000;
+            big.push_back(value);
+            expected.push_back(value);
+        }
+        big.sort();
+        std::sort(expected.begin(), expected.end());
+        CHECK(to_array(big) == expected);
+    }
+}
+
+TEST_CASE("Test sort is stable") {
+    DoubleLinkedList<std::pair<int, int>> list;
+    for (int i = 0; i < 100; ++i) {
+        list.emplace_back(i % 3, i);
+    }
+
+    list.sort([](const auto& a, const auto& b) { return a.first < b.first; });
+
+    auto it = list.begin();
+    for (auto next = std::next(it); next != list.end(); ++it, ++next) {
+        CHECK(it->first <= next->first);
+        if (it->first == next->first) {
+            CHECK(it->second < next->second);
+        }
+    }
+}
+
+TEST_CASE("Test merge of sorted lists moves nodes") {
+    DoubleLinkedList<int> a = {1, 3, 5, 7};
+    DoubleLinkedList<int> b = {0, 2, 3, 8, 9};
+    auto moved = addresses(b);
+
+    a.merge(b);
+    CHECK(b.empty());
+    CHECK(b.begin() == b.end());
+    CHECK(a.size() == 9);
+    CHECK(to_array(a) == DynamicArray<int>{0, 1, 2, 3, 3, 5, 7, 8, 9});
+    CHECK(&a.front().data == moved[0]);
+    CHECK(&a.back().data == moved[4]);
+
+    a.merge(DoubleLinkedList<int>{4, 6}, std::less<>());
+    CHECK(to_array(a) == DynamicArray<int>{0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9});
+}
+
+TEST_CASE("Test splice of whole lists, single elements and ranges") {
+    DoubleLinkedList<int> list = {1, 2, 3};
+    DoubleLinkedList<int> other = {10, 20, 30};
+    auto other_nodes = addresses(other);
+
+    SUBCASE("Whole list") {
+        list.splice(std::next(list.cbegin()), other);
+        CHECK(other.empty());
+        CHECK(list.size() == 6);
+        CHECK(to_array(list) == DynamicArray<int>{1, 10, 20, 30, 2, 3});
+        CHECK(&*std::next(list.begin()) == other_nodes[0]);
+    }
+
+    SUBCASE("Single element") {
+        list.splice(list.cend(), other, std::next(other.cbegin()));
+        CHECK(to_array(list) == DynamicArray<int>{1, 2, 3, 20});
+        CHECK(to_array(other) == DynamicArray<int>{10, 30});
+        CHECK(&list.back().data == other_nodes[1]);
+    }
+
+    SUBCASE("Range") {
+        list.splice(list.cbegin(), other, other.cbegin(), std::prev(other.cend()));
+        CHECK(to_array(list) == DynamicArray<int>{10, 20, 1, 2, 3});
+        CHECK(to_array(other) == DynamicArray<int>{30});
+        CHECK(list.size() == 5);
+        CHECK(other.size() == 1);
+    }
+
+    SUBCASE("Within one list") {
+        list.splice(list.cbegin(), list, std::prev(list.cend()));
+        CHECK(to_array(list) == DynamicArray<int>{3, 1, 2});
+        list.splice(list.cend(), list, list.cbegin(), std::next(list.cbegin(), 2));
+        CHECK(to_array(list) == DynamicArray<int>{2, 3, 1});
+        CHECK(list.size() == 3);
+    }
+}
+
+TEST_CASE("Test splice rejects lists with different allocators") {
+    PoolResource first, second;
+    using List = DoubleLinkedList<int, PoolAllocator<int>>;
+    List a{PoolAllocator<int>(first)};
+    List b{PoolAllocator<int>(second)};
+    b.push_back(1);
+
+    CHECK_THROWS_AS(a.splice(a.cend(), b), std::invalid_argument);
+    CHECK(b.size() == 1);
+}
+
+TEST_CASE("Test reverse, swap, resize and assign") {
+    DoubleLinkedList<int> list = {1, 2, 3, 4};
+
+    list.reverse();
+    CHECK(to_array(list) == DynamicArray<int>{4, 3, 2, 1});
+    CHECK(*(--list.end()) == 1);
+
+    DoubleLinkedList<int> other = {7};
+    list.swap(other);
+    CHECK(to_array(list) == DynamicArray<int>{7});
+    CHECK(to_array(other) == DynamicArray<int>{4, 3, 2, 1});
+
+    DoubleLinkedList<int> empty;
+    swap(empty, list);
+    CHECK(list.empty());
+    CHECK(list.begin() == list.end());
+    CHECK(empty.back().data == 7);
+
+    other.resize(2);
+    CHECK(to_array(other) == DynamicArray<int>{4, 3});
+    other.resize(4, 9);
+    CHECK(to_array(other) == DynamicArray<int>{4, 3, 9, 9});
+    other.resize(5);
+    CHECK(other.back().data == 0);
+
+    auto nodes = addresses(other);
+    other.assign({1, 2});
+    CHECK(to_array(other) == DynamicArray<int>{1, 2});
+    CHECK(&other.front().data == nodes[0]);
+    other.assign(3, 5);
+    CHECK(to_array(other) == DynamicArray<int>{5, 5, 5});
+
+    DoubleLinkedList<int> sized(3);
+    CHECK(to_array(sized) == DynamicArray<int>{0, 0, 0});
+}
+
+TEST_CASE("Test remove, remove_if and unique") {
+    DoubleLinkedList<int> list = {1, 2, 2, 3, 1, 1, 4, 2};
+
+    CHECK(list.unique() == 2);
+    CHECK(to_array(list) == DynamicArray<int>{1, 2, 3, 1, 4, 2});
+
+    // The value may refer to an element of the list itself
+    CHECK(list.remove(list.front().data) == 2);
+    CHECK(to_array(list) == DynamicArray<int>{2, 3, 4, 2});
+
+    CHECK(list.remove_if([](int value) { return value % 2 == 0; }) == 3);
+    CHECK(to_array(list) == DynamicArray<int>{3});
+    CHECK(list.size() == 1);
+}
@@ -0,0 +1,267 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/fixedArray.h>
+#include <algorithmCollection/allocators/arenaAllocator.h>
+#include <algorithmCollection/allocators/polymorphicAllocator.h>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace {
+    // Squares table computed entirely at compile time
+    constexpr FixedArray<int, 8> make_squares() {
+        FixedArray<int, 8> table;
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            table[i] = static_cast<int>(i * i);
+        }
+        return table;
+    }
+
+    constexpr int sum_after_swap() {
+        FixedArray<int, 3> a = {1, 2, 3};
+        FixedArray<int, 3> b;
+        b.fill(10);
+        a.swap(b);
+        int sum = 0;
+        for (int value : a) {
+            sum += value;
+        }
+        return sum + b.back();
+    }
+}
+
+static_assert(make_squares()[7] == 49);
+static_assert(make_squares().front() == 0);
+static_assert(FixedArray<int, 4>{1, 2} == FixedArray<int, 4>{1, 2, 0, 0});
+static_assert(sum_after_swap() == 33);
+static_assert(std::tuple_size_v<FixedArray<int, 5>> == 5);
+static_assert(std::is_same_v<std::tuple_element_t<2, FixedArray<double, 3>>, double>);
+static_assert(get<3>(make_squares()) == 9);
+
+static_assert(std::is_trivially_copyable_v<FixedArray<int, 16>>);
+static_assert(std::is_trivially_copyable_v<FixedArray<double, 3>>);
+static_assert(!std::is_trivially_copyable_v<FixedArray<std::string, 3>>);
+static_assert(!std::is_trivially_copyable_v<HeapFixedArray<int, 16>>);
+static_assert(sizeof(FixedArray<int, 16>) == sizeof(int) * 16);
+static_assert(std::is_nothrow_move_constructible_v<FixedArray<std::string, 4>>);
+static_assert(std::is_nothrow_move_assignable_v<FixedArray<std::string, 4>>);
+static_assert(std::is_nothrow_move_constructible_v<HeapFixedArray<std::string, 4>>);
+static_assert(std::is_nothrow_move_assignable_v<HeapFixedArray<std::string, 4>>);
+
+namespace {
+    // Reflected CRC-32 lookup table, built by the compiler
+    constexpr auto crc32_table = make_table<256>([](std::size_t i) {
+        auto crc = static_cast<std::uint32_t>(i);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+        return crc;
+    });
+
+    constexpr auto ramp = make_table<100>([](std::size_t i) { return static_cast<int>(i); });
+    constexpr auto halves = make_table<100>([](std::size_t i) { return static_cast<double>(i) / 2.0 + 0.1; });
+}
+
+static_assert(std::is_same_v<std::remove_cv_t<decltype(crc32_table)>, FixedArray<std::uint32_t, 256>>);
+static_assert(crc32_table[1] == 0x77073096u);
+static_assert(crc32_table[255] == 0x2D02EF8Du);
+
+static_assert(FixedArray<int, 3>{1, 2, 3} + FixedArray<int, 3>{10, 20, 30} == FixedArray<int, 3>{11, 22, 33});
+static_assert(FixedArray<int, 3>{1, 2, 3} * 2 == FixedArray<int, 3>{2, 4, 6});
+static_assert(10 - FixedArray<int, 3>{1, 2, 3} == FixedArray<int, 3>{9, 8, 7});
+static_assert(-FixedArray<int, 2>{1, -2} == FixedArray<int, 2>{-1, 2});
+static_assert(sum(FixedArray<int, 4>{1, 2, 3, 4}) == 10);
+static_assert(sum(ramp) == 4950);
+static_assert(dot(ramp, ramp) == 328350);
+static_assert(dot(FixedArray<int, 3>{1, 2, 3}, FixedArray<int, 3>{4, 5, 6}) == 32);
+static_assert(reduce(ramp, 1, [](int lhs, int rhs) { return lhs > rhs ? lhs : rhs; }) == 99);
+static_assert(min_max(FixedArray<int, 4>{3, -1, 7, 2}) == std::pair(-1, 7));
+static_assert(sum(FixedArray<int, 0>()) == 0);
+
+TEST_CASE("Test fixed array default construction value-initializes every element") {
+    FixedArray<int, 4> inline_array;
+    HeapFixedArray<int, 4> heap_array;
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        CHECK(inline_array[i] == 0);
+        CHECK(heap_array[i] == 0);
+    }
+}
+
+TEST_CASE("Test fixed array initializer list fills the front and rejects too many values") {
+    FixedArray<std::string, 3> array = {"a", "b"};
+    CHECK(array[0] == "a");
+    CHECK(array[1] == "b");
+    CHECK(array[2].empty());
+
+    CHECK_THROWS_AS((FixedArray<int, 2>{1, 2, 3}), std::invalid_argument);
+    CHECK_THROWS_AS((HeapFixedArray<int, 2>{1, 2, 3}), std::invalid_argument);
+}
+
+TEST_CASE("Test fixed array checked access throws outside the array") {
+    FixedArray<int, 3> array = {1, 2, 3};
+    const auto& view = array;
+
+    CHECK(array.at(2) == 3);
+    CHECK(view.at(0) == 1);
+    CHECK_THROWS_AS(array.at(3), std::out_of_range);
+    CHECK_THROWS_AS(view.at(3), std::out_of_range);
+
+    FixedArray<int, 0> empty;
+    CHECK(empty.empty());
+    CHECK(empty.begin() == empty.end());
+    CHECK_THROWS_AS(empty.front(), std::logic_error);
+    CHECK_THROWS_AS(empty.back(), std::logic_error);
+}
+
+TEST_CASE("Test fixed array structured bindings") {
+    FixedArray<std::string, 3> names = {"x", "y", "z"};
+
+    auto& [first, second, third] = names;
+    CHECK(first == "x");
+    CHECK(third == "z");
+    second = "changed";
+    CHECK(names[1] == "changed");
+
+    const auto [a, b, c] = FixedArray<int, 3>{4, 5, 6};
+    CHECK(a + b + c == 15);
+
+    std::string moved = get<0>(std::move(names));
+    CHECK(moved == "x");
+}
+
+TEST_CASE("Test fixed array copies are independent of the source") {
+    FixedArray<std::string, 2> inline_array = {"left", "right"};
+    auto inline_copy = inline_array;
+    inline_copy[0] = "other";
+    CHECK(inline_array[0] == "left");
+
+    HeapFixedArray<std::string, 2> heap_array = {"left", "right"};
+    auto heap_copy = heap_array;
+    CHECK(heap_copy == heap_array);
+    heap_copy[0] = "other";
+    CHECK(heap_array[0] == "left");
+    heap_array = heap_copy;
+    CHECK(heap_array[0] == "other");
+}
+
+TEST_CASE("Test fixed array moves do not copy elements") {
+    FixedArray<std::string, 2> inline_array = {"left", "right"};
+    FixedArray<std::string, 2> inline_moved = std::move(inline_array);
+    CHECK(inline_moved[1] == "right");
+    CHECK(inline_array[1].empty());
+    inline_array = std::move(inline_moved);
+    CHECK(inline_array[0] == "left");
+    CHECK(inline_moved[0].empty());
+
+    // The buffer changes hands: moved-from arrays can be assigned to again
+    HeapFixedArray<std::string, 2> heap_array = {"left", "right"};
+    const std::string* buffer = heap_array.begin();
+    HeapFixedArray<std::string, 2> heap_moved = std::move(heap_array);
+    CHECK(heap_moved.begin() == buffer);
+    heap_array = heap_moved;
+    CHECK(heap_array[1] == "right");
+    CHECK(heap_array.begin() != buffer);
+
+    HeapFixedArray<std::string, 2> target = {"up", "down"};
+    target = std::move(heap_moved);
+    CHECK(target.begin() == buffer);
+    CHECK(target[0] == "left");
+    heap_moved = std::move(target);
+    CHECK(heap_moved[1] == "right");
+
+    // Allocators that neither propagate nor compare equal keep their buffers and move the elements
+    std::pmr::monotonic_buffer_resource first_resource;
+    std::pmr::monotonic_buffer_resource second_resource;
+    using PmrArray = FixedArray<std::string, 2, PolymorphicAllocator<std::string>>;
+    PmrArray first(&first_resource);
+    first[0] = "a string too long for the small string buffer";
+    PmrArray second(&second_resource);
+    const std::string* second_buffer = second.begin();
+    second = std::move(first);
+    CHECK(second.begin() == second_buffer);
+    CHECK(second[0] == "a string too long for the small string buffer");
+}
+
+TEST_CASE("Test fixed array swap exchanges contents in both storage modes") {
+    FixedArray<int, 3> a = {1, 2, 3};
+    FixedArray<int, 3> b = {4, 5, 6};
+    swap(a, b);
+    CHECK(a == FixedArray<int, 3>{4, 5, 6});
+    CHECK(b == FixedArray<int, 3>{1, 2, 3});
+
+    HeapFixedArray<int, 3> c = {1, 2, 3};
+    HeapFixedArray<int, 3> d = {4, 5, 6};
+    const int* c_data = c.begin();
+    c.swap(d);
+    CHECK(d.begin() == c_data);
+    CHECK(c == HeapFixedArray<int, 3>{4, 5, 6});
+}
+
+TEST_CASE("Test fixed array heap storage uses the given allocator") {
+    ArenaResource arena(1024);
+    using Array = FixedArray<int, 16, MonotonicArenaAllocator<int>>;
+    {
+        Array array(MonotonicArenaAllocator<int>{arena});
+        CHECK(array[15] == 0);
+        CHECK(arena.bytes_allocated() >= sizeof(int) * 16);
+    }
+}
+
+TEST_CASE("Test fixed array element-wise arithmetic") {
+    FixedArray<double, 40> a;
+    FixedArray<double, 40> b;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<double>(i);
+        b[i] = 2.0;
+    }
+
+    const auto c = (a + b) * b - a / b;
+    for (std::size_t i = 0; i < c.size(); ++i) {
+        CHECK(c[i] == (a[i] + 2.0) * 2.0 - a[i] / 2.0);
+    }
+
+    a += 1.0;
+    CHECK(a[39] == 40.0);
+    a -= b;
+    a *= b;
+    a /= 4.0;
+    CHECK(a[3] == 1.0);
+    CHECK((1.0 / b)[0] == 0.5);
+
+    HeapFixedArray<int, 32> heap;
+    heap.fill(3);
+    const HeapFixedArray<int, 32> doubled = heap + heap;
+    CHECK(doubled[31] == 6);
+    CHECK(heap[31] == 3);
+    CHECK(sum(doubled) == 192);
+
+    FixedArray<std::string, 2> words = {"fixed", "array"};
+    words += std::string("!");
+    CHECK(words[1] == "array!");
+    static_assert(!std::is_invocable_v<std::multiplies<>, FixedArray<std::string, 2>, FixedArray<std::string, 2>>);
+}
+
+TEST_CASE("Test fixed array reductions match between compile time and run time") {
+    // The summation order depends on the size only, so floating point results are identical
+    constexpr double compile_time_sum = sum(halves);
+    constexpr double compile_time_dot = dot(halves, halves);
+    FixedArray<double, 100> runtime = halves;
+    CHECK(sum(runtime) == compile_time_sum);
+    CHECK(dot(runtime, runtime) == compile_time_dot);
+    CHECK(sum(runtime) > 2484.999);
+    CHECK(sum(runtime) < 2485.001);
+
+    CHECK(min_max(runtime) == std::pair(0.1, 49.6));
+    CHECK(min_max(FixedArray<std::string, 3>{"b", "a", "c"}) == std::pair<std::string, std::string>("a", "c"));
+    CHECK_THROWS_AS(min_max(FixedArray<int, 0>()), std::logic_error);
+
+    FixedArray<int, 17> odd;
+    odd.fill(1);
+    odd.back() = 100;
+    CHECK(sum(odd) == 116);
+    CHECK(reduce(odd, 0, [](int lhs, int rhs) { return lhs > rhs ? lhs : rhs; }) == 100);
+}
@@ -0,0 +1,243 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/graph.h>
+#include <algorithmCollection/algorithms/threadPool.h>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    using UnweightedGraph = Graph<>;
+    using WeightedGraph = Graph<std::uint32_t>;
+
+    DynamicArray<Edge<>> random_edges(std::size_t vertices, std::size_t edges, unsigned seed) {
+        std::mt19937 rng(seed);
+        DynamicArray<Edge<>> list;
+        for (std::size_t i = 0; i < edges; ++i) {
+            list.push_back(Edge<>{static_cast<std::uint32_t>(rng() % vertices), static_cast<std::uint32_t>(rng() % vertices)});
+        }
+        return list;
+    }
+
+    // Depths by a plain queue BFS over out-arcs
+    std::vector<long> reference_depths(const UnweightedGraph& graph, std::uint32_t source) {
+        std::vector<long> depth(graph.vertex_count(), -1);
+        std::queue<std::uint32_t> queue;
+        depth[source] = 0;
+        queue.push(source);
+        while (!queue.empty()) {
+            const std::uint32_t u = queue.front();
+            queue.pop();
+            for (std::uint32_t v : graph.neighbors(u)) {
+                if (depth[v] < 0) {
+                    depth[v] = depth[u] + 1;
+                    queue.push(v);
+                }
+            }
+        }
+        return depth;
+    }
+
+    // Checks that parent is a BFS tree: every reached vertex hangs off an arc from one level up
+    void check_bfs_tree(const UnweightedGraph& graph, std::uint32_t source, const DynamicArray<std::uint32_t>& parent) {
+        const std::vector<long> depth = reference_depths(graph, source);
+        REQUIRE(parent.size() == graph.vertex_count());
+        REQUIRE(parent[source] == source);
+        for (std::uint32_t v = 0; v < graph.vertex_count(); ++v) {
+            if (depth[v] < 0) {
+                REQUIRE(parent[v] == UnweightedGraph::no_vertex);
+                continue;
+            }
+            if (v == source) {
+                continue;
+            }
+            const std::uint32_t p = parent[v];
+            REQUIRE(p != UnweightedGraph::no_vertex);
+            REQUIRE(depth[p] == depth[v] - 1);
+            bool has_arc = false;
+            for (std::uint32_t w : graph.neighbors(p)) {
+                has_arc = has_arc || w == v;
+            }
+            REQUIRE(has_arc);
+        }
+    }
+}
+
+TEST_CASE("Test graph CSR layout") {
+    DynamicArray<Edge<>> edges{{0, 1}, {0, 2}, {2, 1}, {3, 3}};
+    UnweightedGraph directed(5, edges);
+    CHECK(directed.vertex_count() == 5);
+    CHECK(directed.edge_count() == 4);
+    CHECK(directed.arc_count() == 4);
+    CHECK(directed.out_degree(0) == 2);
+    CHECK(directed.neighbors(0)[0] == 1);
+    CHECK(directed.neighbors(0)[1] == 2);
+    CHECK(directed.neighbors(1).empty());
+    CHECK(directed.neighbors(4).empty());
+    CHECK_FALSE(directed.has_in_edges());
+    CHECK_THROWS_AS(directed.in_neighbors(1), std::logic_error);
+    CHECK(directed.offsets().size() == 6);
+
+    UnweightedGraph undirected(5, edges, GraphKind::Undirected);
+    CHECK(undirected.arc_count() == 7);
+    CHECK(undirected.out_degree(1) == 2);
+    CHECK(undirected.out_degree(3) == 1);
+    CHECK(undirected.in_degree(2) == 2);
+
+    UnweightedGraph bidirectional(5, edges, GraphKind::Bidirectional);
+    CHECK(bidirectional.arc_count() == 4);
+    CHECK(bidirectional.in_degree(1) == 2);
+    CHECK(bidirectional.in_neighbors(1)[0] == 0);
+    CHECK(bidirectional.in_neighbors(1)[1] == 2);
+    CHECK(bidirectional.in_degree(0) == 0);
+
+    CHECK_THROWS_AS(UnweightedGraph(3, edges), std::out_of_range);
+    CHECK(UnweightedGraph().vertex_count() == 0);
+}
+
+TEST_CASE("Test graph weights follow their arcs") {
+    DynamicArray<Edge<std::uint32_t>> edges{{0, 1, 5}, {1, 2, 7}, {0, 2, 9}};
+    WeightedGraph graph(3, edges, GraphKind::Undirected);
+    CHECK(graph.weights(0)[0] == 5);
+    CHECK(graph.weights(0)[1] == 9);
+    CHECK(graph.neighbors(2)[0] == 1);
+    CHECK(graph.weights(2)[0] == 7);
+    CHECK(graph.in_weights(2)[1] == 9);
+}
+
+TEST_CASE("Test adjacency graph mutation and freezing") {
+    AdjacencyGraph<std::uint32_t> adjacency(2);
+    const std::uint32_t c = adjacency.add_vertex();
+    CHECK(c == 2);
+    adjacency.add_edge(0, 1, 4);
+    adjacency.add_edge(0, 2, 1);
+    adjacency.add_edge(2, 1, 2);
+    adjacency.add_edge(1, 0, 8);
+    CHECK(adjacency.edge_count() == 4);
+    CHECK(adjacency.contains_edge(0, 2));
+    CHECK_FALSE(adjacency.contains_edge(2, 0));
+    CHECK(adjacency.remove_edge(0, 1));
+    CHECK_FALSE(adjacency.remove_edge(0, 1));
+    CHECK(adjacency.out_degree(0) == 1);
+    CHECK(adjacency.weights(0)[0] == 1);
+    CHECK_THROWS_AS(adjacency.add_edge(0, 7, 1), std::out_of_range);
+    CHECK_THROWS_AS(adjacency.neighbors(9), std::out_of_range);
+
+    WeightedGraph graph(adjacency);
+    CHECK(graph.vertex_count() == 3);
+    CHECK(graph.edge_count() == 3);
+    auto distance = dijkstra(graph, std::uint32_t{0});
+    CHECK(distance[0] == 0);
+    CHECK(distance[2] == 1);
+    CHECK(distance[1] == 3);
+
+    AdjacencyGraph<> unweighted(3);
+    unweighted.add_edge(0, 1);
+    unweighted.add_edge(1, 2);
+    UnweightedGraph path(unweighted, GraphKind::Undirected);
+    auto parent = bfs(path, std::uint32_t{2});
+    CHECK(parent[0] == 1);
+    CHECK(parent[1] == 2);
+}
+
+TEST_CASE("Test bfs trees") {
+    ThreadPool pool(3);
+    // Sparse graphs stay top-down, the dense ones switch to bottom-up steps
+    for (std::size_t degree : {1, 3, 40}) {
+        const std::size_t vertices = 3000;
+        const DynamicArray<Edge<>> edges = random_edges(vertices, vertices * degree, static_cast<unsigned>(degree));
+        for (GraphKind kind : {GraphKind::Directed, GraphKind::Undirected, GraphKind::Bidirectional}) {
+            UnweightedGraph graph(vertices, edges, kind);
+            for (std::uint32_t source : {0u, 17u, 2999u}) {
+                check_bfs_tree(graph, source, bfs(graph, source));
+                check_bfs_tree(graph, source, bfs(graph, source, &pool));
+            }
+        }
+    }
+    UnweightedGraph graph(4, DynamicArray<Edge<>>{});
+    auto parent = bfs(graph, std::uint32_t{1});
+    CHECK(parent[1] == 1);
+    CHECK(parent[0] == UnweightedGraph::no_vertex);
+    CHECK_THROWS_AS(bfs(graph, std::uint32_t{4}), std::out_of_range);
+}
+
+TEST_CASE("Test shortest paths") {
+    ThreadPool pool(3);
+    std::mt19937 rng(5);
+    const std::size_t vertices = 800;
+    DynamicArray<Edge<std::uint32_t>> edges;
+    for (std::size_t i = 0; i < vertices * 6; ++i) {
+        edges.push_back({static_cast<std::uint32_t>(rng() % vertices), static_cast<std::uint32_t>(rng() % vertices),
+            static_cast<std::uint32_t>(rng() % 100)});
+    }
+    WeightedGraph graph(vertices, edges);
+
+    // Bellman-Ford as reference
+    std::vector<std::uint64_t> expected(vertices, unreachable<std::uint64_t>);
+    expected[3] = 0;
+    for (std::size_t round = 0; round < vertices; ++round) {
+        bool changed = false;
+        for (const auto& edge : edges) {
+            if (expected[edge.source] != unreachable<std::uint64_t> && expected[edge.source] + edge.weight < expected[edge.target]) {
+                expected[edge.target] = expected[edge.source] + edge.weight;
+                changed = true;
+            }
+        }
+        if (!changed) {
+            break;
+        }
+    }
+
+    const auto sequential = dijkstra(graph, std::uint32_t{3});
+    const auto stepped = delta_stepping(graph, std::uint32_t{3}, std::uint32_t{25});
+    const auto parallel = delta_stepping(graph, std::uint32_t{3}, std::uint32_t{10}, &pool);
+    for (std::size_t v = 0; v < vertices; ++v) {
+        const std::uint32_t want = expected[v] == unreachable<std::uint64_t> ? unreachable<std::uint32_t>
+                                                                             : static_cast<std::uint32_t>(expected[v]);
+        REQUIRE(sequential[v] == want);
+        REQUIRE(stepped[v] == want);
+        REQUIRE(parallel[v] == want);
+    }
+    CHECK_THROWS_AS(delta_stepping(graph, std::uint32_t{0}, std::uint32_t{0}), std::invalid_argument);
+
+    Graph<double> real(3, DynamicArray<Edge<double>>{{0, 1, 0.5}, {1, 2, 0.25}});
+    CHECK(dijkstra(real, std::uint32_t{0})[2] == 0.75);
+    CHECK(delta_stepping(real, std::uint32_t{0}, 0.1, &pool)[2] == 0.75);
+    CHECK(dijkstra(real, std::uint32_t{2})[0] == unreachable<double>);
+
+    Graph<int> negative(2, DynamicArray<Edge<int>>{{0, 1, -1}});
+    CHECK_THROWS_AS(dijkstra(negative, std::uint32_t{0}), std::invalid_argument);
+    CHECK_THROWS_AS(delta_stepping(negative, std::uint32_t{0}, 1, &pool), std::invalid_argument);
+}
+
+TEST_CASE("Test connected components") {
+    ThreadPool pool(3);
+    for (std::size_t edges_count : {std::size_t{500}, std::size_t{1500}, std::size_t{6000}}) {
+        const std::size_t vertices = 2000;
+        const DynamicArray<Edge<>> edges = random_edges(vertices, edges_count, static_cast<unsigned>(edges_count));
+        UnweightedGraph directed(vertices, edges);
+        UnweightedGraph undirected(vertices, edges, GraphKind::Undirected);
+
+        // Reference labels: smallest vertex reached by an undirected BFS
+        std::vector<std::uint32_t> expected(vertices, UnweightedGraph::no_vertex);
+        for (std::uint32_t v = 0; v < vertices; ++v) {
+            if (expected[v] != UnweightedGraph::no_vertex) {
+                continue;
+            }
+            const std::vector<long> depth = reference_depths(undirected, v);
+            for (std::uint32_t w = 0; w < vertices; ++w) {
+                if (depth[w] >= 0) {
+                    expected[w] = v;
+                }
+            }
+        }
+
+        const auto labels = connected_components(undirected);
+        const auto weak = connected_components(directed, &pool);
+        for (std::size_t v = 0; v < vertices; ++v) {
+            REQUIRE(labels[v] == expected[v]);
+            REQUIRE(weak[v] == expected[v]);
+        }
+    }
+}
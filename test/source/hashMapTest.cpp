@@ -0,0 +1,299 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/hash_map.h>
+#include <algorithmCollection/allocators/arenaAllocator.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const noexcept { return std::hash<std::string_view>{}(value); }
+    };
+
+    struct StringEq {
+        using is_transparent = void;
+        bool operator()(std::string_view lhs, std::string_view rhs) const noexcept { return lhs == rhs; }
+    };
+
+    // Sends every key to the same probe sequence and control byte
+    struct ConstantHash {
+        std::size_t operator()(int) const noexcept { return 42; }
+    };
+
+    // Counts live instances and throws on the fail_at-th copy; its move may throw, so rehashing copies it
+    struct FragileCopy {
+        static inline int live = 0;
+        static inline int copies = 0;
+        static inline int fail_at = -1;
+
+        int value;
+
+        FragileCopy(int v) : value(v) { ++live; }
+        FragileCopy(const FragileCopy& other) : value(other.value) {
+            if (copies++ == fail_at) {
+                throw std::runtime_error("copy failed");
+            }
+            ++live;
+        }
+        FragileCopy(FragileCopy&& other) noexcept(false) : value(other.value) { ++live; }
+        FragileCopy& operator=(const FragileCopy&) = default;
+        FragileCopy& operator=(FragileCopy&&) = default;
+        ~FragileCopy() { --live; }
+    };
+}
+
+TEST_CASE("Test hash map insert and find") {
+    HashMap<int, std::string> map;
+    CHECK(map.empty());
+    CHECK(map.find(1) == map.end());
+
+    auto [it, inserted] = map.insert({1, "one"});
+    CHECK(inserted);
+    CHECK(it->first == 1);
+    CHECK(it->second == "one");
+
+    auto [again, inserted_again] = map.insert({1, "uno"});
+    CHECK_FALSE(inserted_again);
+    CHECK(again == it);
+    CHECK(again->second == "one");
+
+    map.emplace(2, "two");
+    CHECK(map.size() == 2);
+    CHECK(map.contains(2));
+    CHECK(map.count(3) == 0);
+    CHECK(map.at(2) == "two");
+    CHECK_THROWS_AS(map.at(3), std::out_of_range);
+}
+
+TEST_CASE("Test hash map operator[], try_emplace and insert_or_assign") {
+    HashMap<std::string, int> map;
+    map["a"] = 1;
+    map["a"] += 1;
+    CHECK(map["a"] == 2);
+    CHECK(map["b"] == 0);
+
+    std::string key = "c";
+    auto value = std::make_unique<int>(5);
+    HashMap<std::string, std::unique_ptr<int>> owners;
+    CHECK(owners.try_emplace(key, std::move(value)).second);
+    CHECK(value == nullptr);
+
+    auto other = std::make_unique<int>(6);
+    CHECK_FALSE(owners.try_emplace(key, std::move(other)).second);
+    CHECK(other != nullptr);
+
+    CHECK_FALSE(map.insert_or_assign("a", 10).second);
+    CHECK(map["a"] == 10);
+    CHECK(map.insert_or_assign("d", 4).second);
+}
+
+TEST_CASE("Test hash map matches std::unordered_map under random operations") {
+    HashMap<int, int> map;
+    std::unordered_map<int, int> reference;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> keys(0, 2000);
+
+    for (int i = 0; i < 20000; ++i) {
+        const int key = keys(rng);
+        switch (rng() % 3) {
+        case 0:
+            CHECK(map.insert({key, i}).second == reference.insert({key, i}).second);
+            break;
+        case 1:
+            CHECK(map.erase(key) == reference.erase(key));
+            break;
+        default:
+            CHECK((map.find(key) == map.end()) == (reference.find(key) == reference.end()));
+            break;
+        }
+    }
+
+    CHECK(map.size() == reference.size());
+    std::size_t visited = 0;
+    for (const auto& [key, value] : map) {
+        CHECK(reference.at(key) == value);
+        ++visited;
+    }
+    CHECK(visited == reference.size());
+}
+
+TEST_CASE("Test hash map grows and keeps every element") {
+    HashMap<int, int> map;
+    for (int i = 0; i < 10000; ++i) {
+        map[i] = i * 2;
+    }
+    CHECK(map.size() == 10000);
+    CHECK(map.load_factor() <= map.max_load_factor());
+    for (int i = 0; i < 10000; ++i) {
+        REQUIRE(map.at(i) == i * 2);
+    }
+}
+
+TEST_CASE("Test hash map growth keeps the elements when a copy throws") {
+    {
+        // Finds how many elements fit before the table grows for the second time
+        HashMap<int, int> probe;
+        int count = 0;
+        std::size_t buckets = 0;
+        for (; probe.bucket_count() == buckets || buckets == 0; ++count) {
+            if (probe.bucket_count() != 0) {
+                buckets = probe.bucket_count();
+            }
+            probe.try_emplace(count, count);
+        }
+        --count;
+
+        HashMap<int, FragileCopy> map;
+        for (int i = 0; i < count; ++i) {
+            map.try_emplace(i, i);
+        }
+        REQUIRE(map.bucket_count() == buckets);
+        CHECK(FragileCopy::live == count);
+
+        // The next insert grows the table and its third copy throws
+        FragileCopy::copies = 0;
+        FragileCopy::fail_at = 2;
+        CHECK_THROWS_AS(map.try_emplace(count, count), std::runtime_error);
+        CHECK(map.bucket_count() == buckets);
+        CHECK(map.size() == static_cast<std::size_t>(count));
+        CHECK(FragileCopy::live == count);
+        for (int i = 0; i < count; ++i) {
+            REQUIRE(map.at(i).value == i);
+        }
+
+        FragileCopy::fail_at = -1;
+        map.try_emplace(count, count);
+        CHECK(map.bucket_count() > buckets);
+        CHECK(map.size() == static_cast<std::size_t>(count + 1));
+        CHECK(FragileCopy::live == count + 1);
+        for (int i = 0; i <= count; ++i) {
+            REQUIRE(map.at(i).value == i);
+        }
+    }
+    CHECK(FragileCopy::live == 0);
+}
+
+TEST_CASE("Test hash map with colliding hashes") {
+    HashMap<int, int, ConstantHash> map;
+    for (int i = 0; i < 100; ++i) {
+        map.emplace(i, i);
+    }
+    for (int i = 0; i < 100; i += 2) {
+        CHECK(map.erase(i) == 1);
+    }
+    CHECK(map.size() == 50);
+    for (int i = 0; i < 100; ++i) {
+        CHECK(map.contains(i) == (i % 2 == 1));
+    }
+}
+
+TEST_CASE("Test hash map erase by iterator") {
+    HashMap<int, int> map;
+    for (int i = 0; i < 100; ++i) {
+        map.emplace(i, i);
+    }
+
+    for (auto it = map.begin(); it != map.end();) {
+        if (it->first % 3 == 0) {
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    CHECK(map.size() == 66);
+    CHECK_FALSE(map.contains(99));
+    CHECK(map.contains(98));
+
+    map.erase(map.begin(), map.end());
+    CHECK(map.empty());
+}
+
+TEST_CASE("Test hash map insert and erase churn does not grow the table") {
+    HashMap<int, int> map;
+    map.reserve(64);
+    const std::size_t capacity = map.capacity();
+
+    for (int i = 0; i < 100000; ++i) {
+        map.emplace(i, i);
+        if (map.size() > 32) {
+            map.erase(i - 32);
+        }
+    }
+    CHECK(map.size() == 32);
+    CHECK(map.capacity() == capacity);
+}
+
+TEST_CASE("Test hash map heterogeneous lookup") {
+    HashMap<std::string, int, StringHash, StringEq> map;
+    map.emplace("alpha", 1);
+    map.emplace("beta", 2);
+
+    std::string_view key = "beta";
+    CHECK(map.find(key) != map.end());
+    CHECK(map.contains("alpha"));
+    CHECK(map.at(key) == 2);
+    CHECK(map.erase(std::string_view("alpha")) == 1);
+    CHECK(map.size() == 1);
+}
+
+TEST_CASE("Test hash map reserve and max load factor") {
+    HashMap<int, int> map;
+    map.reserve(1000);
+    const std::size_t capacity = map.capacity();
+    CHECK(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i) {
+        map.emplace(i, i);
+    }
+    CHECK(map.capacity() == capacity);
+
+    map.max_load_factor(0.5f);
+    CHECK(map.load_factor() <= 0.5f);
+    CHECK(map.size() == 1000);
+    CHECK(map.at(999) == 999);
+
+    CHECK_THROWS_AS(map.max_load_factor(0.0f), std::invalid_argument);
+    CHECK_THROWS_AS(map.max_load_factor(1.5f), std::invalid_argument);
+}
+
+TEST_CASE("Test hash map copy and move") {
+    HashMap<std::string, std::string> map = {{"a", "1"}, {"b", "2"}, {"c", "3"}};
+
+    auto copy = map;
+    CHECK(copy == map);
+    copy["a"] = "changed";
+    CHECK(map["a"] == "1");
+    CHECK(copy != map);
+
+    auto moved = std::move(copy);
+    CHECK(moved.size() == 3);
+    CHECK(copy.empty());
+    CHECK(copy.find("a") == copy.end());
+
+    copy = moved;
+    CHECK(copy == moved);
+    map = std::move(moved);
+    CHECK(map["a"] == "changed");
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.begin() == map.end());
+    map["x"] = "y";
+    CHECK(map.size() == 1);
+}
+
+TEST_CASE("Test hash map with arena allocator") {
+    ArenaResource arena;
+    using Alloc = MonotonicArenaAllocator<std::pair<const int, int>>;
+    HashMap<int, int, std::hash<int>, std::equal_to<int>, Alloc> map(Alloc{arena});
+
+    for (int i = 0; i < 1000; ++i) {
+        map.emplace(i, -i);
+    }
+    CHECK(map.size() == 1000);
+    CHECK(map.at(500) == -500);
+    CHECK(arena.bytes_allocated() > 0);
+}
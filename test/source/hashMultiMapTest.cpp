@@ -0,0 +1,80 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/hash_multimap.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+TEST_CASE("Test hash multimap keeps equal keys together in insertion order") {
+    HashMultiMap<std::string, int> map;
+    map.insert({"a", 1});
+    map.emplace("b", 2);
+    map.insert({"a", 3});
+    map.emplace("a", 4);
+
+    CHECK(map.size() == 4);
+    CHECK(map.count("a") == 3);
+    CHECK(map.count("b") == 1);
+    CHECK(map.count("c") == 0);
+
+    auto [first, last] = map.equal_range("a");
+    std::vector<int> values;
+    for (auto it = first; it != last; ++it) {
+        CHECK(it->first == "a");
+        values.push_back(it->second);
+    }
+    CHECK(values == std::vector<int>{1, 3, 4});
+
+    // The values of one key are adjacent in memory
+    CHECK(&*std::next(first, 2) == &*first + 2);
+
+    std::size_t visited = 0;
+    for (const auto& entry : map) {
+        CHECK(map.count(entry.first) > 0);
+        ++visited;
+    }
+    CHECK(visited == map.size());
+}
+
+TEST_CASE("Test hash multimap erase") {
+    HashMultiMap<std::string, int> map = {{"a", 1}, {"a", 2}, {"a", 3}, {"b", 4}};
+
+    auto it = map.find("a");
+    CHECK(it->second == 1);
+    it = map.erase(it);
+    CHECK(it->first == "a");
+    CHECK(it->second == 2);
+    CHECK(map.count("a") == 2);
+
+    auto [first, last] = map.equal_range("a");
+    map.erase(first, last);
+    CHECK(map.count("a") == 0);
+    CHECK(map.size() == 1);
+
+    map.emplace("b", 5);
+    CHECK(map.erase("b") == 2);
+    CHECK(map.empty());
+    CHECK(map.begin() == map.end());
+}
+
+TEST_CASE("Test hash multimap grows and compares") {
+    HashMultiMap<int, int> map;
+    std::vector<std::pair<const int, int>> values;
+    for (int i = 0; i < 3000; ++i) {
+        values.emplace_back(i % 1000, i);
+    }
+    map.insert(values.begin(), values.end());
+    CHECK(map.size() == 3000);
+    for (int key = 0; key < 1000; ++key) {
+        REQUIRE(map.count(key) == 3);
+    }
+
+    HashMultiMap<int, int> reversed(values.rbegin(), values.rend());
+    CHECK(reversed == map);
+    reversed.erase(reversed.find(7));
+    CHECK(reversed != map);
+
+    auto copy = map;
+    auto moved = std::move(copy);
+    CHECK(moved == map);
+    CHECK(copy.empty());
+}
@@ -0,0 +1,50 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/hash_multiset.h>
+#include <string>
+#include <string_view>
+
+namespace {
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const noexcept { return std::hash<std::string_view>{}(value); }
+    };
+
+    struct StringEq {
+        using is_transparent = void;
+        bool operator()(std::string_view lhs, std::string_view rhs) const noexcept { return lhs == rhs; }
+    };
+}
+
+TEST_CASE("Test hash multiset counts duplicates") {
+    HashMultiSet<int> set = {1, 2, 2, 3, 3, 3};
+    CHECK(set.size() == 6);
+    CHECK(set.count(1) == 1);
+    CHECK(set.count(2) == 2);
+    CHECK(set.count(3) == 3);
+    CHECK(set.count(4) == 0);
+
+    set.insert(2);
+    CHECK(set.count(2) == 3);
+    CHECK(set.erase(3) == 3);
+    CHECK(set.size() == 4);
+    CHECK_FALSE(set.contains(3));
+
+    set.clear();
+    CHECK(set.empty());
+    set.insert(9);
+    CHECK(set.count(9) == 1);
+}
+
+TEST_CASE("Test hash multiset heterogeneous lookup") {
+    HashMultiSet<std::string, StringHash, StringEq> set;
+    set.insert("word");
+    set.insert("word");
+    set.emplace("other");
+
+    std::string_view key = "word";
+    CHECK(set.count(key) == 2);
+    auto [first, last] = set.equal_range(key);
+    CHECK(std::distance(first, last) == 2);
+    CHECK(set.erase(key) == 2);
+    CHECK(set.size() == 1);
+}
@@ -0,0 +1,55 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/hash_set.h>
+#include <algorithm>
+#include <forward_list>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("Test hash set insert, find and erase") {
+    HashSet<std::string> set;
+    CHECK(set.insert("a").second);
+    CHECK_FALSE(set.insert("a").second);
+    CHECK(set.emplace(3, 'b').second);
+
+    CHECK(set.size() == 2);
+    CHECK(set.contains("bbb"));
+    CHECK(*set.find("a") == "a");
+    CHECK(set.erase("a") == 1);
+    CHECK(set.erase("a") == 0);
+    CHECK(set.size() == 1);
+}
+
+TEST_CASE("Test hash set iterators do not allow modifying elements") {
+    using Set = HashSet<int>;
+    static_assert(std::is_same_v<decltype(*std::declval<Set::iterator>()), const int&>);
+    static_assert(std::is_same_v<decltype(*std::declval<Set::const_iterator>()), const int&>);
+
+    Set set = {3, 1, 2, 3};
+    std::vector<int> values(set.begin(), set.end());
+    std::sort(values.begin(), values.end());
+    CHECK(values == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("Test hash set bulk insert grows the table once") {
+    std::vector<int> values;
+    for (int i = 0; i < 5000; ++i) {
+        values.push_back(i);
+    }
+
+    HashSet<int> set;
+    set.insert(values.begin(), values.end());
+    const std::size_t capacity = set.capacity();
+    CHECK(set.size() == 5000);
+    CHECK(capacity >= 5000);
+
+    // Every element is already present, so the measured range must not grow the table again
+    HashSet<int> copy(values.begin(), values.end());
+    CHECK(copy == set);
+    CHECK(copy.capacity() == capacity);
+
+    std::forward_list<int> list = {1, 2, 5000, 5001};
+    set.insert(list.begin(), list.end());
+    CHECK(set.size() == 5002);
+}
@@ -0,0 +1,187 @@
+// Counts container storage events in this file. Every container type instantiated here has an
+// element type local to this file, so no other test shares their instantiations.
+#define ALGORITHM_COLLECTION_CONTAINER_STATS
+#include <doctest/doctest.h>
+#include <algorithmCollection/allocators/instrumentedAllocator.h>
+#include <algorithmCollection/allocators/poolAllocator.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/smallDynamicArray.h>
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Sample {
+    int value;
+};
+
+struct Named {
+    std::string name;
+};
+}
+
+TEST_CASE("Test instrumented allocator records allocations and live bytes") {
+    AllocationStats stats;
+    InstrumentedAllocator<SimpleAllocator<Sample>> alloc(stats);
+
+    Sample* small = alloc.allocate(4);
+    Sample* large = alloc.allocate(100);
+    CHECK(stats.allocations() == 2);
+    CHECK(stats.allocated_bytes() == 104 * sizeof(Sample));
+    CHECK(stats.live_bytes() == 104 * sizeof(Sample));
+
+    auto histogram = stats.histogram();
+    CHECK(histogram[AllocationStats::size_class(4 * sizeof(Sample))] == 1);
+    CHECK(histogram[AllocationStats::size_class(100 * sizeof(Sample))] == 1);
+
+    alloc.deallocate(large, 100);
+    CHECK(stats.deallocations() == 1);
+    CHECK(stats.live_bytes() == 4 * sizeof(Sample));
+    CHECK(stats.peak_bytes() == 104 * sizeof(Sample));
+
+    alloc.deallocate(small, 4);
+    CHECK(stats.live_bytes() == 0);
+    CHECK(stats.peak_bytes() == 104 * sizeof(Sample));
+
+    stats.reset();
+    CHECK(stats.allocations() == 0);
+    CHECK(stats.peak_bytes() == 0);
+    CHECK(stats.histogram()[AllocationStats::size_class(4 * sizeof(Sample))] == 0);
+}
+
+TEST_CASE("Test instrumented allocator copies and rebinds share their stats") {
+    AllocationStats stats;
+    InstrumentedAllocator<SimpleAllocator<Sample>> alloc(stats);
+    InstrumentedAllocator<SimpleAllocator<Sample>> copy = alloc;
+    std::allocator_traits<decltype(alloc)>::rebind_alloc<double> rebound(alloc);
+
+    static_assert(std::is_same_v<decltype(rebound)::inner_allocator_type, SimpleAllocator<double>>);
+    CHECK(copy == alloc);
+    CHECK(rebound == alloc);
+    CHECK(&rebound.stats() == &stats);
+
+    AllocationStats other_stats;
+    CHECK(InstrumentedAllocator<SimpleAllocator<Sample>>(other_stats) != alloc);
+    CHECK(&InstrumentedAllocator<SimpleAllocator<Sample>>().stats() == &AllocationStats::global());
+
+    double* d = rebound.allocate(3);
+    Sample* s = copy.allocate(1);
+    CHECK(stats.allocations() == 2);
+    CHECK(stats.live_bytes() == 3 * sizeof(double) + sizeof(Sample));
+    rebound.deallocate(d, 3);
+    copy.deallocate(s, 1);
+    CHECK(stats.live_bytes() == 0);
+}
+
+TEST_CASE("Test instrumented allocator forwards reallocate and wraps stateful allocators") {
+    AllocationStats stats;
+    using Instrumented = InstrumentedAllocator<SimpleAllocator<Sample>>;
+    static_assert(ReallocatingAllocator<Instrumented, Sample>);
+    static_assert(!ReallocatingAllocator<InstrumentedAllocator<PoolAllocator<Sample, 8>>, Sample>);
+
+    {
+        DynamicArray<Sample, Instrumented> array{Instrumented(stats)};
+        for (int i = 0; i < 1000; ++i) {
+            array.push_back(Sample{i});
+        }
+        CHECK(array[999].value == 999);
+        CHECK(stats.reallocations() + stats.failed_reallocations() > 0);
+        CHECK(stats.live_bytes() == array.capacity() * sizeof(Sample));
+        CHECK(stats.peak_bytes() >= stats.live_bytes());
+    }
+    CHECK(stats.live_bytes() == 0);
+    CHECK(stats.allocations() == stats.deallocations());
+
+    stats.reset();
+    PoolResource resource;
+    using PoolInstrumented = InstrumentedAllocator<PoolAllocator<Sample, 8>>;
+    {
+        DoubleLinkedList<Sample, PoolInstrumented> list{PoolInstrumented(stats, PoolAllocator<Sample, 8>(resource))};
+        for (int i = 0; i < 20; ++i) {
+            list.push_back(Sample{i});
+        }
+        CHECK(stats.allocations() == 20);
+        CHECK(stats.live_bytes() > 0);
+    }
+    CHECK(stats.live_bytes() == 0);
+}
+
+TEST_CASE("Test instrumented allocator counts from several threads") {
+    AllocationStats stats;
+    InstrumentedAllocator<SimpleAllocator<Sample>> alloc(stats);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([alloc] {
+            for (int i = 0; i < 1000; ++i) {
+                alloc.deallocate(alloc.allocate(8), 8);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(stats.allocations() == 4000);
+    CHECK(stats.deallocations() == 4000);
+    CHECK(stats.live_bytes() == 0);
+    CHECK(stats.peak_bytes() >= 8 * sizeof(Sample));
+    CHECK(stats.peak_bytes() <= 4 * 8 * sizeof(Sample));
+}
+
+TEST_CASE("Test container stats count grows, shrinks and relocated elements") {
+    static_assert(container_stats_enabled);
+
+    using Array = DynamicArray<Named>;
+    ContainerStats& stats = container_stats<Array>();
+    stats.reset();
+
+    Array array;
+    array.reserve(4);
+    CHECK(stats.grows() == 1);
+    CHECK(stats.relocated_elements() == 0);
+
+    for (int i = 0; i < 4; ++i) {
+        array.push_back(Named{std::to_string(i)});
+    }
+    CHECK(stats.grows() == 1);
+
+    array.push_back(Named{"4"});
+    CHECK(stats.grows() == 2);
+    CHECK(stats.relocated_elements() == 4);
+    CHECK(stats.in_place_resizes() == 0);
+
+    array.shrink_to_fit();
+    CHECK(stats.shrinks() == 1);
+    CHECK(stats.relocated_elements() == 9);
+    CHECK(array[4].name == "4");
+
+    // Trivially relocatable elements are resized through SimpleAllocator::reallocate
+    using TrivialArray = DynamicArray<Sample>;
+    ContainerStats& trivial_stats = container_stats<TrivialArray>();
+    trivial_stats.reset();
+    TrivialArray trivial;
+    for (int i = 0; i < 100; ++i) {
+        trivial.push_back(Sample{i});
+    }
+    CHECK(trivial_stats.grows() > 1);
+    CHECK(trivial_stats.in_place_resizes() == trivial_stats.grows() - 1);
+    CHECK(trivial_stats.relocated_elements() == 0);
+    CHECK(stats.grows() == 2);
+
+    using Small = SmallDynamicArray<Named, 2>;
+    ContainerStats& small_stats = container_stats<Small>();
+    small_stats.reset();
+    Small small;
+    small.push_back(Named{"a"});
+    small.push_back(Named{"b"});
+    CHECK(small_stats.grows() == 0);
+    small.push_back(Named{"c"});
+    CHECK(small_stats.grows() == 1);
+    CHECK(small_stats.relocated_elements() == 2);
+    small.pop_back();
+    small.shrink_to_fit();
+    CHECK(small_stats.shrinks() == 1);
+    CHECK(small_stats.relocated_elements() == 4);
+}
@@ -0,0 +1,147 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/intrusive_linkedList.h>
+#include <stdexcept>
+
+namespace {
+    struct LruTag {};
+    struct TimerTag {};
+
+    struct Entry : IntrusiveListHook<LruTag>, IntrusiveListHook<TimerTag> {
+        int key;
+
+        explicit Entry(int k) : key(k) {}
+
+        bool in_lru() const noexcept { return IntrusiveListHook<LruTag>::is_linked(); }
+        bool in_timers() const noexcept { return IntrusiveListHook<TimerTag>::is_linked(); }
+    };
+
+    using LruList = IntrusiveList<Entry, LruTag>;
+    using TimerList = IntrusiveList<Entry, TimerTag>;
+
+    // Not standard layout: the hook sits behind the vtable pointer and another base
+    struct Shape {
+        virtual ~Shape() = default;
+        virtual int sides() const = 0;
+        double area = 0;
+    };
+
+    struct Square : Shape, IntrusiveListHook<> {
+        int sides() const override { return 4; }
+    };
+
+    struct Triangle : Shape, IntrusiveListHook<> {
+        int sides() const override { return 3; }
+    };
+
+    template <typename List>
+    DynamicArray<int> keys(const List& list) {
+        DynamicArray<int> result;
+        for (const auto& entry : list) {
+            result.push_back(entry.key);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("Test intrusive list links user objects") {
+    Entry a(1), b(2), c(3);
+    LruList list;
+
+    list.push_back(a);
+    list.push_back(b);
+    list.push_front(c);
+
+    CHECK(list.size() == 3);
+    CHECK(&list.front() == &c);
+    CHECK(&list.back() == &b);
+    CHECK(keys(list) == DynamicArray<int>{3, 1, 2});
+    CHECK(a.in_lru());
+}
+
+TEST_CASE("Test intrusive list removes elements by reference") {
+    Entry a(1), b(2), c(3);
+    LruList list;
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+
+    list.remove(b);
+    CHECK(!b.in_lru());
+    CHECK(keys(list) == DynamicArray<int>{1, 3});
+
+    // Moving an element to the front, as an LRU touch would
+    list.remove(c);
+    list.push_front(c);
+    CHECK(keys(list) == DynamicArray<int>{3, 1});
+
+    auto next = list.erase(list.iterator_to(c));
+    CHECK(&*next == &a);
+
+    list.pop_back();
+    CHECK(list.empty());
+    CHECK_THROWS_AS(list.pop_front(), std::logic_error);
+}
+
+TEST_CASE("Test object can be in several intrusive lists") {
+    Entry a(1), b(2);
+    LruList lru;
+    TimerList timers;
+
+    lru.push_back(a);
+    lru.push_back(b);
+    timers.push_back(b);
+    timers.push_back(a);
+
+    CHECK(keys(lru) == DynamicArray<int>{1, 2});
+    CHECK(keys(timers) == DynamicArray<int>{2, 1});
+    CHECK_THROWS_AS(lru.push_back(a), std::logic_error);
+
+    timers.clear();
+    CHECK(!a.in_timers());
+    CHECK(a.in_lru());
+}
+
+TEST_CASE("Test intrusive list reverse iteration and move") {
+    Entry a(1), b(2), c(3);
+    LruList list;
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+
+    DynamicArray<int> reversed;
+    for (auto it = list.rbegin(); it != list.rend(); ++it) {
+        reversed.push_back(it->key);
+    }
+    CHECK(reversed == DynamicArray<int>{3, 2, 1});
+
+    LruList moved(std::move(list));
+    CHECK(list.empty());
+    CHECK(keys(moved) == DynamicArray<int>{1, 2, 3});
+
+    {
+        LruList scoped(std::move(moved));
+    }
+    CHECK(!a.in_lru());
+}
+
+TEST_CASE("Test intrusive list of objects that are not standard layout") {
+    Square square;
+    IntrusiveList<Square> squares;
+    squares.push_back(square);
+    CHECK(&squares.front() == &square);
+    CHECK(squares.front().sides() == 4);
+
+    Triangle first, second;
+    first.area = 1.5;
+    second.area = 2.5;
+    IntrusiveList<Triangle> triangles;
+    triangles.push_back(first);
+    triangles.push_front(second);
+    double total = 0;
+    for (const Triangle& triangle : triangles) {
+        total += triangle.area * triangle.sides();
+    }
+    CHECK(total == 12.0);
+    CHECK(&*triangles.iterator_to(first) == &first);
+}
@@ -0,0 +1,261 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/map.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/allocators/arenaAllocator.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+    // Small nodes, so a few hundred keys already build several levels
+    template <class K, class V>
+    using SmallNodeMap = BTree<BTreeMapPolicy<K, V>, std::less<K>, SimpleAllocator<std::pair<const K, V>>, false, 64>;
+}
+
+TEST_CASE("Test map insert and lookup") {
+    Map<int, std::string> map;
+    CHECK(map.empty());
+    CHECK(map.begin() == map.end());
+    CHECK(map.find(1) == map.end());
+
+    CHECK(map.insert({2, "two"}).second);
+    CHECK(map.emplace(1, "one").second);
+    CHECK(map.try_emplace(3, "three").second);
+    CHECK_FALSE(map.insert({2, "again"}).second);
+    CHECK_FALSE(map.try_emplace(3, "again").second);
+    CHECK(map.size() == 3);
+    CHECK(map.at(2) == "two");
+    CHECK(map[3] == "three");
+    CHECK(map[4].empty());
+    CHECK(map.size() == 4);
+    CHECK_THROWS_AS(map.at(5), std::out_of_range);
+
+    CHECK_FALSE(map.insert_or_assign(1, "uno").second);
+    CHECK(map.at(1) == "uno");
+
+    int expected = 1;
+    for (const auto& [key, value] : map) {
+        CHECK(key == expected++);
+    }
+    CHECK(map.count(4) == 1);
+    CHECK(map.count(7) == 0);
+}
+
+TEST_CASE("Test map ordered queries") {
+    Map<int, int> map;
+    for (int i = 0; i < 1000; i += 10) {
+        map.emplace(i, i / 10);
+    }
+
+    CHECK(map.lower_bound(25)->first == 30);
+    CHECK(map.lower_bound(30)->first == 30);
+    CHECK(map.upper_bound(30)->first == 40);
+    CHECK(map.lower_bound(991) == map.end());
+    CHECK(map.upper_bound(-1) == map.begin());
+
+    auto [first, last] = map.equal_range(50);
+    CHECK(std::distance(first, last) == 1);
+    CHECK(first->second == 5);
+    auto [none, also_none] = map.equal_range(55);
+    CHECK(none == also_none);
+
+    // Range scan over [200, 300)
+    int sum = 0;
+    for (auto it = map.lower_bound(200); it != map.lower_bound(300); ++it) {
+        sum += it->second;
+    }
+    CHECK(sum == 20 + 21 + 22 + 23 + 24 + 25 + 26 + 27 + 28 + 29);
+
+    int expected = 990;
+    for (auto it = map.rbegin(); it != map.rend(); ++it) {
+        CHECK(it->first == expected);
+        expected -= 10;
+    }
+    CHECK(expected == -10);
+}
+
+TEST_CASE("Test map erase returns the next element") {
+    SmallNodeMap<int, int> map;
+    for (int i = 0; i < 500; ++i) {
+        map.emplace(i, i);
+    }
+    CHECK(map.height() > 2);
+
+    // Erase every other key, walking with the returned iterators
+    auto it = map.begin();
+    while (it != map.end()) {
+        it = map.erase(it);
+        if (it != map.end()) {
+            ++it;
+        }
+    }
+    CHECK(map.size() == 250);
+    int expected = 1;
+    for (const auto& [key, value] : map) {
+        CHECK(key == expected);
+        expected += 2;
+    }
+
+    CHECK(map.erase(1) == 1);
+    CHECK(map.erase(1) == 0);
+    auto next = map.erase(map.find(101), map.find(201));
+    CHECK(next->first == 201);
+    CHECK(map.size() == 199);
+
+    map.erase(map.begin(), map.end());
+    CHECK(map.empty());
+    CHECK(map.height() == 0);
+}
+
+TEST_CASE("Test map matches std::map under random operations") {
+    SmallNodeMap<int, int> map;
+    std::map<int, int> reference;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> keys(0, 400);
+
+    for (int step = 0; step < 20000; ++step) {
+        const int key = keys(rng);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            CHECK(map.emplace(key, step).second == reference.emplace(key, step).second);
+            break;
+        case 2:
+            CHECK(map.erase(key) == reference.erase(key));
+            break;
+        default: {
+            auto it = map.lower_bound(key);
+            auto expected = reference.lower_bound(key);
+            if (expected == reference.end()) {
+                CHECK(it == map.end());
+                break;
+            }
+            REQUIRE(it != map.end());
+            CHECK(it->first == expected->first);
+            auto next = map.erase(it);
+            auto expected_next = reference.erase(expected);
+            REQUIRE((next == map.end()) == (expected_next == reference.end()));
+            if (next != map.end()) {
+                CHECK(next->first == expected_next->first);
+            }
+        }
+        }
+        REQUIRE(map.size() == reference.size());
+    }
+    CHECK(std::equal(map.begin(), map.end(), reference.begin(), reference.end()));
+}
+
+TEST_CASE("Test map bulk load") {
+    DynamicArray<std::pair<int, std::string>> sorted;
+    for (int i = 0; i < 3000; ++i) {
+        sorted.push_back({i * 2, std::to_string(i)});
+    }
+
+    SmallNodeMap<int, std::string> map;
+    map.emplace(-1, "replaced");
+    map.bulk_load(sorted);
+    CHECK(map.size() == 3000);
+    CHECK(map.find(-1) == map.end());
+    CHECK(map.find(1000)->second == "500");
+    CHECK(map.lower_bound(1001)->first == 1002);
+
+    int expected = 0;
+    for (const auto& [key, value] : map) {
+        CHECK(key == expected);
+        expected += 2;
+    }
+
+    // A bulk loaded tree keeps the fill invariants, so it can be erased from and inserted into
+    for (int i = 0; i < 6000; i += 4) {
+        CHECK(map.erase(i) == 1);
+    }
+    CHECK(map.size() == 1500);
+    for (int i = 1; i < 300; i += 2) {
+        map.emplace(i, "odd");
+    }
+    CHECK(map.size() == 1650);
+    CHECK(std::is_sorted(map.begin(), map.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }));
+
+    // Build from every size around the node boundaries
+    for (int count = 0; count < 200; ++count) {
+        DynamicArray<std::pair<int, std::string>> values;
+        for (int i = 0; i < count; ++i) {
+            values.push_back({i, std::string(20, 'x')});
+        }
+        SmallNodeMap<int, std::string> small;
+        small.bulk_load(std::move(values));
+        CHECK(values.empty());
+        REQUIRE(small.size() == static_cast<std::size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            REQUIRE(small.erase(i) == 1);
+        }
+        CHECK(small.empty());
+    }
+}
+
+TEST_CASE("Test map bulk load rejects unsorted input") {
+    DynamicArray<std::pair<int, int>> values;
+    for (int i = 0; i < 100; ++i) {
+        values.push_back({i, i});
+    }
+    values.push_back({50, 50});
+
+    Map<int, int> map = {{1, 1}};
+    CHECK_THROWS_AS(map.bulk_load(values), std::invalid_argument);
+    CHECK(map.empty());
+
+    DynamicArray<std::pair<int, int>> duplicates;
+    duplicates.push_back({1, 1});
+    duplicates.push_back({1, 2});
+    CHECK_THROWS_AS(map.bulk_load(duplicates), std::invalid_argument);
+    CHECK(map.empty());
+}
+
+TEST_CASE("Test map copy, move and compare") {
+    SmallNodeMap<std::string, std::unique_ptr<int>> moved_only;
+    for (int i = 0; i < 100; ++i) {
+        moved_only.emplace(std::to_string(i), std::make_unique<int>(i));
+    }
+    for (int i = 0; i < 100; i += 3) {
+        moved_only.erase(std::to_string(i));
+    }
+    CHECK(*moved_only.find("50")->second == 50);
+
+    SmallNodeMap<std::string, int> map;
+    for (int i = 0; i < 200; ++i) {
+        map.emplace(std::to_string(i), i);
+    }
+    SmallNodeMap<std::string, int> copy(map);
+    CHECK(copy == map);
+    copy.erase("7");
+    CHECK(copy != map);
+
+    SmallNodeMap<std::string, int> moved(std::move(copy));
+    CHECK(copy.empty());
+    CHECK(moved.size() == 199);
+    copy = moved;
+    CHECK(copy == moved);
+    moved = std::move(map);
+    CHECK(moved.size() == 200);
+    swap(moved, copy);
+    CHECK(moved.size() == 199);
+    CHECK(copy.size() == 200);
+}
+
+TEST_CASE("Test map heterogeneous lookup and arena allocator") {
+    ArenaResource arena;
+    Map<std::string, int, std::less<>, MonotonicArenaAllocator<std::pair<const std::string, int>>> map(
+        std::less<>{}, MonotonicArenaAllocator<std::pair<const std::string, int>>(arena));
+    for (int i = 0; i < 100; ++i) {
+        map.emplace(std::to_string(i), i);
+    }
+    std::string_view key = "42";
+    CHECK(map.at(key) == 42);
+    CHECK(map.contains(key));
+    CHECK(map.count(std::string_view("nope")) == 0);
+    CHECK(arena.bytes_allocated() > 0);
+}
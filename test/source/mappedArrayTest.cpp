@@ -0,0 +1,161 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/mappedArray.h>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace {
+    // File in the temporary directory, removed when the test ends
+    class TemporaryFile {
+    public:
+        explicit TemporaryFile(const std::string& name)
+            : m_path(std::filesystem::temp_directory_path() / ("algorithm_collection_" + name)) {}
+
+        TemporaryFile(const TemporaryFile&) = delete;
+        TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+        ~TemporaryFile() {
+            std::error_code error;
+            std::filesystem::remove(m_path, error);
+        }
+
+        const std::filesystem::path& path() const noexcept { return m_path; }
+
+    private:
+        std::filesystem::path m_path;
+    };
+
+    // Overwrites one byte of the file at offset
+    void corrupt(const std::filesystem::path& path, std::streamoff offset) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(offset);
+        const char byte = static_cast<char>(file.get() ^ 0x5A);
+        file.seekp(offset);
+        file.put(byte);
+    }
+
+    struct alignas(128) Record {
+        std::uint32_t id;
+        float score;
+    };
+}
+
+TEST_CASE("Test mapped array round trip") {
+    const TemporaryFile file("round_trip.bin");
+    DynamicArray<std::uint64_t> values;
+    for (std::uint64_t i = 0; i < 10000; ++i) {
+        values.push_back(i * i);
+    }
+    write_mapped_array(file.path(), values.data());
+
+    const MappedArray<std::uint64_t> mapped(file.path());
+    CHECK(mapped.size() == values.size());
+    CHECK(std::equal(mapped.begin(), mapped.end(), values.begin(), values.end()));
+    CHECK(mapped[100] == 10000);
+    CHECK(mapped.front() == 0);
+    CHECK(mapped.back() == 9999u * 9999u);
+    CHECK(*mapped.rbegin() == mapped.back());
+    CHECK_THROWS_AS(mapped.at(10000), std::out_of_range);
+    CHECK(reinterpret_cast<std::uintptr_t>(mapped.data().data()) % 64 == 0);
+    CHECK(simd_contains(mapped.data(), 49));
+    CHECK(mapped.verify_checksums());
+    mapped.advise(MappedAccess::Sequential);
+
+    const MappedArray<std::uint64_t> checked(file.path(), MappedCheck::Checksum);
+    CHECK(DynamicArray<std::uint64_t>(checked.data()) == values);
+}
+
+TEST_CASE("Test mapped array of an empty array and of aligned records") {
+    const TemporaryFile empty_file("empty.bin");
+    write_mapped_array(empty_file.path(), DynamicArray<int>().data());
+    const MappedArray<int> empty(empty_file.path(), MappedCheck::Checksum);
+    CHECK(empty.empty());
+    CHECK(empty.begin() == empty.end());
+    CHECK_THROWS_AS(empty.front(), std::logic_error);
+
+    const TemporaryFile records_file("records.bin");
+    DynamicArray<Record> records;
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        records.push_back({i, static_cast<float>(i) / 2.0f});
+    }
+    write_mapped_array(records_file.path(), records.data());
+    const MappedArray<Record> mapped(records_file.path());
+    CHECK(reinterpret_cast<std::uintptr_t>(mapped.data().data()) % alignof(Record) == 0);
+    CHECK(mapped[42].id == 42);
+    CHECK(mapped[42].score == 21.0f);
+}
+
+TEST_CASE("Test mapped array rejects other files") {
+    const TemporaryFile file("reject.bin");
+    CHECK_THROWS_AS(MappedArray<int>(file.path()), std::system_error);
+
+    {
+        std::ofstream out(file.path(), std::ios::binary);
+        out << "definitely not a mapped array, but long enough to hold a header of sixty four bytes";
+    }
+    CHECK_THROWS_AS(MappedArray<int>(file.path()), std::runtime_error);
+
+    const DynamicArray<float> floats = {1.0f, 2.0f, 3.0f};
+    write_mapped_array(file.path(), floats.data());
+    CHECK_THROWS_AS(MappedArray<std::int32_t>(file.path()), std::runtime_error);
+    CHECK_THROWS_AS(MappedArray<double>(file.path()), std::runtime_error);
+    CHECK_THROWS_AS((MappedTable<float, float>(file.path())), std::runtime_error);
+    CHECK(MappedArray<float>(file.path()).size() == 3);
+
+    // A flipped data byte passes the header check but not the checksum
+    corrupt(file.path(), static_cast<std::streamoff>(128 + 5));
+    const MappedArray<float> damaged(file.path());
+    CHECK_FALSE(damaged.verify_checksums());
+    CHECK_THROWS_AS(MappedArray<float>(file.path(), MappedCheck::Checksum), std::runtime_error);
+
+    // Cut off in the middle of the data
+    std::filesystem::resize_file(file.path(), 130);
+    CHECK_THROWS_AS(MappedArray<float>(file.path()), std::runtime_error);
+}
+
+TEST_CASE("Test mapped array moves and survives the file being replaced") {
+    const TemporaryFile file("replace.bin");
+    write_mapped_array(file.path(), DynamicArray<int>{1, 2, 3}.data());
+    MappedArray<int> first(file.path());
+
+    // Writing goes through a new file renamed over the old one, so existing views keep the old data
+    write_mapped_array(file.path(), DynamicArray<int>{7, 8}.data());
+    CHECK(first.size() == 3);
+    CHECK(first[2] == 3);
+
+    MappedArray<int> second(std::move(first));
+    CHECK(first.empty());
+    CHECK(second.back() == 3);
+    second = MappedArray<int>(file.path());
+    CHECK(second.size() == 2);
+    CHECK(second.front() == 7);
+}
+
+TEST_CASE("Test mapped table of tabular columns") {
+    const TemporaryFile file("table.bin");
+    Tabular<std::int32_t, double, std::uint8_t> table;
+    for (int i = 0; i < 1000; ++i) {
+        table.push_back(i - 500, i * 0.5, static_cast<std::uint8_t>(i % 7));
+    }
+    write_mapped_table(file.path(), table);
+
+    const MappedTable<std::int32_t, double, std::uint8_t> mapped(file.path(), MappedCheck::Checksum);
+    CHECK(mapped.size() == 1000);
+    CHECK(column_sum(mapped.column<0>()) == table.sum<0>());
+    CHECK(column_sum(mapped.column<1>()) == table.sum<1>());
+    CHECK(column_min_max(mapped.column<2>()).max == 6);
+    CHECK(reinterpret_cast<std::uintptr_t>(mapped.column<2>().data()) % 64 == 0);
+    const auto [key, value, tag] = mapped.row(10);
+    CHECK(key == -490);
+    CHECK(value == 5.0);
+    CHECK(tag == 3);
+    CHECK_THROWS_AS(mapped.at(1000), std::out_of_range);
+    mapped.advise<1>(MappedAccess::Random);
+
+    CHECK_THROWS_AS((MappedTable<std::int32_t, float, std::uint8_t>(file.path())), std::runtime_error);
+    CHECK_THROWS_AS(MappedArray<std::int32_t>(file.path()), std::runtime_error);
+}
@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/multimap.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <map>
+#include <random>
+#include <string>
+
+TEST_CASE("Test multimap keeps equal keys in insertion order") {
+    MultiMap<int, std::string> map;
+    map.insert({2, "b1"});
+    map.insert({1, "a"});
+    map.insert({2, "b2"});
+    map.emplace(2, "b3");
+    CHECK(map.size() == 4);
+    CHECK(map.count(2) == 3);
+    CHECK(map.count(3) == 0);
+
+    auto [first, last] = map.equal_range(2);
+    CHECK(first->second == "b1");
+    CHECK((++first)->second == "b2");
+    CHECK((++first)->second == "b3");
+    CHECK(++first == last);
+    CHECK(map.find(2)->second == "b1");
+
+    CHECK(map.erase(2) == 3);
+    CHECK(map.size() == 1);
+    CHECK(map.begin()->second == "a");
+}
+
+TEST_CASE("Test multimap matches std::multimap under random operations") {
+    BTree<BTreeMapPolicy<int, int>, std::less<int>, SimpleAllocator<std::pair<const int, int>>, true, 64> map;
+    std::multimap<int, int> reference;
+    std::mt19937 rng(3);
+
+    for (int step = 0; step < 20000; ++step) {
+        const int key = static_cast<int>(rng() % 100);
+        if (rng() % 3 == 0) {
+            auto it = map.find(key);
+            auto expected = reference.find(key);
+            REQUIRE((it == map.end()) == (expected == reference.end()));
+            if (it != map.end()) {
+                CHECK(it->second == expected->second);
+                auto next = map.erase(it);
+                auto expected_next = reference.erase(expected);
+                REQUIRE((next == map.end()) == (expected_next == reference.end()));
+                if (next != map.end()) {
+                    CHECK(next->first == expected_next->first);
+                    CHECK(next->second == expected_next->second);
+                }
+            }
+        } else {
+            map.emplace(key, step);
+            reference.emplace(key, step);
+        }
+        REQUIRE(map.size() == reference.size());
+    }
+    CHECK(std::equal(map.begin(), map.end(), reference.begin(), reference.end()));
+}
+
+TEST_CASE("Test multimap bulk load accepts equal keys") {
+    DynamicArray<std::pair<int, int>> sorted;
+    for (int i = 0; i < 1000; ++i) {
+        sorted.push_back({i / 10, i});
+    }
+    MultiMap<int, int> map;
+    map.bulk_load(sorted);
+    CHECK(map.size() == 1000);
+    CHECK(map.count(42) == 10);
+    CHECK(map.find(42)->second == 420);
+
+    sorted.push_back({0, 0});
+    CHECK_THROWS_AS(map.bulk_load(sorted), std::invalid_argument);
+    CHECK(map.empty());
+}
@@ -0,0 +1,68 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/multiset.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <random>
+#include <set>
+
+TEST_CASE("Test multiset counts duplicates") {
+    MultiSet<int> set = {1, 2, 2, 3, 3, 3};
+    CHECK(set.size() == 6);
+    CHECK(set.count(1) == 1);
+    CHECK(set.count(2) == 2);
+    CHECK(set.count(3) == 3);
+    CHECK(set.count(4) == 0);
+    CHECK(*set.upper_bound(2) == 3);
+    CHECK(std::distance(set.begin(), set.lower_bound(3)) == 3);
+
+    set.insert(2);
+    CHECK(set.count(2) == 3);
+    CHECK(set.erase(3) == 3);
+    CHECK(set.size() == 4);
+    CHECK_FALSE(set.contains(3));
+}
+
+TEST_CASE("Test multiset matches std::multiset under random operations") {
+    BTree<BTreeSetPolicy<int>, std::less<int>, SimpleAllocator<int>, true, 64> set;
+    std::multiset<int> reference;
+    std::mt19937 rng(11);
+
+    for (int step = 0; step < 20000; ++step) {
+        const int key = static_cast<int>(rng() % 50);
+        switch (rng() % 5) {
+        case 0:
+            CHECK(set.erase(key) == reference.erase(key));
+            break;
+        case 1: {
+            auto first = set.lower_bound(key);
+            auto last = set.upper_bound(key + 3);
+            auto expected_first = reference.lower_bound(key);
+            auto expected_last = reference.upper_bound(key + 3);
+            REQUIRE(std::distance(first, last) == std::distance(expected_first, expected_last));
+            auto next = set.erase(first, last);
+            auto expected_next = reference.erase(expected_first, expected_last);
+            REQUIRE((next == set.end()) == (expected_next == reference.end()));
+            if (next != set.end()) {
+                CHECK(*next == *expected_next);
+            }
+            break;
+        }
+        default:
+            set.insert(key);
+            reference.insert(key);
+        }
+        REQUIRE(set.size() == reference.size());
+    }
+    CHECK(std::equal(set.begin(), set.end(), reference.begin(), reference.end()));
+}
+
+TEST_CASE("Test multiset bulk load") {
+    DynamicArray<int> sorted;
+    for (int i = 0; i < 5000; ++i) {
+        sorted.push_back(i / 3);
+    }
+    MultiSet<int> set;
+    set.bulk_load(sorted);
+    CHECK(set.size() == 5000);
+    CHECK(set.count(100) == 3);
+    CHECK(std::equal(set.begin(), set.end(), sorted.begin(), sorted.end()));
+}
@@ -0,0 +1,162 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/algorithms/parallelAlgorithms.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    std::vector<int> random_values(std::size_t count, int range) {
+        std::mt19937 rng(static_cast<unsigned>(count));
+        std::vector<int> values(count);
+        for (int& value : values) {
+            value = static_cast<int>(rng() % static_cast<unsigned>(range));
+        }
+        return values;
+    }
+
+    // Sizes on both sides of the small grain the tests use, which forces deep splits
+    constexpr std::size_t test_grain = 64;
+    const std::size_t test_sizes[] = {0, 1, 63, 64, 65, 1000, 4097, 20000};
+}
+
+TEST_CASE("Test parallel sort matches std::sort") {
+    ThreadPool pool(3);
+    for (std::size_t count : test_sizes) {
+        std::vector<int> values = random_values(count, 1000);
+        std::vector<int> expected = values;
+        std::sort(expected.begin(), expected.end());
+        parallel_sort(pool, std::span<int>(values), std::less<>(), test_grain);
+        REQUIRE(values == expected);
+
+        parallel_sort(pool, std::span<int>(values), std::greater<>(), test_grain);
+        REQUIRE(std::is_sorted(values.begin(), values.end(), std::greater<>()));
+    }
+
+    DynamicArray<std::string> words;
+    for (int i = 0; i < 5000; ++i) {
+        words.push_back(std::to_string((i * 7919) % 5000));
+    }
+    DynamicArray<std::string> sorted_words = words;
+    std::sort(sorted_words.begin(), sorted_words.end());
+    parallel_sort(pool, words.data(), std::less<>(), test_grain);
+    CHECK(words == sorted_words);
+}
+
+TEST_CASE("Test parallel stable sort keeps equivalent elements in order") {
+    ThreadPool pool(3);
+    struct Item {
+        int key;
+        int order;
+    };
+    std::vector<int> keys = random_values(10000, 20);
+    std::vector<Item> items;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        items.push_back({keys[i], static_cast<int>(i)});
+    }
+    parallel_stable_sort(pool, std::span<Item>(items), [](const Item& a, const Item& b) { return a.key < b.key; },
+        test_grain);
+    CHECK(std::is_sorted(items.begin(), items.end(),
+        [](const Item& a, const Item& b) { return a.key < b.key || (a.key == b.key && a.order < b.order); }));
+
+    // Strings are left empty once moved from, so every one must come back from the scratch copy
+    struct Named {
+        std::string key;
+        int order;
+
+        bool operator==(const Named&) const = default;
+    };
+    std::vector<Named> names;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        names.push_back({"key " + std::to_string(keys[i]), static_cast<int>(i)});
+    }
+    const auto by_key = [](const Named& a, const Named& b) { return a.key < b.key; };
+    std::vector<Named> expected = names;
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    parallel_stable_sort(pool, std::span<Named>(names), by_key, test_grain);
+    CHECK(names == expected);
+}
+
+TEST_CASE("Test parallel transform and reduce") {
+    ThreadPool pool(3);
+    for (std::size_t count : test_sizes) {
+        std::vector<int> values = random_values(count, 100);
+        std::vector<long> squares(count);
+        parallel_transform(pool, std::span<const int>(values), std::span<long>(squares),
+            [](int v) { return static_cast<long>(v) * v; }, test_grain);
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(squares[i] == static_cast<long>(values[i]) * values[i]);
+        }
+        CHECK(parallel_reduce(pool, std::span<long>(squares), 5L, std::plus<>(), test_grain) ==
+            std::accumulate(squares.begin(), squares.end(), 5L));
+    }
+
+    // Chunk results are combined in order, so a non-commutative operation works
+    std::vector<std::string> letters;
+    std::string expected = ">";
+    for (int i = 0; i < 3000; ++i) {
+        letters.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+        expected += letters.back();
+    }
+    CHECK(parallel_reduce(pool, std::span<const std::string>(letters), std::string(">"), std::plus<>(), test_grain) ==
+        expected);
+
+    std::vector<int> in(10);
+    std::vector<int> out(9);
+    CHECK_THROWS_AS(parallel_transform(pool, std::span<int>(in), std::span<int>(out), [](int v) { return v; }),
+        std::invalid_argument);
+}
+
+TEST_CASE("Test parallel scans match std scans") {
+    ThreadPool pool(3);
+    for (std::size_t count : test_sizes) {
+        std::vector<int> values = random_values(count, 100);
+        std::vector<long> inclusive(count);
+        std::vector<long> expected(count);
+        parallel_inclusive_scan(pool, std::span<const int>(values), std::span<long>(inclusive), std::plus<>(),
+            test_grain);
+        std::inclusive_scan(values.begin(), values.end(), expected.begin(), std::plus<>(), 0L);
+        REQUIRE(inclusive == expected);
+
+        std::vector<long> exclusive(count);
+        parallel_exclusive_scan(pool, std::span<const int>(values), std::span<long>(exclusive), 7L, std::plus<>(),
+            test_grain);
+        std::exclusive_scan(values.begin(), values.end(), expected.begin(), 7L);
+        REQUIRE(exclusive == expected);
+
+        // In place
+        std::vector<int> copy = values;
+        parallel_inclusive_scan(pool, std::span<int>(copy), std::span<int>(copy), std::plus<>(), test_grain);
+        std::inclusive_scan(values.begin(), values.end(), values.begin());
+        REQUIRE(copy == values);
+    }
+
+    std::vector<int> in(10);
+    std::vector<int> out(11);
+    CHECK_THROWS_AS(parallel_exclusive_scan(pool, std::span<int>(in), std::span<int>(out), 0), std::invalid_argument);
+}
+
+TEST_CASE("Test parallel partition is stable") {
+    ThreadPool pool(3);
+    for (std::size_t count : test_sizes) {
+        std::vector<int> values = random_values(count, 1000);
+        std::vector<int> expected = values;
+        const auto is_even = [](int v) { return v % 2 == 0; };
+        const auto split = std::stable_partition(expected.begin(), expected.end(), is_even) - expected.begin();
+        const std::size_t matched = parallel_partition(pool, std::span<int>(values), is_even, test_grain);
+        REQUIRE(matched == static_cast<std::size_t>(split));
+        REQUIRE(values == expected);
+    }
+}
+
+TEST_CASE("Test parallel algorithms on a pool without threads") {
+    ThreadPool pool(0);
+    std::vector<int> values = random_values(1000, 50);
+    std::vector<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+    parallel_sort(pool, std::span<int>(values), std::less<>(), 16);
+    CHECK(values == expected);
+    CHECK(parallel_reduce(pool, std::span<int>(values), 0) == std::accumulate(values.begin(), values.end(), 0));
+}
@@ -0,0 +1,257 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/allocators/polymorphicAllocator.h>
+#include <algorithmCollection/data structures/bTree.h>
+#include <algorithmCollection/data structures/binaryTree.h>
+#include <algorithmCollection/data structures/deque.h>
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/fixedArray.h>
+#include <algorithmCollection/data structures/hash_map.h>
+#include <algorithmCollection/data structures/hash_multimap.h>
+#include <algorithmCollection/data structures/set.h>
+#include <algorithmCollection/data structures/single_linkedList.h>
+#include <algorithmCollection/data structures/smallDynamicArray.h>
+#include <memory_resource>
+#include <string>
+
+namespace {
+// Counts the bytes it hands out on top of the new/delete resource
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t live_bytes = 0;
+    std::size_t allocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        live_bytes += bytes;
+        ++allocations;
+        return p;
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        live_bytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Makes both the default resource and the resource of containers built without one observable
+class DefaultResourceScope {
+public:
+    explicit DefaultResourceScope(std::pmr::memory_resource* resource)
+        : m_previous(std::pmr::set_default_resource(resource)) {}
+
+    ~DefaultResourceScope() { std::pmr::set_default_resource(m_previous); }
+
+private:
+    std::pmr::memory_resource* m_previous;
+};
+}
+
+TEST_CASE("Test polymorphic allocator draws from its resource") {
+    CountingResource resource;
+    PolymorphicAllocator<int> alloc(&resource);
+
+    int* values = alloc.allocate(10);
+    CHECK(resource.live_bytes == 10 * sizeof(int));
+    alloc.deallocate(values, 10);
+    CHECK(resource.live_bytes == 0);
+    CHECK_THROWS_AS(alloc.allocate(static_cast<std::size_t>(-1)), std::bad_array_new_length);
+
+    PolymorphicAllocator<double> rebound(alloc);
+    CHECK(rebound.resource() == &resource);
+    CHECK(rebound == alloc);
+    CHECK(PolymorphicAllocator<int>().resource() == std::pmr::get_default_resource());
+    CHECK(PolymorphicAllocator<int>(&resource) != PolymorphicAllocator<int>());
+
+    // Copies of a container do not inherit the resource
+    CHECK(alloc.select_on_container_copy_construction().resource() == std::pmr::get_default_resource());
+
+    using Traits = std::allocator_traits<PolymorphicAllocator<int>>;
+    static_assert(!Traits::propagate_on_container_copy_assignment::value);
+    static_assert(!Traits::propagate_on_container_move_assignment::value);
+    static_assert(!Traits::propagate_on_container_swap::value);
+}
+
+TEST_CASE("Test polymorphic allocator keeps each container on its own resource") {
+    CountingResource first_resource;
+    CountingResource second_resource;
+    using Array = DynamicArray<std::string, PolymorphicAllocator<std::string>>;
+
+    {
+        Array first(&first_resource);
+        Array second(&second_resource);
+        for (int i = 0; i < 20; ++i) {
+            first.push_back(std::to_string(i));
+        }
+        const std::size_t first_bytes = first_resource.live_bytes;
+        CHECK(first_bytes > 0);
+
+        // Moving across resources moves the elements into the target's storage
+        second = std::move(first);
+        CHECK(second.get_allocator().resource() == &second_resource);
+        CHECK(first.get_allocator().resource() == &first_resource);
+        CHECK(second.size() == 20);
+        CHECK(second[19] == "19");
+        CHECK(second_resource.live_bytes > 0);
+
+        // Moving within one resource takes the storage
+        Array third(&second_resource);
+        const std::size_t allocations = second_resource.allocations;
+        third = std::move(second);
+        CHECK(second_resource.allocations == allocations);
+        CHECK(third.size() == 20);
+        CHECK(second.empty());
+
+        // Copy assignment keeps the target's resource
+        Array fourth(&first_resource);
+        fourth = third;
+        CHECK(fourth.get_allocator().resource() == &first_resource);
+        CHECK(fourth == third);
+
+        // Extended move construction on another resource
+        Array fifth(std::move(third), PolymorphicAllocator<std::string>(&first_resource));
+        CHECK(fifth.get_allocator().resource() == &first_resource);
+        CHECK(fifth[0] == "0");
+    }
+    CHECK(first_resource.live_bytes == 0);
+    CHECK(second_resource.live_bytes == 0);
+}
+
+TEST_CASE("Test polymorphic allocator copies use the default resource") {
+    CountingResource resource;
+    CountingResource default_resource;
+    DefaultResourceScope scope(&default_resource);
+
+    DoubleLinkedList<int, PolymorphicAllocator<int>> list(&resource);
+    list.push_back(1);
+    list.push_back(2);
+    const std::size_t bytes = resource.live_bytes;
+
+    DoubleLinkedList<int, PolymorphicAllocator<int>> copy(list);
+    CHECK(copy.get_allocator().resource() == &default_resource);
+    CHECK(default_resource.live_bytes == bytes);
+    CHECK(copy == list);
+
+    // Swapping containers on one resource exchanges their nodes
+    DoubleLinkedList<int, PolymorphicAllocator<int>> other(&resource);
+    other.push_back(3);
+    list.swap(other);
+    CHECK(list.size() == 1);
+    CHECK(other.size() == 2);
+    CHECK(list.get_allocator().resource() == &resource);
+}
+
+TEST_CASE("Test polymorphic allocator passes its resource to nested containers") {
+    CountingResource resource;
+    CountingResource default_resource;
+    DefaultResourceScope scope(&default_resource);
+
+    {
+        using Inner = DoubleLinkedList<int, PolymorphicAllocator<int>>;
+        DynamicArray<Inner, PolymorphicAllocator<Inner>> lists(&resource);
+        lists.emplace_back();
+        lists.back().push_back(7);
+        lists.resize(4);
+        CHECK(lists.back().get_allocator().resource() == &resource);
+        CHECK(*lists.front().begin() == 7);
+
+        DoubleLinkedList<std::pmr::string, PolymorphicAllocator<std::pmr::string>> strings(&resource);
+        strings.emplace_back("long enough to leave the small string buffer");
+        CHECK(strings.begin()->get_allocator().resource() == &resource);
+
+        HashMap<int, std::pmr::string, std::hash<int>, std::equal_to<int>,
+            PolymorphicAllocator<std::pair<const int, std::pmr::string>>> map(&resource);
+        map.try_emplace(1, "another string that does not fit in the small buffer");
+        CHECK(map.at(1).get_allocator().resource() == &resource);
+    }
+    CHECK(default_resource.allocations == 0);
+    CHECK(resource.live_bytes == 0);
+}
+
+TEST_CASE("Test polymorphic allocator in every container") {
+    CountingResource first_resource;
+    CountingResource second_resource;
+
+    {
+        SingleLinkedList<int, PolymorphicAllocator<int>> single(&first_resource);
+        single.push_front(1);
+        SingleLinkedList<int, PolymorphicAllocator<int>> single_target(&second_resource);
+        single_target = std::move(single);
+        CHECK(single_target.front() == 1);
+
+        Deque<int, PolymorphicAllocator<int>> deque(&first_resource);
+        deque.push_back(1);
+        deque.push_front(0);
+        Deque<int, PolymorphicAllocator<int>> deque_target(&second_resource);
+        deque_target = std::move(deque);
+        CHECK(deque_target.get_allocator().resource() == &second_resource);
+        CHECK(deque_target.front() == 0);
+        deque_target = deque_target;
+        CHECK(deque_target.size() == 2);
+
+        SmallDynamicArray<int, 2, PolymorphicAllocator<int>> small(&first_resource);
+        for (int i = 0; i < 10; ++i) {
+            small.push_back(i);
+        }
+        SmallDynamicArray<int, 2, PolymorphicAllocator<int>> small_target(&second_resource);
+        small_target = std::move(small);
+        CHECK(small_target.get_allocator().resource() == &second_resource);
+        CHECK(small_target[9] == 9);
+
+        FixedArray<int, 64, PolymorphicAllocator<int>> fixed(&first_resource);
+        fixed[63] = 5;
+        FixedArray<int, 64, PolymorphicAllocator<int>> fixed_copy(fixed, &second_resource);
+        CHECK(fixed_copy[63] == 5);
+
+        HashMap<int, int, std::hash<int>, std::equal_to<int>, PolymorphicAllocator<std::pair<const int, int>>> map(&first_resource);
+        for (int i = 0; i < 100; ++i) {
+            map.insert({i, i});
+        }
+        decltype(map) map_target(&second_resource);
+        map_target = std::move(map);
+        CHECK(map_target.size() == 100);
+        CHECK(map_target.at(42) == 42);
+        map = map_target;
+        CHECK(map.size() == 100);
+        CHECK(map.get_allocator().resource() == &first_resource);
+
+        HashMultiMap<int, int, std::hash<int>, std::equal_to<int>, PolymorphicAllocator<std::pair<const int, int>>> multimap(&first_resource);
+        multimap.insert({1, 1});
+        multimap.insert({1, 2});
+        decltype(multimap) multimap_target(&second_resource);
+        multimap_target = std::move(multimap);
+        CHECK(multimap_target.count(1) == 2);
+        CHECK(multimap.empty());
+
+        BinaryTree<int, std::less<int>, PolymorphicAllocator<int>> tree(std::less<int>(), &first_resource);
+        for (int i = 0; i < 50; ++i) {
+            tree.insert(i);
+        }
+        BinaryTree<int, std::less<int>, PolymorphicAllocator<int>> tree_target(std::less<int>(), &second_resource);
+        tree_target = std::move(tree);
+        CHECK(tree_target.size() == 50);
+        CHECK(tree.empty());
+        CHECK(*tree_target.begin() == 0);
+        tree = tree_target;
+        CHECK(tree == tree_target);
+
+        Set<int, std::less<int>, PolymorphicAllocator<int>> set(&first_resource);
+        for (int i = 0; i < 500; ++i) {
+            set.insert(i);
+        }
+        Set<int, std::less<int>, PolymorphicAllocator<int>> set_target(&second_resource);
+        set_target = std::move(set);
+        CHECK(set_target.size() == 500);
+        CHECK(set.empty());
+        CHECK(set_target.contains(499));
+        set = set_target;
+        CHECK(set.size() == 500);
+    }
+    CHECK(first_resource.live_bytes == 0);
+    CHECK(second_resource.live_bytes == 0);
+}
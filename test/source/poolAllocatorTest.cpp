@@ -0,0 +1,186 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/allocators/poolAllocator.h>
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Outlives every thread_local, so destroying it must not touch per-thread state
+    PooledDoubleLinkedList<int> static_list;
+}
+
+TEST_CASE("Test pool hands out aligned nodes from contiguous blocks") {
+    PoolResource resource;
+    PoolAllocator<double, 8> alloc(resource);
+
+    double* first = alloc.allocate(1);
+    double* second = alloc.allocate(1);
+
+    CHECK(reinterpret_cast<std::uintptr_t>(first) % alignof(double) == 0);
+    CHECK(second == first + 1);
+    CHECK(alloc.pool().in_use() == 2);
+    CHECK(alloc.pool().block_count() == 1);
+
+    alloc.deallocate(first, 1);
+    alloc.deallocate(second, 1);
+    CHECK(alloc.pool().in_use() == 0);
+}
+
+TEST_CASE("Test pool recycles freed nodes") {
+    PoolResource resource;
+    PoolAllocator<int, 4> alloc(resource);
+
+    int* a = alloc.allocate(1);
+    alloc.deallocate(a, 1);
+    int* b = alloc.allocate(1);
+    CHECK(a == b);
+
+    SUBCASE("A new block is only requested once the current one is used up") {
+        for (int i = 0; i < 3; ++i) {
+            alloc.allocate(1);
+        }
+        CHECK(alloc.pool().block_count() == 1);
+        alloc.allocate(1);
+        CHECK(alloc.pool().block_count() == 2);
+    }
+}
+
+TEST_CASE("Test pool allocator rebinding shares the resource") {
+    PoolResource resource;
+    PoolAllocator<int> ints(resource);
+    PoolAllocator<std::string> strings(ints);
+    PoolAllocator<int> back(strings);
+
+    CHECK(strings.resource() == &resource);
+    CHECK(ints == strings);
+    CHECK(back == ints);
+    CHECK(&back.pool() == &ints.pool());
+    CHECK(&strings.pool() != &ints.pool());
+
+    PoolResource other;
+    CHECK(ints != PoolAllocator<int>(other));
+}
+
+TEST_CASE("Test pool allocator array allocations") {
+    PoolResource resource;
+    PoolAllocator<int> alloc(resource);
+
+    int* values = alloc.allocate(16);
+    for (int i = 0; i < 16; ++i) {
+        values[i] = i;
+    }
+    CHECK(values[15] == 15);
+    CHECK(alloc.pool().in_use() == 0);
+    alloc.deallocate(values, 16);
+}
+
+TEST_CASE("Test pooled double linked list") {
+    PoolResource resource;
+    PooledDoubleLinkedList<std::string, 16> list{PoolAllocator<std::string, 16>(resource)};
+
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(std::to_string(i));
+    }
+
+    CHECK(list.size() == 100);
+    CHECK(list.front().data == "0");
+    CHECK(list.back().data == "99");
+    CHECK(list.get_allocator().pool().in_use() == 100);
+    CHECK(list.get_allocator().pool().block_count() == 7);
+
+    SUBCASE("Removed nodes are recycled") {
+        list.pop_front();
+        list.pop_back();
+        CHECK(list.get_allocator().pool().in_use() == 98);
+
+        list.push_back("100");
+        list.push_front("-1");
+        CHECK(list.get_allocator().pool().block_count() == 7);
+    }
+
+    SUBCASE("Clearing returns every node") {
+        list.clear();
+        CHECK(list.get_allocator().pool().in_use() == 0);
+    }
+}
+
+TEST_CASE("Test default constructed pooled list") {
+    PooledDoubleLinkedList<int> list;
+
+    list.push_back(1);
+    list.push_back(2);
+    CHECK(list.size() == 2);
+    CHECK(list.get_allocator().resource() == &PoolResource::shared_default());
+    CHECK(PoolResource::shared_default().synchronized());
+
+    static_list.push_back(3);
+    CHECK(static_list.back().data == 3);
+}
+
+TEST_CASE("Test default pooled lists cross threads") {
+    PooledDoubleLinkedList<std::string> moved;
+    std::thread([&] {
+        PooledDoubleLinkedList<std::string> local;
+        for (int i = 0; i < 100; ++i) {
+            local.push_back(std::to_string(i));
+        }
+        moved = std::move(local);
+    }).join();
+    CHECK(moved.size() == 100);
+    CHECK(moved.back().data == "99");
+    moved.pop_front();
+    moved.push_back("100");
+    CHECK(moved.front().data == "1");
+
+    // Threads filling and emptying their own lists at once share the default resource
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int round = 0; round < 20; ++round) {
+                PooledDoubleLinkedList<int> list;
+                for (int i = 0; i < 500; ++i) {
+                    list.push_back(i);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    moved.clear();
+    CHECK(moved.empty());
+}
+
+TEST_CASE("Test synchronized pool statistics read while other threads allocate") {
+    PoolResource resource(pool_synchronized);
+    PoolAllocator<int, 16> alloc(resource);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([alloc] {
+            PoolAllocator<int, 16> local(alloc);
+            for (int round = 0; round < 200; ++round) {
+                int* nodes[8];
+                for (int*& node : nodes) {
+                    node = local.allocate(1);
+                }
+                for (int* node : nodes) {
+                    local.deallocate(node, 1);
+                }
+            }
+        });
+    }
+    std::size_t peak = 0;
+    for (int i = 0; i < 1000; ++i) {
+        peak = std::max(peak, alloc.pool().in_use());
+        peak = std::max(peak, alloc.pool().block_count());
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(peak <= 16);
+    CHECK(alloc.pool().in_use() == 0);
+}
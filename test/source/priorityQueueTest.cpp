@@ -0,0 +1,303 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/priority_queue.h>
+#include <algorithmCollection/data structures/deque.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    template <std::size_t Arity>
+    void check_against_std(unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> dist(0, 500);
+        PriorityQueue<int, std::less<int>, Arity> queue;
+        std::priority_queue<int> reference;
+        for (int i = 0; i < 5000; ++i) {
+            if (reference.empty() || rng() % 3 != 0) {
+                const int value = dist(rng);
+                queue.push(value);
+                reference.push(value);
+            } else {
+                REQUIRE(queue.top() == reference.top());
+                queue.pop();
+                reference.pop();
+            }
+            REQUIRE(queue.size() == reference.size());
+        }
+        while (!reference.empty()) {
+            REQUIRE(queue.top() == reference.top());
+            queue.pop();
+            reference.pop();
+        }
+        CHECK(queue.empty());
+    }
+}
+
+TEST_CASE("Test priority queue orders like std::priority_queue") {
+    check_against_std<2>(1);
+    check_against_std<3>(2);
+    check_against_std<4>(3);
+    check_against_std<8>(4);
+}
+
+TEST_CASE("Test priority queue on an empty queue") {
+    PriorityQueue<int> queue;
+    CHECK(queue.empty());
+    CHECK_THROWS_AS(queue.top(), std::out_of_range);
+    CHECK_THROWS_AS(queue.pop(), std::logic_error);
+    CHECK_THROWS_AS(queue.replace_top(1), std::logic_error);
+    CHECK_THROWS_AS(queue.take_top(), std::logic_error);
+}
+
+TEST_CASE("Test priority queue min-heap with std::greater") {
+    PriorityQueue<std::string, std::greater<std::string>> queue{"pear", "apple", "fig", "kiwi"};
+    CHECK(queue.top() == "apple");
+    queue.emplace(3, 'a');
+    CHECK(queue.top() == "aaa");
+    CHECK(queue.take_top() == "aaa");
+    CHECK(queue.take_top() == "apple");
+    CHECK(queue.take_top() == "fig");
+    CHECK(queue.size() == 2);
+}
+
+TEST_CASE("Test priority queue bulk construction") {
+    DynamicArray<int> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back((i * 7919) % 1000);
+    }
+    PriorityQueue<int, std::less<int>, 4> from_container(values);
+    PriorityQueue<int, std::less<int>, 3> from_range(values.begin(), values.end());
+    CHECK(from_container.size() == 1000);
+    for (int expected = 999; expected >= 0; --expected) {
+        REQUIRE(from_container.take_top() == expected);
+        REQUIRE(from_range.take_top() == expected);
+    }
+
+    PriorityQueue<int> queue{5, 1};
+    queue.assign(values.begin(), values.begin() + 10);
+    CHECK(queue.size() == 10);
+    int previous = queue.take_top();
+    while (!queue.empty()) {
+        REQUIRE(queue.top() <= previous);
+        previous = queue.take_top();
+    }
+}
+
+TEST_CASE("Test priority queue push_range") {
+    PriorityQueue<int> queue;
+    std::vector<int> reference;
+    std::mt19937 rng(7);
+    for (int batch : {1, 3, 50, 2, 200, 5}) {
+        std::vector<int> values;
+        for (int i = 0; i < batch; ++i) {
+            values.push_back(static_cast<int>(rng() % 1000));
+        }
+        queue.push_range(values.begin(), values.end());
+        reference.insert(reference.end(), values.begin(), values.end());
+    }
+    std::sort(reference.begin(), reference.end(), std::greater<int>());
+    for (int expected : reference) {
+        REQUIRE(queue.take_top() == expected);
+    }
+}
+
+TEST_CASE("Test priority queue replace_top") {
+    // Timer wheel style: the earliest deadline is rescheduled further out
+    PriorityQueue<int, std::greater<int>> timers{10, 20, 30};
+    timers.replace_top(25);
+    CHECK(timers.top() == 20);
+    timers.replace_top(5);
+    CHECK(timers.top() == 5);
+    CHECK(timers.size() == 3);
+    CHECK(timers.take_top() == 5);
+    CHECK(timers.take_top() == 25);
+    CHECK(timers.take_top() == 30);
+}
+
+TEST_CASE("Test priority queue over a deque with move only values") {
+    auto comp = [](const std::unique_ptr<int>& lhs, const std::unique_ptr<int>& rhs) { return *lhs < *rhs; };
+    PriorityQueue<std::unique_ptr<int>, decltype(comp), 2, Deque<std::unique_ptr<int>>> queue(comp);
+    for (int i : {4, 9, 1, 7}) {
+        queue.push(std::make_unique<int>(i));
+    }
+    CHECK(*queue.top() == 9);
+    std::unique_ptr<int> top = queue.take_top();
+    CHECK(*top == 9);
+    CHECK(*queue.top() == 7);
+}
+
+TEST_CASE("Test priority queue swap") {
+    PriorityQueue<int> a{1, 2, 3};
+    PriorityQueue<int> b{10};
+    swap(a, b);
+    CHECK(a.size() == 1);
+    CHECK(a.top() == 10);
+    CHECK(b.size() == 3);
+    CHECK(b.top() == 3);
+}
+
+TEST_CASE("Test indexed priority queue handles") {
+    IndexedPriorityQueue<int, std::greater<int>> queue;
+    auto a = queue.push(50);
+    auto b = queue.push(40);
+    auto c = queue.push(30);
+    CHECK(queue.top() == 30);
+    CHECK(queue.top_handle() == c);
+
+    queue.decrease_key(a, 10);
+    CHECK(queue.top() == 10);
+    CHECK(queue.top_handle() == a);
+    CHECK(queue.value(a) == 10);
+    CHECK_THROWS_AS(queue.decrease_key(b, 45), std::invalid_argument);
+    CHECK(queue.value(b) == 40);
+
+    queue.update(a, 60);
+    CHECK(queue.top() == 30);
+    queue.erase(c);
+    CHECK_FALSE(queue.contains(c));
+    CHECK(queue.top_handle() == b);
+    CHECK(queue.size() == 2);
+    CHECK_THROWS_AS(queue.erase(c), std::invalid_argument);
+    CHECK_THROWS_AS(queue.value(c), std::invalid_argument);
+
+    // The slot of c is reused, but the old handle stays invalid
+    auto d = queue.push(1);
+    CHECK(queue.contains(d));
+    CHECK_FALSE(queue.contains(c));
+    CHECK(queue.top_handle() == d);
+
+    queue.pop();
+    queue.pop();
+    CHECK(queue.top_handle() == a);
+    queue.clear();
+    CHECK(queue.empty());
+    CHECK_FALSE(queue.contains(a));
+    CHECK_THROWS_AS(queue.top(), std::out_of_range);
+    CHECK_THROWS_AS(queue.pop(), std::logic_error);
+    CHECK_FALSE(queue.contains(decltype(queue)::Handle{}));
+}
+
+TEST_CASE("Test indexed priority queue reuses slots after clear and move") {
+    IndexedPriorityQueue<int> queue;
+    DynamicArray<decltype(queue)::Handle> old_handles;
+    for (int i = 0; i < 100; ++i) {
+        old_handles.push_back(queue.push(i));
+    }
+    queue.erase(old_handles[10]);
+    queue.clear();
+    CHECK(queue.empty());
+
+    for (int i = 0; i < 100; ++i) {
+        auto handle = queue.push(i + 1000);
+        CHECK(queue.value(handle) == i + 1000);
+    }
+    for (const auto& handle : old_handles) {
+        REQUIRE_FALSE(queue.contains(handle));
+    }
+    CHECK(queue.top() == 1099);
+
+    // A moved-from queue starts over with no slots
+    IndexedPriorityQueue<int> moved(std::move(queue));
+    CHECK(moved.size() == 100);
+    auto fresh = queue.push(7);
+    CHECK(queue.size() == 1);
+    CHECK(queue.top_handle() == fresh);
+    queue = std::move(moved);
+    CHECK(queue.size() == 100);
+    auto reused = moved.push(8);
+    CHECK(moved.value(reused) == 8);
+    static_assert(noexcept(queue.clear()));
+}
+
+TEST_CASE("Test indexed priority queue random operations") {
+    using Queue = IndexedPriorityQueue<int, std::less<int>, 4>;
+    Queue queue;
+    std::multimap<int, Queue::Handle> reference;
+    std::vector<std::pair<Queue::Handle, int>> live;
+    std::mt19937 rng(11);
+
+    auto forget = [&](Queue::Handle handle, int value) {
+        auto [first, last] = reference.equal_range(value);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == handle) {
+                reference.erase(it);
+                break;
+            }
+        }
+        for (std::size_t i = 0; i < live.size(); ++i) {
+            if (live[i].first == handle) {
+                live[i] = live.back();
+                live.pop_back();
+                break;
+            }
+        }
+    };
+
+    for (int step = 0; step < 6000; ++step) {
+        const unsigned op = rng() % 5;
+        if (live.empty() || op == 0) {
+            const int value = static_cast<int>(rng() % 1000);
+            auto handle = queue.push(value);
+            reference.emplace(value, handle);
+            live.emplace_back(handle, value);
+        } else if (op == 1) {
+            REQUIRE(queue.top() == reference.rbegin()->first);
+            const auto handle = queue.top_handle();
+            forget(handle, queue.top());
+            queue.pop();
+            REQUIRE_FALSE(queue.contains(handle));
+        } else if (op == 2) {
+            auto [handle, value] = live[rng() % live.size()];
+            forget(handle, value);
+            queue.erase(handle);
+        } else {
+            auto& [handle, value] = live[rng() % live.size()];
+            const int new_value = static_cast<int>(rng() % 1000);
+            auto [first, last] = reference.equal_range(value);
+            for (auto it = first; it != last; ++it) {
+                if (it->second == handle) {
+                    reference.erase(it);
+                    break;
+                }
+            }
+            reference.emplace(new_value, handle);
+            if (op == 3) {
+                queue.update(handle, new_value);
+            } else if (new_value >= value) {
+                queue.decrease_key(handle, new_value);
+            } else {
+                queue.update(handle, new_value);
+            }
+            value = new_value;
+        }
+        REQUIRE(queue.size() == reference.size());
+        if (!queue.empty()) {
+            REQUIRE(queue.top() == reference.rbegin()->first);
+        }
+    }
+    for (auto& [handle, value] : live) {
+        REQUIRE(queue.value(handle) == value);
+    }
+}
+
+TEST_CASE("Test indexed priority queue bulk assign") {
+    IndexedPriorityQueue<int> queue;
+    queue.push(1000);
+    std::vector<int> values{5, 3, 9, 1, 7, 2, 8};
+    auto handles = queue.assign(values.begin(), values.end());
+    REQUIRE(handles.size() == values.size());
+    CHECK(queue.size() == values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        CHECK(queue.value(handles[i]) == values[i]);
+    }
+    queue.update(handles[3], 100);
+    CHECK(queue.top_handle() == handles[3]);
+    queue.pop();
+    CHECK(queue.top() == 9);
+}
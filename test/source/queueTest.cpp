@@ -0,0 +1,38 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/queue.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE("Test queue is first in first out") {
+    Queue<int> queue;
+    CHECK(queue.empty());
+    for (int i = 0; i < 1000; ++i) {
+        queue.push(i);
+    }
+    CHECK(queue.size() == 1000);
+    CHECK(queue.back() == 999);
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(queue.front() == i);
+        queue.pop();
+    }
+    CHECK(queue.empty());
+    CHECK_THROWS_AS(queue.pop(), std::logic_error);
+    CHECK_THROWS_AS(queue.front(), std::out_of_range);
+}
+
+TEST_CASE("Test queue over a dynamic array") {
+    Queue<std::string, DynamicArray<std::string>> queue;
+    queue.push("first");
+    queue.emplace(3, 'x');
+    CHECK(queue.front() == "first");
+    CHECK(queue.back() == "xxx");
+    queue.pop();
+    CHECK(queue.front() == "xxx");
+    CHECK(queue.container().size() == 1);
+
+    Queue<std::string, DynamicArray<std::string>> other;
+    swap(queue, other);
+    CHECK(queue.empty());
+    CHECK(other.size() == 1);
+}
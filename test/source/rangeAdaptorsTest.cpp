@@ -0,0 +1,152 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/algorithms/rangeAdaptors.h>
+#include <algorithmCollection/data structures/deque.h>
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <algorithmCollection/data structures/tabular.h>
+#include <ranges>
+#include <span>
+#include <string>
+
+namespace {
+    // Filters even values and squares them, the pipeline every container runs below
+    template <typename R>
+    auto squared_evens(R&& range) {
+        return std::forward<R>(range) | std::views::filter([](int value) { return value % 2 == 0; })
+            | std::views::transform([](int value) { return value * value; });
+    }
+}
+
+TEST_CASE("Test range pipelines collect from every container") {
+    DynamicArray<int> array;
+    DoubleLinkedList<int> list;
+    Deque<int> deque;
+    Tabular<int, double> table;
+    for (int i = 0; i < 10; ++i) {
+        array.push_back(i);
+        list.push_back(i);
+        deque.push_back(i);
+        table.push_back(i, i * 0.5);
+    }
+    const DynamicArray<int> expected{0, 4, 16, 36, 64};
+
+    DynamicArray<int> out;
+    CHECK(&(squared_evens(array) | collect_into(out)) == &out);
+    CHECK(out == expected);
+    CHECK((squared_evens(list) | collect()) == expected);
+    CHECK((squared_evens(deque) | collect()) == expected);
+    CHECK((squared_evens(table.column<0>()) | collect()) == expected);
+
+    // collect_into appends
+    squared_evens(list) | collect_into(out);
+    CHECK(out.size() == 10);
+    CHECK(out[5] == 0);
+    CHECK(out[9] == 64);
+
+    // Empty sources leave the destination untouched
+    DynamicArray<int> empty;
+    squared_evens(empty) | collect_into(out);
+    CHECK(out.size() == 10);
+    CHECK((squared_evens(DoubleLinkedList<int>()) | collect()).empty());
+}
+
+TEST_CASE("Test collect_into reserves once for sized ranges") {
+    DoubleLinkedList<std::string> words;
+    for (int i = 0; i < 100; ++i) {
+        words.push_back(std::to_string(i));
+    }
+
+    // A transform keeps the size of the list, so the destination allocates exactly once
+    DynamicArray<std::size_t> lengths;
+    lengths.push_back(0);
+    words | std::views::transform([](const std::string& word) { return word.size(); }) | collect_into(lengths);
+    CHECK(lengths.size() == 101);
+    CHECK(lengths.capacity() == 101);
+    CHECK(lengths[100] == 2);
+
+    // Contiguous sources are copied in bulk
+    DynamicArray<int> source{1, 2, 3, 4, 5};
+    DynamicArray<int> copy;
+    std::span<const int>(source) | collect_into(copy);
+    CHECK(copy == source);
+    CHECK(copy.capacity() == 5);
+
+    // Unsized ranges reserve the hint when given one
+    DynamicArray<int> evens;
+    source | std::views::filter([](int value) { return value % 2 == 0; }) | collect_into(evens, 3);
+    CHECK(evens == DynamicArray<int>{2, 4});
+    CHECK(evens.capacity() == 3);
+}
+
+TEST_CASE("Test batched spans contiguous ranges in place") {
+    DynamicArray<int> values;
+    for (int i = 0; i < 10; ++i) {
+        values.push_back(i);
+    }
+
+    auto batches = values | batched<4>;
+    static_assert(std::ranges::input_range<decltype(batches)>);
+    CHECK(batches.size() == 3);
+    DynamicArray<std::size_t> sizes;
+    int next = 0;
+    for (std::span<int> batch : batches) {
+        CHECK(batch.data() == &values[next]);
+        sizes.push_back(batch.size());
+        next += static_cast<int>(batch.size());
+        batch[0] = -1;
+    }
+    CHECK(sizes == DynamicArray<std::size_t>{4, 4, 2});
+    CHECK(values[4] == -1);
+    CHECK(values[8] == -1);
+
+    Tabular<float> table;
+    for (int i = 0; i < 8; ++i) {
+        table.push_back(static_cast<float>(i));
+    }
+    float total = 0;
+    for (std::span<float> batch : table.column<0>() | batched<8>) {
+        total += column_sum(batch);
+    }
+    CHECK(total == 28.0f);
+
+    DynamicArray<int> empty;
+    CHECK((empty | batched<4>).begin() == std::default_sentinel);
+}
+
+TEST_CASE("Test batched gathers other ranges into its buffer") {
+    DoubleLinkedList<int> list;
+    for (int i = 0; i < 11; ++i) {
+        list.push_back(i);
+    }
+
+    auto batches = list | std::views::transform([](int value) { return value * 10; }) | batched<4>;
+    CHECK(batches.size() == 3);
+    DynamicArray<int> seen;
+    DynamicArray<std::size_t> sizes;
+    for (std::span<const int> batch : batches) {
+        sizes.push_back(batch.size());
+        for (int value : batch) {
+            seen.push_back(value);
+        }
+    }
+    CHECK(sizes == DynamicArray<std::size_t>{4, 4, 3});
+    CHECK(seen.size() == 11);
+    CHECK(seen[10] == 100);
+
+    // Deques and filters have no contiguous storage either
+    Deque<int> deque;
+    for (int i = 0; i < 6; ++i) {
+        deque.push_front(i);
+    }
+    int sum = 0;
+    std::size_t count = 0;
+    for (auto batch : deque | std::views::filter([](int value) { return value > 1; }) | batched<3>) {
+        for (int value : batch) {
+            sum += value;
+        }
+        ++count;
+    }
+    CHECK(sum == 14);
+    CHECK(count == 2);
+
+    CHECK((DoubleLinkedList<int>() | batched<4>).begin() == std::default_sentinel);
+}
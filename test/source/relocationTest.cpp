@@ -0,0 +1,214 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/allocators/arenaAllocator.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/relocation.h>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Handle type that counts its moves. It owns no self-references, so it opts into trivial
+    // relocation and the array must never call its move constructor while growing or shifting.
+    struct Handle {
+        static inline int moves = 0;
+
+        int id;
+
+        explicit Handle(int i) : id(i) {}
+        Handle(const Handle& other) : id(other.id) {}
+        Handle(Handle&& other) noexcept : id(other.id) { ++moves; }
+        Handle& operator=(const Handle& other) = default;
+        Handle& operator=(Handle&& other) noexcept {
+            id = other.id;
+            ++moves;
+            return *this;
+        }
+        ~Handle() {}
+    };
+
+    // Relocatable element counting the live instances, to catch a leaked staged element
+    struct Tracked {
+        static inline int live = 0;
+
+        int id;
+
+        explicit Tracked(int i) : id(i) { ++live; }
+        Tracked(const Tracked& other) : id(other.id) { ++live; }
+        ~Tracked() { --live; }
+    };
+
+    // Element whose move may throw, so growth copies it; the copy numbered fail_at throws
+    struct FragileCopy {
+        static inline int live = 0;
+        static inline int copies = 0;
+        static inline int fail_at = -1;
+
+        std::string value;
+
+        explicit FragileCopy(std::string v) : value(std::move(v)) { ++live; }
+        FragileCopy(const FragileCopy& other) : value(other.value) {
+            if (copies++ == fail_at) {
+                throw std::runtime_error("copy");
+            }
+            ++live;
+        }
+        FragileCopy(FragileCopy&& other) noexcept(false) : value(std::move(other.value)) { ++live; }
+        FragileCopy& operator=(const FragileCopy&) = default;
+        FragileCopy& operator=(FragileCopy&&) = default;
+        ~FragileCopy() { --live; }
+    };
+
+    // Allocator whose reallocate() throws instead of returning nullptr
+    template <typename T>
+    struct ThrowingReallocator {
+        using value_type = T;
+
+        ThrowingReallocator() = default;
+
+        template <typename U>
+        ThrowingReallocator(const ThrowingReallocator<U>&) noexcept {}
+
+        T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+        void deallocate(T* p, std::size_t n) noexcept { std::allocator<T>().deallocate(p, n); }
+        T* reallocate(T*, std::size_t, std::size_t) { throw std::bad_alloc(); }
+
+        bool operator==(const ThrowingReallocator&) const noexcept { return true; }
+    };
+}
+
+template <>
+struct is_trivially_relocatable<Tracked> : std::true_type {};
+
+template <>
+struct is_trivially_relocatable<Handle> : std::true_type {};
+
+TEST_CASE("Test trivially relocatable trait") {
+    CHECK(is_trivially_relocatable_v<int>);
+    CHECK(is_trivially_relocatable_v<const double>);
+    CHECK(is_trivially_relocatable_v<std::unique_ptr<int>>);
+    CHECK(is_trivially_relocatable_v<Handle>);
+    CHECK(!is_trivially_relocatable_v<std::string>);
+    CHECK(ReallocatingAllocator<SimpleAllocator<int>, int>);
+    CHECK(ReallocatingAllocator<MonotonicArenaAllocator<int>, int>);
+}
+
+TEST_CASE("Test relocatable elements are never moved one by one") {
+    Handle::moves = 0;
+    DynamicArray<Handle> arr;
+
+    for (int i = 0; i < 100; ++i) {
+        arr.emplace_back(i);
+    }
+    arr.emplace(arr.cbegin() + 50, -1);
+    arr.push_front(Handle(-2));
+    arr.insert(arr.cbegin() + 10, 3, Handle(-3));
+    arr.erase(arr.cbegin() + 5);
+    arr.erase(arr.cbegin() + 20, arr.cbegin() + 30);
+    arr.pop_front();
+    arr.shrink_to_fit();
+
+    // The only moves are the two rvalue arguments passed to push_front and emplace's in-place path
+    CHECK(Handle::moves <= 1);
+    CHECK(arr.size() == 100 + 1 + 1 + 3 - 1 - 10 - 1);
+    CHECK(arr[0].id == 0);
+    CHECK(arr.back().id == 99);
+}
+
+TEST_CASE("Test DynamicArray of unique_ptr relocates ownership") {
+    DynamicArray<std::unique_ptr<int>> arr;
+    for (int i = 0; i < 20; ++i) {
+        arr.push_back(std::make_unique<int>(i));
+    }
+    arr.emplace(arr.cbegin(), std::make_unique<int>(-1));
+    arr.erase(arr.cbegin() + 1);
+
+    CHECK(arr.size() == 20);
+    CHECK(*arr[0] == -1);
+    CHECK(*arr[1] == 1);
+    CHECK(*arr.back() == 19);
+}
+
+TEST_CASE("Test growth by reallocate keeps self-referencing arguments valid") {
+    DynamicArray<int> arr = {7};
+    for (int i = 0; i < 10; ++i) {
+        arr.push_back(arr[0]);
+        arr.emplace(arr.cbegin(), arr.back());
+    }
+
+    CHECK(arr.size() == 21);
+    CHECK(std::all_of(arr.begin(), arr.end(), [](int value) { return value == 7; }));
+}
+
+TEST_CASE("Test a throwing reallocate destroys the staged element") {
+    static_assert(ReallocatingAllocator<ThrowingReallocator<Tracked>, Tracked>);
+    Tracked::live = 0;
+    {
+        DynamicArray<Tracked, ThrowingReallocator<Tracked>> arr;
+        arr.emplace_back(1);
+        arr.shrink_to_fit();
+        CHECK_THROWS_AS(arr.emplace_back(2), std::bad_alloc);
+        CHECK(arr.size() == 1);
+        CHECK(arr[0].id == 1);
+        CHECK(Tracked::live == 1);
+    }
+    CHECK(Tracked::live == 0);
+}
+
+TEST_CASE("Test growth copies elements whose move may throw and keeps the array on failure") {
+    FragileCopy::live = 0;
+    {
+        DynamicArray<FragileCopy> arr;
+        for (int i = 0; i < 8; ++i) {
+            arr.emplace_back("a string long enough to own a heap buffer " + std::to_string(i));
+        }
+        arr.shrink_to_fit();
+        const FragileCopy* storage = &arr[0];
+
+        FragileCopy::copies = 0;
+        FragileCopy::fail_at = 5;
+        CHECK_THROWS_AS(arr.emplace_back("extra"), std::runtime_error);
+        CHECK(arr.size() == 8);
+        CHECK(&arr[0] == storage);
+        CHECK(arr[7].value == "a string long enough to own a heap buffer 7");
+        CHECK(FragileCopy::live == 8);
+
+        FragileCopy::copies = 0;
+        CHECK_THROWS_AS(arr.emplace(arr.cbegin() + 3, "middle"), std::runtime_error);
+        CHECK(arr.size() == 8);
+        CHECK(FragileCopy::live == 8);
+
+        // Without failures the elements are copied across, never moved from
+        FragileCopy::fail_at = -1;
+        arr.emplace(arr.cbegin() + 3, "middle");
+        CHECK(arr.size() == 9);
+        CHECK(arr[3].value == "middle");
+        CHECK(arr[8].value == "a string long enough to own a heap buffer 7");
+        CHECK(FragileCopy::live == 9);
+    }
+    CHECK(FragileCopy::live == 0);
+}
+
+TEST_CASE("Test arena allocation grows in place when it is the last block") {
+    ArenaResource arena(1 << 16);
+    MonotonicArenaAllocator<int> alloc(arena);
+    DynamicArray<int, MonotonicArenaAllocator<int>> arr(alloc);
+
+    arr.push_back(0);
+    const int* storage = arr.data().data();
+    for (int i = 1; i < 1000; ++i) {
+        arr.push_back(i);
+    }
+
+    CHECK(arr.data().data() == storage);
+    CHECK(arr[999] == 999);
+    CHECK(arena.bytes_allocated() == arr.capacity() * sizeof(int));
+
+    SUBCASE("A later allocation forces a copy") {
+        arena.allocate(8);
+        arr.resize(arr.capacity() + 1);
+        CHECK(arr.data().data() != storage);
+        CHECK(arr[500] == 500);
+    }
+}
@@ -0,0 +1,68 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/set.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+
+TEST_CASE("Test set insert, find and erase") {
+    Set<int> set = {5, 3, 8, 1, 3};
+    CHECK(set.size() == 4);
+    CHECK(set.contains(3));
+    CHECK_FALSE(set.contains(4));
+    CHECK_FALSE(set.insert(5).second);
+    CHECK(*set.insert(4).first == 4);
+    CHECK(*set.begin() == 1);
+    CHECK(*set.rbegin() == 8);
+    CHECK(*set.upper_bound(4) == 5);
+    CHECK(set.erase(3) == 1);
+    CHECK(set.erase(3) == 0);
+    CHECK(*set.erase(set.find(4)) == 5);
+    CHECK(set.size() == 3);
+    set.clear();
+    CHECK(set.empty());
+}
+
+TEST_CASE("Test set matches std::set under random operations") {
+    BTree<BTreeSetPolicy<std::string>, std::less<std::string>, SimpleAllocator<std::string>, false, 64> set;
+    std::set<std::string> reference;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 10000; ++step) {
+        const std::string key = std::to_string(rng() % 500);
+        if (rng() % 3 == 0) {
+            CHECK(set.erase(key) == reference.erase(key));
+        } else {
+            CHECK(set.insert(key).second == reference.insert(key).second);
+        }
+        REQUIRE(set.size() == reference.size());
+    }
+    CHECK(std::equal(set.begin(), set.end(), reference.begin(), reference.end()));
+    CHECK(std::equal(set.rbegin(), set.rend(), reference.rbegin(), reference.rend()));
+}
+
+TEST_CASE("Test set bulk load and heterogeneous lookup") {
+    DynamicArray<std::string> sorted;
+    for (char c = 'a'; c <= 'z'; ++c) {
+        sorted.push_back(std::string(3, c));
+    }
+
+    Set<std::string, std::less<>> set;
+    set.bulk_load(sorted);
+    CHECK(set.size() == 26);
+    CHECK(set.contains(std::string_view("mmm")));
+    CHECK(*set.lower_bound(std::string_view("mz")) == "nnn");
+    CHECK(std::equal(set.begin(), set.end(), sorted.begin(), sorted.end()));
+
+    Set<int> large;
+    DynamicArray<int> values;
+    for (int i = 0; i < 100000; ++i) {
+        values.push_back(i);
+    }
+    large.bulk_load(values);
+    CHECK(large.size() == 100000);
+    CHECK(large.height() <= 4);
+    CHECK(*large.lower_bound(77777) == 77777);
+    CHECK(std::equal(large.begin(), large.end(), values.begin(), values.end()));
+}
@@ -0,0 +1,162 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/simdKernels.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/fixedArray.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // Every level up to the one this machine supports
+    std::vector<SimdLevel> available_levels() {
+        std::vector<SimdLevel> levels;
+        for (SimdLevel level : {SimdLevel::Portable, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            if (level <= simd_level()) {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+
+    // Kernels at every level against the std algorithms, for sizes around the vector widths and for
+    // windows starting at unaligned offsets
+    template <typename T>
+    void check_kernels() {
+        std::mt19937_64 rng(7);
+        std::vector<T> values(300);
+        for (T& value : values) {
+            value = static_cast<T>(rng() % 5);
+        }
+        for (SimdLevel level : available_levels()) {
+            for (std::size_t offset = 0; offset < 3; ++offset) {
+                for (std::size_t n = 0; n + offset <= values.size(); n += (n < 140 ? 1 : 37)) {
+                    const T* data = values.data() + offset;
+                    for (int needle = 0; needle < 6; ++needle) {
+                        const T value = static_cast<T>(needle);
+                        CHECK(simd_detail::find(level, data, n, value) ==
+                            static_cast<std::size_t>(std::find(data, data + n, value) - data));
+                        CHECK(simd_detail::count(level, data, n, value) ==
+                            static_cast<std::size_t>(std::count(data, data + n, value)));
+                    }
+
+                    std::vector<T> other(data, data + n);
+                    CHECK(simd_detail::mismatch(level, data, other.data(), n) == n);
+                    if (n > 0) {
+                        const std::size_t position = static_cast<std::size_t>(rng() % n);
+                        other[position] = static_cast<T>(9);
+                        CHECK(simd_detail::mismatch(level, data, other.data(), n) == position);
+
+                        const auto [low, high] = simd_detail::min_max(level, data, n);
+                        const auto expected = std::minmax_element(data, data + n);
+                        CHECK(low == *expected.first);
+                        CHECK(high == *expected.second);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Test simd kernels agree with the std algorithms for every element width") {
+    check_kernels<std::int8_t>();
+    check_kernels<std::uint8_t>();
+    check_kernels<std::int16_t>();
+    check_kernels<std::uint16_t>();
+    check_kernels<std::int32_t>();
+    check_kernels<std::uint64_t>();
+    check_kernels<std::int64_t>();
+    check_kernels<float>();
+    check_kernels<double>();
+    check_kernels<long double>();
+}
+
+TEST_CASE("Test simd kernels compare floating point values like ==") {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> values(40, 1.0);
+    values[20] = -0.0;
+    values[30] = nan;
+    for (SimdLevel level : available_levels()) {
+        CHECK(simd_detail::find(level, values.data(), values.size(), 0.0) == 20);
+        CHECK(simd_detail::find(level, values.data(), values.size(), nan) == values.size());
+        CHECK(simd_detail::count(level, values.data(), values.size(), 1.0) == 38);
+        // A NaN differs from itself, so identical arrays mismatch at its position
+        CHECK(simd_detail::mismatch(level, values.data(), values.data(), values.size()) == 30);
+    }
+    std::vector<double> copy = values;
+    CHECK_FALSE(simd_equal(std::span(values), std::span(copy)));
+    values[30] = copy[30] = 2.0;
+    CHECK(simd_equal(std::span(values), std::span(copy)));
+}
+
+TEST_CASE("Test simd compare is lexicographic") {
+    const std::vector<int> a = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::vector<int> b = a;
+    CHECK(simd_compare(std::span(a), std::span(b)) == std::strong_ordering::equal);
+    b[7] = -1;
+    CHECK(simd_compare(std::span(a), std::span(b)) == std::strong_ordering::greater);
+    CHECK(simd_compare(std::span(b), std::span(a)) == std::strong_ordering::less);
+    CHECK(simd_compare(std::span(a).first(4), std::span(a)) == std::strong_ordering::less);
+
+    const std::vector<std::uint8_t> bytes = {1, 200, 3};
+    const std::vector<std::uint8_t> other = {1, 7, 3};
+    CHECK(simd_compare(std::span(bytes), std::span(other)) == std::strong_ordering::greater);
+    CHECK(simd_compare(std::span(bytes).first(0), std::span(other).first(0)) == std::strong_ordering::equal);
+
+    const std::vector<double> reals = {1.0, std::numeric_limits<double>::quiet_NaN()};
+    CHECK(simd_compare(std::span(reals), std::span(reals)) == std::partial_ordering::unordered);
+    CHECK_THROWS_AS(simd_min_max(std::span(reals).first(0)), std::logic_error);
+}
+
+TEST_CASE("Test dynamic array lookups and comparisons use the kernels") {
+    DynamicArray<int> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i % 100);
+    }
+    CHECK(values.find(42) == values.begin() + 42);
+    CHECK(values.find(100) == values.end());
+    CHECK(values.contains(99));
+    CHECK_FALSE(values.contains(-1));
+    CHECK(values.count(7) == 10);
+
+    DynamicArray<int> copy = values;
+    CHECK(copy == values);
+    CHECK((copy <=> values) == std::strong_ordering::equal);
+    copy[500] = 1000;
+    CHECK(copy != values);
+    CHECK(copy > values);
+    CHECK(DynamicArray<int>{} == DynamicArray<int>{});
+
+    DynamicArray<std::string> words = {"a", "b", "c"};
+    CHECK(words.find("b") == words.begin() + 1);
+    CHECK(words.count("d") == 0);
+}
+
+TEST_CASE("Test fixed array lookups and lexicographic comparison") {
+    FixedArray<std::uint16_t, 100> values;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<std::uint16_t>(i * 3);
+    }
+    CHECK(values.find(30) == values.begin() + 10);
+    CHECK(values.find(31) == values.end());
+    CHECK(values.contains(297));
+    CHECK(values.count(0) == 1);
+
+    FixedArray<std::uint16_t, 100> larger = values;
+    larger[60] = 1000;
+    CHECK(values < larger);
+    CHECK(larger > values);
+    CHECK((values <=> values) == std::strong_ordering::equal);
+
+    FixedArray<std::string, 2> words = {"x", "y"};
+    CHECK(words < FixedArray<std::string, 2>{"x", "z"});
+    CHECK(words.contains("y"));
+}
+
+// Constant evaluation takes the scalar path
+static_assert(FixedArray<int, 3>{1, 2, 3} < FixedArray<int, 3>{1, 3, 0});
+static_assert(FixedArray<int, 3>{1, 2, 3}.contains(3));
+static_assert(FixedArray<int, 4>{5, 5, 1}.count(5) == 2);
@@ -0,0 +1,220 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/single_linkedList.h>
+#include <algorithm>
+#include <forward_list>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Test single linked list push, insert_after and erase_after") {
+    SingleLinkedList<int> list;
+    CHECK(list.empty());
+    CHECK_THROWS_AS(list.front(), std::out_of_range);
+    CHECK_THROWS_AS(list.pop_front(), std::logic_error);
+
+    list.push_front(3);
+    list.push_front(1);
+    CHECK(list.front() == 1);
+    auto it = list.insert_after(list.begin(), 2);
+    CHECK(*it == 2);
+    it = list.insert_after(std::next(it), {4, 5});
+    CHECK(*it == 5);
+    list.insert_after(list.before_begin(), 2, 0);
+    CHECK(list == SingleLinkedList<int>{0, 0, 1, 2, 3, 4, 5});
+    CHECK(list.size() == 7);
+
+    CHECK(*list.erase_after(list.before_begin()) == 0);
+    list.pop_front();
+    CHECK(list.front() == 1);
+    CHECK(*list.erase_after(list.begin(), std::next(list.begin(), 3)) == 4);
+    CHECK(list == SingleLinkedList<int>{1, 4, 5});
+    CHECK_THROWS_AS(list.erase_after(std::next(list.begin(), 2)), std::out_of_range);
+    CHECK(*list.emplace_after(list.begin(), 9) == 9);
+    CHECK(list.size() == 4);
+    list.clear();
+    CHECK(list.empty());
+    CHECK(list.begin() == list.end());
+}
+
+TEST_CASE("Test single linked list assign, resize and comparison") {
+    SingleLinkedList<std::string> list = {"a", "b", "c"};
+    list.assign({"x", "y"});
+    CHECK(list == SingleLinkedList<std::string>{"x", "y"});
+    list.assign(4, "z");
+    CHECK(list.size() == 4);
+    CHECK(std::all_of(list.begin(), list.end(), [](const std::string& s) { return s == "z"; }));
+
+    list.resize(2);
+    CHECK(list.size() == 2);
+    list.resize(3, "w");
+    CHECK(list == SingleLinkedList<std::string>{"z", "z", "w"});
+    list.resize(5);
+    CHECK(*std::next(list.begin(), 4) == "");
+
+    SingleLinkedList<int> small = {1, 2};
+    SingleLinkedList<int> large = {1, 3};
+    CHECK(small < large);
+    CHECK(SingleLinkedList<int>{1, 2, 0} > small);
+
+    SingleLinkedList<int> copy(small);
+    CHECK(copy == small);
+    SingleLinkedList<int> moved(std::move(copy));
+    CHECK(moved == small);
+    CHECK(copy.empty());
+    copy = large;
+    CHECK(copy == large);
+    swap(copy, moved);
+    CHECK(copy == small);
+    CHECK(moved == large);
+}
+
+TEST_CASE("Test single linked list splice_after") {
+    SingleLinkedList<int> list = {1, 2, 3};
+    SingleLinkedList<int> other = {10, 20, 30, 40};
+
+    // Single element: 20 moves behind 1
+    list.splice_after(list.begin(), other, other.begin());
+    CHECK(list == SingleLinkedList<int>{1, 20, 2, 3});
+    CHECK(other == SingleLinkedList<int>{10, 30, 40});
+
+    // Range (10, end): 30 and 40 move to the front
+    list.splice_after(list.before_begin(), other, other.begin(), other.end());
+    CHECK(list == SingleLinkedList<int>{30, 40, 1, 20, 2, 3});
+    CHECK(other.size() == 1);
+
+    // Whole list
+    list.splice_after(std::next(list.begin(), 5), other);
+    CHECK(list == SingleLinkedList<int>{30, 40, 1, 20, 2, 3, 10});
+    CHECK(other.empty());
+    CHECK(list.size() == 7);
+
+    // Within one list: move 1 to the front
+    list.splice_after(list.before_begin(), list, std::next(list.begin()));
+    CHECK(list == SingleLinkedList<int>{1, 30, 40, 20, 2, 3, 10});
+    CHECK(list.size() == 7);
+    CHECK_THROWS_AS(list.splice_after(list.begin(), other, other.before_begin()), std::out_of_range);
+}
+
+TEST_CASE("Test single linked list sort, merge, unique, remove and reverse") {
+    SingleLinkedList<int> list;
+    std::forward_list<int> reference;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 500; ++i) {
+        const int value = static_cast<int>(rng() % 50);
+        list.push_front(value);
+        reference.push_front(value);
+    }
+    list.sort();
+    reference.sort();
+    CHECK(std::equal(list.begin(), list.end(), reference.begin(), reference.end()));
+
+    SingleLinkedList<int> other = {-1, 25, 100};
+    list.merge(other);
+    CHECK(other.empty());
+    CHECK(list.size() == 503);
+    CHECK(std::is_sorted(list.begin(), list.end()));
+    CHECK(list.front() == -1);
+
+    const auto removed = list.unique();
+    CHECK(removed == 503 - 52);
+    CHECK(list.size() == 52);
+    CHECK(list.remove(25) == 1);
+    CHECK(list.remove_if([](int v) { return v % 2 != 0; }) == 25);
+    list.reverse();
+    CHECK(list.front() == 100);
+    CHECK(std::is_sorted(list.begin(), list.end(), std::greater<>()));
+}
+
+TEST_CASE("Test single linked list stable sort") {
+    struct Item {
+        int key;
+        int order;
+    };
+    SingleLinkedList<Item> list;
+    for (int i = 9; i >= 0; --i) {
+        list.push_front({i % 3, i});
+    }
+    list.sort([](const Item& a, const Item& b) { return a.key < b.key; });
+    CHECK(std::is_sorted(list.begin(), list.end(),
+        [](const Item& a, const Item& b) { return a.key < b.key || (a.key == b.key && a.order < b.order); }));
+}
+
+TEST_CASE("Test pooled single linked list") {
+    PooledSingleLinkedList<int> list = {1, 2, 3};
+    list.insert_after(list.begin(), 5);
+    CHECK(list.size() == 4);
+    CHECK(*std::next(list.begin()) == 5);
+}
+
+TEST_CASE("Test treiber stack push and pop") {
+    TreiberLink nodes[3];
+    TreiberStack stack;
+    CHECK(stack.empty());
+    CHECK(stack.pop() == nullptr);
+    stack.push(&nodes[0]);
+    stack.push(&nodes[1]);
+    CHECK(stack.pop() == &nodes[1]);
+
+    nodes[2].next.store(&nodes[1]);
+    stack.push_chain(&nodes[2], &nodes[1]);
+    CHECK(stack.pop() == &nodes[2]);
+    TreiberLink* all = stack.pop_all();
+    CHECK(all == &nodes[1]);
+    CHECK(all->next.load() == &nodes[0]);
+    CHECK(stack.empty());
+}
+
+TEST_CASE("Test concurrent stack") {
+    ConcurrentStack<std::string> stack;
+    std::string value;
+    CHECK_FALSE(stack.try_pop(value));
+    stack.push("a");
+    stack.emplace(3, 'b');
+    CHECK_FALSE(stack.empty());
+    CHECK(stack.try_pop(value));
+    CHECK(value == "bbb");
+    CHECK(stack.try_pop(value));
+    CHECK(value == "a");
+    CHECK(stack.empty());
+    stack.reserve(16);
+    stack.push("left for the destructor");
+}
+
+TEST_CASE("Test concurrent stack with several producers and consumers") {
+    constexpr int threads = 4;
+    constexpr int per_thread = 20000;
+    ConcurrentStack<int> stack;
+    std::vector<std::vector<int>> seen(threads);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            // Each thread pushes its own values and pops anything, so nodes cycle between threads
+            for (int i = 0; i < per_thread; ++i) {
+                stack.push(t * per_thread + i);
+                int value;
+                if (stack.try_pop(value)) {
+                    seen[static_cast<std::size_t>(t)].push_back(value);
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    int value;
+    std::vector<int> all;
+    while (stack.try_pop(value)) {
+        all.push_back(value);
+    }
+    for (const auto& values : seen) {
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end());
+    CHECK(all.size() == static_cast<std::size_t>(threads * per_thread));
+    CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+    CHECK(all.front() == 0);
+    CHECK(all.back() == threads * per_thread - 1);
+}
@@ -0,0 +1,225 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/smallDynamicArray.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    // Element whose move may throw, so growth copies it; the copy numbered fail_at throws
+    struct FragileCopy {
+        static inline int live = 0;
+        static inline int copies = 0;
+        static inline int fail_at = -1;
+
+        std::string value;
+
+        explicit FragileCopy(std::string v) : value(std::move(v)) { ++live; }
+        FragileCopy(const FragileCopy& other) : value(other.value) {
+            if (copies++ == fail_at) {
+                throw std::runtime_error("copy");
+            }
+            ++live;
+        }
+        FragileCopy(FragileCopy&& other) noexcept(false) : value(std::move(other.value)) { ++live; }
+        FragileCopy& operator=(const FragileCopy&) = default;
+        FragileCopy& operator=(FragileCopy&&) = default;
+        ~FragileCopy() { --live; }
+    };
+}
+
+TEST_CASE("Test small array stays inline up to N elements") {
+    SmallDynamicArray<int, 8> arr;
+    CHECK(arr.is_inline());
+    CHECK(arr.capacity() == 8);
+
+    for (int i = 0; i < 8; ++i) {
+        arr.push_back(i);
+    }
+    CHECK(arr.is_inline());
+    CHECK(arr.data().data() == &arr[0]);
+    CHECK(reinterpret_cast<const std::byte*>(arr.data().data()) >= reinterpret_cast<const std::byte*>(&arr));
+    CHECK(reinterpret_cast<const std::byte*>(arr.data().data()) < reinterpret_cast<const std::byte*>(&arr) + sizeof(arr));
+
+    arr.push_back(8);
+    CHECK(!arr.is_inline());
+    CHECK(arr.capacity() == 16);
+    CHECK(arr.size() == 9);
+    for (int i = 0; i < 9; ++i) {
+        CHECK(arr[i] == i);
+    }
+}
+
+TEST_CASE("Test small array shrinks back into the inline buffer") {
+    SmallDynamicArray<std::string, 4> arr = {"a", "b", "c", "d", "e", "f"};
+    CHECK(!arr.is_inline());
+
+    arr.erase(arr.cbegin() + 1, arr.cend() - 1);
+    CHECK(!arr.is_inline());
+    arr.shrink_to_fit();
+    CHECK(arr.is_inline());
+    CHECK(arr.capacity() == 4);
+    CHECK(arr == SmallDynamicArray<std::string, 4>{"a", "f"});
+
+    arr.push_back(std::string(40, 'x'));
+    arr.clear();
+    CHECK(arr.empty());
+    CHECK(arr.is_inline());
+}
+
+TEST_CASE("Test small array insert, emplace and erase") {
+    SmallDynamicArray<std::string, 4> arr = {"b", "d"};
+
+    arr.emplace(arr.cbegin() + 1, "c");
+    arr.push_front("a");
+    CHECK(arr.is_inline());
+    CHECK(arr == SmallDynamicArray<std::string, 4>{"a", "b", "c", "d"});
+
+    arr.insert(arr.cbegin() + 2, 2, "x");
+    CHECK(arr == SmallDynamicArray<std::string, 4>{"a", "b", "x", "x", "c", "d"});
+
+    arr.insert(arr.cbegin(), {"0", "1"});
+    CHECK(arr.size() == 8);
+    CHECK(arr.front() == "0");
+
+    arr.erase(arr.cbegin());
+    arr.pop_front();
+    arr.pop_back();
+    CHECK(arr == SmallDynamicArray<std::string, 4>{"a", "b", "x", "x", "c"});
+    CHECK_THROWS_AS(arr.erase(arr.cend()), std::out_of_range);
+    CHECK_THROWS_AS(arr.at(5), std::out_of_range);
+
+    SUBCASE("Arguments may alias elements") {
+        SmallDynamicArray<std::string, 2> small = {"first", "second"};
+        small.push_back(small[0]);
+        small.insert(small.cbegin(), 2, small.back());
+        CHECK(small == SmallDynamicArray<std::string, 2>{"first", "first", "first", "second", "first"});
+    }
+}
+
+TEST_CASE("Test small array copy, move and swap") {
+    SmallDynamicArray<std::string, 4> inline_arr = {"a", "b"};
+    SmallDynamicArray<std::string, 4> heap_arr = {"1", "2", "3", "4", "5"};
+
+    SmallDynamicArray<std::string, 4> copy(heap_arr);
+    CHECK(copy == heap_arr);
+
+    SmallDynamicArray<std::string, 4> moved_inline(std::move(inline_arr));
+    CHECK(moved_inline.is_inline());
+    CHECK(moved_inline.size() == 2);
+    CHECK(inline_arr.empty());
+
+    const std::string* heap_storage = heap_arr.data().data();
+    SmallDynamicArray<std::string, 4> moved_heap(std::move(heap_arr));
+    CHECK(moved_heap.data().data() == heap_storage);
+    CHECK(heap_arr.is_inline());
+    CHECK(heap_arr.empty());
+
+    moved_inline.swap(moved_heap);
+    CHECK(moved_inline.size() == 5);
+    CHECK(moved_heap == SmallDynamicArray<std::string, 4>{"a", "b"});
+
+    copy = moved_heap;
+    CHECK(copy.size() == 2);
+    copy = std::move(moved_inline);
+    CHECK(copy.size() == 5);
+    CHECK(copy.back() == "5");
+
+    // Elements that cannot be assigned, as in hash map entries, are still copied
+    using Entry = std::pair<const std::string, int>;
+    SmallDynamicArray<Entry, 2> entries;
+    entries.emplace_back("a", 1);
+    SmallDynamicArray<Entry, 2> inline_copy(entries);
+    CHECK(inline_copy.is_inline());
+    CHECK(inline_copy[0].first == "a");
+    entries.emplace_back("b", 2);
+    entries.emplace_back("c", 3);
+    SmallDynamicArray<Entry, 2> heap_copy(entries);
+    CHECK(!heap_copy.is_inline());
+    CHECK(heap_copy.size() == 3);
+    CHECK(heap_copy[2].second == 3);
+}
+
+TEST_CASE("Test small array ordering and resize") {
+    SmallDynamicArray<int, 4> a = {1, 2, 3};
+    SmallDynamicArray<int, 4> b = {1, 2, 4};
+
+    CHECK(a < b);
+    CHECK(a != b);
+    CHECK((a <=> SmallDynamicArray<int, 4>{1, 2, 3}) == std::strong_ordering::equal);
+    CHECK((SmallDynamicArray<float, 4>{1.0f} <=> SmallDynamicArray<float, 4>{2.0f}) == std::partial_ordering::less);
+    CHECK(SmallDynamicArray<double, 2>{1.0, 2.0, 3.0} > SmallDynamicArray<double, 2>{1.0, 2.0});
+
+    a.resize(6, 9);
+    CHECK(a.size() == 6);
+    CHECK(a[5] == 9);
+    a.resize(2);
+    CHECK(a == SmallDynamicArray<int, 4>{1, 2});
+
+    a.assign(3, 7);
+    CHECK(a == SmallDynamicArray<int, 4>{7, 7, 7});
+
+    SmallDynamicArray<int, 4> sized(10);
+    CHECK(sized.size() == 10);
+    CHECK(sized[9] == 0);
+}
+
+TEST_CASE("Test small array move-only elements") {
+    SmallDynamicArray<std::unique_ptr<int>, 2> arr;
+    for (int i = 0; i < 5; ++i) {
+        arr.emplace(arr.cbegin(), std::make_unique<int>(i));
+    }
+    CHECK(*arr.front() == 4);
+    CHECK(*arr.back() == 0);
+
+    SmallDynamicArray<std::unique_ptr<int>, 2> moved(std::move(arr));
+    CHECK(moved.size() == 5);
+}
+
+TEST_CASE("Test small array exposes the DynamicArray interface") {
+    SmallDynamicArray<int, 4> small = {4, 2, 3};
+    DynamicArray<int> dynamic = {4, 2, 3};
+
+    std::sort(small.begin(), small.end());
+    std::sort(dynamic.begin(), dynamic.end());
+    CHECK(std::equal(small.data().begin(), small.data().end(), dynamic.data().begin(), dynamic.data().end()));
+    CHECK(*small.rbegin() == 4);
+}
+
+TEST_CASE("Test small array growth keeps the elements when a copy throws") {
+    FragileCopy::live = 0;
+    {
+        SmallDynamicArray<FragileCopy, 4> arr;
+        for (int i = 0; i < 4; ++i) {
+            arr.emplace_back("long enough to leave the small string buffer " + std::to_string(i));
+        }
+
+        // Leaving the inline buffer
+        FragileCopy::copies = 0;
+        FragileCopy::fail_at = 2;
+        CHECK_THROWS_AS(arr.emplace_back("extra"), std::runtime_error);
+        CHECK(arr.is_inline());
+        CHECK(arr.size() == 4);
+        CHECK(arr[3].value == "long enough to leave the small string buffer 3");
+        CHECK(FragileCopy::live == 4);
+
+        // Growing a heap buffer
+        FragileCopy::fail_at = -1;
+        arr.emplace_back("extra");
+        arr.shrink_to_fit();
+        const std::size_t capacity = arr.capacity();
+        while (arr.size() < capacity) {
+            arr.emplace_back("filler");
+        }
+        const int live = FragileCopy::live;
+        FragileCopy::copies = 0;
+        FragileCopy::fail_at = 3;
+        CHECK_THROWS_AS(arr.emplace(arr.begin() + 1, "middle"), std::runtime_error);
+        CHECK(arr.size() == capacity);
+        CHECK(arr[4].value == "extra");
+        CHECK(FragileCopy::live == live);
+    }
+    CHECK(FragileCopy::live == 0);
+}
@@ -0,0 +1,168 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/algorithms/sorting.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    template <typename T>
+    std::vector<T> random_values(std::size_t n, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        std::vector<T> values(n);
+        for (T& value : values) {
+            if constexpr (std::is_floating_point_v<T>) {
+                value = static_cast<T>(static_cast<double>(rng() % 2000001) / 1000.0 - 1000.0);
+            } else {
+                value = static_cast<T>(rng());
+            }
+        }
+        return values;
+    }
+
+    template <typename T>
+    void check_radix_sorts() {
+        DynamicArray<T> scratch;
+        for (std::size_t n : {0, 1, 2, 31, 33, 1000, 20000}) {
+            std::vector<T> expected = random_values<T>(n, n + 1);
+            std::vector<T> lsd = expected;
+            std::vector<T> msd = expected;
+            std::sort(expected.begin(), expected.end());
+            radix_sort(std::span(lsd), scratch);
+            msd_radix_sort(std::span(msd));
+            CHECK(lsd == expected);
+            CHECK(msd == expected);
+        }
+    }
+}
+
+TEST_CASE("Test radix sorts match std::sort for every key type") {
+    check_radix_sorts<std::uint8_t>();
+    check_radix_sorts<std::int8_t>();
+    check_radix_sorts<std::int16_t>();
+    check_radix_sorts<std::uint32_t>();
+    check_radix_sorts<std::int32_t>();
+    check_radix_sorts<std::uint64_t>();
+    check_radix_sorts<std::int64_t>();
+    check_radix_sorts<float>();
+    check_radix_sorts<double>();
+}
+
+TEST_CASE("Test radix sort skips constant bytes and reuses scratch") {
+    // Small values in 64 bit keys: only the low byte differs
+    std::vector<std::uint64_t> values(5000);
+    std::mt19937 rng(1);
+    for (auto& value : values) {
+        value = rng() % 200;
+    }
+    DynamicArray<std::uint64_t> scratch(8000);
+    const auto* storage = scratch.begin();
+    radix_sort(std::span(values), scratch);
+    CHECK(std::is_sorted(values.begin(), values.end()));
+    CHECK(scratch.begin() == storage);
+    radix_sort(std::span(values));
+    CHECK(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST_CASE("Test radix sort orders floating point keys by the total order") {
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> values = {3.5, -0.0, inf, -inf, 0.0, -2.25, 1e-300, -1e-300};
+    DynamicArray<double> scratch;
+    radix_sort(std::span(values), scratch);
+    CHECK(values == std::vector<double>{-inf, -2.25, -1e-300, -0.0, 0.0, 1e-300, 3.5, inf});
+    CHECK(std::signbit(values[3]));
+    CHECK_FALSE(std::signbit(values[4]));
+
+    std::vector<float> floats = {2.0f, -0.0f, 0.0f, -1.0f};
+    msd_radix_sort(std::span(floats));
+    CHECK(std::signbit(floats[1]));
+    CHECK(floats.front() == -1.0f);
+}
+
+TEST_CASE("Test radix sort by key is stable") {
+    struct Posting {
+        std::uint32_t document;
+        std::string term;
+    };
+    std::vector<Posting> postings;
+    for (std::uint32_t i = 0; i < 3000; ++i) {
+        postings.push_back({(i * 7919u) % 500u, std::to_string(i)});
+    }
+    DynamicArray<Posting> scratch;
+    radix_sort_by_key(std::span(postings), [](const Posting& p) { return p.document; }, scratch);
+    CHECK(std::is_sorted(postings.begin(), postings.end(),
+        [](const Posting& a, const Posting& b) { return a.document < b.document; }));
+    // Equal documents keep their insertion order
+    for (std::size_t i = 1; i < postings.size(); ++i) {
+        if (postings[i - 1].document == postings[i].document) {
+            CHECK(std::stoi(postings[i - 1].term) < std::stoi(postings[i].term));
+        }
+    }
+
+    std::vector<std::pair<int, int>> pairs = {{3, 0}, {-1, 1}, {3, 2}, {-7, 3}};
+    radix_sort_by_key(std::span(pairs), [](const std::pair<int, int>& p) { return p.first; });
+    CHECK(pairs == std::vector<std::pair<int, int>>{{-7, 3}, {-1, 1}, {3, 0}, {3, 2}});
+}
+
+TEST_CASE("Test branchless bounds match std::lower_bound and std::upper_bound") {
+    std::vector<int> values;
+    for (int i = 0; i < 200; ++i) {
+        values.push_back(i / 3);
+    }
+    for (std::size_t n = 0; n <= values.size(); n += 7) {
+        const auto prefix = std::span<const int>(values).first(n);
+        for (int probe = -2; probe < 70; ++probe) {
+            CHECK(branchless_lower_bound(prefix, probe) ==
+                static_cast<std::size_t>(std::lower_bound(prefix.begin(), prefix.end(), probe) - prefix.begin()));
+            CHECK(branchless_upper_bound(prefix, probe) ==
+                static_cast<std::size_t>(std::upper_bound(prefix.begin(), prefix.end(), probe) - prefix.begin()));
+        }
+    }
+    const std::vector<int> descending = {9, 7, 7, 2};
+    CHECK(branchless_lower_bound(std::span(descending), 7, std::greater<>()) == 1);
+    CHECK(branchless_upper_bound(std::span(descending), 7, std::greater<>()) == 3);
+}
+
+TEST_CASE("Test galloping intersection and union match the std set operations") {
+    std::mt19937 rng(5);
+    DynamicArray<int> out;
+    for (std::size_t small : {0, 1, 10, 500}) {
+        for (std::size_t large : {0, 3, 1000, 20000}) {
+            std::vector<int> a(small);
+            std::vector<int> b(large);
+            for (int& v : a) {
+                v = static_cast<int>(rng() % 5000);
+            }
+            for (int& v : b) {
+                v = static_cast<int>(rng() % 5000);
+            }
+            std::sort(a.begin(), a.end());
+            std::sort(b.begin(), b.end());
+
+            std::vector<int> expected;
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            sorted_intersection(std::span(a), std::span(b), out);
+            CHECK(std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+            sorted_intersection(std::span(b), std::span(a), out);
+            CHECK(std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+
+            expected.clear();
+            std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            sorted_union(std::span(a), std::span(b), out);
+            CHECK(std::equal(out.begin(), out.end(), expected.begin(), expected.end()));
+        }
+    }
+
+    // Duplicates follow the multiset rules: min count for intersection, max count for union
+    const std::vector<int> a = {1, 1, 1, 4};
+    const std::vector<int> b = {1, 1, 2, 3, 4, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22,
+        23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33};
+    sorted_intersection(std::span(a), std::span(b), out);
+    CHECK(out == DynamicArray<int>{1, 1, 4});
+    sorted_union(std::span(a).first(3), std::span(b).first(2), out);
+    CHECK(out == DynamicArray<int>{1, 1, 1});
+}
@@ -0,0 +1,33 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/stack.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE("Test stack is last in first out") {
+    Stack<int> stack;
+    CHECK(stack.empty());
+    for (int i = 0; i < 1000; ++i) {
+        stack.push(i);
+    }
+    CHECK(stack.size() == 1000);
+    for (int i = 999; i >= 0; --i) {
+        REQUIRE(stack.top() == i);
+        stack.pop();
+    }
+    CHECK(stack.empty());
+    CHECK_THROWS_AS(stack.pop(), std::logic_error);
+}
+
+TEST_CASE("Test stack over a dynamic array") {
+    Stack<std::string, DynamicArray<std::string>> stack(DynamicArray<std::string>{"a", "b"});
+    CHECK(stack.top() == "b");
+    stack.emplace(2, 'c');
+    CHECK(stack.top() == "cc");
+    stack.pop();
+    stack.pop();
+    CHECK(stack.top() == "a");
+
+    Stack<std::string, DynamicArray<std::string>> copy = stack;
+    CHECK(copy == stack);
+}
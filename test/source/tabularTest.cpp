@@ -0,0 +1,134 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/data structures/tabular.h>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+    // Throws when constructed from a negative value, to interrupt a row append
+    struct Picky {
+        int value;
+
+        Picky(int v) : value(v) {
+            if (v < 0) {
+                throw std::runtime_error("negative");
+            }
+        }
+    };
+}
+
+TEST_CASE("Test tabular rows and columns") {
+    Tabular<int, double, std::string> table;
+    CHECK(table.empty());
+    table.push_back(1, 2.5, "one");
+    table.push_back(2, 0.5, std::string("two"));
+    table.push_back(std::tuple<int, double, std::string>{3, 4.0, "three"});
+    CHECK(table.size() == 3);
+    CHECK(decltype(table)::column_count == 3);
+
+    std::span<const int> ids = std::as_const(table).column<0>();
+    CHECK(ids.size() == 3);
+    CHECK(ids[2] == 3);
+    table.column<1>()[0] = 3.5;
+
+    auto [id, price, name] = table.row(1);
+    CHECK(id == 2);
+    CHECK(price == 0.5);
+    CHECK(name == "two");
+    std::get<2>(table.row(0)) = "uno";
+    CHECK(std::get<2>(table.at(0)) == "uno");
+    CHECK(std::get<1>(table.at(0)) == 3.5);
+    CHECK_THROWS_AS(table.at(3), std::out_of_range);
+
+    table.pop_back();
+    CHECK(table.size() == 2);
+    table.clear();
+    CHECK_THROWS_AS(table.pop_back(), std::logic_error);
+
+    Tabular<int, char> listed{{1, 'a'}, {2, 'b'}};
+    CHECK(listed.size() == 2);
+    CHECK(listed.column<1>()[1] == 'b');
+}
+
+TEST_CASE("Test tabular append rolls back on a throwing column") {
+    Tabular<std::string, Picky> table;
+    table.push_back("ok", 1);
+    CHECK_THROWS_AS(table.push_back("bad", -1), std::runtime_error);
+    CHECK(table.size() == 1);
+    CHECK(table.column<0>().size() == 1);
+    CHECK(table.column<1>().size() == 1);
+}
+
+TEST_CASE("Test column kernels") {
+    std::mt19937 rng(3);
+    for (std::size_t size : {std::size_t{1}, std::size_t{7}, std::size_t{8}, std::size_t{9}, std::size_t{1000}}) {
+        DynamicArray<std::int32_t> values;
+        for (std::size_t i = 0; i < size; ++i) {
+            values.push_back(static_cast<std::int32_t>(rng() % 2001) - 1000);
+        }
+        std::int64_t sum = 0;
+        std::int32_t low = values[0];
+        std::int32_t high = values[0];
+        std::int64_t positive_sum = 0;
+        std::size_t positives = 0;
+        for (std::int32_t v : values) {
+            sum += v;
+            low = std::min(low, v);
+            high = std::max(high, v);
+            if (v > 0) {
+                positive_sum += v;
+                ++positives;
+            }
+        }
+        CHECK(column_sum(values.data()) == sum);
+        const auto range = column_min_max(values.data());
+        CHECK(range.min == low);
+        CHECK(range.max == high);
+
+        RowMask mask = column_mask(values.data(), [](std::int32_t v) { return v > 0; });
+        CHECK(mask.size() == size);
+        CHECK(mask_count(mask.data()) == positives);
+        CHECK(column_sum(values.data(), mask.data()) == positive_sum);
+        CHECK(mask_indices(mask.data()).size() == positives);
+
+        mask_not(mask);
+        CHECK(mask_count(mask.data()) == size - positives);
+    }
+
+    DynamicArray<std::uint32_t> big{4000000000u, 4000000000u, 1u};
+    CHECK(column_sum(big.data()) == 8000000001ull);
+    DynamicArray<double> reals{0.5, 0.25, -1.0};
+    CHECK(column_sum(reals.data()) == -0.25);
+    CHECK(column_min_max(reals.data()).min == -1.0);
+    CHECK_THROWS_AS(column_min_max(DynamicArray<int>().data()), std::logic_error);
+    CHECK_THROWS_AS(column_sum(reals.data(), RowMask(2).data()), std::invalid_argument);
+}
+
+TEST_CASE("Test tabular masks and filter") {
+    Tabular<int, double, std::string> orders;
+    for (int i = 0; i < 100; ++i) {
+        orders.push_back(i, i * 1.5, "order-" + std::to_string(i));
+    }
+    CHECK(orders.sum<0>() == 4950);
+    CHECK(orders.sum<1>() == 4950 * 1.5);
+    CHECK(orders.min_max<1>().max == 99 * 1.5);
+
+    RowMask even = orders.where<0>([](int id) { return id % 2 == 0; });
+    RowMask cheap = orders.where<1>([](double price) { return price < 30.0; });
+    mask_and(even, cheap.data());
+    CHECK(mask_count(even.data()) == 10);
+    CHECK(orders.sum<0>(even) == 90);
+
+    Tabular<int, double, std::string> selected = orders.filter(even);
+    CHECK(selected.size() == 10);
+    CHECK(std::get<2>(selected.row(9)) == "order-18");
+
+    RowMask odd = orders.where<0>([](int id) { return id % 2 == 1; });
+    mask_or(odd, orders.where<0>([](int id) { return id == 0; }).data());
+    CHECK(mask_count(odd.data()) == 51);
+    CHECK_THROWS_AS(orders.filter(RowMask(3)), std::invalid_argument);
+    CHECK_THROWS_AS(mask_and(odd, RowMask(3).data()), std::invalid_argument);
+}
@@ -0,0 +1,161 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/allocators/threadCachingAllocator.h>
+#include <algorithmCollection/data structures/double_linkedList.h>
+#include <algorithmCollection/data structures/dynamicArray.h>
+#include <algorithmCollection/data structures/hash_map.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Test thread caching size classes") {
+    using Resource = ThreadCachingResource;
+    CHECK(Resource::size_class(1) == 0);
+    CHECK(Resource::size_class(16) == 0);
+    CHECK(Resource::size_class(17) == 1);
+    CHECK(Resource::size_class(32) == 1);
+    CHECK(Resource::size_class(Resource::max_block) == Resource::size_classes - 1);
+    CHECK(Resource::block_size(Resource::size_classes - 1) == Resource::max_block);
+    CHECK(Resource::batch_size(0) == 64);
+    CHECK(Resource::batch_size(Resource::size_classes - 1) == 2);
+
+    for (std::size_t c = 0; c < Resource::size_classes; ++c) {
+        CHECK(Resource::chunk_bytes % (Resource::block_size(c) * Resource::batch_size(c)) == 0);
+    }
+}
+
+TEST_CASE("Test thread caching allocator recycles blocks on the same thread") {
+    ThreadCachingAllocator<std::uint64_t> alloc;
+
+    std::uint64_t* first = alloc.allocate(3);
+    CHECK(reinterpret_cast<std::uintptr_t>(first) % 32 == 0);
+    alloc.deallocate(first, 3);
+    std::uint64_t* second = alloc.allocate(4);
+    CHECK(first == second);
+    alloc.deallocate(second, 4);
+
+    CHECK(alloc.allocate(0) == nullptr);
+    CHECK_THROWS_AS(alloc.allocate(static_cast<std::size_t>(-1)), std::bad_array_new_length);
+
+    // Beyond max_block the request goes straight to the heap
+    std::uint64_t* large = alloc.allocate(ThreadCachingResource::max_block);
+    large[ThreadCachingResource::max_block - 1] = 1;
+    alloc.deallocate(large, ThreadCachingResource::max_block);
+
+    struct alignas(256) Aligned {
+        std::byte bytes[256];
+    };
+    ThreadCachingAllocator<Aligned> aligned_alloc;
+    Aligned* aligned = aligned_alloc.allocate(2);
+    CHECK(reinterpret_cast<std::uintptr_t>(aligned) % 256 == 0);
+    aligned_alloc.deallocate(aligned, 2);
+
+    CHECK(ThreadCachingAllocator<int>() == ThreadCachingAllocator<double>());
+}
+
+TEST_CASE("Test thread caching allocator spills to and refills from the central list") {
+    using Resource = ThreadCachingResource;
+    constexpr std::size_t bytes = 4096;
+    const std::size_t size_class = Resource::size_class(bytes);
+    const std::size_t batch = Resource::batch_size(size_class);
+    ThreadCachingAllocator<std::byte> alloc;
+
+    std::vector<std::byte*> blocks;
+    for (std::size_t i = 0; i < 4 * batch; ++i) {
+        blocks.push_back(alloc.allocate(bytes));
+    }
+    const std::size_t central_before = Resource::instance().central_blocks(size_class);
+    for (std::byte* block : blocks) {
+        alloc.deallocate(block, bytes);
+    }
+
+    // The cache never holds two full batches, the rest went back in batches
+    CHECK(Resource::cached_blocks(size_class) < 2 * batch);
+    CHECK(Resource::instance().central_blocks(size_class) + Resource::cached_blocks(size_class) >= central_before + 4 * batch);
+    CHECK(Resource::instance().reserved_bytes() >= Resource::chunk_bytes);
+
+    SUBCASE("An exiting thread hands its cache back") {
+        std::size_t cached_by_worker = 0;
+        const std::size_t central = Resource::instance().central_blocks(size_class);
+        std::thread worker([&] {
+            std::byte* block = alloc.allocate(bytes);
+            alloc.deallocate(block, bytes);
+            cached_by_worker = Resource::cached_blocks(size_class);
+        });
+        worker.join();
+        CHECK(cached_by_worker > 0);
+        CHECK(Resource::instance().central_blocks(size_class) == central);
+    }
+}
+
+TEST_CASE("Test thread caching allocator frees blocks allocated on another thread") {
+    ThreadCachingAllocator<std::uint64_t> alloc;
+    constexpr std::size_t count = 10000;
+
+    std::vector<std::uint64_t*> blocks(count);
+    std::thread producer([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            blocks[i] = alloc.allocate(2);
+            blocks[i][0] = i;
+        }
+    });
+    producer.join();
+
+    bool intact = true;
+    std::thread consumer([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            intact = intact && blocks[i][0] == i;
+            alloc.deallocate(blocks[i], 2);
+        }
+    });
+    consumer.join();
+    CHECK(intact);
+
+    // Concurrent churn with every node freed by a different thread than the one allocating it
+    constexpr int threads = 4;
+    std::vector<std::atomic<std::uint64_t*>> slots(1024);
+    std::atomic<std::size_t> mismatches{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (std::size_t i = 0; i < 20000; ++i) {
+                auto* fresh = alloc.allocate(2);
+                fresh[0] = static_cast<std::uint64_t>(t);
+                fresh[1] = static_cast<std::uint64_t>(t);
+                auto* previous = slots[(i * 7 + static_cast<std::size_t>(t)) % slots.size()].exchange(fresh);
+                if (previous) {
+                    if (previous[0] != previous[1]) {
+                        mismatches.fetch_add(1);
+                    }
+                    alloc.deallocate(previous, 2);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto& slot : slots) {
+        alloc.deallocate(slot.load(), 2);
+    }
+    CHECK(mismatches.load() == 0);
+}
+
+TEST_CASE("Test thread caching allocator in containers") {
+    DynamicArray<std::string, ThreadCachingAllocator<std::string>> strings;
+    DoubleLinkedList<int, ThreadCachingAllocator<int>> list;
+    HashMap<int, int, std::hash<int>, std::equal_to<int>, ThreadCachingAllocator<std::pair<const int, int>>> map;
+    for (int i = 0; i < 5000; ++i) {
+        strings.push_back(std::to_string(i) + "-long-enough-to-leave-the-small-buffer");
+        list.push_back(i);
+        map.insert({i, i * 2});
+    }
+    CHECK(strings[4999].starts_with("4999"));
+    CHECK(list.size() == 5000);
+    CHECK(map.at(1234) == 2468);
+
+    // A list built on one thread and destroyed on another
+    auto moved = std::make_unique<DoubleLinkedList<int, ThreadCachingAllocator<int>>>(std::move(list));
+    std::thread([owned = std::move(moved)]() mutable { owned.reset(); }).join();
+}
@@ -0,0 +1,136 @@
+#include <doctest/doctest.h>
+#include <algorithmCollection/algorithms/threadPool.h>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Test thread pool covers every index once") {
+    ThreadPool pool(3);
+    CHECK(pool.concurrency() == 4);
+    for (std::size_t count : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{1000}, std::size_t{100003}}) {
+        std::vector<std::atomic<int>> hits(count);
+        std::atomic<bool> worker_in_range{true};
+        pool.parallel_for(count, 64, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+            if (worker >= pool.concurrency() || end - begin > 64) {
+                worker_in_range = false;
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                hits[i].fetch_add(1);
+            }
+        });
+        CHECK(worker_in_range);
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(hits[i].load() == 1);
+        }
+    }
+}
+
+TEST_CASE("Test thread pool without threads runs inline") {
+    ThreadPool pool(0);
+    CHECK(pool.concurrency() == 1);
+    std::vector<std::size_t> begins;
+    pool.parallel_for(10, 3, [&](std::size_t begin, std::size_t, std::size_t worker) {
+        CHECK(worker == 0);
+        begins.push_back(begin);
+    });
+    CHECK(begins == std::vector<std::size_t>{0, 3, 6, 9});
+}
+
+TEST_CASE("Test thread pool per worker scratch") {
+    ThreadPool pool(2);
+    std::vector<long> sums(pool.concurrency(), 0);
+    for (int round = 0; round < 50; ++round) {
+        pool.parallel_for(10000, 100, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+            for (std::size_t i = begin; i < end; ++i) {
+                sums[worker] += static_cast<long>(i);
+            }
+        });
+    }
+    long total = 0;
+    for (long sum : sums) {
+        total += sum;
+    }
+    CHECK(total == 50L * 9999 * 10000 / 2);
+}
+
+TEST_CASE("Test thread pool rethrows exceptions") {
+    ThreadPool pool(2);
+    CHECK_THROWS_AS(pool.parallel_for(1000, 10, [](std::size_t begin, std::size_t, std::size_t) {
+        if (begin == 500) {
+            throw std::runtime_error("chunk failed");
+        }
+    }), std::runtime_error);
+
+    // The pool stays usable afterwards
+    std::atomic<std::size_t> covered{0};
+    pool.parallel_for(1000, 10, [&](std::size_t begin, std::size_t end, std::size_t) { covered += end - begin; });
+    CHECK(covered == 1000);
+}
+
+TEST_CASE("Test thread pool nested loops run inline") {
+    ThreadPool pool(2);
+    std::atomic<std::size_t> covered{0};
+    std::atomic<bool> same_worker{true};
+    pool.parallel_for(8, 1, [&](std::size_t, std::size_t, std::size_t outer) {
+        pool.parallel_for(100, 10, [&](std::size_t begin, std::size_t end, std::size_t inner) {
+            if (inner != outer) {
+                same_worker = false;
+            }
+            covered += end - begin;
+        });
+    });
+    CHECK(same_worker);
+    CHECK(covered == 800);
+}
+
+namespace {
+    // Sums [begin, end) by splitting it in halves down to single elements
+    long split_sum(ThreadPool& pool, const std::vector<long>& values, std::size_t begin, std::size_t end) {
+        if (end - begin == 1) {
+            return values[begin];
+        }
+        const std::size_t middle = begin + (end - begin) / 2;
+        long left = 0;
+        long right = 0;
+        pool.invoke([&] { left = split_sum(pool, values, begin, middle); },
+            [&] { right = split_sum(pool, values, middle, end); });
+        return left + right;
+    }
+}
+
+TEST_CASE("Test thread pool invoke forks and joins") {
+    std::vector<long> values(5000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<long>(i);
+    }
+    for (std::size_t threads : {std::size_t{0}, std::size_t{1}, std::size_t{3}}) {
+        ThreadPool pool(threads);
+        CHECK(split_sum(pool, values, 0, values.size()) == 4999L * 5000 / 2);
+
+        long total = 0;
+        pool.fork_join([&] { total = split_sum(pool, values, 0, values.size()); });
+        CHECK(total == 4999L * 5000 / 2);
+    }
+}
+
+TEST_CASE("Test thread pool invoke rethrows exceptions") {
+    ThreadPool pool(2);
+    std::atomic<int> ran{0};
+    CHECK_THROWS_AS(pool.invoke([&] { ++ran; }, [] { throw std::runtime_error("second failed"); }), std::runtime_error);
+    CHECK_THROWS_AS(pool.invoke([] { throw std::runtime_error("first failed"); }, [&] { ++ran; }), std::runtime_error);
+    CHECK(ran.load() >= 1);
+
+    // The pool stays usable afterwards
+    std::vector<long> values(100, 1);
+    CHECK(split_sum(pool, values, 0, values.size()) == 100);
+}
+
+TEST_CASE("Test thread pool invoke inside a loop chunk runs inline") {
+    ThreadPool pool(2);
+    std::atomic<std::size_t> covered{0};
+    pool.parallel_for(8, 1, [&](std::size_t, std::size_t, std::size_t) {
+        pool.invoke([&] { ++covered; }, [&] { ++covered; });
+    });
+    CHECK(covered == 16);
+}